@@ -0,0 +1,11 @@
+#pragma once
+
+// x86 캐시 라인 크기 (false sharing 방지용 정렬/패딩 단위)
+#define CACHE_LINE_SIZE 64
+
+#define __cacheline_aligned __attribute__((aligned(CACHE_LINE_SIZE)))
+
+// spin-wait 루프 힌트 (HT에서 다른 논리 CPU에 파이프라인 양보, 전력 절감)
+static inline void cpu_relax(void) {
+    __asm__ __volatile__("pause" ::: "memory");
+}
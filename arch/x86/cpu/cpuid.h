@@ -0,0 +1,23 @@
+#pragma once
+#include <stdint.h>
+
+// CPUID leaf 1 EDX
+#define CPUID_EDX_FPU  (1u << 0)
+#define CPUID_EDX_TSC  (1u << 4)
+#define CPUID_EDX_MSR  (1u << 5)
+#define CPUID_EDX_PAT  (1u << 16)
+#define CPUID_EDX_FXSR (1u << 24)
+#define CPUID_EDX_SSE  (1u << 25)
+#define CPUID_EDX_SSE2 (1u << 26)
+
+static inline void cpuid(uint32_t leaf, uint32_t* a, uint32_t* b, uint32_t* c, uint32_t* d) {
+    __asm__ __volatile__("cpuid"
+        : "=a"(*a), "=b"(*b), "=c"(*c), "=d"(*d)
+        : "a"(leaf), "c"(0));
+}
+
+static inline uint32_t cpuid_features_edx(void) {
+    uint32_t a, b, c, d;
+    cpuid(1, &a, &b, &c, &d);
+    return d;
+}
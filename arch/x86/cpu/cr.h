@@ -0,0 +1,69 @@
+#pragma once
+#include <stdint.h>
+
+// CR0 bits
+#define CR0_PE (1u << 0)   // Protected mode enable
+#define CR0_MP (1u << 1)   // Monitor coprocessor (TS일 때 WAIT/FWAIT도 #NM)
+#define CR0_EM (1u << 2)   // x87 emulation (1이면 모든 FPU 명령이 #NM)
+#define CR0_TS (1u << 3)   // Task switched (lazy FPU: 다음 FPU 명령에서 #NM)
+#define CR0_NE (1u << 5)   // Native x87 error reporting (#MF)
+#define CR0_WP (1u << 16)  // Supervisor write-protect (ring0도 RO 페이지 존중)
+#define CR0_PG (1u << 31)  // Paging enable
+
+// CR4 bits
+#define CR4_PSE        (1u << 4)   // 4MB page 지원
+#define CR4_OSFXSR     (1u << 9)   // FXSAVE/FXRSTOR + SSE 명령 허용
+#define CR4_OSXMMEXCPT (1u << 10)  // SIMD FP 예외를 #XM으로 전달
+
+static inline uint32_t read_cr0(void) {
+    uint32_t val;
+    __asm__ __volatile__("mov %%cr0, %0" : "=r"(val));
+    return val;
+}
+
+static inline void write_cr0(uint32_t val) {
+    __asm__ __volatile__("mov %0, %%cr0" : : "r"(val) : "memory");
+}
+
+// CR2: 마지막 #PF가 발생한 선형 주소
+static inline uint32_t read_cr2(void) {
+    uint32_t val;
+    __asm__ __volatile__("mov %%cr2, %0" : "=r"(val));
+    return val;
+}
+
+// CR3: 현재 page directory의 물리 주소
+static inline uint32_t read_cr3(void) {
+    uint32_t val;
+    __asm__ __volatile__("mov %%cr3, %0" : "=r"(val));
+    return val;
+}
+
+static inline void write_cr3(uint32_t val) {
+    __asm__ __volatile__("mov %0, %%cr3" : : "r"(val) : "memory");
+}
+
+static inline uint32_t read_cr4(void) {
+    uint32_t val;
+    __asm__ __volatile__("mov %%cr4, %0" : "=r"(val));
+    return val;
+}
+
+static inline void write_cr4(uint32_t val) {
+    __asm__ __volatile__("mov %0, %%cr4" : : "r"(val) : "memory");
+}
+
+// 단일 페이지 TLB 무효화
+static inline void invlpg(uint32_t vaddr) {
+    __asm__ __volatile__("invlpg (%0)" : : "r"(vaddr) : "memory");
+}
+
+// CR0.TS clear (FPU 사용 허용)
+static inline void clts(void) {
+    __asm__ __volatile__("clts" : : : "memory");
+}
+
+// CR0.TS set (다음 FPU 명령에서 #NM)
+static inline void stts(void) {
+    write_cr0(read_cr0() | CR0_TS);
+}
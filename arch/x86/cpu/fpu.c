@@ -0,0 +1,147 @@
+#include "fpu.h"
+#include "cr.h"
+#include "cpuid.h"
+#include "../../../kernel/sched/thread.h"
+#include "../../../kernel/memory/heap.h"
+#include "../../../kernel/console/kprintf.h"
+#include "../interrupt/irq.h"
+#include "irqflags.h"
+
+static int g_fpu_ready = 0;
+
+// CR0.TS 현재 값 캐시 (CR0 쓰기는 serializing이라 바뀔 때만 기록)
+static int g_ts_set = 0;
+
+// 현재 FPU 레지스터에 상태가 올라가 있는 스레드 (없으면 0)
+static thread_t* g_fpu_owner = 0;
+
+// fninit 직후 상태: 새 스레드의 첫 FPU 사용 시 이 이미지를 복사
+static fpu_state_t g_fpu_init_state;
+
+static int g_kernel_fpu_active = 0;
+
+static uint32_t g_nm_traps = 0;
+static uint32_t g_saves = 0;
+static uint32_t g_restores = 0;
+
+static inline void fxsave(fpu_state_t* s) {
+    __asm__ __volatile__("fxsave (%0)" : : "r"(s->fxsave) : "memory");
+}
+
+static inline void fxrstor(const fpu_state_t* s) {
+    __asm__ __volatile__("fxrstor (%0)" : : "r"(s->fxsave) : "memory");
+}
+
+void fpu_init(void) {
+    uint32_t edx = cpuid_features_edx();
+
+    if (!(edx & CPUID_EDX_FPU) || !(edx & CPUID_EDX_FXSR)) {
+        kprintf("[FPU] no FXSR support, FPU left disabled\n");
+        write_cr0(read_cr0() | CR0_EM);
+        return;
+    }
+
+    uint32_t cr0 = read_cr0();
+    cr0 &= ~(CR0_EM | CR0_TS);
+    cr0 |= CR0_MP | CR0_NE;
+    write_cr0(cr0);
+
+    uint32_t cr4 = read_cr4() | CR4_OSFXSR;
+    if (edx & CPUID_EDX_SSE) cr4 |= CR4_OSXMMEXCPT;
+    write_cr4(cr4);
+
+    __asm__ __volatile__("fninit");
+    fxsave(&g_fpu_init_state);
+
+    // 아무도 FPU를 소유하지 않은 상태에서 시작: 첫 사용 스레드가 #NM으로 가져감
+    stts();
+    g_ts_set = 1;
+    g_fpu_ready = 1;
+
+    kprintf("[FPU] x87%s enabled (lazy switching)\n", (edx & CPUID_EDX_SSE) ? "+SSE" : "");
+}
+
+int fpu_available(void) {
+    return g_fpu_ready;
+}
+
+void fpu_switch_to(thread_t* next) {
+    if (!g_fpu_ready) return;
+
+    // 소유자에게 돌아가는 경우엔 레지스터가 그대로 유효하므로 trap 불필요
+    int want_ts = (next != g_fpu_owner);
+    if (want_ts == g_ts_set) return;
+
+    if (want_ts) stts();
+    else clts();
+    g_ts_set = want_ts;
+}
+
+int fpu_handle_nm(void) {
+    if (!g_fpu_ready) return 0;
+
+    clts();
+    g_ts_set = 0;
+    g_nm_traps++;
+
+    thread_t* cur = thread_current();
+    if (g_fpu_owner == cur) return 1;
+
+    if (g_fpu_owner) {
+        fxsave(g_fpu_owner->fpu);
+        g_saves++;
+    }
+
+    if (!cur->fpu) {
+        cur->fpu = (fpu_state_t*)kmalloc_aligned(sizeof(fpu_state_t), 16);
+        *cur->fpu = g_fpu_init_state;
+    }
+
+    fxrstor(cur->fpu);
+    g_restores++;
+    g_fpu_owner = cur;
+    return 1;
+}
+
+void fpu_thread_exit(thread_t* t) {
+    if (g_fpu_owner == t) g_fpu_owner = 0;
+    if (t->fpu) {
+        kfree(t->fpu);
+        t->fpu = 0;
+    }
+}
+
+int kernel_fpu_begin(void) {
+    if (!g_fpu_ready || in_irq() || g_kernel_fpu_active) return 0;
+
+    sched_preempt_disable();
+    uint32_t flags = irq_save();
+
+    clts();
+    g_ts_set = 0;
+
+    // 레지스터에 올라가 있는 스레드 상태를 먼저 내려둠 (다음 사용 시 #NM으로 복원)
+    if (g_fpu_owner) {
+        fxsave(g_fpu_owner->fpu);
+        g_saves++;
+        g_fpu_owner = 0;
+    }
+    g_kernel_fpu_active = 1;
+
+    irq_restore(flags);
+    return 1;
+}
+
+void kernel_fpu_end(void) {
+    g_kernel_fpu_active = 0;
+
+    // 소유자 없음: 어떤 스레드든 다음 FPU 사용 시 #NM으로 자기 상태를 복원
+    stts();
+    g_ts_set = 1;
+    sched_preempt_enable();
+}
+
+void fpu_dump_stats(void) {
+    kprintf("[FPU] nm_traps=%u saves=%u restores=%u owner=%s\n",
+        g_nm_traps, g_saves, g_restores, g_fpu_owner ? g_fpu_owner->name : "-");
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <stdint.h>
+
+struct thread;
+
+// FXSAVE/FXRSTOR 영역 (512바이트, 16바이트 정렬)
+typedef struct fpu_state {
+    uint8_t fxsave[512];
+} __attribute__((aligned(16))) fpu_state_t;
+
+// x87/SSE 활성화 (CR0.MP/NE, CR4.OSFXSR/OSXMMEXCPT) + 초기 상태 캡처
+// FXSR 미지원 CPU면 FPU는 꺼진 채로 남고 #NM은 치명적 예외로 처리됨
+void fpu_init(void);
+
+int fpu_available(void);
+
+// context switch 직전 호출: 다음 스레드가 FPU 소유자가 아니면 CR0.TS를 set
+// (실제 저장/복원은 해당 스레드가 FPU를 처음 건드릴 때 #NM에서 수행)
+void fpu_switch_to(struct thread* next);
+
+// #NM (Device Not Available) 처리. 해결했으면 1
+int fpu_handle_nm(void);
+
+// 스레드 종료 시 FPU 소유권/저장 영역 정리
+void fpu_thread_exit(struct thread* t);
+
+// 커널 코드에서 SSE 레지스터 사용 구간
+// 현재 소유자의 FPU 상태를 저장하고 선점을 막는다. IRQ 컨텍스트/중첩/FPU 미지원이면 0 반환
+// (0이면 SSE를 쓰지 말고 정수 경로로 처리, kernel_fpu_end도 호출하지 않음)
+int kernel_fpu_begin(void);
+void kernel_fpu_end(void);
+
+void fpu_dump_stats(void);
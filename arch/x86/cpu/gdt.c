@@ -14,7 +14,9 @@ typedef struct __attribute__((packed)) {
     uint32_t base;
 } gdt_ptr_t;
 
-static gdt_entry_t gdt[3];
+#define GDT_ENTRIES 5
+
+static gdt_entry_t gdt[GDT_ENTRIES];
 static gdt_ptr_t gp;
 
 extern void gdt_flush(uint32_t gdt_ptr_addr);
@@ -32,7 +34,7 @@ static void gdt_set_gate(int num, uint32_t base, uint32_t limit, uint8_t access,
 }
 
 void gdt_init(void) {
-    gp.limit = (sizeof(gdt_entry_t) * 3) - 1;
+    gp.limit = (sizeof(gdt_entry_t) * GDT_ENTRIES) - 1;
     gp.base = (uint32_t)&gdt;
 
     // 0: null descriptor
@@ -47,6 +49,16 @@ void gdt_init(void) {
     // access 0x92 = present, ring0, data segment, writable
     gdt_set_gate(2, 0, 0xFFFFFFFF, 0x92, 0xCF); // Data segment
 
+    // 3, 4: TSS 자리 (tss_init에서 채움)
+    gdt_set_gate(3, 0, 0, 0, 0);
+    gdt_set_gate(4, 0, 0, 0, 0);
+
     gdt_flush((uint32_t)&gp);
 
-}
\ No newline at end of file
+}
+
+void gdt_set_tss(int num, uint32_t base, uint32_t limit) {
+    // access 0x89 = present, ring0, system segment, type 0x9 (32-bit available TSS)
+    // gran 0x00 = byte granularity
+    gdt_set_gate(num, base, limit, 0x89, 0x00);
+}
@@ -1,4 +1,13 @@
 #pragma once
 #include <stdint.h>
 
-void gdt_init(void);
\ No newline at end of file
+// GDT selector
+#define GDT_KERNEL_CS   0x08
+#define GDT_KERNEL_DS   0x10
+#define GDT_TSS_SEL     0x18    // 기본 TSS (ltr, 이후 ring3 진입 시 esp0)
+#define GDT_DF_TSS_SEL  0x20    // #DF task gate용 TSS
+
+void gdt_init(void);
+
+// num번 엔트리를 32비트 available TSS descriptor로 설정
+void gdt_set_tss(int num, uint32_t base, uint32_t limit);
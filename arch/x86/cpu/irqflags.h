@@ -0,0 +1,46 @@
+#pragma once
+#include <stdint.h>
+
+#define EFLAGS_IF (1u << 9)
+
+// irqsoff tracer 훅 (kernel/trace/irqsoff.c). 추적이 켜져 있을 때만 부르며, 항상 인터럽트가 꺼진 채로
+// 호출된다 (off는 cli 직후, on은 sti 직전). 위치는 훅의 return address = 이 헬퍼를 인라인한 함수
+extern volatile uint32_t g_irqsoff_tracing;
+void trace_irqs_off(void);
+void trace_irqs_on(void);
+
+static inline void irq_disable(void) {
+    __asm__ __volatile__("cli" : : : "memory");
+    if (g_irqsoff_tracing) trace_irqs_off();
+}
+
+static inline void irq_enable(void) {
+    if (g_irqsoff_tracing) trace_irqs_on();
+    __asm__ __volatile__("sti" : : : "memory");
+}
+
+static inline int irqs_disabled(void) {
+    uint32_t flags;
+    __asm__ __volatile__("pushf; pop %0" : "=r"(flags));
+    return (flags & EFLAGS_IF) == 0;
+}
+
+// 현재 IF 상태를 반환하고 인터럽트 비활성화
+static inline uint32_t irq_save(void) {
+    uint32_t flags;
+    __asm__ __volatile__("pushf; pop %0; cli" : "=r"(flags) : : "memory");
+    if (g_irqsoff_tracing && (flags & EFLAGS_IF)) trace_irqs_off();
+    return flags;
+}
+
+// irq_save 이전 상태로 복원 (원래 꺼져 있었으면 그대로 유지)
+static inline void irq_restore(uint32_t flags) {
+    if (flags & EFLAGS_IF) irq_enable();
+}
+
+// 인터럽트를 켜고 다음 인터럽트까지 대기.
+// sti 다음 한 명령까지는 인터럽트가 들어오지 않으므로 sti와 hlt 사이에서 깨움을 놓치지 않는다
+static inline void safe_halt(void) {
+    if (g_irqsoff_tracing) trace_irqs_on();
+    __asm__ __volatile__("sti; hlt" : : : "memory");
+}
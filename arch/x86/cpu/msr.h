@@ -0,0 +1,16 @@
+#pragma once
+#include <stdint.h>
+
+// Model Specific Register (CPUID.1:EDX.MSR 필요)
+#define MSR_IA32_PAT 0x277
+
+static inline uint64_t rdmsr(uint32_t msr) {
+    uint32_t lo, hi;
+    __asm__ __volatile__("rdmsr" : "=a"(lo), "=d"(hi) : "c"(msr));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+static inline void wrmsr(uint32_t msr, uint64_t val) {
+    __asm__ __volatile__("wrmsr"
+        : : "c"(msr), "a"((uint32_t)val), "d"((uint32_t)(val >> 32)) : "memory");
+}
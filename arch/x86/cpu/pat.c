@@ -0,0 +1,35 @@
+#include "pat.h"
+#include "msr.h"
+#include "cpuid.h"
+#include "../../../kernel/console/kprintf.h"
+
+// PA0..PA7 (각 8비트): WB WT UC- UC | WC WT UC- UC
+#define PAT_VALUE ((uint64_t)PAT_WB          | ((uint64_t)PAT_WT << 8)  | \
+                   ((uint64_t)PAT_UCM << 16) | ((uint64_t)PAT_UC << 24) | \
+                   ((uint64_t)PAT_WC << 32)  | ((uint64_t)PAT_WT << 40) | \
+                   ((uint64_t)PAT_UCM << 48) | ((uint64_t)PAT_UC << 56))
+
+static int g_pat_ok = 0;
+
+int pat_init(void) {
+    uint32_t edx = cpuid_features_edx();
+    if (!(edx & CPUID_EDX_MSR) || !(edx & CPUID_EDX_PAT)) {
+        kprintf("[PAT] not supported, framebuffer stays uncached\n");
+        return 0;
+    }
+
+    uint64_t old = rdmsr(MSR_IA32_PAT);
+
+    // PA4를 쓰는 매핑이 아직 없으므로 캐시 비우기 후 바로 교체해도 된다 (단일 CPU, 부팅 시)
+    __asm__ __volatile__("wbinvd" : : : "memory");
+    wrmsr(MSR_IA32_PAT, PAT_VALUE);
+    __asm__ __volatile__("wbinvd" : : : "memory");
+
+    g_pat_ok = 1;
+    kprintf("[PAT] 0x%llx -> 0x%llx (PA4=WC)\n", old, PAT_VALUE);
+    return 1;
+}
+
+int pat_available(void) {
+    return g_pat_ok;
+}
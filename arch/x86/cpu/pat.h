@@ -0,0 +1,23 @@
+#pragma once
+#include <stdint.h>
+#include "../../../kernel/memory/paging.h"
+
+// Page Attribute Table: PTE의 PAT/PCD/PWT 3비트가 고르는 8개 메모리 타입 슬롯
+// 기본값(WB, WT, UC-, UC 반복)에서 PA4만 WC로 바꿔, 기존 PCD/PWT 의미는 그대로 두고
+// PTE에 PAGE_PAT 하나만 세우면 write-combining이 되게 한다.
+
+// PAT memory types
+#define PAT_UC  0x00
+#define PAT_WC  0x01
+#define PAT_WT  0x04
+#define PAT_WP  0x05
+#define PAT_WB  0x06
+#define PAT_UCM 0x07   // UC- (MTRR이 WC면 WC)
+
+// 4KB PTE에 줄 캐시 속성 (pat_init 성공 시에만 의미 있음)
+#define PAGE_CACHE_WC PAGE_PAT
+
+// PAT MSR 프로그래밍 (paging_init 이전, WC 매핑을 만들기 전). 지원하면 1
+int pat_init(void);
+
+int pat_available(void);
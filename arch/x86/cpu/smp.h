@@ -0,0 +1,14 @@
+#pragma once
+#include <stdint.h>
+
+// CPU 단위 자료구조 크기. 아직 AP 부팅(SMP)이 없으므로 BSP 하나만 온라인
+// per-CPU 배열은 [MAX_CPUS]로 두고 cpu_id()로 인덱싱해 두면 SMP 추가 시 그대로 확장된다.
+#define MAX_CPUS 1
+
+static inline uint32_t cpu_id(void) {
+    return 0;
+}
+
+static inline uint32_t cpu_online_mask(void) {
+    return (1u << MAX_CPUS) - 1;
+}
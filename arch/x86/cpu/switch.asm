@@ -0,0 +1,26 @@
+BITS 32
+
+global context_switch
+
+; void context_switch(uint32_t* old_esp, uint32_t new_esp)
+; callee-saved 레지스터(ebp/ebx/esi/edi)만 현재 스택에 저장하고 스택을 교체.
+; 나머지 레지스터는 C 호출 규약상 호출자가 이미 보존함.
+context_switch:
+    mov eax, [esp + 4]  ; old_esp 저장 위치
+    mov edx, [esp + 8]  ; 전환할 스택
+
+    push ebp
+    push ebx
+    push esi
+    push edi
+
+    mov [eax], esp
+    mov esp, edx
+
+    pop edi
+    pop esi
+    pop ebx
+    pop ebp
+    ret
+
+section .note.GNU-stack noalloc noexec nowrite progbits
@@ -0,0 +1,53 @@
+#include "tsc.h"
+#include "cpuid.h"
+#include "../../../kernel/time/time.h"
+#include "../../../kernel/console/kprintf.h"
+#include "../../../kernel/lib/div64.h"
+
+#define TSC_CALIB_TICKS 10
+
+static uint32_t g_tsc_hz = 0;
+
+void tsc_calibrate(void) {
+    if (!(cpuid_features_edx() & CPUID_EDX_TSC)) {
+        kprintf("[TSC] not supported\n");
+        return;
+    }
+
+    uint32_t hz = time_get_hz();
+
+    // tick 경계에 맞춘 뒤 N tick 동안의 TSC 증가량 측정
+    uint64_t t = timer_ticks();
+    while (timer_ticks() == t) { __asm__ __volatile__("pause"); }
+
+    uint64_t start_tick = timer_ticks();
+    uint64_t start = rdtsc();
+    while (timer_ticks() < start_tick + TSC_CALIB_TICKS) { __asm__ __volatile__("pause"); }
+    uint64_t end = rdtsc();
+
+    // 100ms 동안의 증가량은 32비트에 들어감 (~40GHz까지)
+    uint32_t delta = (uint32_t)(end - start);
+    g_tsc_hz = (delta / TSC_CALIB_TICKS) * hz;
+
+    kprintf("[TSC] %u MHz\n", g_tsc_hz / 1000000);
+}
+
+uint32_t tsc_hz(void) {
+    return g_tsc_hz;
+}
+
+uint64_t tsc_cycles_to_us(uint64_t cycles) {
+    uint32_t mhz = g_tsc_hz / 1000000;
+    if (mhz == 0) return 0;
+    div_u64_u32(&cycles, mhz);
+    return cycles;
+}
+
+uint64_t tsc_cycles_to_ns(uint64_t cycles) {
+    // cycles * 1000 / MHz: 곱셈 overflow는 4GHz 기준 약 50일 이후
+    uint32_t mhz = g_tsc_hz / 1000000;
+    if (mhz == 0) return 0;
+    cycles *= 1000;
+    div_u64_u32(&cycles, mhz);
+    return cycles;
+}
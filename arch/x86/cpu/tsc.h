@@ -0,0 +1,18 @@
+#pragma once
+#include <stdint.h>
+
+static inline uint64_t rdtsc(void) {
+    uint32_t lo, hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+// PIT tick을 기준으로 TSC 주파수 측정 (time_set_hz + sti 이후 호출, 약 100ms 소요)
+void tsc_calibrate(void);
+
+// 측정된 TSC 주파수 (Hz). 미측정이면 0
+uint32_t tsc_hz(void);
+
+// TSC 사이클 -> 마이크로초/나노초 (미측정이면 0)
+uint64_t tsc_cycles_to_us(uint64_t cycles);
+uint64_t tsc_cycles_to_ns(uint64_t cycles);
@@ -0,0 +1,80 @@
+#include "tss.h"
+#include "gdt.h"
+#include "cr.h"
+#include "../../../kernel/lib/string.h"
+#include "../../../kernel/console/kprintf.h"
+#include "../../../kernel/panic/panic.h"
+#include "../../../kernel/sched/thread.h"
+#include "../../../kernel/sched/kstack.h"
+
+#define DF_STACK_SIZE 4096
+
+static tss_t g_tss;
+static tss_t g_df_tss;
+static uint8_t g_df_stack[DF_STACK_SIZE] __attribute__((aligned(16)));
+
+// #DF task 진입점: task gate로 들어오므로 이전 상태는 g_tss에 저장되어 있고
+// 이 함수는 자기 TSS의 깨끗한 스택에서 실행된다 (error code 하나가 스택에 있음, 복귀 없음)
+__attribute__((noreturn))
+static void double_fault_task(void) {
+    thread_t* t = thread_current();
+
+    kprintf_clear_console();
+    kprintf_puts_at(2, 2, "DOUBLE FAULT (#DF)");
+    kprintf_puts_at(4, 2, "See console for details.");
+
+    kprintf("\n==============================\n");
+    kprintf("[EXC] Double Fault (#DF) - separate task/stack\n");
+    kprintf("==============================\n");
+    kprintf("  thread=%s cr2=0x%x cr3=0x%x\n", t ? t->name : "-", read_cr2(), g_tss.cr3);
+    kprintf("  eip=0x%x cs=0x%x eflags=0x%x\n", g_tss.eip, g_tss.cs, g_tss.eflags);
+    kprintf("  eax=0x%x ebx=0x%x ecx=0x%x edx=0x%x\n", g_tss.eax, g_tss.ebx, g_tss.ecx, g_tss.edx);
+    kprintf("  esi=0x%x edi=0x%x ebp=0x%x esp=0x%x\n", g_tss.esi, g_tss.edi, g_tss.ebp, g_tss.esp);
+
+    // guard 페이지까지 내려간 커널 스택: #PF 프레임을 쌓을 수 없어 #DF로 온다
+    uint32_t slot = kstack_guard_hit(g_tss.esp);
+    if (!slot) slot = kstack_guard_hit(read_cr2());
+    if (slot) {
+        kprintf("  kernel stack overflow: slot %u guard page hit\n", slot - 1);
+    }
+
+    panic("Double fault trapped. System halted.");
+}
+
+void tss_init(void) {
+    memset(&g_tss, 0, sizeof(g_tss));
+    g_tss.ss0 = GDT_KERNEL_DS;
+    g_tss.iomap_base = sizeof(tss_t);   // I/O 비트맵 없음
+
+    memset(&g_df_tss, 0, sizeof(g_df_tss));
+    g_df_tss.eip = (uint32_t)double_fault_task;
+    g_df_tss.esp = (uint32_t)(g_df_stack + DF_STACK_SIZE);
+    g_df_tss.ss0 = GDT_KERNEL_DS;
+    g_df_tss.esp0 = g_df_tss.esp;
+    g_df_tss.eflags = 0x2;              // IF=0, 예약 비트 1
+    g_df_tss.cs = GDT_KERNEL_CS;
+    g_df_tss.ds = GDT_KERNEL_DS;
+    g_df_tss.es = GDT_KERNEL_DS;
+    g_df_tss.fs = GDT_KERNEL_DS;
+    g_df_tss.gs = GDT_KERNEL_DS;
+    g_df_tss.ss = GDT_KERNEL_DS;
+    g_df_tss.cr3 = read_cr3();
+    g_df_tss.iomap_base = sizeof(tss_t);
+
+    gdt_set_tss(GDT_TSS_SEL >> 3, (uint32_t)&g_tss, sizeof(tss_t) - 1);
+    gdt_set_tss(GDT_DF_TSS_SEL >> 3, (uint32_t)&g_df_tss, sizeof(tss_t) - 1);
+
+    // task switch 시 CPU가 현재 상태를 저장할 TSS
+    __asm__ __volatile__("ltr %w0" : : "r"(GDT_TSS_SEL));
+
+    kprintf("[INFO] TSS loaded (sel=0x%x), #DF task gate stack=0x%x\n",
+        GDT_TSS_SEL, g_df_tss.esp);
+}
+
+void tss_set_df_cr3(uint32_t cr3) {
+    g_df_tss.cr3 = cr3;
+}
+
+void tss_set_kernel_stack(uint32_t esp0) {
+    g_tss.esp0 = esp0;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <stdint.h>
+
+// 32비트 TSS (하드웨어 task switch 때 CPU가 읽고 쓰는 배치 그대로)
+typedef struct __attribute__((packed)) tss {
+    uint32_t prev_task;
+    uint32_t esp0, ss0;
+    uint32_t esp1, ss1;
+    uint32_t esp2, ss2;
+    uint32_t cr3;
+    uint32_t eip, eflags;
+    uint32_t eax, ecx, edx, ebx;
+    uint32_t esp, ebp, esi, edi;
+    uint32_t es, cs, ss, ds, fs, gs;
+    uint32_t ldt;
+    uint16_t trap;
+    uint16_t iomap_base;
+} tss_t;
+
+// 기본 TSS + #DF 전용 TSS를 GDT에 올리고 ltr (gdt_init 이후)
+// x86-32에는 IST가 없으므로 전용 스택이 필요한 #DF만 task gate로 분리한다.
+void tss_init(void);
+
+// #DF task가 쓸 page directory (paging_init 이후, 커널 매핑은 모든 주소 공간에 공통)
+void tss_set_df_cr3(uint32_t cr3);
+
+// ring3 → ring0 진입 시 스택
+void tss_set_kernel_stack(uint32_t esp0);
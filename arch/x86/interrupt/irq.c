@@ -4,23 +4,81 @@
 #include "pit.h"
 #include "../../../kernel/console/kprintf.h"
 #include "../../../kernel/time/time.h"
+#include "../../../kernel/sched/thread.h"
+#include "../../../kernel/sched/workqueue.h"
+#include "../../../kernel/sched/cputime.h"
+#include "../../../kernel/sync/rcu.h"
+#include "../../../kernel/syscall/syscall.h"
+#include "../../../kernel/lib/cmdline.h"
+#include "../../../kernel/lib/div64.h"
+#include "../../../kernel/trace/irqsoff.h"
+#include "../cpu/tsc.h"
 
-#define IRQ_BASE 32
+// 진입 비용 측정용 벡터 (빈 핸들러)
+#define IRQ_BENCH_VECTOR 0xF0
+#define IRQ_BENCH_ITERS  10000
 
+// 핸들러 테이블은 RCU로 보호: 매 IRQ마다 읽히지만 등록/해제는 드물다
+// reader(irq_dispatch)는 인터럽트 off 상태라 그 자체로 read-side 구간이고 락을 잡지 않는다.
 static irq_handler_t g_irq_handlers[16] = {0};
+static irq_handler_t g_vector_handlers[256] = {0};
+
+// IRQ 핸들러 실행 중 여부 (스케줄러는 IRQ 컨텍스트에서 전환하지 않음)
+static volatile uint32_t g_irq_depth = 0;
+
+int in_irq(void) {
+    return g_irq_depth != 0;
+}
 
 void irq_register_handler(uint8_t irq, irq_handler_t handler) {
-    if (irq < 16) g_irq_handlers[irq] = handler;
+    if (irq < 16) rcu_assign_pointer(g_irq_handlers[irq], handler);
+}
+
+int irq_register_vector(uint8_t vector, irq_handler_t handler) {
+    if (vector < IRQ_VECTOR_BASE || vector == SYSCALL_VECTOR) {
+        kprintf("[IRQ] vector 0x%x is reserved\n", vector);
+        return 0;
+    }
+    rcu_assign_pointer(g_vector_handlers[vector], handler);
+    return 1;
 }
 
+void irq_unregister_handler(uint8_t irq) {
+    if (irq >= 16) return;
+    rcu_assign_pointer(g_irq_handlers[irq], (irq_handler_t)0);
+
+    // 반환 후에는 옛 핸들러가 어느 CPU에서도 실행 중이지 않음 (핸들러 데이터 해제 가능)
+    synchronize_rcu();
+}
+
+void irq_unregister_vector(uint8_t vector) {
+    if (vector < IRQ_VECTOR_BASE || vector == SYSCALL_VECTOR) return;
+    rcu_assign_pointer(g_vector_handlers[vector], (irq_handler_t)0);
+    synchronize_rcu();
+}
+
+// 주기 로그는 IRQ 안에서 콘솔/시리얼 출력을 하지 않도록 workqueue로 넘긴다
+static void tick_log_work(work_t* w) {
+    (void)w;
+    kprintf("[TICK] 100 ticks\n");
+}
+
+static work_t g_tick_log_work = { 0, 0, tick_log_work, 0, 0 };
+
 static void irq0_timer(regs_t* r) {
     (void)r;
+    // storm 중 추가 인터럽트는 진입/EOI 비용만 내고 끝난다
+    if (!pit_storm_tick()) return;
     pit_on_tick();
     time_on_tick();
+    sched_tick();
 
     // 너무 자주 로그를 출력하면 안되므로, 100틱 처리
     if ((pit_ticks() % 100)  == 0) {
-        kprintf("[TICK] 100 ticks\n");
+        // workqueue 준비 전(부팅 초기)에는 직접 출력
+        if (!queue_work(system_wq, &g_tick_log_work)) {
+            if (!(g_tick_log_work.flags & WORK_PENDING)) kprintf("[TICK] 100 ticks\n");
+        }
     }
 }
 
@@ -40,17 +98,77 @@ void irq_init(void) {
     kprintf("[INFO] PIC remapped, IRQ0/IRQ1 unmasked\n");
 }
 
-// isr_handler에서 호출될 IRQ 공통 핸들러
+// isr_stub.asm의 IRQ 공통부에서 직접 호출
 void irq_dispatch(regs_t* r) {
-    uint8_t irq = (uint8_t)(r->int_no - IRQ_BASE);
-
-    if (irq < 16) {
-       if (g_irq_handlers[irq]) {
-        g_irq_handlers[irq](r);
-       } else {
-        kprintf("[WARN] Unhandled IRQ\n");
-       }
+    uint32_t vector = r->int_no;
+
+    irqsoff_irq_enter(vector, r->eip, r->eflags);
+    cputime_irq_enter(r->cs & 3);
+    g_irq_depth++;
+
+    if (vector < IRQ_VECTOR_BASE) {
+        uint8_t irq = (uint8_t)(vector - IRQ_BASE);
+        irq_handler_t handler = rcu_dereference(g_irq_handlers[irq]);
+        if (handler) {
+            handler(r);
+        } else {
+            kprintf("[WARN] Unhandled IRQ\n");
+        }
+        pic_send_eoi(irq);
+    } else {
+        irq_handler_t handler = rcu_dereference(g_vector_handlers[vector]);
+        if (handler) {
+            handler(r);
+        } else {
+            kprintf("[WARN] Unhandled vector 0x%x\n", vector);
+        }
+    }
+
+    g_irq_depth--;
+    cputime_irq_exit(vector);
+
+    // EOI 이후 선점: 전환된 스레드가 돌아오면 이 스택으로 iret
+    sched_irq_exit();
+    irqsoff_irq_exit(r->eflags);
+}
+
+static void irq_bench_handler(regs_t* r) {
+    (void)r;
+}
+
+static void bench_vector(void) {
+    uint64_t best = ~0ull;
+    uint64_t t0 = rdtsc();
+    for (uint32_t i = 0; i < IRQ_BENCH_ITERS; i++) {
+        uint64_t s = rdtsc();
+        __asm__ __volatile__("int %0" : : "i"(IRQ_BENCH_VECTOR) : "memory");
+        uint64_t d = rdtsc() - s;
+        if (d < best) best = d;
     }
+    uint64_t avg = rdtsc() - t0;
+    div_u64_u32(&avg, IRQ_BENCH_ITERS);
+    kprintf("[IRQ] vector 0x%x round trip: avg=%llu best=%llu cyc (stub + irq_dispatch)\n",
+        IRQ_BENCH_VECTOR, avg, best);
+}
 
-    pic_send_eoi(irq);
-}
\ No newline at end of file
+static void bench_syscall(void) {
+    uint64_t best = ~0ull;
+    uint64_t t0 = rdtsc();
+    for (uint32_t i = 0; i < IRQ_BENCH_ITERS; i++) {
+        uint64_t s = rdtsc();
+        syscall3(SYS_GETTID, 0, 0, 0);
+        uint64_t d = rdtsc() - s;
+        if (d < best) best = d;
+    }
+    uint64_t avg = rdtsc() - t0;
+    div_u64_u32(&avg, IRQ_BENCH_ITERS);
+    kprintf("[IRQ] int 0x80 (gettid) round trip: avg=%llu best=%llu cyc\n", avg, best);
+}
+
+void irq_entry_bench(void) {
+    if (!cmdline_bench("irq")) return;
+    if (!irq_register_vector(IRQ_BENCH_VECTOR, irq_bench_handler)) return;
+    bench_vector();
+    bench_syscall();
+    irq_unregister_vector(IRQ_BENCH_VECTOR);
+}
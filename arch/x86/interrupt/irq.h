@@ -6,7 +6,25 @@ typedef struct regs regs_t;
 
 typedef void (*irq_handler_t)(regs_t* r);
 
+// PIC IRQ는 벡터 32~47, 그 위(48~255, 0x80 제외)는 MSI/IPI 등 직접 할당하는 벡터
+#define IRQ_BASE        32
+#define IRQ_VECTOR_BASE 48
+
 void irq_init(void);
 void irq_register_handler(uint8_t irq, irq_handler_t handler);
+
+// PIC를 거치지 않는 벡터에 핸들러 등록 (EOI는 핸들러/컨트롤러 몫). 성공 1
+int irq_register_vector(uint8_t vector, irq_handler_t handler);
+
+// 핸들러 제거 후 grace period까지 대기 (스레드 컨텍스트 전용)
+void irq_unregister_handler(uint8_t irq);
+void irq_unregister_vector(uint8_t vector);
+
+// isr_stub.asm의 IRQ 공통부가 직접 호출 (예외 분기 없이)
 void irq_dispatch(regs_t* r);
 
+// IRQ 핸들러 실행 중이면 1
+int in_irq(void);
+
+// 빈 핸들러 벡터로 인터럽트 진입/복귀 왕복 비용 측정 (TSC cycle)
+void irq_entry_bench(void);
@@ -3,6 +3,11 @@
 #include "../../../kernel/lib/itoa.h" 
 #include "../../../kernel/console/kprintf.h"
 #include "../../../kernel/panic/panic.h"
+#include "../../../kernel/memory/vma.h"
+#include "../../../kernel/sched/kstack.h"
+#include "../../../kernel/trace/irqsoff.h"
+#include "../cpu/cr.h"
+#include "../cpu/fpu.h"
 #include "irq.h"
 
 static const char* exception_messages[32] = {
@@ -69,19 +74,21 @@ static void dump_regs(regs_t* r) {
       r->useresp, r->ss);
 }
 
-
-static inline uint32_t read_cr2(void) {
-   uint32_t val;
-   __asm__ __volatile__("mov %%cr2, %0" : "=r"(val));
-   return val;
-}
-
 void isr_handler(regs_t* r) {
 
+   // 복구 가능한 예외(#PF demand paging, #NM)도 interrupt gate라 처리하는 동안 인터럽트가 꺼져 있다
+   irqsoff_irq_enter(r->int_no, r->eip, r->eflags);
+
    // Page Fault (#PF)
    if (r->int_no == 14) {
       uint32_t cr2 = read_cr2();
 
+      // demand paging: 등록된 VMA 범위면 페이지를 채우고 재시도
+      if (vm_handle_fault(cr2, r->err_code)) {
+         irqsoff_irq_exit(r->eflags);
+         return;
+      }
+
       // 화면에 심각한 오류 표시
       kprintf_clear_console();
       kprintf_puts_at(2, 2, "PAGE FAULT (#PF)");
@@ -92,12 +99,20 @@ void isr_handler(regs_t* r) {
       kprintf("[EXC] Page Fault (#PF)\n");
       kprintf("==============================\n");
       kprintf("  cr2=0x%x err=0x%x\n", cr2, r->err_code);
+      if (kstack_guard_hit(cr2)) {
+         kprintf("  kernel stack overflow (guard page below stack slot %u)\n", kstack_guard_hit(cr2) - 1);
+      }
 
       pf_print_reason(r->err_code);
       dump_regs(r);
 
       panic("Page fault trapped. System halted.");
 
+   } else if (r->int_no == 7 && fpu_handle_nm()) {
+      // Device Not Available: lazy FPU 전환 (CR0.TS)
+      irqsoff_irq_exit(r->eflags);
+      return;
+
    } else if (r->int_no < 32) {
       const char* name = exception_messages[r->int_no];
 
@@ -113,12 +128,8 @@ void isr_handler(regs_t* r) {
 
       panic("CPU exception trapped. System halted.");
 
-   } else if (r->int_no >= 32 && r->int_no < 48) {
-      // IRQ 처리
-      irq_dispatch(r);
-      return;
    } else {
-      // 알 수 없는 인터럽트 (경고 로그)
+      // IRQ/시스템 콜은 stub에서 바로 irq_dispatch/syscall_dispatch로 가므로 여기 올 일 없음
       kprintf("[WARN] Unknown interrupt received: 0x%x\n", r->int_no);
    }
 
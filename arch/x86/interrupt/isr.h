@@ -8,5 +8,6 @@ typedef struct regs {
     uint32_t eip, cs, eflags, useresp, ss; // Pushed by the processor automatically.
 } regs_t;
 
+// CPU 예외(0~31) 전용. IRQ는 irq_dispatch, int 0x80은 syscall_dispatch로 stub에서 직행
 void isr_handler(regs_t* r);
 
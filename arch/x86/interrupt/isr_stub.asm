@@ -1,84 +1,104 @@
 BITS 32
 
-global isr0
-global isr1
-global isr2
-global isr3
-global isr4
-global isr5
-global isr6
-global isr7
-global isr8
-global isr9
-global isr10
-global isr11
-global isr12
-global isr13
-global isr14
-global isr15
-global isr16
-global isr17
-global isr18
-global isr19
-global isr20
-global isr21
-global isr22
-global isr23
-global isr24
-global isr25
-global isr26
-global isr27
-global isr28
-global isr29
-global isr30
-global isr31
-; Add for IRQs (32-47) - hardware interrupts
-global isr32
-global isr33
-global isr34
-global isr35
-global isr36
-global isr37
-global isr38
-global isr39
-global isr40
-global isr41
-global isr42
-global isr43
-global isr44
-global isr45
-global isr46
-global isr47
+; 256개 벡터의 진입 stub을 매크로로 만들고, 주소 표(isr_stub_table)를 idt.c가 읽어 IDT를 채운다.
+; - 0~31  CPU 예외: 전체 저장 + 세그먼트 재설정 후 isr_handler (예외 전용)
+; - 0x80  시스템 콜: syscall_dispatch 직행
+; - 그 외 (PIC IRQ 32~47, 이후 MSI/IPI 자리): irq_dispatch 직행
+; interrupt gate가 이미 IF를 끄므로 stub에서 cli는 하지 않는다.
+
+global isr_stub_table
 
 extern isr_handler
+extern irq_dispatch
+extern syscall_dispatch
+
+KERNEL_DS    equ 0x10
+; %if에서 비교하므로 equ가 아닌 전처리 상수
+%define SYSCALL_VEC 0x80
+
+; regs_t 안의 저장된 cs 위치 (ds + pusha 8개 + int_no + err_code + eip 다음)
+REGS_CS      equ 48
 
-; For ISRs without an error code, push 0
-%macro ISR_NOERR 1
-isr%1:
-    cli
-    push dword 0 ; err_code
+; 벡터 하나의 stub: error code 자리를 맞추고 벡터 번호를 push한 뒤 경로별 공통부로
+; CPU가 error code를 push하는 예외: 8, 10~14, 17, 21
+%macro ISR_STUB 1
+isr_stub_%1:
+%if (%1 == 8) || ((%1 >= 10) && (%1 <= 14)) || (%1 == 17) || (%1 == 21)
     push dword %1 ; int_no
-    jmp isr_common_stub
+%else
+    push dword 0  ; err_code
+    push dword %1 ; int_no
+%endif
+%if %1 < 32
+    jmp exc_common_stub
+%elif %1 == SYSCALL_VEC
+    jmp syscall_common_stub
+%else
+    jmp irq_common_stub
+%endif
 %endmacro
 
-; For ISRs with an error code, CPU already pushes err_code
-%macro ISR_ERR 1
-isr%1:
-    cli
-    push dword %1 ; int_no
-    jmp isr_common_stub
+%macro ISR_STUB_ADDR 1
+    dd isr_stub_%1
+%endmacro
+
+; IRQ/시스템 콜 공통부: 커널에서 들어왔으면 ds/es/fs/gs가 이미 KERNEL_DS이므로
+; 세그먼트 재설정은 유저 모드에서 들어왔을 때만 한다. regs_t 배치는 예외 경로와 같다.
+%macro FAST_COMMON_STUB 2
+%1:
+    pusha
+
+    ; C 코드는 DF=0을 가정 (memmove의 역방향 복사 중 인터럽트 대비)
+    cld
+
+    mov ax, ds
+    push eax
+
+    test dword [esp + REGS_CS], 3
+    jz %%from_kernel
+    mov ax, KERNEL_DS
+    mov ds, ax
+    mov es, ax
+    mov fs, ax
+    mov gs, ax
+%%from_kernel:
+    push esp
+    call %2
+    add esp, 4
+
+    ; 선점으로 다른 스레드를 거쳐 돌아올 수 있으므로 복귀 직전에 다시 확인
+    test dword [esp + REGS_CS], 3
+    jz %%to_kernel
+    pop eax
+    mov ds, ax
+    mov es, ax
+    mov fs, ax
+    mov gs, ax
+    popa
+    add esp, 8     ; pop int_no + err_code
+    iretd
+%%to_kernel:
+    add esp, 4     ; 저장한 ds 버림
+    popa
+    add esp, 8
+    iretd
 %endmacro
 
-isr_common_stub:
+section .text
+
+; 예외 공통부: 드물게 실행되므로 항상 전체 저장
+exc_common_stub:
     ; save registers
     pusha
 
+    cld
+
     ; save data segment
     mov ax, ds
     push eax
 
     ; set kernel data segment (commonly 0x10). GRUB 환경에서 대체로 유효
-    mov ax, 0x10
+    mov ax, KERNEL_DS
     mov ds, ax
     mov es, ax
     mov fs, ax
@@ -100,46 +120,22 @@ isr_common_stub:
     add esp, 8     ; pop int_no + err_code (또는 int_no + err_code 형태로 정렬)
     iretd
 
-; Intel-defined exceptions with error code:
-; 8, 10, 11, 12, 13, 14, 17
-ISR_NOERR 0
-ISR_NOERR 1
-ISR_NOERR 2
-ISR_NOERR 3
-ISR_NOERR 4
-ISR_NOERR 5
-ISR_NOERR 6
-ISR_NOERR 7
-ISR_ERR   8
-ISR_NOERR 9
-ISR_ERR   10
-ISR_ERR   11
-ISR_ERR   12
-ISR_ERR   13
-ISR_ERR   14
-ISR_NOERR 15
-ISR_NOERR 16
-ISR_ERR   17
-ISR_NOERR 18
-ISR_NOERR 19
-ISR_NOERR 20
-ISR_NOERR 21
-ISR_NOERR 22
-ISR_NOERR 23
-ISR_NOERR 24
-ISR_NOERR 25
-ISR_NOERR 26
-ISR_NOERR 27
-ISR_NOERR 28
-ISR_NOERR 29
-ISR_NOERR 30
-ISR_NOERR 31
-
-%assign i 32
-%rep 16
-ISR_NOERR i
+FAST_COMMON_STUB irq_common_stub, irq_dispatch
+FAST_COMMON_STUB syscall_common_stub, syscall_dispatch
+
+%assign i 0
+%rep 256
+ISR_STUB i
 %assign i i+1
 %endrep
 
+section .rodata
+align 4
+isr_stub_table:
+%assign i 0
+%rep 256
+ISR_STUB_ADDR i
+%assign i i+1
+%endrep
 
-section .note.GNU-stack noalloc noexec nowrite progbits
\ No newline at end of file
+section .note.GNU-stack noalloc noexec nowrite progbits
@@ -1,24 +1,75 @@
-
+#include "pit.h"
 #include "../io/ports.h"
+#include "../cpu/irqflags.h"
 
 #define PIT_CH0    0x40
 #define PIT_CMD         0x43
-#define PIT_BASE_HZ    1193182
 
 static volatile uint64_t g_ticks = 0;
+static uint32_t g_hz = 0;
+static uint32_t g_divisor = 0;
+
+// storm: PIT를 hz * g_storm_mult로 돌리고, g_storm_mult번째 인터럽트만 tick으로 넘긴다
+static volatile uint32_t g_storm_mult = 1;
+static volatile uint32_t g_storm_phase = 0;
+static volatile uint32_t g_storm_extra = 0;
 
 uint64_t pit_ticks(void) { return g_ticks; }
 
 // IRQ0에서 호출할 tick 증가 함수(irq.c에서 사용)
 void pit_on_tick(void) { g_ticks++; }
 
+static void pit_program(uint32_t divisor) {
+    if (divisor > 0xFFFF) divisor = 0xFFFF;
+    if (divisor < 2) divisor = 2;
+    g_divisor = divisor;
+
+    // mode 2 (rate generator): 주기는 mode 3과 같고, 카운터가 divisor에서 1까지 선형으로
+    // 줄어들므로 latch로 읽어 마지막 인터럽트 edge 이후 경과 시간을 알 수 있다
+    outb(PIT_CMD, 0x34); // channel 0, lobyte/hibyte, mode 2, binary
+    outb(PIT_CH0, (uint8_t)(divisor & 0xFF));
+    outb(PIT_CH0, (uint8_t)((divisor >> 8)& 0xFF));
+}
+
 void pit_init(uint32_t hz) { 
 
     if (hz == 0) hz = 100;
+    g_hz = hz;
 
-    uint32_t divisor = PIT_BASE_HZ / hz;
+    pit_program(PIT_BASE_HZ / hz);
+}
 
-    outb(PIT_CMD, 0x36); // channel 0, lobyte/hibyte, mode 3, binary
-    outb(PIT_CH0, (uint8_t)(divisor & 0xFF));
-    outb(PIT_CH0, (uint8_t)((divisor >> 8)& 0xFF));
-}
\ No newline at end of file
+uint32_t pit_divisor(void) { return g_divisor; }
+
+uint32_t pit_read_count(void) {
+    outb(PIT_CMD, 0x00); // channel 0 counter latch
+    uint32_t lo = inb(PIT_CH0);
+    uint32_t hi = inb(PIT_CH0);
+    return (hi << 8) | lo;
+}
+
+void pit_set_storm(uint32_t mult) {
+    if (mult == 0) mult = 1;
+    if (mult > PIT_STORM_MAX) mult = PIT_STORM_MAX;
+    if (!g_hz || mult == g_storm_mult) return;
+
+    uint32_t f = irq_save();
+    g_storm_mult = mult;
+    g_storm_phase = 0;
+    pit_program(PIT_BASE_HZ / (g_hz * mult));
+    irq_restore(f);
+}
+
+uint32_t pit_storm_mult(void) { return g_storm_mult; }
+
+uint32_t pit_storm_extra(void) { return g_storm_extra; }
+
+int pit_storm_tick(void) {
+    if (g_storm_mult == 1) return 1;
+    if (++g_storm_phase < g_storm_mult) {
+        g_storm_extra++;
+        return 0;
+    }
+    g_storm_phase = 0;
+    return 1;
+}
@@ -1,7 +1,22 @@
 #pragma once
 #include <stdint.h>
 
+#define PIT_BASE_HZ    1193182
+#define PIT_STORM_MAX  50
+
 void pit_init(uint32_t hz);
 void pit_on_tick(void);
 uint64_t pit_ticks(void);
 
+// 현재 channel 0 reload 값과 latch로 읽은 카운터 (divisor → 1로 감소, 1 다음에 IRQ0)
+uint32_t pit_divisor(void);
+uint32_t pit_read_count(void);
+
+// 인터럽트 storm: PIT를 hz * mult로 올린다 (1이면 원래 주기). 추가 인터럽트는
+// pit_storm_tick()이 걸러내므로 tick 기반 코드(시간, 스케줄러)는 그대로 동작한다
+void pit_set_storm(uint32_t mult);
+uint32_t pit_storm_mult(void);
+uint32_t pit_storm_extra(void);           // 지금까지 걸러낸 추가 인터럽트 수
+
+// IRQ0 맨 앞에서 호출: 이번 인터럽트가 실제 tick이면 1
+int pit_storm_tick(void);
@@ -4,14 +4,33 @@ BITS 32
 SECTION .multiboot
 align 4
 MULTIBOOT_MAGIC    equ 0x1BADB002   ; Magic Number - Multiboot Specification
+; bit(1<<0): page-align modules (ELF 모듈을 복사 없이 페이지 단위로 매핑하기 위함)
 ; bit(1<<1): request mem info
-MULTIBOOT_FLAGS    equ (1<<1) ; 1<<1 = 2  : 메모리 정보 요청
+; bit(1<<2): video mode 요청 (아래 mode_type/width/height/depth, 결과는 info의 framebuffer_*)
+MULTIBOOT_FLAGS    equ (1<<0) | (1<<1) | (1<<2) ; 모듈 페이지 정렬 + 메모리 정보 + 그래픽 모드
 MULTIBOOT_CHECKSUM equ -(MULTIBOOT_MAGIC + MULTIBOOT_FLAGS)
 
+; 1280x800x32 = 8x16 글꼴로 160x50 콘솔 (GRUB이 못 맞추면 가까운 모드나 텍스트 모드)
+VIDEO_WIDTH        equ 1280
+VIDEO_HEIGHT       equ 800
+VIDEO_DEPTH        equ 32
+
 dd MULTIBOOT_MAGIC
 dd MULTIBOOT_FLAGS
 dd MULTIBOOT_CHECKSUM
 
+; bit16(a.out kludge)을 쓰지 않으므로 주소 필드는 0 (video 필드 위치를 맞추기 위해 존재)
+dd 0    ; header_addr
+dd 0    ; load_addr
+dd 0    ; load_end_addr
+dd 0    ; bss_end_addr
+dd 0    ; entry_addr
+
+dd 0    ; mode_type: 0 = linear graphics
+dd VIDEO_WIDTH
+dd VIDEO_HEIGHT
+dd VIDEO_DEPTH
+
 SECTION .text
 global start
 extern kernel_main  ; kernel_main() in kernel.c
@@ -0,0 +1,235 @@
+#include "ata.h"
+#include "../../kernel/memory/heap.h"
+#include "../../kernel/sync/mutex.h"
+#include "../../kernel/lib/errno.h"
+#include "../../kernel/console/kprintf.h"
+#include "../../arch/x86/io/ports.h"
+
+#define ATA_REG_DATA     0
+#define ATA_REG_ERROR    1
+#define ATA_REG_SECCOUNT 2
+#define ATA_REG_LBA0     3
+#define ATA_REG_LBA1     4
+#define ATA_REG_LBA2     5
+#define ATA_REG_DRIVE    6
+#define ATA_REG_STATUS   7
+#define ATA_REG_COMMAND  7
+
+#define ATA_SR_BSY  0x80
+#define ATA_SR_DF   0x20
+#define ATA_SR_DRQ  0x08
+#define ATA_SR_ERR  0x01
+
+#define ATA_CMD_READ_PIO    0x20
+#define ATA_CMD_WRITE_PIO   0x30
+#define ATA_CMD_CACHE_FLUSH 0xE7
+#define ATA_CMD_IDENTIFY    0xEC
+
+#define ATA_CTRL_NIEN 0x02
+#define ATA_POLL_LIMIT 10000000u
+
+typedef struct ata_channel {
+    uint16_t io;
+    uint16_t ctrl;
+    mutex_t lock;           // 채널의 두 드라이브가 레지스터를 공유
+} ata_channel_t;
+
+typedef struct ata_drive {
+    ata_channel_t* ch;
+    uint8_t slave;
+} ata_drive_t;
+
+static ata_channel_t g_channels[2] = {
+    { 0x1F0, 0x3F6, { 0 } },
+    { 0x170, 0x376, { 0 } },
+};
+
+static inline void insw(uint16_t port, void* buf, uint32_t words) {
+    __asm__ __volatile__("rep insw" : "+D"(buf), "+c"(words) : "d"(port) : "memory");
+}
+
+static inline void outsw(uint16_t port, const void* buf, uint32_t words) {
+    __asm__ __volatile__("rep outsw" : "+S"(buf), "+c"(words) : "d"(port) : "memory");
+}
+
+// 드라이브 선택 후 400ns (alternate status 4번 읽기)
+static void ata_delay(const ata_channel_t* ch) {
+    for (int i = 0; i < 4; i++) (void)inb(ch->ctrl);
+}
+
+static int wait_not_busy(const ata_channel_t* ch) {
+    for (uint32_t i = 0; i < ATA_POLL_LIMIT; i++) {
+        uint8_t st = inb(ch->io + ATA_REG_STATUS);
+        if (!(st & ATA_SR_BSY)) return (st & (ATA_SR_ERR | ATA_SR_DF)) ? -EIO : 0;
+    }
+    return -EIO;
+}
+
+static int wait_drq(const ata_channel_t* ch) {
+    for (uint32_t i = 0; i < ATA_POLL_LIMIT; i++) {
+        uint8_t st = inb(ch->io + ATA_REG_STATUS);
+        if (st & ATA_SR_BSY) continue;
+        if (st & (ATA_SR_ERR | ATA_SR_DF)) return -EIO;
+        if (st & ATA_SR_DRQ) return 0;
+    }
+    return -EIO;
+}
+
+static void issue(const ata_drive_t* d, uint32_t lba, uint32_t count, uint8_t cmd) {
+    const ata_channel_t* ch = d->ch;
+    outb(ch->io + ATA_REG_DRIVE, (uint8_t)(0xE0 | (d->slave << 4) | ((lba >> 24) & 0x0F)));
+    ata_delay(ch);
+    outb(ch->io + ATA_REG_SECCOUNT, (uint8_t)(count & 0xFF));     // 256 → 0
+    outb(ch->io + ATA_REG_LBA0, (uint8_t)lba);
+    outb(ch->io + ATA_REG_LBA1, (uint8_t)(lba >> 8));
+    outb(ch->io + ATA_REG_LBA2, (uint8_t)(lba >> 16));
+    outb(ch->io + ATA_REG_COMMAND, cmd);
+}
+
+static int ata_read(blockdev_t* dev, uint32_t lba, uint32_t count, void* buf) {
+    ata_drive_t* d = (ata_drive_t*)dev->priv;
+    uint8_t* p = (uint8_t*)buf;
+    int rc = 0;
+
+    mutex_lock(&d->ch->lock);
+    while (count && rc == 0) {
+        uint32_t n = count > ATA_MAX_SECTORS_PER_CMD ? ATA_MAX_SECTORS_PER_CMD : count;
+        rc = wait_not_busy(d->ch);
+        if (rc) break;
+        issue(d, lba, n, ATA_CMD_READ_PIO);
+        for (uint32_t i = 0; i < n; i++) {
+            rc = wait_drq(d->ch);
+            if (rc) break;
+            insw(d->ch->io + ATA_REG_DATA, p, SECTOR_SIZE / 2);
+            p += SECTOR_SIZE;
+        }
+        lba += n;
+        count -= n;
+    }
+    mutex_unlock(&d->ch->lock);
+
+    if (rc) kprintf("[ATA] %s: read error at lba %u\n", dev->name, lba);
+    return rc;
+}
+
+static int ata_write(blockdev_t* dev, uint32_t lba, uint32_t count, const void* buf) {
+    ata_drive_t* d = (ata_drive_t*)dev->priv;
+    const uint8_t* p = (const uint8_t*)buf;
+    int rc = 0;
+
+    mutex_lock(&d->ch->lock);
+    while (count && rc == 0) {
+        uint32_t n = count > ATA_MAX_SECTORS_PER_CMD ? ATA_MAX_SECTORS_PER_CMD : count;
+        rc = wait_not_busy(d->ch);
+        if (rc) break;
+        issue(d, lba, n, ATA_CMD_WRITE_PIO);
+        for (uint32_t i = 0; i < n; i++) {
+            rc = wait_drq(d->ch);
+            if (rc) break;
+            outsw(d->ch->io + ATA_REG_DATA, p, SECTOR_SIZE / 2);
+            p += SECTOR_SIZE;
+        }
+        if (rc == 0) rc = wait_not_busy(d->ch);
+        lba += n;
+        count -= n;
+    }
+    mutex_unlock(&d->ch->lock);
+
+    if (rc) kprintf("[ATA] %s: write error at lba %u\n", dev->name, lba);
+    return rc;
+}
+
+static int ata_flush(blockdev_t* dev) {
+    ata_drive_t* d = (ata_drive_t*)dev->priv;
+
+    mutex_lock(&d->ch->lock);
+    int rc = wait_not_busy(d->ch);
+    if (rc == 0) {
+        outb(d->ch->io + ATA_REG_DRIVE, (uint8_t)(0xE0 | (d->slave << 4)));
+        ata_delay(d->ch);
+        outb(d->ch->io + ATA_REG_COMMAND, ATA_CMD_CACHE_FLUSH);
+        rc = wait_not_busy(d->ch);
+    }
+    mutex_unlock(&d->ch->lock);
+    return rc;
+}
+
+static const blockdev_ops_t g_ata_ops = {
+    .read = ata_read,
+    .write = ata_write,
+    .flush = ata_flush,
+};
+
+// IDENTIFY DEVICE. ATA 디스크면 LBA28 섹터 수, 없거나 ATAPI면 0
+static uint32_t identify(ata_channel_t* ch, uint8_t slave, char model[41]) {
+    outb(ch->io + ATA_REG_DRIVE, (uint8_t)(0xA0 | (slave << 4)));
+    ata_delay(ch);
+    outb(ch->io + ATA_REG_SECCOUNT, 0);
+    outb(ch->io + ATA_REG_LBA0, 0);
+    outb(ch->io + ATA_REG_LBA1, 0);
+    outb(ch->io + ATA_REG_LBA2, 0);
+    outb(ch->io + ATA_REG_COMMAND, ATA_CMD_IDENTIFY);
+
+    uint8_t st = inb(ch->io + ATA_REG_STATUS);
+    if (st == 0 || st == 0xFF) return 0;                  // 드라이브 없음 / 빈 버스
+
+    for (uint32_t i = 0; i < ATA_POLL_LIMIT && (inb(ch->io + ATA_REG_STATUS) & ATA_SR_BSY); i++) {}
+    // ATAPI/SATA는 시그니처를 LBA1/LBA2에 남기고 IDENTIFY를 거부한다
+    if (inb(ch->io + ATA_REG_LBA1) || inb(ch->io + ATA_REG_LBA2)) return 0;
+    if (wait_drq(ch)) return 0;
+
+    uint16_t id[256];
+    insw(ch->io + ATA_REG_DATA, id, 256);
+
+    // 모델 문자열: word 27..46, 각 word 안에서 바이트가 뒤집혀 있음
+    for (int i = 0; i < 20; i++) {
+        model[i * 2] = (char)(id[27 + i] >> 8);
+        model[i * 2 + 1] = (char)(id[27 + i] & 0xFF);
+    }
+    int n = 40;
+    while (n > 0 && model[n - 1] == ' ') n--;
+    model[n] = 0;
+
+    return (uint32_t)id[60] | ((uint32_t)id[61] << 16);
+}
+
+int ata_init(void) {
+    int found = 0;
+
+    for (uint32_t c = 0; c < 2; c++) {
+        ata_channel_t* ch = &g_channels[c];
+        mutex_init(&ch->lock, c ? "ata1" : "ata0");
+        outb(ch->ctrl, ATA_CTRL_NIEN);
+        if (inb(ch->io + ATA_REG_STATUS) == 0xFF) continue;      // 채널 없음
+
+        for (uint8_t slave = 0; slave < 2; slave++) {
+            char model[41];
+            uint32_t sectors = identify(ch, slave, model);
+            if (!sectors) continue;
+
+            ata_drive_t* d = (ata_drive_t*)kmalloc(sizeof(ata_drive_t));
+            d->ch = ch;
+            d->slave = slave;
+
+            blockdev_t* dev = (blockdev_t*)kmalloc(sizeof(blockdev_t));
+            dev->name[0] = 'a';
+            dev->name[1] = 't';
+            dev->name[2] = 'a';
+            dev->name[3] = (char)('0' + c * 2 + slave);
+            dev->name[4] = 0;
+            dev->nr_sectors = sectors;
+            dev->ops = &g_ata_ops;
+            dev->priv = d;
+
+            if (blockdev_register(dev) != 0) {
+                kfree(d);
+                kfree(dev);
+                continue;
+            }
+            kprintf("[ATA] %s: \"%s\" %u MB (PIO, LBA28)\n", dev->name, model, sectors / 2048);
+            found++;
+        }
+    }
+    if (!found) kprintf("[ATA] no disks\n");
+    return found;
+}
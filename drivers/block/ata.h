@@ -0,0 +1,13 @@
+#pragma once
+#include <stdint.h>
+#include "../../kernel/block/blockdev.h"
+
+// ATA(IDE) 디스크 PIO 드라이버
+// - 레거시 포트의 두 채널(0x1F0, 0x170) master/slave를 IDENTIFY로 찾아 ata0..ata3로 등록
+// - LBA28, 명령 하나에 최대 256섹터 (READ/WRITE SECTORS), 상태 폴링 (IRQ14/15는 nIEN으로 끔)
+// - flush: CACHE FLUSH (0xE7). ATAPI(CD-ROM)는 건너뜀
+
+#define ATA_MAX_SECTORS_PER_CMD 256
+
+// 찾은 디스크 수
+int ata_init(void);
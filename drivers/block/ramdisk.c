@@ -0,0 +1,43 @@
+#include "ramdisk.h"
+#include "../../kernel/memory/heap.h"
+#include "../../kernel/lib/string.h"
+#include "../../kernel/console/kprintf.h"
+
+static int ramdisk_read(blockdev_t* dev, uint32_t lba, uint32_t count, void* buf) {
+    memcpy(buf, (uint8_t*)dev->priv + lba * SECTOR_SIZE, count * SECTOR_SIZE);
+    return 0;
+}
+
+static int ramdisk_write(blockdev_t* dev, uint32_t lba, uint32_t count, const void* buf) {
+    memcpy((uint8_t*)dev->priv + lba * SECTOR_SIZE, buf, count * SECTOR_SIZE);
+    return 0;
+}
+
+static const blockdev_ops_t g_ramdisk_ops = {
+    .read = ramdisk_read,
+    .write = ramdisk_write,
+};
+
+blockdev_t* ramdisk_create(const char* name, uint32_t nr_sectors) {
+    uint8_t* mem = (uint8_t*)kmalloc_aligned(nr_sectors * SECTOR_SIZE, 4096);
+    if (!mem) {
+        kprintf("[RAMDISK] %s: out of memory\n", name);
+        return 0;
+    }
+    memset(mem, 0, nr_sectors * SECTOR_SIZE);
+
+    blockdev_t* dev = (blockdev_t*)kmalloc(sizeof(blockdev_t));
+    uint32_t i = 0;
+    for (; name[i] && i < BLOCKDEV_NAME_LEN - 1; i++) dev->name[i] = name[i];
+    dev->name[i] = 0;
+    dev->nr_sectors = nr_sectors;
+    dev->ops = &g_ramdisk_ops;
+    dev->priv = mem;
+
+    if (blockdev_register(dev) != 0) {
+        kfree(mem);
+        kfree(dev);
+        return 0;
+    }
+    return dev;
+}
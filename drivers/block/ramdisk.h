@@ -0,0 +1,6 @@
+#pragma once
+#include <stdint.h>
+#include "../../kernel/block/blockdev.h"
+
+// 메모리 기반 블록 장치 (커널 heap). 실패 시 0
+blockdev_t* ramdisk_create(const char* name, uint32_t nr_sectors);
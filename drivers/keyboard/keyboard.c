@@ -1,8 +1,23 @@
 #include "keyboard.h"
 #include "../../kernel/console/kprintf.h"
+#include "../../kernel/sched/thread.h"
+#include "../../kernel/sched/wait.h"
+#include "../../kernel/tty/tty.h"
+#include "../../kernel/panic/panic.h"
+#include "../../arch/x86/cpu/irqflags.h"
 #include "../../arch/x86/interrupt/irq.h"
 #include "../../arch/x86/io/ports.h"
 
+#define KBD_DATA_PORT 0x60
+
+// raw scancode 버퍼 (IRQ1 → kbd 스레드). 힙 초기화 전에 등록되므로 lib/ring 대신 정적 바이트 버퍼.
+#define SC_RING_SIZE 256
+#define SC_RING_MASK (SC_RING_SIZE - 1)
+
+// 디코딩된 이벤트 (kbd 스레드 → kbd_read)
+#define EV_RING_SIZE 128
+#define EV_RING_MASK (EV_RING_SIZE - 1)
+
 static const char scancode_to_ascii[128] = {
     0, 27, '1', '2', '3', '4', '5', '6', '7', '8',    // 0-9
     '9', '0', '-', '=', '\b',    // Backspace
@@ -20,31 +35,246 @@ static const char scancode_to_ascii[128] = {
     0,        // Alt
     ' ',    // Space bar
     0,        // Caps lock
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0,    // F1-F10
+    0,        // Num lock
+    0,        // Scroll lock
+    '7', '8', '9', '-', '4', '5', '6', '+', '1', '2', '3', '0', '.',    // keypad
     // Remaining keys are not mapped
 };
 
+static const char scancode_to_ascii_shift[128] = {
+    0, 27, '!', '@', '#', '$', '%', '^', '&', '*',
+    '(', ')', '_', '+', '\b',
+    '\t',
+    'Q', 'W', 'E', 'R',
+    'T', 'Y', 'U', 'I', 'O', 'P', '{', '}', '\n',
+    0,
+    'A', 'S', 'D', 'F', 'G', 'H', 'J', 'K', 'L', ':',
+    '"', '~',
+    0,
+    '|', 'Z', 'X', 'C', 'V', 'B', 'N',
+    'M', '<', '>', '?',
+    0,
+    '*',
+    0,
+    ' ',
+    0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0,
+    0,
+    '7', '8', '9', '-', '4', '5', '6', '+', '1', '2', '3', '0', '.',
+};
+
+// ---- IRQ1 → 디코더 ----
+static volatile uint8_t g_sc_ring[SC_RING_SIZE];
+static volatile uint32_t g_sc_head = 0;     // IRQ만 씀
+static volatile uint32_t g_sc_tail = 0;     // kbd 스레드만 씀
+static wait_queue_t g_sc_waiters = WAIT_QUEUE_INIT;
+
+// ---- 디코더 → 읽는 쪽 ----
+static kbd_event_t g_ev_ring[EV_RING_SIZE];
+static uint32_t g_ev_head = 0;
+static uint32_t g_ev_tail = 0;
+static wait_queue_t g_ev_waiters = WAIT_QUEUE_INIT;
+
+// 디코더 상태 (kbd 스레드 전용)
+static uint8_t g_mods = 0;
+static int g_ext_prefix = 0;
+static uint32_t g_pause_skip = 0;
+static uint32_t g_key_down[256 / 32];
+
+static struct {
+    uint32_t irqs;
+    uint32_t sc_dropped;
+    uint32_t events;
+    uint32_t repeats;
+    uint32_t ev_dropped;
+} g_kbd_stats;
+
 static void keyboard_irq(regs_t* r) {
     (void)r;
 
-    uint8_t sc = inb(0x60);
+    // IRQ 안에서는 읽어서 넣고 깨우기만 한다
+    uint8_t sc = inb(KBD_DATA_PORT);
+    uint32_t head = g_sc_head;
+    g_kbd_stats.irqs++;
 
-    // break code (키 떼기)는 상위비트 1(0x80) set
-    if (sc & 0x80) {
-        // 키 떼기 이벤트 무시
+    if (head - g_sc_tail == SC_RING_SIZE) {
+        g_kbd_stats.sc_dropped++;
         return;
-    }   
+    }
+    g_sc_ring[head & SC_RING_MASK] = sc;
+    __atomic_store_n(&g_sc_head, head + 1, __ATOMIC_RELEASE);
+
+    if (!wait_queue_empty(&g_sc_waiters)) wake_up_one(&g_sc_waiters);
+}
+
+static int key_is_down(uint8_t key) {
+    return (g_key_down[key >> 5] >> (key & 31)) & 1;
+}
 
-    char c = 0;
-    if (sc < 128) c = scancode_to_ascii[sc];
+static void key_set_down(uint8_t key, int down) {
+    if (down) g_key_down[key >> 5] |= 1u << (key & 31);
+    else g_key_down[key >> 5] &= ~(1u << (key & 31));
+}
 
-    if (c) {
-        kprintf("[KBD] sc=0x%x '%c'\n", sc, c);
-    } else {
-        kprintf("[KBD] sc=0x%x (no ASCII)\n", sc);
+static uint8_t mod_bit(uint8_t key) {
+    switch (key) {
+        case KEY_LSHIFT:
+        case KEY_RSHIFT: return KBD_MOD_SHIFT;
+        case KEY_LCTRL:
+        case KEY_RCTRL:  return KBD_MOD_CTRL;
+        case KEY_LALT:
+        case KEY_RALT:   return KBD_MOD_ALT;
+    }
+    return 0;
+}
+
+// 양쪽 Shift/Ctrl/Alt 중 하나라도 눌려 있으면 modifier 유지
+static uint8_t mods_from_keys(void) {
+    uint8_t m = g_mods & KBD_MOD_CAPS;
+    if (key_is_down(KEY_LSHIFT) || key_is_down(KEY_RSHIFT)) m |= KBD_MOD_SHIFT;
+    if (key_is_down(KEY_LCTRL) || key_is_down(KEY_RCTRL)) m |= KBD_MOD_CTRL;
+    if (key_is_down(KEY_LALT) || key_is_down(KEY_RALT)) m |= KBD_MOD_ALT;
+    return m;
+}
+
+static char key_to_ascii(uint8_t key, uint8_t mods) {
+    if (key == KEY_KP_ENTER) return '\n';
+    if (key == (KEY_EXT | 0x35)) return '/';    // keypad /
+    if (key & KEY_EXT) return 0;
+
+    char c = (mods & KBD_MOD_SHIFT) ? scancode_to_ascii_shift[key] : scancode_to_ascii[key];
+    if (!c) return 0;
+
+    // Caps Lock은 글자에만 적용 (Shift와 함께면 다시 소문자)
+    if ((mods & KBD_MOD_CAPS) && ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))) {
+        c ^= 0x20;
+    }
+    if ((mods & KBD_MOD_CTRL) && ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))) {
+        c &= 0x1F;
+    }
+    return c;
+}
+
+static void ev_push(const kbd_event_t* ev) {
+    uint32_t f = irq_save();
+    if (g_ev_head - g_ev_tail == EV_RING_SIZE) {
+        // 아무도 읽지 않으면 가장 오래된 이벤트를 버린다
+        g_ev_tail++;
+        g_kbd_stats.ev_dropped++;
+    }
+    g_ev_ring[g_ev_head & EV_RING_MASK] = *ev;
+    g_ev_head++;
+    irq_restore(f);
+
+    if (!wait_queue_empty(&g_ev_waiters)) wake_up_one(&g_ev_waiters);
+}
+
+// scancode 하나를 디코딩. 완성된 이벤트가 있으면 1
+static int kbd_decode(uint8_t sc, kbd_event_t* ev) {
+    // Pause: E1 1D 45 E1 9D C5 (make/break 구분 없음) → 무시
+    if (g_pause_skip) {
+        g_pause_skip--;
+        return 0;
+    }
+    if (sc == 0xE1) {
+        g_pause_skip = 5;
+        return 0;
+    }
+    if (sc == 0xE0) {
+        g_ext_prefix = 1;
+        return 0;
+    }
+
+    int release = (sc & 0x80) != 0;
+    uint8_t key = sc & 0x7F;
+    if (g_ext_prefix) {
+        g_ext_prefix = 0;
+        // Print Screen 등이 보내는 가짜 Shift (E0 2A / E0 AA)
+        if (key == KEY_LSHIFT || key == KEY_RSHIFT) return 0;
+        key |= KEY_EXT;
+    }
+
+    int repeat = !release && key_is_down(key);
+    key_set_down(key, !release);
+
+    if (key == KEY_CAPSLOCK && !release && !repeat) g_mods ^= KBD_MOD_CAPS;
+    if (mod_bit(key)) g_mods = mods_from_keys();
+
+    ev->keycode = key;
+    ev->mods = g_mods;
+    ev->flags = (release ? KBD_EV_RELEASE : 0) | (repeat ? KBD_EV_REPEAT : 0);
+    ev->ascii = release ? 0 : key_to_ascii(key, g_mods);
+    return 1;
+}
+
+static void kbd_thread(void* arg) {
+    (void)arg;
+
+    for (;;) {
+        uint32_t f = irq_save();
+        while (g_sc_tail == __atomic_load_n(&g_sc_head, __ATOMIC_ACQUIRE)) {
+            wait_queue_sleep(&g_sc_waiters);
+        }
+        irq_restore(f);
+
+        // 쌓인 scancode를 한 번에 처리
+        uint32_t head = __atomic_load_n(&g_sc_head, __ATOMIC_ACQUIRE);
+        while (g_sc_tail != head) {
+            uint8_t sc = g_sc_ring[g_sc_tail & SC_RING_MASK];
+            __atomic_store_n(&g_sc_tail, g_sc_tail + 1, __ATOMIC_RELEASE);
+
+            kbd_event_t ev;
+            if (!kbd_decode(sc, &ev)) continue;
+
+            g_kbd_stats.events++;
+            if (ev.flags & KBD_EV_REPEAT) g_kbd_stats.repeats++;
+
+            ev_push(&ev);
+            if (!(ev.flags & KBD_EV_RELEASE) && ev.ascii) tty_input(ev.ascii);
+        }
     }
 }
 
 void keyboard_init(void) {
     irq_register_handler(1, keyboard_irq);
     kprintf("[INFO] Keyboard IRQ handler registered\n");
-}
\ No newline at end of file
+}
+
+void kbd_start(void) {
+    // 입력 지연이 작업량에 묻히지 않도록 일반 스레드보다 높게
+    thread_create("kbd", kbd_thread, 0, PRIO_MAX - 2);
+}
+
+int kbd_try_read(kbd_event_t* ev) {
+    int ok = 0;
+    uint32_t f = irq_save();
+    if (g_ev_tail != g_ev_head) {
+        *ev = g_ev_ring[g_ev_tail & EV_RING_MASK];
+        g_ev_tail++;
+        ok = 1;
+    }
+    irq_restore(f);
+    return ok;
+}
+
+void kbd_read(kbd_event_t* ev) {
+    if (in_irq()) {
+        panic("kbd_read: blocking call in IRQ context");
+    }
+
+    uint32_t f = irq_save();
+    while (g_ev_tail == g_ev_head) {
+        wait_queue_sleep(&g_ev_waiters);
+    }
+    *ev = g_ev_ring[g_ev_tail & EV_RING_MASK];
+    g_ev_tail++;
+    irq_restore(f);
+}
+
+void kbd_dump_stats(void) {
+    kprintf("[KBD] irqs=%u sc_dropped=%u events=%u repeats=%u ev_dropped=%u mods=0x%x\n",
+        g_kbd_stats.irqs, g_kbd_stats.sc_dropped, g_kbd_stats.events,
+        g_kbd_stats.repeats, g_kbd_stats.ev_dropped, (uint32_t)g_mods);
+}
@@ -1,3 +1,63 @@
 #pragma once
+#include <stdint.h>
 
-void keyboard_init(void);
\ No newline at end of file
+// PS/2 키보드 (scancode set 1)
+// IRQ1은 raw scancode를 lock-free SPSC 버퍼에 넣고 디코더 스레드를 깨우기만 한다.
+// 디코딩(modifier 상태, 0xE0 확장 코드, 자동 반복 구분)은 "kbd" 스레드가 하고,
+// 결과 이벤트는 kbd_read()와 TTY line discipline(tty_input)으로 전달된다.
+
+// 확장 키(0xE0 prefix)는 keycode = 0x80 | scancode
+#define KEY_EXT        0x80
+#define KEY_ESC        0x01
+#define KEY_BACKSPACE  0x0E
+#define KEY_ENTER      0x1C
+#define KEY_LCTRL      0x1D
+#define KEY_LSHIFT     0x2A
+#define KEY_RSHIFT     0x36
+#define KEY_LALT       0x38
+#define KEY_CAPSLOCK   0x3A
+#define KEY_F1         0x3B     // F1..F10 = 0x3B..0x44
+#define KEY_RCTRL      (KEY_EXT | 0x1D)
+#define KEY_RALT       (KEY_EXT | 0x38)
+#define KEY_KP_ENTER   (KEY_EXT | 0x1C)
+#define KEY_HOME       (KEY_EXT | 0x47)
+#define KEY_UP         (KEY_EXT | 0x48)
+#define KEY_PGUP       (KEY_EXT | 0x49)
+#define KEY_LEFT       (KEY_EXT | 0x4B)
+#define KEY_RIGHT      (KEY_EXT | 0x4D)
+#define KEY_END        (KEY_EXT | 0x4F)
+#define KEY_DOWN       (KEY_EXT | 0x50)
+#define KEY_PGDN       (KEY_EXT | 0x51)
+#define KEY_INSERT     (KEY_EXT | 0x52)
+#define KEY_DELETE     (KEY_EXT | 0x53)
+
+// kbd_event_t.flags
+#define KBD_EV_RELEASE 0x1
+#define KBD_EV_REPEAT  0x2      // 눌린 채로 다시 온 make code (typematic)
+
+// kbd_event_t.mods
+#define KBD_MOD_SHIFT  0x1
+#define KBD_MOD_CTRL   0x2
+#define KBD_MOD_ALT    0x4
+#define KBD_MOD_CAPS   0x8
+
+typedef struct kbd_event {
+    uint8_t keycode;
+    char ascii;                 // 출력 가능한 문자/제어 문자가 아니면 0
+    uint8_t flags;
+    uint8_t mods;               // 이벤트 시점 modifier 상태
+} kbd_event_t;
+
+// IRQ1 핸들러 등록 (힙/스케줄러 전에도 호출 가능: scancode는 버퍼에 쌓인다)
+void keyboard_init(void);
+
+// 디코더 스레드 시작 (sched_init 이후)
+void kbd_start(void);
+
+// 다음 입력 이벤트까지 대기 (스레드 컨텍스트 전용)
+void kbd_read(kbd_event_t* ev);
+
+// 잠들지 않음: 이벤트가 있으면 1
+int kbd_try_read(kbd_event_t* ev);
+
+void kbd_dump_stats(void);
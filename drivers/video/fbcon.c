@@ -0,0 +1,342 @@
+#include "fbcon.h"
+#include "font8x8.h"
+#include "../../kernel/memory/multiboot.h"
+#include "../../kernel/memory/paging.h"
+#include "../../kernel/memory/pmm.h"
+#include "../../kernel/console/kprintf.h"
+#include "../../kernel/lib/string.h"
+#include "../../kernel/lib/cmdline.h"
+#include "../../kernel/lib/div64.h"
+#include "../../arch/x86/cpu/pat.h"
+#include "../../arch/x86/cpu/fpu.h"
+#include "../../arch/x86/cpu/tsc.h"
+#include "../../arch/x86/cpu/irqflags.h"
+
+#define FB_NONE    0    // VGA 텍스트 콘솔 사용
+#define FB_PENDING 1    // 그래픽 모드 확인됨, 아직 매핑 전 (셀 배열에만 기록)
+#define FB_ON      2
+
+// 아직 그린 적 없는 셀 (어떤 실제 셀 값과도 다르게)
+#define CELL_UNDRAWN 0xFFFF
+
+static int g_state = FB_NONE;
+
+static uint32_t g_phys;
+static uint32_t g_pitch;
+static uint32_t g_width;
+static uint32_t g_height;
+static uint8_t* g_fb;
+
+static int g_cols;
+static int g_rows;
+static int g_cx;
+static int g_cy;
+static uint8_t g_attr = 0x07;
+
+// 원본 셀 배열과 framebuffer에 마지막으로 그린 셀 (둘 다 g_cols 간격)
+static uint16_t g_cells[FBCON_MAX_ROWS * FBCON_MAX_COLS];
+static uint16_t g_drawn[FBCON_MAX_ROWS * FBCON_MAX_COLS];
+
+// 글꼴 한 행을 펼쳐 두는 스캔라인 버퍼
+static uint32_t g_line[FBCON_MAX_COLS * FBCON_CELL_W] __attribute__((aligned(16)));
+
+// VGA 16색 → framebuffer 픽셀 값
+static uint32_t g_palette[16];
+
+// 글꼴 4비트 → 픽셀 4개의 선택 마스크
+static uint32_t g_nibble[16][4];
+
+static int g_no_sse = 0;        // bench에서 rep movsd 경로 측정용
+
+static uint32_t g_flushes = 0;
+static uint32_t g_spans = 0;
+static uint64_t g_bytes = 0;
+static uint64_t g_cycles = 0;
+
+static const uint32_t g_vga_rgb[16] = {
+    0x000000, 0x0000AA, 0x00AA00, 0x00AAAA, 0xAA0000, 0xAA00AA, 0xAA5500, 0xAAAAAA,
+    0x555555, 0x5555FF, 0x55FF55, 0x55FFFF, 0xFF5555, 0xFF55FF, 0xFFFF55, 0xFFFFFF,
+};
+
+static uint32_t pack_channel(uint32_t v8, uint8_t pos, uint8_t size) {
+    if (size == 0) return 0;
+    if (size < 8) v8 >>= 8 - size;
+    return v8 << pos;
+}
+
+int fbcon_probe(uint32_t mb_addr) {
+    const multiboot_info_t* mb = multiboot_framebuffer(mb_addr);
+    if (!mb) return 0;
+    if (mb->framebuffer_type != MULTIBOOT_FRAMEBUFFER_TYPE_RGB || mb->framebuffer_bpp != 32) return 0;
+    if (mb->framebuffer_addr >> 32) return 0;
+
+    g_phys = (uint32_t)mb->framebuffer_addr;
+    g_pitch = mb->framebuffer_pitch;
+    g_width = mb->framebuffer_width;
+    g_height = mb->framebuffer_height;
+
+    g_cols = (int)(g_width / FBCON_CELL_W);
+    g_rows = (int)(g_height / FBCON_CELL_H);
+    if (g_cols > FBCON_MAX_COLS) g_cols = FBCON_MAX_COLS;
+    if (g_rows > FBCON_MAX_ROWS) g_rows = FBCON_MAX_ROWS;
+    if (g_cols == 0 || g_rows == 0) return 0;
+
+    for (int i = 0; i < 16; i++) {
+        uint32_t rgb = g_vga_rgb[i];
+        g_palette[i] = pack_channel((rgb >> 16) & 0xFF, mb->red_field_position, mb->red_mask_size)
+                     | pack_channel((rgb >> 8) & 0xFF, mb->green_field_position, mb->green_mask_size)
+                     | pack_channel(rgb & 0xFF, mb->blue_field_position, mb->blue_mask_size);
+    }
+    for (int k = 0; k < 16; k++) {
+        for (int i = 0; i < 4; i++) g_nibble[k][i] = (k >> i) & 1 ? 0xFFFFFFFFu : 0;
+    }
+
+    memsetw(g_cells, ((uint16_t)g_attr << 8) | ' ', (size_t)(g_cols * g_rows));
+    memsetw(g_drawn, CELL_UNDRAWN, (size_t)(g_cols * g_rows));
+    g_cx = 0;
+    g_cy = 0;
+    g_state = FB_PENDING;
+    return 1;
+}
+
+int fbcon_active(void) {
+    return g_state != FB_NONE;
+}
+
+int fbcon_cols(void) { return g_cols; }
+int fbcon_rows(void) { return g_rows; }
+
+// -------------------------
+// 그리기
+// -------------------------
+
+// 커서 위치는 전경/배경을 뒤집어 블록 커서로 보이게
+static inline uint16_t cell_at(int r, int c) {
+    uint16_t v = g_cells[r * g_cols + c];
+    if (r == g_cy && c == g_cx) {
+        uint8_t a = (uint8_t)(v >> 8);
+        a = (uint8_t)((a << 4) | (a >> 4));
+        v = (uint16_t)((a << 8) | (v & 0xFF));
+    }
+    return v;
+}
+
+static inline void blit(uint8_t* dst, const void* src, uint32_t n, int sse) {
+    if (sse) memcpy_sse2(dst, src, n);
+    else memcpy_rep(dst, src, n);
+}
+
+// r행의 [c0, c1] 열: 글꼴 행마다 스캔라인 버퍼에 펼친 뒤 같은 줄을 두 번 복사 (세로 2배)
+static void draw_span(int r, int c0, int c1, int sse) {
+    uint32_t bytes = (uint32_t)(c1 - c0 + 1) * FBCON_CELL_W * 4;
+    uint8_t* dst = g_fb + (uint32_t)r * FBCON_CELL_H * g_pitch + (uint32_t)c0 * FBCON_CELL_W * 4;
+
+    for (int gy = 0; gy < 8; gy++) {
+        uint32_t* p = g_line;
+        for (int c = c0; c <= c1; c++) {
+            uint16_t v = cell_at(r, c);
+            uint8_t bits = font8x8_glyph((uint8_t)v)[gy];
+            uint32_t fg = g_palette[(v >> 8) & 0xF];
+            uint32_t bg = g_palette[(v >> 12) & 0xF];
+            uint32_t x = fg ^ bg;
+
+            const uint32_t* lo = g_nibble[bits & 0xF];
+            const uint32_t* hi = g_nibble[bits >> 4];
+            p[0] = bg ^ (x & lo[0]);
+            p[1] = bg ^ (x & lo[1]);
+            p[2] = bg ^ (x & lo[2]);
+            p[3] = bg ^ (x & lo[3]);
+            p[4] = bg ^ (x & hi[0]);
+            p[5] = bg ^ (x & hi[1]);
+            p[6] = bg ^ (x & hi[2]);
+            p[7] = bg ^ (x & hi[3]);
+            p += 8;
+        }
+
+        blit(dst, g_line, bytes, sse);
+        dst += g_pitch;
+        blit(dst, g_line, bytes, sse);
+        dst += g_pitch;
+    }
+
+    g_bytes += (uint64_t)bytes * FBCON_CELL_H;
+    g_spans++;
+}
+
+// 셀 배열과 g_drawn을 비교해 바뀐 열 구간만 다시 그림
+static void flush(void) {
+    if (g_state != FB_ON) return;
+
+    uint64_t t0 = rdtsc();
+    int sse = !g_no_sse && string_sse2_enabled() && kernel_fpu_begin();
+
+    for (int r = 0; r < g_rows; r++) {
+        uint16_t* drawn = &g_drawn[r * g_cols];
+        int c0 = 0;
+        while (c0 < g_cols && cell_at(r, c0) == drawn[c0]) c0++;
+        if (c0 == g_cols) continue;
+
+        int c1 = g_cols - 1;
+        while (cell_at(r, c1) == drawn[c1]) c1--;
+
+        draw_span(r, c0, c1, sse);
+        for (int c = c0; c <= c1; c++) drawn[c] = cell_at(r, c);
+    }
+
+    if (sse) {
+        // WC 버퍼를 비워 다음 출력 전에 화면에 반영
+        __asm__ __volatile__("sfence" : : : "memory");
+        kernel_fpu_end();
+    }
+
+    g_flushes++;
+    g_cycles += rdtsc() - t0;
+}
+
+// -------------------------
+// 문자 출력 (kprintf의 VGA 백엔드와 같은 제어 문자 처리)
+// -------------------------
+static void scroll_if_needed(void) {
+    if (g_cy < g_rows) return;
+
+    // framebuffer는 건드리지 않고 셀만 올림 (다음 flush에서 바뀐 행을 다시 그림)
+    memmove(g_cells, g_cells + g_cols, (size_t)(g_rows - 1) * g_cols * sizeof(uint16_t));
+    memsetw(g_cells + (g_rows - 1) * g_cols, ((uint16_t)g_attr << 8) | ' ', (size_t)g_cols);
+    g_cy = g_rows - 1;
+}
+
+static void putc_cell(char c) {
+    if (c == '\n') {
+        g_cx = 0;
+        g_cy++;
+        scroll_if_needed();
+        return;
+    }
+    if (c == '\r') {
+        g_cx = 0;
+        return;
+    }
+    if (c == '\b') {
+        if (g_cx > 0) g_cx--;
+        return;
+    }
+    if (c == '\t') {
+        int next = (g_cx + 4) & ~3;
+        while (g_cx < next) putc_cell(' ');
+        return;
+    }
+
+    g_cells[g_cy * g_cols + g_cx] = ((uint16_t)g_attr << 8) | (uint8_t)c;
+    g_cx++;
+
+    if (g_cx >= g_cols) {
+        g_cx = 0;
+        g_cy++;
+        scroll_if_needed();
+    }
+}
+
+void fbcon_write(const char* s, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) putc_cell(s[i]);
+    flush();
+}
+
+void fbcon_set_cursor(int x, int y) {
+    if (x < 0) x = 0;
+    if (x >= g_cols) x = g_cols - 1;
+    if (y < 0) y = 0;
+    if (y >= g_rows) y = g_rows - 1;
+    g_cx = x;
+    g_cy = y;
+}
+
+void fbcon_clear(void) {
+    memsetw(g_cells, ((uint16_t)g_attr << 8) | ' ', (size_t)(g_cols * g_rows));
+    g_cx = 0;
+    g_cy = 0;
+}
+
+int fbcon_init(void) {
+    if (g_state != FB_PENDING) return 0;
+
+    uint32_t size = (g_pitch * g_height + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    if (size > FBCON_VIRT_SIZE || (g_phys & (PAGE_SIZE - 1))) {
+        g_state = FB_NONE;
+        kprintf("[FBCON] framebuffer 0x%x size=%u not mappable, back to VGA text\n", g_phys, size);
+        return 0;
+    }
+
+    int wc = pat_available();
+    uint32_t flags = PAGE_WRITE | (wc ? PAGE_CACHE_WC : 0);
+    pde_t* kpd = paging_kernel_directory();
+    for (uint32_t off = 0; off < size; off += PAGE_SIZE) {
+        if (!paging_map(kpd, FBCON_VIRT_BASE + off, g_phys + off, flags)) {
+            g_state = FB_NONE;
+            kprintf("[FBCON] map failed at +0x%x, back to VGA text\n", off);
+            return 0;
+        }
+    }
+
+    // 부팅 초기부터 셀 배열에 쌓인 로그를 한 번에 그림
+    uint32_t f = irq_save();
+    g_fb = (uint8_t*)FBCON_VIRT_BASE;
+    g_state = FB_ON;
+    flush();
+    irq_restore(f);
+
+    kprintf("[FBCON] %ux%u pitch=%u phys=0x%x -> %dx%d cells, %s\n",
+        g_width, g_height, g_pitch, g_phys, g_cols, g_rows, wc ? "write-combining" : "uncached (no PAT)");
+    return 1;
+}
+
+void fbcon_dump_stats(void) {
+    if (g_state != FB_ON) {
+        kprintf("[FBCON] inactive (VGA text console)\n");
+        return;
+    }
+    uint64_t avg = g_cycles;
+    if (g_flushes) div_u64_u32(&avg, g_flushes);
+    kprintf("[FBCON] flushes=%u spans=%u bytes=%llu avg=%llu cycles/flush\n",
+        g_flushes, g_spans, g_bytes, avg);
+}
+
+// 화면 높이만큼 줄을 출력 (줄마다 스크롤 → 전체 redraw) 하고 flush 비용 측정
+static void bench_pass(const char* name) {
+    uint32_t flushes0 = g_flushes;
+    uint64_t cycles0 = g_cycles;
+    uint64_t bytes0 = g_bytes;
+
+    for (int i = 0; i < g_rows; i++) {
+        kprintf("[FBCON] bench %s line %d: the quick brown fox jumps over the lazy dog 0123456789\n", name, i);
+    }
+
+    uint32_t n = g_flushes - flushes0;
+    uint64_t cycles = g_cycles - cycles0;
+    uint64_t bytes = g_bytes - bytes0;
+    uint64_t per = cycles;
+    if (n) div_u64_u32(&per, n);
+
+    // MB/s = bytes / us
+    uint64_t us = tsc_cycles_to_us(cycles);
+    uint64_t mbps = bytes;
+    if (us) div_u64_u32(&mbps, (uint32_t)us);
+    else mbps = 0;
+
+    kprintf("[FBCON] %s: %u flushes, %llu cycles/flush (%llu us total), %llu MB/s\n",
+        name, n, per, us, mbps);
+}
+
+void fbcon_bench(void) {
+    if (!cmdline_bench("fbcon")) return;
+    if (g_state != FB_ON) {
+        kprintf("[FBCON] bench skipped (no linear framebuffer)\n");
+        return;
+    }
+
+    if (string_sse2_enabled()) bench_pass("sse2");
+    g_no_sse = 1;
+    bench_pass("rep-movsd");
+    g_no_sse = 0;
+
+    fbcon_dump_stats();
+}
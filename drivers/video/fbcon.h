@@ -0,0 +1,44 @@
+#pragma once
+#include <stdint.h>
+
+// Multiboot linear framebuffer 텍스트 콘솔
+// - 화면 내용은 셀 배열(문자 + VGA 속성)이 원본이고, framebuffer는 읽지 않는다
+//   (WC/UC 메모리 읽기는 매우 느리므로 스크롤도 셀 배열 memmove + 다시 그리기)
+// - 마지막으로 그린 셀 배열과 비교해 바뀐 행의 바뀐 열 구간만 다시 그린다
+// - 8x8 글꼴을 세로 2배로 늘려 8x16 셀: 한 글꼴 행을 스캔라인 버퍼에 펼친 뒤 두 줄에 복사
+// - 스캔라인 복사는 SSE(movntdq) 또는 rep movsd, framebuffer는 PAT로 write-combining 매핑
+// 32bpp RGB 모드만 지원하고, 그 외에는 VGA 텍스트 콘솔을 그대로 쓴다.
+
+#define FBCON_CELL_W 8
+#define FBCON_CELL_H 16
+
+// 셀 배열은 부팅 초기(heap 이전)부터 쓰므로 정적 크기
+#define FBCON_MAX_COLS 256
+#define FBCON_MAX_ROWS 128
+
+// framebuffer를 매핑할 커널 MMIO 영역 ([3GB, 4GB), 모든 page directory가 공유)
+#define FBCON_VIRT_BASE 0xD0000000u
+#define FBCON_VIRT_SIZE 0x02000000u     // 32MB
+
+// Multiboot framebuffer 정보 확인 (paging 이전, kernel_main 시작 직후)
+// 쓸 수 있는 그래픽 모드면 1: 이후 콘솔 출력은 셀 배열에 쌓이고 fbcon_init 때 한 번에 그려진다
+int fbcon_probe(uint32_t mb_addr);
+
+// framebuffer를 FBCON_VIRT_BASE에 매핑(pat_init 성공 시 WC)하고 전체를 그린다
+// paging_init 직후, 프로세스 page directory를 만들기 전에 호출. 성공 1
+int fbcon_init(void);
+
+// probe 성공 여부 (kprintf가 VGA 텍스트 대신 fbcon으로 보낼지)
+int fbcon_active(void);
+
+// ---- kprintf 백엔드 (kprintf lock 보유, 인터럽트 off 상태에서 호출) ----
+void fbcon_write(const char* s, uint32_t n);
+void fbcon_set_cursor(int x, int y);
+void fbcon_clear(void);
+int fbcon_cols(void);
+int fbcon_rows(void);
+
+void fbcon_dump_stats(void);
+
+// 전체 화면 스크롤 출력의 redraw 비용 측정 (tsc_calibrate 이후)
+void fbcon_bench(void);
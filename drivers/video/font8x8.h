@@ -0,0 +1,10 @@
+#pragma once
+#include <stdint.h>
+
+// 8x8 비트맵 글꼴 (printable ASCII 0x20~0x7E, public domain font8x8_basic)
+// 행마다 1바이트, bit0이 가장 왼쪽 픽셀
+#define FONT8X8_FIRST 0x20
+#define FONT8X8_LAST  0x7E
+
+// 범위 밖 문자는 빈 사각형 글리프
+const uint8_t* font8x8_glyph(uint8_t c);
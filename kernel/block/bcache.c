@@ -0,0 +1,372 @@
+#include "bcache.h"
+#include "../memory/heap.h"
+#include "../sched/thread.h"
+#include "../fs/procfs.h"
+#include "../time/time.h"
+#include "../lib/errno.h"
+#include "../lib/string.h"
+#include "../console/kprintf.h"
+
+static bcache_t* g_caches = 0;
+static mutex_t g_list_lock;
+
+static inline uint32_t hash_of(uint32_t block) {
+    return block % BCACHE_HASH_SIZE;
+}
+
+// 장치 끝의 블록은 8섹터보다 짧을 수 있다
+static inline uint32_t block_sectors(const bcache_t* bc, uint32_t block) {
+    uint32_t left = bc->dev->nr_sectors - block * BCACHE_BLOCK_SECTORS;
+    return left < BCACHE_BLOCK_SECTORS ? left : BCACHE_BLOCK_SECTORS;
+}
+
+static inline uint32_t ms_to_ticks(uint32_t ms) {
+    uint32_t t = ms * time_get_hz() / 1000;
+    return t ? t : 1;
+}
+
+static void lru_unlink(bbuf_t* b) {
+    b->prev->next = b->next;
+    b->next->prev = b->prev;
+}
+
+static void lru_push_front(bcache_t* bc, bbuf_t* b) {
+    b->next = bc->lru.next;
+    b->prev = &bc->lru;
+    bc->lru.next->prev = b;
+    bc->lru.next = b;
+}
+
+static void lru_touch(bcache_t* bc, bbuf_t* b) {
+    lru_unlink(b);
+    lru_push_front(bc, b);
+}
+
+static bbuf_t* find(bcache_t* bc, uint32_t block) {
+    for (bbuf_t* b = bc->hash[hash_of(block)]; b; b = b->hnext) {
+        if (b->block == block && b->valid) return b;
+    }
+    return 0;
+}
+
+static void hash_remove(bcache_t* bc, bbuf_t* b) {
+    bbuf_t** link = &bc->hash[hash_of(b->block)];
+    while (*link && *link != b) link = &(*link)->hnext;
+    if (*link) *link = b->hnext;
+    b->hnext = 0;
+}
+
+// 연속된 블록 run[0..n)을 요청 하나로 쓰고 dirty 해제 (lock 보유)
+static int write_run(bcache_t* bc, bbuf_t** run, uint32_t n) {
+    uint32_t lba = run[0]->block * BCACHE_BLOCK_SECTORS;
+    uint32_t sectors = (n - 1) * BCACHE_BLOCK_SECTORS + block_sectors(bc, run[n - 1]->block);
+    const void* src = run[0]->data;
+
+    if (n > 1) {
+        for (uint32_t i = 0; i < n; i++) memcpy(bc->bounce + i * BCACHE_BLOCK_SIZE, run[i]->data, BCACHE_BLOCK_SIZE);
+        src = bc->bounce;
+    }
+    int rc = blockdev_write(bc->dev, lba, sectors, src);
+    if (rc) return rc;
+
+    bc->stats.write_reqs++;
+    bc->stats.write_sectors += sectors;
+    for (uint32_t i = 0; i < n; i++) {
+        run[i]->dirty = 0;
+        bc->nr_dirty--;
+    }
+    return 0;
+}
+
+// dirty 블록 중 all이면 전부, 아니면 expire tick 이전에 dirty가 된 것만 번호순으로 묶어서 반영
+static int flush_locked(bcache_t* bc, int all, uint64_t expire, uint32_t* reason) {
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < bc->nr_bufs; i++) {
+        bbuf_t* b = &bc->bufs[i];
+        if (b->dirty && (all || b->dirty_tick <= expire)) bc->scratch[n++] = b;
+    }
+    if (!n) return 0;
+
+    for (uint32_t i = 1; i < n; i++) {
+        bbuf_t* b = bc->scratch[i];
+        uint32_t j = i;
+        while (j > 0 && bc->scratch[j - 1]->block > b->block) {
+            bc->scratch[j] = bc->scratch[j - 1];
+            j--;
+        }
+        bc->scratch[j] = b;
+    }
+
+    int rc = 0;
+    for (uint32_t i = 0; i < n;) {
+        uint32_t j = i + 1;
+        while (j < n && j - i < BCACHE_MAX_IO_BLOCKS && bc->scratch[j]->block == bc->scratch[j - 1]->block + 1) j++;
+        int r = write_run(bc, &bc->scratch[i], j - i);
+        if (r && !rc) rc = r;
+        i = j;
+    }
+    (*reason)++;
+    return rc;
+}
+
+// block용 버퍼 (내용 없음). 깨끗한 블록 중 가장 오래 안 쓴 것, 전부 dirty면 먼저 반영
+static bbuf_t* grab(bcache_t* bc, uint32_t block) {
+    bbuf_t* b = bc->lru.prev;
+    while (b != &bc->lru && b->dirty) b = b->prev;
+    if (b == &bc->lru) {
+        flush_locked(bc, 1, 0, &bc->stats.flush_evict);
+        b = bc->lru.prev;
+        if (b->dirty) return 0;
+    }
+
+    if (b->valid) hash_remove(bc, b);
+    b->block = block;
+    b->valid = 0;
+    b->dirty = 0;
+    b->hnext = bc->hash[hash_of(block)];
+    bc->hash[hash_of(block)] = b;
+    lru_touch(bc, b);
+    return b;
+}
+
+// 캐시에 없는 연속 블록 [block, block + n)을 요청 하나로 읽는다
+static int read_run(bcache_t* bc, uint32_t block, uint32_t n) {
+    bbuf_t* run[BCACHE_MAX_IO_BLOCKS];
+    for (uint32_t i = 0; i < n; i++) {
+        run[i] = grab(bc, block + i);
+        if (!run[i]) return -EIO;
+    }
+
+    uint32_t sectors = (n - 1) * BCACHE_BLOCK_SECTORS + block_sectors(bc, block + n - 1);
+    void* dst = n > 1 ? bc->bounce : run[0]->data;
+    int rc = blockdev_read(bc->dev, block * BCACHE_BLOCK_SECTORS, sectors, dst);
+    if (rc) {
+        for (uint32_t i = 0; i < n; i++) hash_remove(bc, run[i]);
+        return rc;
+    }
+    if (n > 1) {
+        for (uint32_t i = 0; i < n; i++) memcpy(run[i]->data, bc->bounce + i * BCACHE_BLOCK_SIZE, BCACHE_BLOCK_SIZE);
+    }
+    for (uint32_t i = 0; i < n; i++) run[i]->valid = 1;
+
+    bc->stats.read_reqs++;
+    bc->stats.read_sectors += sectors;
+    bc->stats.misses += n;
+    return 0;
+}
+
+static int range_ok(const bcache_t* bc, uint64_t pos, uint32_t len) {
+    uint64_t size = (uint64_t)bc->dev->nr_sectors * SECTOR_SIZE;
+    return pos <= size && len <= size - pos;
+}
+
+int bcache_read(bcache_t* bc, uint64_t pos, uint32_t len, void* buf) {
+    if (!range_ok(bc, pos, len)) return -EINVAL;
+    if (!len) return 0;
+
+    uint8_t* dst = (uint8_t*)buf;
+    uint32_t last = (uint32_t)((pos + len - 1) >> BCACHE_BLOCK_SHIFT);
+    uint32_t fresh_end = 0;
+    int rc = 0;
+
+    mutex_lock(&bc->lock);
+    while (len) {
+        uint32_t block = (uint32_t)(pos >> BCACHE_BLOCK_SHIFT);
+        uint32_t off = (uint32_t)pos & (BCACHE_BLOCK_SIZE - 1);
+        uint32_t n = BCACHE_BLOCK_SIZE - off;
+        if (n > len) n = len;
+
+        bbuf_t* b = find(bc, block);
+        if (!b) {
+            uint32_t run = 1;
+            while (run < BCACHE_MAX_IO_BLOCKS && block + run <= last && !find(bc, block + run)) run++;
+            rc = read_run(bc, block, run);
+            if (rc) break;
+            fresh_end = block + run;
+            b = find(bc, block);
+        } else if (block >= fresh_end) {
+            bc->stats.hits++;
+        }
+
+        memcpy(dst, b->data + off, n);
+        lru_touch(bc, b);
+        dst += n;
+        pos += n;
+        len -= n;
+    }
+    mutex_unlock(&bc->lock);
+    return rc;
+}
+
+int bcache_write(bcache_t* bc, uint64_t pos, uint32_t len, const void* buf) {
+    if (!range_ok(bc, pos, len)) return -EINVAL;
+
+    const uint8_t* src = (const uint8_t*)buf;
+    uint64_t now = timer_ticks();
+    int rc = 0;
+
+    mutex_lock(&bc->lock);
+    while (len) {
+        uint32_t block = (uint32_t)(pos >> BCACHE_BLOCK_SHIFT);
+        uint32_t off = (uint32_t)pos & (BCACHE_BLOCK_SIZE - 1);
+        uint32_t n = BCACHE_BLOCK_SIZE - off;
+        if (n > len) n = len;
+
+        bbuf_t* b = find(bc, block);
+        if (b) {
+            bc->stats.hits++;
+        } else if (off == 0 && n >= block_sectors(bc, block) * SECTOR_SIZE) {
+            // 블록 전체를 덮으므로 읽을 필요 없음
+            b = grab(bc, block);
+            if (!b) {
+                rc = -EIO;
+                break;
+            }
+            b->valid = 1;
+            bc->stats.misses++;
+        } else {
+            rc = read_run(bc, block, 1);
+            if (rc) break;
+            b = find(bc, block);
+        }
+
+        memcpy(b->data + off, src, n);
+        lru_touch(bc, b);
+
+        if (bc->writethrough) {
+            uint32_t s0 = off / SECTOR_SIZE;
+            uint32_t s1 = (off + n + SECTOR_SIZE - 1) / SECTOR_SIZE;
+            rc = blockdev_write(bc->dev, block * BCACHE_BLOCK_SECTORS + s0, s1 - s0, b->data + s0 * SECTOR_SIZE);
+            if (rc) break;
+            bc->stats.write_reqs++;
+            bc->stats.write_sectors += s1 - s0;
+        } else if (!b->dirty) {
+            b->dirty = 1;
+            b->dirty_tick = now;
+            bc->nr_dirty++;
+        }
+        src += n;
+        pos += n;
+        len -= n;
+    }
+
+    // dirty가 너무 많으면 쓰는 쪽이 직접 반영 (flusher를 기다리지 않음)
+    if (rc == 0 && bc->nr_dirty * 100 > bc->nr_bufs * BCACHE_DIRTY_HARD_PCT) {
+        rc = flush_locked(bc, 1, 0, &bc->stats.flush_hard);
+    }
+    mutex_unlock(&bc->lock);
+    return rc;
+}
+
+int bcache_sync(bcache_t* bc) {
+    mutex_lock(&bc->lock);
+    int rc = bc->nr_dirty ? flush_locked(bc, 1, 0, &bc->stats.flush_sync) : 0;
+    mutex_unlock(&bc->lock);
+    if (rc) return rc;
+    return blockdev_flush(bc->dev);
+}
+
+void bcache_set_writethrough(bcache_t* bc, int on) {
+    if (on) bcache_sync(bc);
+    bc->writethrough = on;
+}
+
+uint32_t bcache_dirty(bcache_t* bc) {
+    return bc->nr_dirty;
+}
+
+void bcache_get_stats(bcache_t* bc, bcache_stats_t* out) {
+    mutex_lock(&bc->lock);
+    *out = bc->stats;
+    mutex_unlock(&bc->lock);
+}
+
+bcache_t* bcache_create(blockdev_t* dev, uint32_t nr_bufs) {
+    if (!nr_bufs) nr_bufs = BCACHE_DEFAULT_BUFFERS;
+    // 묶음 읽기 하나가 자기 블록을 다시 내쫓지 않도록
+    if (nr_bufs < 2 * BCACHE_MAX_IO_BLOCKS) nr_bufs = 2 * BCACHE_MAX_IO_BLOCKS;
+
+    bcache_t* bc = (bcache_t*)kmalloc(sizeof(bcache_t));
+    memset(bc, 0, sizeof(*bc));
+    bc->dev = dev;
+    bc->nr_bufs = nr_bufs;
+    mutex_init(&bc->lock, "bcache");
+    bc->bufs = (bbuf_t*)kmalloc(nr_bufs * sizeof(bbuf_t));
+    bc->scratch = (bbuf_t**)kmalloc(nr_bufs * sizeof(bbuf_t*));
+    bc->bounce = (uint8_t*)kmalloc_aligned(BCACHE_MAX_IO_BLOCKS * BCACHE_BLOCK_SIZE, 16);
+    uint8_t* data = (uint8_t*)kmalloc_aligned(nr_bufs * BCACHE_BLOCK_SIZE, 16);
+
+    bc->lru.next = bc->lru.prev = &bc->lru;
+    for (uint32_t i = 0; i < nr_bufs; i++) {
+        bbuf_t* b = &bc->bufs[i];
+        memset(b, 0, sizeof(*b));
+        b->data = data + i * BCACHE_BLOCK_SIZE;
+        lru_push_front(bc, b);
+    }
+
+    mutex_lock(&g_list_lock);
+    bc->next = g_caches;
+    g_caches = bc;
+    mutex_unlock(&g_list_lock);
+    return bc;
+}
+
+void bcache_destroy(bcache_t* bc) {
+    mutex_lock(&g_list_lock);
+    bcache_t** link = &g_caches;
+    while (*link && *link != bc) link = &(*link)->next;
+    if (*link) *link = bc->next;
+    mutex_unlock(&g_list_lock);
+
+    bcache_sync(bc);
+    kfree(bc->bufs[0].data);
+    kfree(bc->bufs);
+    kfree(bc->scratch);
+    kfree(bc->bounce);
+    kfree(bc);
+}
+
+static void flusher(void* arg) {
+    (void)arg;
+    for (;;) {
+        sleep_ms(BCACHE_FLUSH_INTERVAL_MS);
+        uint64_t now = timer_ticks();
+        uint32_t expire_ticks = ms_to_ticks(BCACHE_DIRTY_EXPIRE_MS);
+
+        mutex_lock(&g_list_lock);
+        for (bcache_t* bc = g_caches; bc; bc = bc->next) {
+            if (!bc->nr_dirty) continue;
+            mutex_lock(&bc->lock);
+            int rc;
+            if (bc->nr_dirty * 100 > bc->nr_bufs * BCACHE_DIRTY_BG_PCT) {
+                rc = flush_locked(bc, 1, 0, &bc->stats.flush_bg);
+            } else {
+                rc = now > expire_ticks ? flush_locked(bc, 0, now - expire_ticks, &bc->stats.flush_age) : 0;
+            }
+            mutex_unlock(&bc->lock);
+            if (rc) kprintf("[BCACHE] %s: write-back failed (%d)\n", bc->dev->name, rc);
+        }
+        mutex_unlock(&g_list_lock);
+    }
+}
+
+static void show_bcache(proc_seq_t* s) {
+    proc_printf(s, "%-8s %5s %5s %8s %8s %12s %12s  flush age/bg/hard/evict/sync\n",
+        "dev", "bufs", "dirty", "hits", "misses", "rd req/sec", "wr req/sec");
+    mutex_lock(&g_list_lock);
+    for (bcache_t* bc = g_caches; bc; bc = bc->next) {
+        bcache_stats_t st;
+        bcache_get_stats(bc, &st);
+        proc_printf(s, "%-8s %5u %5u %8u %8u %5u/%-6u %5u/%-6u  %u/%u/%u/%u/%u\n",
+            bc->dev->name, bc->nr_bufs, bc->nr_dirty, st.hits, st.misses,
+            st.read_reqs, st.read_sectors, st.write_reqs, st.write_sectors,
+            st.flush_age, st.flush_bg, st.flush_hard, st.flush_evict, st.flush_sync);
+    }
+    mutex_unlock(&g_list_lock);
+}
+
+void bcache_init(void) {
+    mutex_init(&g_list_lock, "bcache-list");
+    procfs_register("bcache", show_bcache);
+    thread_create("bflush", flusher, 0, PRIO_NORMAL + 1);
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <stdint.h>
+#include "blockdev.h"
+#include "../sync/mutex.h"
+
+// write-back 버퍼 캐시 (블록 장치 하나당 하나)
+// - 단위는 BCACHE_BLOCK_SIZE(4KB, 8섹터) 블록. 해시로 찾고 LRU로 교체 (깨끗한 블록부터)
+// - 쓰기는 캐시 블록에만 하고 dirty로 표시. 블록 전체를 덮는 쓰기는 장치에서 읽지 않는다
+// - 반영은 flusher 스레드(bflush)가 BCACHE_FLUSH_INTERVAL_MS마다 확인해서:
+//   BCACHE_DIRTY_EXPIRE_MS보다 오래된 dirty 블록, 또는 dirty가 BCACHE_DIRTY_BG_PCT를 넘으면 전부
+// - dirty가 BCACHE_DIRTY_HARD_PCT를 넘으면 쓰는 쪽이 직접 flush (throttle)
+// - flush는 dirty 블록을 번호순으로 정렬해 연속된 블록을 최대 BCACHE_MAX_IO_BLOCKS개(64KB)씩
+//   한 번의 blockdev_write로 묶는다. 읽기도 연속된 miss 블록을 한 요청으로 읽는다
+// - bcache_sync: 전부 반영 + 장치 쓰기 캐시 flush (fsync)
+
+#define BCACHE_BLOCK_SHIFT       12
+#define BCACHE_BLOCK_SIZE        (1u << BCACHE_BLOCK_SHIFT)
+#define BCACHE_BLOCK_SECTORS     (BCACHE_BLOCK_SIZE / SECTOR_SIZE)
+#define BCACHE_MAX_IO_BLOCKS     16u
+#define BCACHE_HASH_SIZE         64u
+#define BCACHE_DEFAULT_BUFFERS   64u
+#define BCACHE_FLUSH_INTERVAL_MS 100u
+#define BCACHE_DIRTY_EXPIRE_MS   3000u
+#define BCACHE_DIRTY_BG_PCT      25u
+#define BCACHE_DIRTY_HARD_PCT    60u
+
+typedef struct bbuf {
+    uint32_t block;                 // 장치 LBA / BCACHE_BLOCK_SECTORS
+    uint8_t* data;
+    uint8_t valid;
+    uint8_t dirty;
+    uint64_t dirty_tick;            // 처음 dirty가 된 tick
+    struct bbuf* hnext;
+    struct bbuf* prev;              // LRU (앞이 최근)
+    struct bbuf* next;
+} bbuf_t;
+
+typedef struct bcache_stats {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t read_reqs;             // 장치 읽기 요청 / 섹터
+    uint32_t read_sectors;
+    uint32_t write_reqs;            // 장치 쓰기 요청 / 섹터 (묶인 정도 = 섹터 / 요청)
+    uint32_t write_sectors;
+    uint32_t flush_age;             // flush 원인별 횟수
+    uint32_t flush_bg;
+    uint32_t flush_hard;
+    uint32_t flush_evict;
+    uint32_t flush_sync;
+} bcache_stats_t;
+
+typedef struct bcache {
+    blockdev_t* dev;
+    mutex_t lock;
+    bbuf_t* bufs;
+    uint32_t nr_bufs;
+    bbuf_t* hash[BCACHE_HASH_SIZE];
+    bbuf_t lru;                     // 원형 리스트 머리
+    uint32_t nr_dirty;
+    int writethrough;               // 비교용: 쓰기를 바로 장치로 (블록 단위 요청)
+    uint8_t* bounce;                // 묶음 I/O 버퍼 (BCACHE_MAX_IO_BLOCKS 블록)
+    bbuf_t** scratch;               // flush 대상 정렬용 (nr_bufs)
+    bcache_stats_t stats;
+    struct bcache* next;
+} bcache_t;
+
+// flusher 스레드 시작 + /proc/bcache 등록 (procfs_init 이후)
+void bcache_init(void);
+
+// nr_bufs가 0이면 BCACHE_DEFAULT_BUFFERS
+bcache_t* bcache_create(blockdev_t* dev, uint32_t nr_bufs);
+// 전부 반영한 뒤 해제
+void bcache_destroy(bcache_t* bc);
+
+// 바이트 단위 read/write (장치 범위 안). 성공 0, 실패 -errno
+int bcache_read(bcache_t* bc, uint64_t pos, uint32_t len, void* buf);
+int bcache_write(bcache_t* bc, uint64_t pos, uint32_t len, const void* buf);
+
+// 모든 dirty 블록 반영 + blockdev_flush
+int bcache_sync(bcache_t* bc);
+
+void bcache_set_writethrough(bcache_t* bc, int on);
+uint32_t bcache_dirty(bcache_t* bc);
+void bcache_get_stats(bcache_t* bc, bcache_stats_t* out);
@@ -0,0 +1,77 @@
+#include "blockdev.h"
+#include "../lib/errno.h"
+#include "../lib/string.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/irqflags.h"
+
+static blockdev_t* g_blockdevs = 0;
+
+static int name_eq(const char* a, const char* b) {
+    uint32_t la = strlen(a);
+    return la == strlen(b) && memcmp(a, b, la) == 0;
+}
+
+int blockdev_register(blockdev_t* dev) {
+    if (blockdev_find(dev->name)) return -EEXIST;
+
+    dev->read_ops = dev->write_ops = 0;
+    dev->read_sectors = dev->write_sectors = 0;
+    dev->flush_ops = 0;
+
+    uint32_t f = irq_save();
+    dev->next = g_blockdevs;
+    g_blockdevs = dev;
+    irq_restore(f);
+
+    kprintf("[BLK] %s: %u sectors (%u KB)\n", dev->name, dev->nr_sectors, dev->nr_sectors / 2);
+    return 0;
+}
+
+blockdev_t* blockdev_find(const char* name) {
+    for (blockdev_t* d = g_blockdevs; d; d = d->next) {
+        if (name_eq(d->name, name)) return d;
+    }
+    return 0;
+}
+
+static int range_ok(const blockdev_t* dev, uint32_t lba, uint32_t count) {
+    return count && lba < dev->nr_sectors && count <= dev->nr_sectors - lba;
+}
+
+int blockdev_read(blockdev_t* dev, uint32_t lba, uint32_t count, void* buf) {
+    if (!range_ok(dev, lba, count)) return -EINVAL;
+    if (!dev->ops->read) return -EIO;
+
+    int rc = dev->ops->read(dev, lba, count, buf);
+    if (rc == 0) {
+        dev->read_ops++;
+        dev->read_sectors += count;
+    }
+    return rc;
+}
+
+int blockdev_write(blockdev_t* dev, uint32_t lba, uint32_t count, const void* buf) {
+    if (!range_ok(dev, lba, count)) return -EINVAL;
+    if (!dev->ops->write) return -EPERM;
+
+    int rc = dev->ops->write(dev, lba, count, buf);
+    if (rc == 0) {
+        dev->write_ops++;
+        dev->write_sectors += count;
+    }
+    return rc;
+}
+
+int blockdev_flush(blockdev_t* dev) {
+    if (!dev->ops->flush) return 0;
+    int rc = dev->ops->flush(dev);
+    if (rc == 0) dev->flush_ops++;
+    return rc;
+}
+
+void blockdev_dump(void) {
+    for (blockdev_t* d = g_blockdevs; d; d = d->next) {
+        kprintf("[BLK] %-8s sectors=%u reads=%u/%u writes=%u/%u (ops/sectors) flushes=%u\n",
+            d->name, d->nr_sectors, d->read_ops, d->read_sectors, d->write_ops, d->write_sectors, d->flush_ops);
+    }
+}
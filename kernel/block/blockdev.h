@@ -0,0 +1,43 @@
+#pragma once
+#include <stdint.h>
+
+// 블록 장치 계층: 섹터 단위 read/write를 드라이버(ramdisk, ATA 등)에 위임
+// 드라이버 콜백은 스레드 컨텍스트에서 호출되며 잠들 수 있다.
+#define BLOCKDEV_NAME_LEN 16
+#define SECTOR_SIZE       512u
+
+struct blockdev;
+
+typedef struct blockdev_ops {
+    // 성공 0, 실패 -errno
+    int (*read)(struct blockdev* dev, uint32_t lba, uint32_t count, void* buf);
+    int (*write)(struct blockdev* dev, uint32_t lba, uint32_t count, const void* buf);
+    // 장치 쓰기 캐시를 매체로 (선택, 없으면 쓰기가 곧 영속)
+    int (*flush)(struct blockdev* dev);
+} blockdev_ops_t;
+
+typedef struct blockdev {
+    char name[BLOCKDEV_NAME_LEN];
+    uint32_t nr_sectors;
+    const blockdev_ops_t* ops;
+    void* priv;                 // 드라이버 데이터
+
+    uint32_t read_ops;
+    uint32_t write_ops;
+    uint32_t read_sectors;
+    uint32_t write_sectors;
+    uint32_t flush_ops;
+
+    struct blockdev* next;
+} blockdev_t;
+
+// 드라이버가 채운 dev를 등록 (같은 이름이 있으면 -EEXIST)
+int blockdev_register(blockdev_t* dev);
+blockdev_t* blockdev_find(const char* name);
+
+// 범위 검사 후 드라이버 호출. 성공 0, 실패 -errno
+int blockdev_read(blockdev_t* dev, uint32_t lba, uint32_t count, void* buf);
+int blockdev_write(blockdev_t* dev, uint32_t lba, uint32_t count, const void* buf);
+int blockdev_flush(blockdev_t* dev);
+
+void blockdev_dump(void);
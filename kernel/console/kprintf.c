@@ -1,213 +1,511 @@
-#include "kprintf.h"
-#include <stdint.h>
-#include <stdarg.h>
-#include "../../drivers/serial/serial.h"
-#include "../panic/panic.h"
-#include "../lib/itoa.h"
-
-
-// -------------------------
-// Minimal VGA console backend
-// -------------------------
-static uint16_t* const VGA_MEM = (uint16_t*)0xB8000;
-static const int VGA_W = 80;
-static const int VGA_H = 25;
-
-static int cur_x = 0;
-static int cur_y = 0;
-static uint8_t vga_attr = 0x07; // light grey on black
-
-static volatile int kprintf_lock = 0;
-
-static void lock(void) {
-    while (__sync_lock_test_and_set(&kprintf_lock, 1)) { }
-}
-
-static void unlock(void) {
-    __sync_lock_release(&kprintf_lock);
-}
-
-static void vga_scroll_if_needed(void) {
-    if (cur_y < VGA_H) return;
-
-    // scroll up by one line
-    for (int y = 1; y < VGA_H; y++) {
-        for (int x = 0; x < VGA_W; x++) {
-            VGA_MEM[(y - 1) * VGA_W + x] = VGA_MEM[y * VGA_W + x];
-        }
-    }
-
-    // clear last line
-    for (int x = 0; x < VGA_W; x++) {
-        VGA_MEM[(VGA_H - 1) * VGA_W + x] = ((uint16_t)vga_attr << 8) | ' ';
-    }
-
-    cur_y = VGA_H - 1;
-}
-
-static void vga_putc_console(char c) {
-    if (c == '\n') {
-        cur_x = 0;
-        cur_y++;
-        vga_scroll_if_needed();
-        return;
-    }
-    if (c == '\r') {
-        cur_x = 0;
-        return;
-    }
-    if ( c == '\t') {
-        int next = (cur_x + 4) & ~3;
-        while (cur_x < next) vga_putc_console(' ');
-        return;
-    }
-
-    VGA_MEM[cur_y * VGA_W + cur_x] = ((uint16_t)vga_attr << 8) | (uint8_t)c;
-    cur_x++;
-
-    if (cur_x >= VGA_W) {
-        cur_x = 0;
-        cur_y++;
-        vga_scroll_if_needed();
-    }
-}
-
-// Unified output: VGA + Serial
-static void kout_char(char c) {
-    vga_putc_console(c);
-
-    char s[2] = {c, 0};
-    serial_write(s);
-}
-
-static void kout_str(const char* s) {
-    if (!s) s = "(null)";
-    while (*s) kout_char(*s++);
-}
-
-
-// -------------------------
-// Formatting helpers
-// -------------------------
-static void kout_u32_hex(uint32_t v) {
-    char buf[11];
-    u32_to_hex(v, buf);
-    kout_str(buf);
-}
-
-static void kout_u32_dec(uint32_t v) {
-    // 최소 구현
-    char tmp[11];
-    int i = 0;
-    if (v == 0) {
-        kout_char('0');
-        return;
-    }
-    while (v && i < 10) {
-        tmp[i++] = '0' + (v % 10);
-        v /= 10;
-    }
-    for (int j = i - 1; j >= 0; j--) kout_char(tmp[j]);
-}
-
-static void kout_i32_dec(int32_t v) {
-    if (v < 0) {
-        kout_char('-');
-        // INT32_MIN도 안전하게 처리
-        uint32_t uv = (uint32_t)(~(uint32_t)v) + 1; // two's complement abs
-        kout_u32_dec(uv);
-    } else {
-        kout_u32_dec((uint32_t)v);
-    }
-}
-
-void kvprintf(const char* fmt, va_list args) {
-    for (const char* p = fmt; *p; p++) {
-        if (*p != '%') {
-            kout_char(*p);
-            continue;
-        }
-
-        p++; // skip '%'
-        if (*p == 0) break;
-
-        switch (*p) {
-            case '%':
-                kout_char('%');
-                break;
-            case 'c': {
-                int c = va_arg(args, int);
-                kout_char((char)c);
-                break;
-            }
-            case 's': {
-                const char* s = va_arg(args, const char*);
-                if (!s) s = "(null)";
-                kout_str(s);
-                break;
-            }
-            case 'x': {
-                uint32_t v = va_arg(args, uint32_t);
-                kout_u32_hex(v);
-                break;
-            }
-            case 'u': {
-                uint32_t v = va_arg(args, uint32_t);
-                kout_u32_dec(v);
-                break;
-            }
-            case 'd': {
-                int32_t v = va_arg(args, int32_t);
-                kout_i32_dec(v);
-                break;
-            }
-            default:
-                // 알 수 없는 포맷은 그대로 출력해 디버깅 가능하게
-                kout_char('%');
-                kout_char(*p);
-                break;
-        }
-    }
-}
-
-void kprintf(const char* fmt, ...) {
-    lock();
-    va_list args;
-    va_start(args, fmt);
-    kvprintf(fmt, args);
-    va_end(args);
-    unlock();
-}
-
-void kprintf_set_cursor(int x, int y) {
-    if (x < 0) x = 0; if (x >= VGA_W) x = VGA_W - 1;
-    if (y < 0) y = 0; if (y >= VGA_H) y = VGA_H - 1;
-    cur_x = x;
-    cur_y = y;
-}
-
-void kprintf_clear_console(void) {
-    for (int y = 0; y < VGA_H; y++) {
-        for (int x = 0; x < VGA_W; x++) {
-            VGA_MEM[y * VGA_W + x] = ((uint16_t)vga_attr << 8) | ' ';
-        }
-    }
-    cur_x = 0;
-    cur_y = 0;
-}
-
-void kprintf_puts_at(int row, int col, const char* s) {
-    // 커서 위치 저장
-    int old_x = cur_x;
-    int old_y = cur_y;
-    
-    // 새 위치 설정
-    kprintf_set_cursor(col, row);
-    
-    // 문자열 출력
-    kout_str(s);
-    
-    // 원래 커서 위치 복원 (선택적, 필요하면 주석 처리)
-    // cur_x = old_x;
-    // cur_y = old_y;
+#include "kprintf.h"
+#include <stdint.h>
+#include <stdarg.h>
+#include "../../drivers/serial/serial.h"
+#include "../../drivers/video/fbcon.h"
+#include "../panic/panic.h"
+#include "../lib/div64.h"
+#include "../lib/string.h"
+#include "../../arch/x86/cpu/irqflags.h"
+
+
+// -------------------------
+// Minimal VGA console backend
+// -------------------------
+static uint16_t* const VGA_MEM = (uint16_t*)0xB8000;
+static const int VGA_W = 80;
+static const int VGA_H = 25;
+
+static int cur_x = 0;
+static int cur_y = 0;
+static uint8_t vga_attr = 0x07; // light grey on black
+
+static volatile int kprintf_lock = 0;
+
+// 잠금 보유 중 IRQ/선점이 끼어들면 같은 CPU에서 영원히 spin하므로 인터럽트도 함께 끈다
+static uint32_t lock(void) {
+    uint32_t flags = irq_save();
+    while (__sync_lock_test_and_set(&kprintf_lock, 1)) { }
+    return flags;
+}
+
+static void unlock(uint32_t flags) {
+    __sync_lock_release(&kprintf_lock);
+    irq_restore(flags);
+}
+
+static void vga_scroll_if_needed(void) {
+    if (cur_y < VGA_H) return;
+
+    // scroll up by one line
+    memmove(VGA_MEM, VGA_MEM + VGA_W, (VGA_H - 1) * VGA_W * sizeof(uint16_t));
+
+    // clear last line
+    memsetw(VGA_MEM + (VGA_H - 1) * VGA_W, ((uint16_t)vga_attr << 8) | ' ', VGA_W);
+
+    cur_y = VGA_H - 1;
+}
+
+static void vga_putc_console(char c) {
+    if (c == '\n') {
+        cur_x = 0;
+        cur_y++;
+        vga_scroll_if_needed();
+        return;
+    }
+    if (c == '\r') {
+        cur_x = 0;
+        return;
+    }
+    if (c == '\b') {
+        // 커서만 뒤로 (지우기는 TTY echo가 "\b \b"로)
+        if (cur_x > 0) cur_x--;
+        return;
+    }
+    if ( c == '\t') {
+        int next = (cur_x + 4) & ~3;
+        while (cur_x < next) vga_putc_console(' ');
+        return;
+    }
+
+    VGA_MEM[cur_y * VGA_W + cur_x] = ((uint16_t)vga_attr << 8) | (uint8_t)c;
+    cur_x++;
+
+    if (cur_x >= VGA_W) {
+        cur_x = 0;
+        cur_y++;
+        vga_scroll_if_needed();
+    }
+}
+
+// -------------------------
+// 커널 로그 ring (kprintf lock으로 보호)
+// -------------------------
+static char g_klog[KLOG_SIZE];
+static uint32_t g_klog_pos = 0;      // 지금까지 쓴 전체 바이트 (위치는 & (KLOG_SIZE-1))
+
+static void klog_append(const char* s, uint32_t n) {
+    if (n > KLOG_SIZE) {
+        s += n - KLOG_SIZE;
+        g_klog_pos += n - KLOG_SIZE;
+        n = KLOG_SIZE;
+    }
+    uint32_t at = g_klog_pos & (KLOG_SIZE - 1);
+    uint32_t first = KLOG_SIZE - at;
+    if (first > n) first = n;
+    memcpy(g_klog + at, s, first);
+    memcpy(g_klog, s + first, n - first);
+    g_klog_pos += n;
+}
+
+// Unified output: VGA + Serial (버퍼 단위로 한 번에, 호출자가 lock 보유)
+// buf는 s[n] 자리에 NUL을 쓸 수 있어야 한다
+static void console_write(char* s, uint32_t n) {
+    klog_append(s, n);
+
+    // 그래픽 모드로 부팅했으면 framebuffer 콘솔 (0xB8000은 화면에 보이지 않음)
+    if (fbcon_active()) fbcon_write(s, n);
+    else for (uint32_t i = 0; i < n; i++) vga_putc_console(s[i]);
+
+    s[n] = 0;
+    serial_write(s);
+}
+
+static void kout_str(const char* s) {
+    if (!s) s = "(null)";
+
+    char buf[64];
+    while (*s) {
+        uint32_t n = 0;
+        while (*s && n < sizeof(buf) - 1) buf[n++] = *s++;
+        console_write(buf, n);
+    }
+}
+
+
+// -------------------------
+// Formatting helpers
+// -------------------------
+
+// 포맷 결과가 쌓이는 버퍼. 가득 차면 flush가 있으면 비우고, 없으면 잘라낸다.
+// cap에는 항상 NUL 한 칸이 남는다.
+typedef struct fmt_out {
+    char* buf;
+    uint32_t cap;
+    uint32_t len;
+    uint32_t total;                       // 잘린 부분 포함 전체 길이
+    void (*flush)(struct fmt_out* o);
+    void* ctx;
+} fmt_out_t;
+
+static void out_mem(fmt_out_t* o, const char* s, uint32_t n) {
+    o->total += n;
+    while (n) {
+        uint32_t room = o->cap - 1 - o->len;
+        if (room == 0) {
+            if (!o->flush) return;
+            o->flush(o);
+            continue;
+        }
+        uint32_t k = n < room ? n : room;
+        memcpy(o->buf + o->len, s, k);
+        o->len += k;
+        s += k;
+        n -= k;
+    }
+}
+
+static void out_pad(fmt_out_t* o, char c, int n) {
+    char tmp[16];
+    for (int i = 0; i < (int)sizeof(tmp); i++) tmp[i] = c;
+    while (n > 0) {
+        int k = n < (int)sizeof(tmp) ? n : (int)sizeof(tmp);
+        out_mem(o, tmp, (uint32_t)k);
+        n -= k;
+    }
+}
+
+#define FMT_LEFT  0x01   // '-'
+#define FMT_ZERO  0x02   // '0'
+#define FMT_PLUS  0x04   // '+'
+#define FMT_SPACE 0x08   // ' '
+#define FMT_ALT   0x10   // '#'
+
+// "00".."99": 나눗셈 한 번에 두 자리씩
+static const char g_digits2[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// end 바로 앞에서부터 거꾸로 채우고 시작 위치 반환
+static char* u32_to_dec(char* end, uint32_t v) {
+    while (v >= 100) {
+        uint32_t q = v / 100;
+        uint32_t r = (v - q * 100) * 2;
+        end -= 2;
+        end[0] = g_digits2[r];
+        end[1] = g_digits2[r + 1];
+        v = q;
+    }
+    if (v >= 10) {
+        end -= 2;
+        end[0] = g_digits2[v * 2];
+        end[1] = g_digits2[v * 2 + 1];
+    } else {
+        *--end = (char)('0' + v);
+    }
+    return end;
+}
+
+static char* u64_to_dec(char* end, uint64_t v) {
+    // 10^9 단위로 잘라 32비트 경로 재사용
+    while (v >> 32) {
+        uint32_t chunk = div_u64_u32(&v, 1000000000u);
+        char* p = u32_to_dec(end, chunk);
+        while (p > end - 9) *--p = '0';
+        end = p;
+    }
+    return u32_to_dec(end, (uint32_t)v);
+}
+
+static char* u64_to_hex(char* end, uint64_t v, int upper) {
+    const char* hex = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    do {
+        *--end = hex[v & 0xF];
+        v >>= 4;
+    } while (v);
+    return end;
+}
+
+// prefix(부호, 0x) + 정밀도 0 채움 + 숫자, 폭에 맞춰 공백/0 패딩
+static void out_number(fmt_out_t* o, const char* prefix, const char* digits, int ndig,
+                       int flags, int width, int prec) {
+    int plen = 0;
+    while (prefix[plen]) plen++;
+
+    int zeros = (prec > ndig) ? prec - ndig : 0;
+    int len = plen + zeros + ndig;
+
+    if ((flags & FMT_ZERO) && !(flags & FMT_LEFT) && prec < 0 && width > len) {
+        zeros += width - len;
+        len = width;
+    }
+
+    if (!(flags & FMT_LEFT)) out_pad(o, ' ', width - len);
+    out_mem(o, prefix, (uint32_t)plen);
+    out_pad(o, '0', zeros);
+    out_mem(o, digits, (uint32_t)ndig);
+    if (flags & FMT_LEFT) out_pad(o, ' ', width - len);
+}
+
+static void out_string(fmt_out_t* o, const char* s, int flags, int width, int prec) {
+    if (!s) s = "(null)";
+
+    int n = 0;
+    while (s[n] && (prec < 0 || n < prec)) n++;
+
+    if (!(flags & FMT_LEFT)) out_pad(o, ' ', width - n);
+    out_mem(o, s, (uint32_t)n);
+    if (flags & FMT_LEFT) out_pad(o, ' ', width - n);
+}
+
+// 지원: %[-0+ #][width|*][.prec|.*][hh|h|l|ll|z]{d,i,u,x,X,p,c,s,%}
+static void format(fmt_out_t* o, const char* fmt, va_list args) {
+    while (*fmt) {
+        // 일반 문자열 구간은 한 번에 복사
+        const char* lit = fmt;
+        while (*fmt && *fmt != '%') fmt++;
+        if (fmt != lit) out_mem(o, lit, (uint32_t)(fmt - lit));
+        if (!*fmt) break;
+
+        const char* spec = fmt++;   // '%'
+
+        int flags = 0;
+        for (;; fmt++) {
+            if (*fmt == '-') flags |= FMT_LEFT;
+            else if (*fmt == '0') flags |= FMT_ZERO;
+            else if (*fmt == '+') flags |= FMT_PLUS;
+            else if (*fmt == ' ') flags |= FMT_SPACE;
+            else if (*fmt == '#') flags |= FMT_ALT;
+            else break;
+        }
+
+        int width = 0;
+        if (*fmt == '*') {
+            width = va_arg(args, int);
+            if (width < 0) {
+                flags |= FMT_LEFT;
+                width = -width;
+            }
+            fmt++;
+        } else {
+            while (*fmt >= '0' && *fmt <= '9') width = width * 10 + (*fmt++ - '0');
+        }
+
+        int prec = -1;
+        if (*fmt == '.') {
+            fmt++;
+            prec = 0;
+            if (*fmt == '*') {
+                prec = va_arg(args, int);
+                if (prec < 0) prec = -1;
+                fmt++;
+            } else {
+                while (*fmt >= '0' && *fmt <= '9') prec = prec * 10 + (*fmt++ - '0');
+            }
+        }
+
+        int is64 = 0;
+        if (*fmt == 'l') {
+            fmt++;
+            if (*fmt == 'l') {
+                is64 = 1;
+                fmt++;
+            }
+        } else if (*fmt == 'h') {
+            fmt++;
+            if (*fmt == 'h') fmt++;
+        } else if (*fmt == 'z') {
+            fmt++;      // size_t == 32비트
+        }
+
+        char tmp[24];
+        char* end = tmp + sizeof(tmp);
+        char* digits;
+        const char* prefix = "";
+
+        switch (*fmt) {
+            case '%':
+                out_mem(o, "%", 1);
+                break;
+            case 'c': {
+                char c = (char)va_arg(args, int);
+                if (!(flags & FMT_LEFT)) out_pad(o, ' ', width - 1);
+                out_mem(o, &c, 1);
+                if (flags & FMT_LEFT) out_pad(o, ' ', width - 1);
+                break;
+            }
+            case 's':
+                out_string(o, va_arg(args, const char*), flags, width, prec);
+                break;
+            case 'd':
+            case 'i': {
+                int64_t v = is64 ? va_arg(args, int64_t) : (int64_t)va_arg(args, int32_t);
+                // INT64_MIN도 안전하게: 부호 없는 2의 보수 절댓값
+                uint64_t uv = (v < 0) ? (uint64_t)0 - (uint64_t)v : (uint64_t)v;
+                if (v < 0) prefix = "-";
+                else if (flags & FMT_PLUS) prefix = "+";
+                else if (flags & FMT_SPACE) prefix = " ";
+                digits = (uv == 0 && prec == 0) ? end : u64_to_dec(end, uv);
+                out_number(o, prefix, digits, (int)(end - digits), flags, width, prec);
+                break;
+            }
+            case 'u': {
+                uint64_t v = is64 ? va_arg(args, uint64_t) : (uint64_t)va_arg(args, uint32_t);
+                digits = (v == 0 && prec == 0) ? end : u64_to_dec(end, v);
+                out_number(o, prefix, digits, (int)(end - digits), flags, width, prec);
+                break;
+            }
+            case 'x':
+            case 'X': {
+                uint64_t v = is64 ? va_arg(args, uint64_t) : (uint64_t)va_arg(args, uint32_t);
+                if ((flags & FMT_ALT) && v) prefix = (*fmt == 'X') ? "0X" : "0x";
+                digits = (v == 0 && prec == 0) ? end : u64_to_hex(end, v, *fmt == 'X');
+                out_number(o, prefix, digits, (int)(end - digits), flags, width, prec);
+                break;
+            }
+            case 'p': {
+                // 항상 0x + 8자리 (주소 정렬 비교가 쉽도록)
+                uint32_t v = (uint32_t)va_arg(args, void*);
+                digits = u64_to_hex(end, v, 0);
+                out_number(o, "0x", digits, (int)(end - digits), flags, width, prec < 0 ? 8 : prec);
+                break;
+            }
+            default:
+                // 알 수 없는 포맷은 그대로 출력해 디버깅 가능하게
+                if (!*fmt) {
+                    out_mem(o, spec, (uint32_t)(fmt - spec));
+                    continue;
+                }
+                out_mem(o, spec, (uint32_t)(fmt - spec + 1));
+                break;
+        }
+        fmt++;
+    }
+}
+
+int kvsnprintf(char* buf, size_t size, const char* fmt, va_list args) {
+    char dummy;
+    fmt_out_t o;
+    o.buf = (size > 0) ? buf : &dummy;
+    o.cap = (size > 0) ? (uint32_t)size : 1;
+    o.len = 0;
+    o.total = 0;
+    o.flush = 0;
+    o.ctx = 0;
+
+    format(&o, fmt, args);
+    o.buf[o.len] = 0;
+    return (int)o.total;
+}
+
+int ksnprintf(char* buf, size_t size, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int n = kvsnprintf(buf, size, fmt, args);
+    va_end(args);
+    return n;
+}
+
+// 콘솔 sink: 한 줄은 보통 스택 버퍼 하나에 들어가므로 포맷은 lock 없이 하고,
+// 버퍼가 넘칠 때(긴 출력)만 그 시점부터 lock을 잡고 중간 flush 한다.
+typedef struct {
+    int locked;
+    uint32_t flags;
+} console_ctx_t;
+
+static void console_flush(fmt_out_t* o) {
+    console_ctx_t* c = (console_ctx_t*)o->ctx;
+    if (!c->locked) {
+        c->flags = lock();
+        c->locked = 1;
+    }
+    console_write(o->buf, o->len);
+    o->len = 0;
+}
+
+void kvprintf(const char* fmt, va_list args) {
+    char buf[KPRINTF_BUF_SIZE];
+    console_ctx_t ctx = { 0, 0 };
+    fmt_out_t o;
+    o.buf = buf;
+    o.cap = sizeof(buf);
+    o.len = 0;
+    o.total = 0;
+    o.flush = console_flush;
+    o.ctx = &ctx;
+
+    format(&o, fmt, args);
+    console_flush(&o);
+    unlock(ctx.flags);
+}
+
+void kprintf(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    kvprintf(fmt, args);
+    va_end(args);
+}
+
+void kputs(const char* s) {
+    uint32_t flags = lock();
+    kout_str(s);
+    kout_str("\n");
+    unlock(flags);
+}
+
+uint32_t klog_copy(char* buf, uint32_t size) {
+    if (size == 0) return 0;
+
+    uint32_t flags = lock();
+    uint32_t n = g_klog_pos < KLOG_SIZE ? g_klog_pos : KLOG_SIZE;
+    if (n > size - 1) n = size - 1;
+
+    uint32_t start = (g_klog_pos - n) & (KLOG_SIZE - 1);
+    uint32_t first = KLOG_SIZE - start;
+    if (first > n) first = n;
+    memcpy(buf, g_klog + start, first);
+    memcpy(buf + first, g_klog, n - first);
+    unlock(flags);
+
+    buf[n] = 0;
+    return n;
+}
+
+uint32_t klog_total(void) {
+    return g_klog_pos;
+}
+
+void kprintf_set_cursor(int x, int y) {
+    if (fbcon_active()) {
+        fbcon_set_cursor(x, y);
+        return;
+    }
+    if (x < 0) x = 0; if (x >= VGA_W) x = VGA_W - 1;
+    if (y < 0) y = 0; if (y >= VGA_H) y = VGA_H - 1;
+    cur_x = x;
+    cur_y = y;
+}
+
+void kprintf_clear_console(void) {
+    if (fbcon_active()) {
+        fbcon_clear();
+        return;
+    }
+    memsetw(VGA_MEM, ((uint16_t)vga_attr << 8) | ' ', VGA_W * VGA_H);
+    cur_x = 0;
+    cur_y = 0;
+}
+
+void kprintf_puts_at(int row, int col, const char* s) {
+    // 커서 위치 저장
+    int old_x = cur_x;
+    int old_y = cur_y;
+    
+    // 새 위치 설정
+    kprintf_set_cursor(col, row);
+    
+    // 문자열 출력
+    kout_str(s);
+    
+    // 원래 커서 위치 복원 (선택적, 필요하면 주석 처리)
+    // cur_x = old_x;
+    // cur_y = old_y;
 }
\ No newline at end of file
@@ -1,14 +1,36 @@
-#pragma once
-#include <stdarg.h>
-
-void kprintf(const char* fmt, ...);
-void kvprintf(const char* fmt, va_list args);
-
-// 옵션: 로그 레벨용(원하면 나중에 사용)
-void kputs(const char* s);
-
-void kprintf_set_cursor(int x, int y);
-void kprintf_clear_console(void);
-
-// 특정 위치에 문자열 출력 (vga_puts_at 대체)
+#pragma once
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 지원 포맷: %[-0+ #][width|*][.prec|.*][hh|h|l|ll|z]{d,i,u,x,X,p,c,s,%}
+// (%x는 접두사 없는 소문자 hex, %p는 0x + 8자리)
+
+// kprintf 한 번의 출력을 모으는 스택 버퍼 크기 (넘치면 lock을 잡고 중간 flush)
+#define KPRINTF_BUF_SIZE 256
+
+void kprintf(const char* fmt, ...);
+void kvprintf(const char* fmt, va_list args);
+
+// 콘솔을 건드리지 않고 buf에 포맷 (항상 NUL 종료, 잘렸더라도 전체 길이 반환)
+// lock/IRQ 상태와 무관하게 어디서나 호출 가능
+int ksnprintf(char* buf, size_t size, const char* fmt, ...);
+int kvsnprintf(char* buf, size_t size, const char* fmt, va_list args);
+
+// 커널 로그 ring: 콘솔로 나간 출력의 마지막 KLOG_SIZE 바이트 (2의 거듭제곱)
+#define KLOG_SIZE 8192
+
+// 최근 로그를 buf에 복사 (최대 size-1 바이트, 항상 NUL 종료). 복사한 길이 반환
+uint32_t klog_copy(char* buf, uint32_t size);
+
+// 부팅 이후 로그로 나간 전체 바이트 수
+uint32_t klog_total(void);
+
+// 옵션: 로그 레벨용(원하면 나중에 사용)
+void kputs(const char* s);
+
+void kprintf_set_cursor(int x, int y);
+void kprintf_clear_console(void);
+
+// 특정 위치에 문자열 출력 (vga_puts_at 대체)
 void kprintf_puts_at(int row, int col, const char* s);
\ No newline at end of file
@@ -0,0 +1,907 @@
+#include "fat32.h"
+#include "../memory/heap.h"
+#include "../lib/errno.h"
+#include "../lib/string.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/tsc.h"
+
+typedef struct fat_bpb {
+    uint8_t jmp[3];
+    char oem[8];
+    uint16_t bytes_per_sector;
+    uint8_t sec_per_clus;
+    uint16_t reserved_sectors;
+    uint8_t num_fats;
+    uint16_t root_entries;          // FAT32는 0
+    uint16_t total16;
+    uint8_t media;
+    uint16_t fat_size16;            // FAT32는 0
+    uint16_t sec_per_track;
+    uint16_t heads;
+    uint32_t hidden;
+    uint32_t total32;
+    uint32_t fat_size32;
+    uint16_t ext_flags;
+    uint16_t version;
+    uint32_t root_cluster;
+    uint16_t fsinfo_sector;
+    uint16_t backup_boot;
+    uint8_t reserved[12];
+    uint8_t drive;
+    uint8_t reserved1;
+    uint8_t boot_sig;               // 0x29
+    uint32_t volume_id;
+    char label[11];
+    char fs_type[8];
+} __attribute__((packed)) fat_bpb_t;
+
+typedef struct fat_dirent {
+    char name[11];                  // 8.3, 공백 채움
+    uint8_t attr;
+    uint8_t nt_res;
+    uint8_t crt_time_tenth;
+    uint16_t crt_time;
+    uint16_t crt_date;
+    uint16_t acc_date;
+    uint16_t cluster_hi;
+    uint16_t wrt_time;
+    uint16_t wrt_date;
+    uint16_t cluster_lo;
+    uint32_t size;
+} __attribute__((packed)) fat_dirent_t;
+
+#define DIRENT_SIZE     32u
+#define DIRENT_FREE     0xE5
+#define FSINFO_LEAD     0x41615252u
+#define FSINFO_STRUCT   0x61417272u
+#define FSINFO_TRAIL    0xAA550000u
+#define FAT_RESERVED    32u
+#define FAT_NUM_FATS    2u
+#define FAT_BACKUP_BOOT 6u
+// RTC가 없어 고정 날짜 (2025-01-01 00:00)
+#define FAT_DATE_DEFAULT ((45u << 9) | (1u << 5) | 1u)
+
+// 열린 파일
+typedef struct fat_file {
+    fat32_fs_t* fs;
+    uint32_t first;                 // 첫 클러스터 (0 = 빈 파일)
+    uint32_t last;                  // 마지막 클러스터
+    uint32_t nclusters;
+    uint64_t dirent_pos;            // 디렉터리 엔트리의 장치 바이트 위치
+    uint32_t meta_dirty;            // 크기/첫 클러스터를 엔트리에 아직 안 씀
+    uint32_t pos_index;             // 마지막으로 찾은 (클러스터 순번, 번호): 순차 접근 시 체인을 처음부터 안 따라감
+    uint32_t pos_cluster;
+} fat_file_t;
+
+// 경로 탐색 결과
+typedef struct fat_walk {
+    int is_root;                    // 경로가 루트 자체
+    uint32_t parent;                // 마지막 구성요소가 들어 있는 디렉터리 클러스터
+    char name[11];
+    int found;
+    fat_dirent_t ent;
+    uint64_t pos;
+} fat_walk_t;
+
+static const file_ops_t g_fat_file_ops;
+
+// -------------------------
+// 비트맵 / FAT
+// -------------------------
+static inline int bit_test(const uint32_t* map, uint32_t i) {
+    return (map[i >> 5] >> (i & 31)) & 1;
+}
+
+static inline void bit_set(uint32_t* map, uint32_t i) {
+    map[i >> 5] |= 1u << (i & 31);
+}
+
+static inline void bit_clear(uint32_t* map, uint32_t i) {
+    map[i >> 5] &= ~(1u << (i & 31));
+}
+
+static inline uint64_t sector_pos(uint32_t lba) {
+    return (uint64_t)lba * SECTOR_SIZE;
+}
+
+static inline uint64_t cluster_pos(const fat32_fs_t* fs, uint32_t c) {
+    return sector_pos(fs->data_start + (c - 2) * fs->sec_per_clus);
+}
+
+static inline int cluster_valid(const fat32_fs_t* fs, uint32_t c) {
+    return c >= 2 && c < fs->nr_clusters + 2;
+}
+
+static inline uint32_t fat_get(const fat32_fs_t* fs, uint32_t c) {
+    return fs->fat[c] & FAT32_MASK;
+}
+
+static inline uint32_t dirent_cluster(const fat_dirent_t* e) {
+    return ((uint32_t)e->cluster_hi << 16) | e->cluster_lo;
+}
+
+static inline void dirent_set_cluster(fat_dirent_t* e, uint32_t c) {
+    e->cluster_hi = (uint16_t)(c >> 16);
+    e->cluster_lo = (uint16_t)c;
+}
+
+// 상위 4비트는 보존 (예약)
+static void fat_set(fat32_fs_t* fs, uint32_t c, uint32_t v) {
+    fs->fat[c] = (fs->fat[c] & ~FAT32_MASK) | (v & FAT32_MASK);
+    bit_set(fs->fat_dirty, c / (SECTOR_SIZE / 4));
+
+    if (v == 0 && bit_test(fs->used_map, c)) {
+        bit_clear(fs->used_map, c);
+        fs->free_count++;
+    } else if (v != 0 && !bit_test(fs->used_map, c)) {
+        bit_set(fs->used_map, c);
+        fs->free_count--;
+    }
+}
+
+// 바뀐 FAT 섹터를 모든 FAT 사본에 (캐시로) + FSInfo 힌트 갱신
+static int fat_writeback(fat32_fs_t* fs) {
+    uint32_t nsec = ((fs->nr_clusters + 2) * 4 + SECTOR_SIZE - 1) / SECTOR_SIZE;
+    int any = 0;
+
+    for (uint32_t s = 0; s < nsec; s++) {
+        if (!bit_test(fs->fat_dirty, s)) continue;
+        bit_clear(fs->fat_dirty, s);
+        any = 1;
+        const uint8_t* src = (const uint8_t*)fs->fat + s * SECTOR_SIZE;
+        for (uint32_t k = 0; k < fs->num_fats; k++) {
+            int rc = bcache_write(fs->bc, sector_pos(fs->fat_start + k * fs->fat_sectors + s), SECTOR_SIZE, src);
+            if (rc) return rc;
+        }
+    }
+    if (!any || !fs->fsinfo_sector || fs->fsinfo_sector >= fs->fat_start) return 0;
+
+    uint32_t info[2] = { fs->free_count, fs->next_free };
+    return bcache_write(fs->bc, sector_pos(fs->fsinfo_sector) + 488, sizeof(info), info);
+}
+
+// start부터 (끝에서 처음으로 돌아) 첫 빈 클러스터. 없으면 0
+static uint32_t find_free(const fat32_fs_t* fs, uint32_t start) {
+    uint32_t end = fs->nr_clusters + 2;
+    if (start < 2 || start >= end) start = 2;
+
+    for (int pass = 0; pass < 2; pass++) {
+        uint32_t c = pass ? 2 : start;
+        uint32_t stop = pass ? start : end;
+        while (c < stop) {
+            // 꽉 찬 word는 한 번에 건너뜀
+            if ((c & 31) == 0 && fs->used_map[c >> 5] == 0xFFFFFFFFu) {
+                c += 32;
+                continue;
+            }
+            if (!bit_test(fs->used_map, c)) return c;
+            c++;
+        }
+    }
+    return 0;
+}
+
+// n개를 할당해 prev(0이면 새 체인) 뒤에 잇는다. 가능한 한 연속 구간으로
+static int alloc_clusters(fat32_fs_t* fs, uint32_t n, uint32_t prev, uint32_t* first, uint32_t* last) {
+    if (n > fs->free_count) return -ENOSPC;
+    fs->alloc_calls++;
+
+    uint32_t end = fs->nr_clusters + 2;
+    uint32_t tail = prev, c = fs->next_free, got = 0;
+    *first = 0;
+    while (got < n) {
+        c = find_free(fs, c);
+        if (!c) return -ENOSPC;
+
+        uint32_t run = 1;
+        while (got + run < n && c + run < end && !bit_test(fs->used_map, c + run)) run++;
+        for (uint32_t i = 0; i < run; i++) {
+            fat_set(fs, c + i, i + 1 < run ? c + i + 1 : FAT32_MASK);
+        }
+        if (tail) fat_set(fs, tail, c);
+        if (!*first) *first = c;
+
+        tail = c + run - 1;
+        got += run;
+        c += run;
+        fs->alloc_runs++;
+    }
+    fs->next_free = tail + 1 < end ? tail + 1 : 2;
+    *last = tail;
+    return 0;
+}
+
+static void free_chain(fat32_fs_t* fs, uint32_t c) {
+    while (cluster_valid(fs, c)) {
+        uint32_t next = fat_get(fs, c);
+        fat_set(fs, c, 0);
+        c = next;
+    }
+}
+
+static int zero_cluster(fat32_fs_t* fs, uint32_t c) {
+    uint8_t zero[SECTOR_SIZE];
+    memset(zero, 0, sizeof(zero));
+    for (uint32_t s = 0; s < fs->sec_per_clus; s++) {
+        int rc = bcache_write(fs->bc, cluster_pos(fs, c) + s * SECTOR_SIZE, SECTOR_SIZE, zero);
+        if (rc) return rc;
+    }
+    return 0;
+}
+
+// -------------------------
+// 이름 / 디렉터리
+// -------------------------
+static int name_char_ok(char c) {
+    if (c <= ' ' || c == 0x7F) return 0;
+    const char* bad = "\"*+,/:;<=>?[\\]|";
+    for (; *bad; bad++) {
+        if (c == *bad) return 0;
+    }
+    return 1;
+}
+
+static char upper(char c) {
+    return (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c;
+}
+
+// 경로 구성요소 [s, s+len) → 8.3 (공백 채움)
+static int to_83(const char* s, uint32_t len, char out[11]) {
+    memset(out, ' ', 11);
+    if (len == 1 && s[0] == '.') {
+        out[0] = '.';
+        return 0;
+    }
+    if (len == 2 && s[0] == '.' && s[1] == '.') {
+        out[0] = out[1] = '.';
+        return 0;
+    }
+
+    uint32_t dot = len;
+    for (uint32_t i = 0; i < len; i++) {
+        if (s[i] == '.') dot = i;
+    }
+    uint32_t ext_len = dot < len ? len - dot - 1 : 0;
+    if (dot == 0 || dot > 8 || ext_len > 3) return -EINVAL;
+
+    for (uint32_t i = 0; i < dot; i++) {
+        if (!name_char_ok(s[i])) return -EINVAL;
+        out[i] = upper(s[i]);
+    }
+    for (uint32_t i = 0; i < ext_len; i++) {
+        if (!name_char_ok(s[dot + 1 + i])) return -EINVAL;
+        out[8 + i] = upper(s[dot + 1 + i]);
+    }
+    if ((uint8_t)out[0] == DIRENT_FREE) out[0] = 0x05;      // 0xE5로 시작하는 이름의 규약
+    return 0;
+}
+
+// 8.3 → "NAME.EXT"
+static void from_83(const char* n, char out[13]) {
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < 8 && n[i] != ' '; i++) out[k++] = (i == 0 && n[i] == 0x05) ? (char)DIRENT_FREE : n[i];
+    if (n[8] != ' ') {
+        out[k++] = '.';
+        for (uint32_t i = 8; i < 11 && n[i] != ' '; i++) out[k++] = n[i];
+    }
+    out[k] = 0;
+}
+
+// 디렉터리 엔트리를 차례로 훑는다. visit이 1을 반환하면 멈추고 1, 끝(이름 첫 바이트 0)이나
+// 체인 끝이면 0, I/O 오류는 -errno
+typedef int (*dir_visit_t)(fat32_fs_t* fs, fat_dirent_t* e, uint64_t pos, void* arg);
+
+static int dir_scan(fat32_fs_t* fs, uint32_t dir, dir_visit_t visit, void* arg) {
+    fat_dirent_t sec[SECTOR_SIZE / DIRENT_SIZE];
+
+    for (uint32_t c = dir; cluster_valid(fs, c); c = fat_get(fs, c)) {
+        for (uint32_t s = 0; s < fs->sec_per_clus; s++) {
+            uint64_t base = cluster_pos(fs, c) + s * SECTOR_SIZE;
+            int rc = bcache_read(fs->bc, base, SECTOR_SIZE, sec);
+            if (rc) return rc;
+            for (uint32_t i = 0; i < SECTOR_SIZE / DIRENT_SIZE; i++) {
+                int r = visit(fs, &sec[i], base + i * DIRENT_SIZE, arg);
+                if (r) return r;
+            }
+        }
+    }
+    return 0;
+}
+
+typedef struct find_arg {
+    const char* name;
+    fat_dirent_t* out;
+    uint64_t* pos;
+} find_arg_t;
+
+static int visit_find(fat32_fs_t* fs, fat_dirent_t* e, uint64_t pos, void* arg) {
+    (void)fs;
+    find_arg_t* a = (find_arg_t*)arg;
+    if (e->name[0] == 0) return -ENOENT;
+    if ((uint8_t)e->name[0] == DIRENT_FREE || e->attr == FAT_ATTR_LFN || (e->attr & FAT_ATTR_VOLUME_ID)) return 0;
+    if (memcmp(e->name, a->name, 11) != 0) return 0;
+    *a->out = *e;
+    *a->pos = pos;
+    return 1;
+}
+
+static int dir_find(fat32_fs_t* fs, uint32_t dir, const char* name, fat_dirent_t* out, uint64_t* pos) {
+    find_arg_t a = { name, out, pos };
+    int r = dir_scan(fs, dir, visit_find, &a);
+    return r == 1 ? 0 : (r ? r : -ENOENT);
+}
+
+static int visit_free_slot(fat32_fs_t* fs, fat_dirent_t* e, uint64_t pos, void* arg) {
+    (void)fs;
+    if (e->name[0] != 0 && (uint8_t)e->name[0] != DIRENT_FREE) return 0;
+    *(uint64_t*)arg = pos;
+    return 1;
+}
+
+// 디렉터리 dir에 엔트리 추가 (빈 슬롯이 없으면 클러스터 하나를 이어 붙임)
+static int dir_add(fat32_fs_t* fs, uint32_t dir, const fat_dirent_t* e, uint64_t* out_pos) {
+    uint64_t pos;
+    int r = dir_scan(fs, dir, visit_free_slot, &pos);
+    if (r < 0) return r;
+
+    if (r == 0) {
+        uint32_t last = dir;
+        while (cluster_valid(fs, fat_get(fs, last))) last = fat_get(fs, last);
+        uint32_t first, tail;
+        r = alloc_clusters(fs, 1, last, &first, &tail);
+        if (r) return r;
+        r = zero_cluster(fs, tail);
+        if (r) return r;
+        pos = cluster_pos(fs, tail);
+    }
+    *out_pos = pos;
+    return bcache_write(fs->bc, pos, DIRENT_SIZE, e);
+}
+
+static int walk(fat32_fs_t* fs, const char* path, fat_walk_t* w) {
+    memset(w, 0, sizeof(*w));
+    w->parent = fs->root_cluster;
+
+    const char* p = path;
+    while (*p == '/') p++;
+    if (!*p) {
+        w->is_root = 1;
+        return 0;
+    }
+
+    uint32_t dir = fs->root_cluster;
+    for (;;) {
+        const char* s = p;
+        while (*p && *p != '/') p++;
+        uint32_t len = (uint32_t)(p - s);
+        while (*p == '/') p++;
+        int last = *p == 0;
+
+        char name[11];
+        int rc = to_83(s, len, name);
+        if (rc) return rc;
+
+        fat_dirent_t e;
+        uint64_t pos;
+        rc = dir_find(fs, dir, name, &e, &pos);
+        if (last) {
+            w->parent = dir;
+            memcpy(w->name, name, 11);
+            if (rc == 0) {
+                w->found = 1;
+                w->ent = e;
+                w->pos = pos;
+            }
+            return rc == -ENOENT ? 0 : rc;
+        }
+        if (rc) return rc;
+        if (!(e.attr & FAT_ATTR_DIRECTORY)) return -ENOTDIR;
+        // ".."가 루트를 가리키면 0으로 저장된다
+        dir = dirent_cluster(&e) ? dirent_cluster(&e) : fs->root_cluster;
+    }
+}
+
+static void dirent_init(fat_dirent_t* e, const char* name, uint8_t attr, uint32_t cluster) {
+    memset(e, 0, sizeof(*e));
+    memcpy(e->name, name, 11);
+    e->attr = attr;
+    e->crt_date = e->wrt_date = e->acc_date = FAT_DATE_DEFAULT;
+    dirent_set_cluster(e, cluster);
+}
+
+// -------------------------
+// 파일
+// -------------------------
+
+// index번째 클러스터 번호 (체인 밖이면 0)
+static uint32_t file_cluster(fat_file_t* ff, uint32_t index) {
+    fat32_fs_t* fs = ff->fs;
+    uint32_t i = 0, c = ff->first;
+    if (ff->pos_cluster && index >= ff->pos_index) {
+        i = ff->pos_index;
+        c = ff->pos_cluster;
+    }
+    while (i < index && cluster_valid(fs, c)) {
+        c = fat_get(fs, c);
+        i++;
+    }
+    if (!cluster_valid(fs, c)) return 0;
+    ff->pos_index = index;
+    ff->pos_cluster = c;
+    return c;
+}
+
+// 엔트리에 크기/첫 클러스터 반영 (캐시로)
+static int update_dirent(file_t* f) {
+    fat_file_t* ff = (fat_file_t*)f->priv;
+    if (!ff->meta_dirty) return 0;
+
+    fat_dirent_t e;
+    int rc = bcache_read(ff->fs->bc, ff->dirent_pos, DIRENT_SIZE, &e);
+    if (rc) return rc;
+    dirent_set_cluster(&e, ff->first);
+    e.size = (uint32_t)f->size;
+    e.wrt_date = FAT_DATE_DEFAULT;
+    e.attr |= FAT_ATTR_ARCHIVE;
+    rc = bcache_write(ff->fs->bc, ff->dirent_pos, DIRENT_SIZE, &e);
+    if (rc == 0) ff->meta_dirty = 0;
+    return rc;
+}
+
+// [off, off+len)를 연속 클러스터 단위로 나눠 캐시에 read/write
+static int32_t file_io(file_t* f, uint8_t* buf, uint32_t len, uint32_t off, int write) {
+    fat_file_t* ff = (fat_file_t*)f->priv;
+    fat32_fs_t* fs = ff->fs;
+    uint32_t cs = fs->cluster_size;
+    uint32_t done = 0;
+
+    while (done < len) {
+        uint32_t o = off + done;
+        uint32_t idx = o / cs;
+        uint32_t in = o & (cs - 1);
+        uint32_t c = file_cluster(ff, idx);
+        if (!c) return -EIO;
+
+        // 장치에서도 이어지는 클러스터는 한 번에
+        uint32_t span = cs - in, cc = c, ci = idx;
+        while (span < len - done && fat_get(fs, cc) == cc + 1) {
+            cc++;
+            ci++;
+            span += cs;
+        }
+        uint32_t n = span < len - done ? span : len - done;
+        int rc = write ? bcache_write(fs->bc, cluster_pos(fs, c) + in, n, buf + done)
+                       : bcache_read(fs->bc, cluster_pos(fs, c) + in, n, buf + done);
+        if (rc) return rc;
+        ff->pos_index = ci;
+        ff->pos_cluster = cc;
+        done += n;
+    }
+    return (int32_t)len;
+}
+
+static int32_t fat_file_read(file_t* f, void* buf, uint32_t len, uint64_t off) {
+    fat_file_t* ff = (fat_file_t*)f->priv;
+    if (off >= f->size) return 0;
+    uint32_t avail = (uint32_t)(f->size - off);
+    if (len > avail) len = avail;
+
+    mutex_lock(&ff->fs->lock);
+    int32_t r = file_io(f, (uint8_t*)buf, len, (uint32_t)off, 0);
+    mutex_unlock(&ff->fs->lock);
+    return r;
+}
+
+// 클러스터 체인을 end 바이트까지 늘림
+static int grow(file_t* f, uint32_t end) {
+    fat_file_t* ff = (fat_file_t*)f->priv;
+    fat32_fs_t* fs = ff->fs;
+    uint32_t need = (end + fs->cluster_size - 1) / fs->cluster_size;
+    if (need <= ff->nclusters) return 0;
+
+    uint32_t first, last;
+    int rc = alloc_clusters(fs, need - ff->nclusters, ff->last, &first, &last);
+    if (rc) return rc;
+    if (!ff->first) ff->first = first;
+    ff->last = last;
+    ff->nclusters = need;
+    ff->meta_dirty = 1;
+    return 0;
+}
+
+static int32_t fat_file_write(file_t* f, const void* buf, uint32_t len, uint64_t off) {
+    fat_file_t* ff = (fat_file_t*)f->priv;
+    fat32_fs_t* fs = ff->fs;
+    if (off + len > 0xFFFFFFFFull) return -EFBIG;
+    uint32_t o = (uint32_t)off;
+
+    mutex_lock(&fs->lock);
+    int32_t r = grow(f, o + len);
+
+    // 파일 끝 너머에서 시작하면 사이를 0으로 (FAT에는 구멍이 없다)
+    uint8_t zero[SECTOR_SIZE];
+    if (r == 0 && o > f->size) memset(zero, 0, sizeof(zero));
+    while (r == 0 && o > f->size) {
+        uint32_t gap = o - (uint32_t)f->size;
+        uint32_t n = gap < SECTOR_SIZE ? gap : SECTOR_SIZE;
+        r = file_io(f, zero, n, (uint32_t)f->size, 1);
+        if (r > 0) {
+            f->size += n;
+            r = 0;
+        }
+    }
+
+    if (r == 0) r = file_io(f, (uint8_t*)buf, len, o, 1);
+    if (r > 0 && o + len > f->size) {
+        f->size = o + len;
+        ff->meta_dirty = 1;
+    }
+    if (r >= 0) {
+        int rc = update_dirent(f);
+        if (rc == 0) rc = fat_writeback(fs);
+        if (rc) r = rc;
+    }
+    mutex_unlock(&fs->lock);
+    return r;
+}
+
+// fsync: 이 파일만이 아니라 장치 캐시 전체를 반영한다 (FAT/디렉터리도 함께 일관되게)
+static int32_t fat_file_sync(file_t* f, uint64_t off, uint32_t len) {
+    (void)off;
+    (void)len;
+    fat_file_t* ff = (fat_file_t*)f->priv;
+
+    mutex_lock(&ff->fs->lock);
+    int rc = update_dirent(f);
+    if (rc == 0) rc = fat_writeback(ff->fs);
+    mutex_unlock(&ff->fs->lock);
+    if (rc) return rc;
+    return bcache_sync(ff->fs->bc);
+}
+
+static void fat_file_release(file_t* f) {
+    fat_file_t* ff = (fat_file_t*)f->priv;
+    fat32_fs_t* fs = ff->fs;
+
+    mutex_lock(&fs->lock);
+    if (update_dirent(f) == 0) fat_writeback(fs);
+    fs->open_files--;
+    mutex_unlock(&fs->lock);
+    kfree(ff);
+}
+
+static const file_ops_t g_fat_file_ops = {
+    .read = fat_file_read,
+    .write = fat_file_write,
+    .release = fat_file_release,
+    .sync = fat_file_sync,
+};
+
+file_t* fat32_open(fat32_fs_t* fs, const char* path, uint32_t flags, int* err) {
+    fat_walk_t w;
+    int rc;
+
+    mutex_lock(&fs->lock);
+    rc = walk(fs, path, &w);
+    if (rc == 0 && (w.is_root || (w.found && (w.ent.attr & FAT_ATTR_DIRECTORY)))) rc = -EISDIR;
+    if (rc == 0 && !w.found && !(flags & FAT_O_CREAT)) rc = -ENOENT;
+    if (rc == 0 && !w.found) {
+        dirent_init(&w.ent, w.name, FAT_ATTR_ARCHIVE, 0);
+        rc = dir_add(fs, w.parent, &w.ent, &w.pos);
+    }
+    if (rc == 0 && (flags & FAT_O_TRUNC) && (w.ent.size || dirent_cluster(&w.ent))) {
+        free_chain(fs, dirent_cluster(&w.ent));
+        dirent_set_cluster(&w.ent, 0);
+        w.ent.size = 0;
+        rc = bcache_write(fs->bc, w.pos, DIRENT_SIZE, &w.ent);
+    }
+    if (rc == 0) rc = fat_writeback(fs);
+    if (rc) {
+        mutex_unlock(&fs->lock);
+        if (err) *err = rc;
+        return 0;
+    }
+
+    fat_file_t* ff = (fat_file_t*)kmalloc(sizeof(fat_file_t));
+    memset(ff, 0, sizeof(*ff));
+    ff->fs = fs;
+    ff->first = dirent_cluster(&w.ent);
+    ff->dirent_pos = w.pos;
+    for (uint32_t c = ff->first; cluster_valid(fs, c); c = fat_get(fs, c)) {
+        ff->last = c;
+        ff->nclusters++;
+    }
+    fs->open_files++;
+    mutex_unlock(&fs->lock);
+
+    char name[13];
+    from_83(w.name, name);
+    if (err) *err = 0;
+    return file_alloc(name, &g_fat_file_ops, ff, w.ent.size);
+}
+
+int fat32_mkdir(fat32_fs_t* fs, const char* path) {
+    fat_walk_t w;
+
+    mutex_lock(&fs->lock);
+    int rc = walk(fs, path, &w);
+    if (rc == 0 && (w.is_root || w.found)) rc = -EEXIST;
+
+    uint32_t c = 0, last;
+    if (rc == 0) rc = alloc_clusters(fs, 1, 0, &c, &last);
+    if (rc == 0) rc = zero_cluster(fs, c);
+    if (rc == 0) {
+        // "."과 ".." (부모가 루트면 0)
+        fat_dirent_t dots[2];
+        char dot[11], dotdot[11];
+        to_83(".", 1, dot);
+        to_83("..", 2, dotdot);
+        dirent_init(&dots[0], dot, FAT_ATTR_DIRECTORY, c);
+        dirent_init(&dots[1], dotdot, FAT_ATTR_DIRECTORY, w.parent == fs->root_cluster ? 0 : w.parent);
+        rc = bcache_write(fs->bc, cluster_pos(fs, c), sizeof(dots), dots);
+    }
+    if (rc == 0) {
+        dirent_init(&w.ent, w.name, FAT_ATTR_DIRECTORY, c);
+        rc = dir_add(fs, w.parent, &w.ent, &w.pos);
+    }
+    if (rc && c && rc != -EEXIST) free_chain(fs, c);
+    int wb = fat_writeback(fs);
+    mutex_unlock(&fs->lock);
+    return rc ? rc : wb;
+}
+
+int fat32_unlink(fat32_fs_t* fs, const char* path) {
+    fat_walk_t w;
+
+    mutex_lock(&fs->lock);
+    int rc = walk(fs, path, &w);
+    if (rc == 0 && (w.is_root || (w.found && (w.ent.attr & FAT_ATTR_DIRECTORY)))) rc = -EISDIR;
+    if (rc == 0 && !w.found) rc = -ENOENT;
+    if (rc == 0) {
+        free_chain(fs, dirent_cluster(&w.ent));
+        uint8_t mark = DIRENT_FREE;
+        rc = bcache_write(fs->bc, w.pos, 1, &mark);
+    }
+    if (rc == 0) rc = fat_writeback(fs);
+    mutex_unlock(&fs->lock);
+    return rc;
+}
+
+static int visit_print(fat32_fs_t* fs, fat_dirent_t* e, uint64_t pos, void* arg) {
+    (void)fs;
+    (void)pos;
+    (void)arg;
+    if (e->name[0] == 0) return 1;
+    if ((uint8_t)e->name[0] == DIRENT_FREE || e->attr == FAT_ATTR_LFN || (e->attr & FAT_ATTR_VOLUME_ID)) return 0;
+
+    char name[13];
+    from_83(e->name, name);
+    if (e->attr & FAT_ATTR_DIRECTORY) kprintf("  %-12s  <DIR>       cluster %u\n", name, dirent_cluster(e));
+    else kprintf("  %-12s  %10u  cluster %u\n", name, e->size, dirent_cluster(e));
+    return 0;
+}
+
+int fat32_ls(fat32_fs_t* fs, const char* path) {
+    fat_walk_t w;
+
+    mutex_lock(&fs->lock);
+    int rc = walk(fs, path, &w);
+    uint32_t dir = fs->root_cluster;
+    if (rc == 0 && !w.is_root) {
+        if (!w.found) rc = -ENOENT;
+        else if (!(w.ent.attr & FAT_ATTR_DIRECTORY)) rc = -ENOTDIR;
+        else if (dirent_cluster(&w.ent)) dir = dirent_cluster(&w.ent);
+    }
+    if (rc == 0) {
+        kprintf("[FAT32] %s:%s\n", fs->dev->name, path);
+        int r = dir_scan(fs, dir, visit_print, 0);
+        if (r < 0) rc = r;
+    }
+    mutex_unlock(&fs->lock);
+    return rc;
+}
+
+int fat32_sync(fat32_fs_t* fs) {
+    mutex_lock(&fs->lock);
+    int rc = fat_writeback(fs);
+    mutex_unlock(&fs->lock);
+    if (rc) return rc;
+    return bcache_sync(fs->bc);
+}
+
+bcache_t* fat32_bcache(fat32_fs_t* fs) {
+    return fs->bc;
+}
+
+// -------------------------
+// format / mount
+// -------------------------
+static int write_zero(blockdev_t* dev, uint32_t lba, uint32_t count, const uint8_t* zero, uint32_t zero_sectors) {
+    while (count) {
+        uint32_t n = count < zero_sectors ? count : zero_sectors;
+        int rc = blockdev_write(dev, lba, n, zero);
+        if (rc) return rc;
+        lba += n;
+        count -= n;
+    }
+    return 0;
+}
+
+int fat32_format(blockdev_t* dev, const char* label) {
+    uint32_t total = dev->nr_sectors;
+    uint32_t spc = total <= 131072 ? 1 : (total <= 1048576 ? 4 : 8);
+
+    // FAT 크기: Microsoft FAT 명세의 FAT32 계산식
+    uint32_t tmp1 = total - FAT_RESERVED;
+    uint32_t tmp2 = (256 * spc + FAT_NUM_FATS) / 2;
+    uint32_t fatsz = (tmp1 + tmp2 - 1) / tmp2;
+    uint32_t data_start = FAT_RESERVED + FAT_NUM_FATS * fatsz;
+    if (total <= data_start + 16 * spc) return -ENOSPC;
+    uint32_t nclusters = (total - data_start) / spc;
+
+    const uint32_t zero_sectors = BCACHE_BLOCK_SECTORS;
+    uint8_t* zero = (uint8_t*)kmalloc(zero_sectors * SECTOR_SIZE);
+    memset(zero, 0, zero_sectors * SECTOR_SIZE);
+    uint8_t sec[SECTOR_SIZE];
+
+    int rc = write_zero(dev, 0, FAT_RESERVED, zero, zero_sectors);
+    if (rc == 0) rc = write_zero(dev, FAT_RESERVED, FAT_NUM_FATS * fatsz, zero, zero_sectors);
+    if (rc == 0) rc = write_zero(dev, data_start, spc, zero, zero_sectors);
+
+    // 부트 섹터 (+ 백업)
+    memset(sec, 0, sizeof(sec));
+    fat_bpb_t* b = (fat_bpb_t*)sec;
+    b->jmp[0] = 0xEB;
+    b->jmp[1] = 0x58;
+    b->jmp[2] = 0x90;
+    memcpy(b->oem, "MYOS    ", 8);
+    b->bytes_per_sector = SECTOR_SIZE;
+    b->sec_per_clus = (uint8_t)spc;
+    b->reserved_sectors = FAT_RESERVED;
+    b->num_fats = FAT_NUM_FATS;
+    b->media = 0xF8;
+    b->sec_per_track = 32;
+    b->heads = 64;
+    b->total32 = total;
+    b->fat_size32 = fatsz;
+    b->root_cluster = 2;
+    b->fsinfo_sector = 1;
+    b->backup_boot = FAT_BACKUP_BOOT;
+    b->drive = 0x80;
+    b->boot_sig = 0x29;
+    b->volume_id = (uint32_t)rdtsc();
+    char vol[11];
+    memset(vol, ' ', 11);
+    for (uint32_t i = 0; label && label[i] && i < 11; i++) vol[i] = upper(label[i]);
+    memcpy(b->label, vol, 11);
+    memcpy(b->fs_type, "FAT32   ", 8);
+    sec[510] = 0x55;
+    sec[511] = 0xAA;
+    if (rc == 0) rc = blockdev_write(dev, 0, 1, sec);
+    if (rc == 0) rc = blockdev_write(dev, FAT_BACKUP_BOOT, 1, sec);
+
+    // FSInfo (+ 백업): 루트가 클러스터 2를 쓴다
+    memset(sec, 0, sizeof(sec));
+    uint32_t* w = (uint32_t*)sec;
+    w[0] = FSINFO_LEAD;
+    w[484 / 4] = FSINFO_STRUCT;
+    w[488 / 4] = nclusters - 1;
+    w[492 / 4] = 3;
+    w[508 / 4] = FSINFO_TRAIL;
+    if (rc == 0) rc = blockdev_write(dev, 1, 1, sec);
+    if (rc == 0) rc = blockdev_write(dev, FAT_BACKUP_BOOT + 1, 1, sec);
+
+    // FAT[0] = media, FAT[1] = EOC, FAT[2] = 루트 디렉터리 (EOC)
+    memset(sec, 0, sizeof(sec));
+    w[0] = 0x0FFFFFF8;
+    w[1] = 0x0FFFFFFF;
+    w[2] = 0x0FFFFFFF;
+    for (uint32_t k = 0; rc == 0 && k < FAT_NUM_FATS; k++) rc = blockdev_write(dev, FAT_RESERVED + k * fatsz, 1, sec);
+
+    // 루트 디렉터리 첫 엔트리 = 볼륨 레이블
+    memset(sec, 0, sizeof(sec));
+    dirent_init((fat_dirent_t*)sec, vol, FAT_ATTR_VOLUME_ID, 0);
+    if (rc == 0) rc = blockdev_write(dev, data_start, 1, sec);
+    if (rc == 0) rc = blockdev_flush(dev);
+
+    kfree(zero);
+    if (rc == 0) {
+        kprintf("[FAT32] %s: formatted, %u clusters x %u B, FAT %u sectors\n",
+            dev->name, nclusters, spc * SECTOR_SIZE, fatsz);
+    }
+    return rc;
+}
+
+fat32_fs_t* fat32_mount(blockdev_t* dev, uint32_t nr_bufs) {
+    uint8_t sec[SECTOR_SIZE];
+    if (blockdev_read(dev, 0, 1, sec) != 0) return 0;
+
+    const fat_bpb_t* b = (const fat_bpb_t*)sec;
+    uint32_t spc = b->sec_per_clus;
+    if (sec[510] != 0x55 || sec[511] != 0xAA || b->bytes_per_sector != SECTOR_SIZE ||
+        spc == 0 || (spc & (spc - 1)) || b->num_fats == 0 ||
+        b->fat_size16 != 0 || b->fat_size32 == 0 || b->root_entries != 0) {
+        kprintf("[FAT32] %s: not a FAT32 volume\n", dev->name);
+        return 0;
+    }
+
+    uint32_t total = b->total16 ? b->total16 : b->total32;
+    if (total > dev->nr_sectors) total = dev->nr_sectors;
+    uint32_t data_start = b->reserved_sectors + b->num_fats * b->fat_size32;
+    if (total <= data_start) return 0;
+
+    uint32_t nclusters = (total - data_start) / spc;
+    if (nclusters > b->fat_size32 * (SECTOR_SIZE / 4) - 2) nclusters = b->fat_size32 * (SECTOR_SIZE / 4) - 2;
+    uint32_t fat_secs = ((nclusters + 2) * 4 + SECTOR_SIZE - 1) / SECTOR_SIZE;
+    if (fat_secs * SECTOR_SIZE > FAT32_MAX_FAT_BYTES) {
+        kprintf("[FAT32] %s: FAT too large to cache (%u KB)\n", dev->name, fat_secs / 2);
+        return 0;
+    }
+
+    fat32_fs_t* fs = (fat32_fs_t*)kmalloc(sizeof(fat32_fs_t));
+    memset(fs, 0, sizeof(*fs));
+    fs->dev = dev;
+    mutex_init(&fs->lock, "fat32");
+    fs->sec_per_clus = spc;
+    fs->cluster_size = spc * SECTOR_SIZE;
+    fs->fat_start = b->reserved_sectors;
+    fs->fat_sectors = b->fat_size32;
+    fs->num_fats = b->num_fats;
+    fs->data_start = data_start;
+    fs->nr_clusters = nclusters;
+    fs->root_cluster = b->root_cluster;
+    fs->fsinfo_sector = b->fsinfo_sector;
+
+    // FAT은 마운트 때 한 번 큰 요청으로 읽어 메모리에 둔다 (이후 읽기는 캐시 없이 배열 접근)
+    fs->fat = (uint32_t*)kmalloc(fat_secs * SECTOR_SIZE);
+    for (uint32_t s = 0; s < fat_secs;) {
+        uint32_t n = fat_secs - s < 128 ? fat_secs - s : 128;
+        if (blockdev_read(dev, fs->fat_start + s, n, (uint8_t*)fs->fat + s * SECTOR_SIZE) != 0) {
+            kprintf("[FAT32] %s: FAT read failed\n", dev->name);
+            kfree(fs->fat);
+            kfree(fs);
+            return 0;
+        }
+        s += n;
+    }
+
+    uint32_t map_words = (nclusters + 2 + 31) / 32;
+    fs->used_map = (uint32_t*)kmalloc(map_words * 4);
+    memset(fs->used_map, 0, map_words * 4);
+    bit_set(fs->used_map, 0);
+    bit_set(fs->used_map, 1);
+    for (uint32_t c = 2; c < nclusters + 2; c++) {
+        if (fat_get(fs, c)) bit_set(fs->used_map, c);
+        else fs->free_count++;
+    }
+    // 마지막 word의 범위 밖 비트는 사용 중으로 (find_free가 word 단위로 건너뜀)
+    for (uint32_t c = nclusters + 2; c < map_words * 32; c++) bit_set(fs->used_map, c);
+
+    uint32_t dirty_words = (fat_secs + 31) / 32;
+    fs->fat_dirty = (uint32_t*)kmalloc(dirty_words * 4);
+    memset(fs->fat_dirty, 0, dirty_words * 4);
+
+    fs->next_free = 2;
+    if (fs->fsinfo_sector && fs->fsinfo_sector < fs->fat_start && blockdev_read(dev, fs->fsinfo_sector, 1, sec) == 0) {
+        const uint32_t* w = (const uint32_t*)sec;
+        if (w[0] == FSINFO_LEAD && w[484 / 4] == FSINFO_STRUCT && cluster_valid(fs, w[492 / 4])) fs->next_free = w[492 / 4];
+    } else {
+        fs->fsinfo_sector = 0;
+    }
+
+    fs->bc = bcache_create(dev, nr_bufs);
+    kprintf("[FAT32] %s: mounted, %u clusters x %u B, %u free, FAT %u KB in memory\n",
+        dev->name, nclusters, fs->cluster_size, fs->free_count, fat_secs / 2);
+    return fs;
+}
+
+int fat32_unmount(fat32_fs_t* fs) {
+    if (fs->open_files) return -EBUSY;
+    int rc = fat32_sync(fs);
+    bcache_destroy(fs->bc);
+    kfree(fs->fat);
+    kfree(fs->used_map);
+    kfree(fs->fat_dirty);
+    kfree(fs);
+    return rc;
+}
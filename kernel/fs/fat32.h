@@ -0,0 +1,83 @@
+#pragma once
+#include <stdint.h>
+#include "file.h"
+#include "../block/blockdev.h"
+#include "../block/bcache.h"
+#include "../sync/mutex.h"
+
+// FAT32 파일 시스템 (읽기/쓰기)
+// - 모든 섹터 접근은 장치의 write-back 버퍼 캐시(bcache)를 거친다. 반영은 flusher 스레드 / fsync
+// - FAT 전체를 메모리에 두고(fat[]), 클러스터 사용 여부 비트맵으로 빈 클러스터를 찾는다.
+//   파일을 늘릴 때 필요한 개수를 한 번에 연속 구간으로 잡으므로 순차 쓰기가 장치에서도 연속이 되어
+//   bcache가 큰 요청으로 묶는다. 바뀐 FAT 섹터는 연산 끝에 모든 FAT 사본에 캐시로 쓴다
+// - 이름은 8.3 짧은 이름만 (LFN 엔트리는 읽을 때 건너뜀), 경로 구분자 '/', 대소문자 무시
+// - 열린 파일은 file_t (read/write/sync = fsync/release)
+
+#define FAT32_MAX_FAT_BYTES (2u * 1024 * 1024)     // 메모리에 올릴 수 있는 FAT 크기 상한
+
+#define FAT_O_CREAT 0x1
+#define FAT_O_TRUNC 0x2
+
+#define FAT_ATTR_READ_ONLY 0x01
+#define FAT_ATTR_HIDDEN    0x02
+#define FAT_ATTR_SYSTEM    0x04
+#define FAT_ATTR_VOLUME_ID 0x08
+#define FAT_ATTR_DIRECTORY 0x10
+#define FAT_ATTR_ARCHIVE   0x20
+#define FAT_ATTR_LFN       0x0F
+
+#define FAT32_EOC  0x0FFFFFF8u                    // 이 값 이상이면 체인 끝
+#define FAT32_MASK 0x0FFFFFFFu
+
+typedef struct fat32_fs {
+    blockdev_t* dev;
+    bcache_t* bc;
+    mutex_t lock;
+
+    uint32_t sec_per_clus;
+    uint32_t cluster_size;          // 바이트
+    uint32_t fat_start;             // 첫 FAT의 LBA (= 예약 섹터 수)
+    uint32_t fat_sectors;           // FAT 하나의 섹터 수
+    uint32_t num_fats;
+    uint32_t data_start;            // 클러스터 2의 LBA
+    uint32_t nr_clusters;           // 데이터 클러스터 수 (번호 2 .. nr_clusters + 1)
+    uint32_t root_cluster;
+    uint32_t fsinfo_sector;
+
+    uint32_t* fat;                  // nr_clusters + 2 엔트리
+    uint32_t* used_map;             // 클러스터별 1비트 (1 = 사용 중)
+    uint32_t* fat_dirty;            // FAT 섹터별 1비트 (캐시에 아직 안 씀)
+    uint32_t free_count;
+    uint32_t next_free;             // 다음 할당 탐색 시작점
+
+    uint32_t open_files;
+    uint32_t alloc_runs;            // 할당 요청 / 그 결과 연속 구간 수 (단편화 정도)
+    uint32_t alloc_calls;
+} fat32_fs_t;
+
+// 장치 전체를 FAT32로 포맷 (512B 섹터, FAT 2개). 성공 0, 실패 -errno
+int fat32_format(blockdev_t* dev, const char* label);
+
+// 마운트: 부트 섹터 검사 + FAT 적재 + bcache 생성 (nr_bufs 0이면 기본). 실패 시 0
+fat32_fs_t* fat32_mount(blockdev_t* dev, uint32_t nr_bufs);
+
+// 열린 파일이 있으면 -EBUSY. 전부 반영한 뒤 해제
+int fat32_unmount(fat32_fs_t* fs);
+
+// 경로의 파일 열기 (FAT_O_CREAT: 없으면 생성, FAT_O_TRUNC: 길이 0으로). 실패 시 0, err에 -errno
+file_t* fat32_open(fat32_fs_t* fs, const char* path, uint32_t flags, int* err);
+
+int fat32_mkdir(fat32_fs_t* fs, const char* path);
+int fat32_unlink(fat32_fs_t* fs, const char* path);
+
+// 디렉터리 목록을 콘솔로 (이름, 크기, 첫 클러스터)
+int fat32_ls(fat32_fs_t* fs, const char* path);
+
+// FAT/디렉터리/데이터 전부 반영 + 장치 flush
+int fat32_sync(fat32_fs_t* fs);
+
+// 캐시 비교/측정용
+bcache_t* fat32_bcache(fat32_fs_t* fs);
+
+// 순차 쓰기: write-through vs write-back 요청 수, fsync, 재마운트 후 확인 (+ ATA 디스크가 FAT32면 결과 기록)
+void fat32_bench(void);
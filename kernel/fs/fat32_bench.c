@@ -0,0 +1,213 @@
+#include "fat32.h"
+#include "../sched/thread.h"
+#include "../memory/heap.h"
+#include "../time/time.h"
+#include "../lib/string.h"
+#include "../lib/errno.h"
+#include "../lib/cmdline.h"
+#include "../console/kprintf.h"
+#include "../../drivers/block/ramdisk.h"
+#include "../../arch/x86/cpu/tsc.h"
+
+// 2MB ramdisk에 1MB를 4KB씩 순차로 쓰고 장치 요청 수를 비교:
+// write-through(블록마다 바로 장치로) vs write-back(캐시 + fsync 때 정렬/병합)
+#define FB_DISK_SECTORS 4096
+#define FB_TOTAL        (1024u * 1024)
+#define FB_CHUNK        4096u
+
+typedef struct fb_result {
+    uint32_t reqs;
+    uint32_t sectors;
+    uint64_t us;
+} fb_result_t;
+
+static void fill(uint8_t* buf, uint32_t off, uint32_t len) {
+    for (uint32_t i = 0; i < len; i++) {
+        uint32_t x = off + i;
+        buf[i] = (uint8_t)(x ^ (x >> 9) ^ 0x5A);
+    }
+}
+
+static int write_pass(fat32_fs_t* fs, const char* path, int writethrough, uint8_t* buf, fb_result_t* r) {
+    bcache_t* bc = fat32_bcache(fs);
+    blockdev_t* dev = fs->dev;
+    bcache_set_writethrough(bc, writethrough);
+
+    int err;
+    file_t* f = fat32_open(fs, path, FAT_O_CREAT | FAT_O_TRUNC, &err);
+    if (!f) {
+        kprintf("[FAT32] open %s failed (%d)\n", path, err);
+        return err;
+    }
+
+    uint32_t w0 = dev->write_ops, s0 = dev->write_sectors;
+    uint64_t t0 = rdtsc();
+    for (uint32_t off = 0; off < FB_TOTAL && err == 0; off += FB_CHUNK) {
+        fill(buf, off, FB_CHUNK);
+        int32_t n = file_write(f, buf, FB_CHUNK, off);
+        if (n != (int32_t)FB_CHUNK) err = n < 0 ? n : -EIO;
+    }
+    if (err == 0) err = file_fsync(f);
+    r->us = tsc_cycles_to_us(rdtsc() - t0);
+    file_put(f);
+
+    r->reqs = dev->write_ops - w0;
+    r->sectors = dev->write_sectors - s0;
+    bcache_set_writethrough(bc, 0);
+    if (err) kprintf("[FAT32] write %s failed (%d)\n", path, err);
+    return err;
+}
+
+// 읽어서 패턴과 다른 바이트 수 (열기 실패는 -1)
+static int32_t verify(fat32_fs_t* fs, const char* path, uint8_t* buf) {
+    int err;
+    file_t* f = fat32_open(fs, path, 0, &err);
+    if (!f) return -1;
+
+    uint8_t* want = (uint8_t*)kmalloc(FB_CHUNK);
+    int32_t bad = f->size == FB_TOTAL ? 0 : (int32_t)FB_TOTAL;
+    for (uint32_t off = 0; off < FB_TOTAL && bad == 0; off += FB_CHUNK) {
+        if (file_read(f, buf, FB_CHUNK, off) != (int32_t)FB_CHUNK) {
+            bad = (int32_t)FB_TOTAL;
+            break;
+        }
+        fill(want, off, FB_CHUNK);
+        for (uint32_t i = 0; i < FB_CHUNK; i++) bad += buf[i] != want[i];
+    }
+    kfree(want);
+    file_put(f);
+    return bad;
+}
+
+static int write_text(fat32_fs_t* fs, const char* path, const char* text) {
+    int err;
+    file_t* f = fat32_open(fs, path, FAT_O_CREAT | FAT_O_TRUNC, &err);
+    if (!f) return err;
+    int32_t n = file_write(f, text, strlen(text), 0);
+    if (n >= 0) n = file_fsync(f);
+    file_put(f);
+    return n;
+}
+
+static void print_text(fat32_fs_t* fs, const char* path) {
+    int err;
+    file_t* f = fat32_open(fs, path, 0, &err);
+    if (!f) {
+        kprintf("[FAT32] %s: open failed (%d)\n", path, err);
+        return;
+    }
+    char text[256];
+    int32_t n = file_read(f, text, sizeof(text) - 1, 0);
+    text[n > 0 ? n : 0] = 0;
+    kprintf("[FAT32] %s (%llu B): %s", path, f->size, text);
+    file_put(f);
+}
+
+// dirty 블록이 flusher의 나이 기준으로 빠지는지 (fsync 없이)
+static void age_check(fat32_fs_t* fs, uint8_t* buf) {
+    bcache_t* bc = fat32_bcache(fs);
+    bcache_stats_t s0, s1;
+    bcache_get_stats(bc, &s0);
+
+    int err;
+    file_t* f = fat32_open(fs, "/AGE.DAT", FAT_O_CREAT | FAT_O_TRUNC, &err);
+    if (!f) return;
+    fill(buf, 0, FB_CHUNK);
+    file_write(f, buf, FB_CHUNK, 0);
+    file_write(f, buf, FB_CHUNK, FB_CHUNK);
+    file_put(f);
+
+    uint32_t before = bcache_dirty(bc);
+    sleep_ms(BCACHE_DIRTY_EXPIRE_MS + 500);
+    uint32_t after = bcache_dirty(bc);
+    bcache_get_stats(bc, &s1);
+    kprintf("[FAT32] age flush: dirty %u -> %u after %u ms, age flushes %u, bg %u (%s)\n",
+        before, after, BCACHE_DIRTY_EXPIRE_MS + 500, s1.flush_age - s0.flush_age,
+        s1.flush_bg - s0.flush_bg, (before && !after) ? "OK" : "FAIL");
+}
+
+// 벤치가 돈 부팅에서 fat32.report도 있고 ATA 디스크가 FAT32면 결과를 남긴다 (호스트에서 mtype으로 확인)
+// 사용자의 디스크를 몰래 마운트하고 덮어쓰지 않도록 기본은 꺼져 있다
+static void ata_report(const char* text) {
+    if (!cmdline_has("fat32.report")) return;
+    blockdev_t* dev = blockdev_find("ata0");
+    if (!dev) {
+        kprintf("[FAT32] no ata0 (make disk && make run DISK=build/disk.img CMDLINE=\"bench=fat32 fat32.report\")\n");
+        return;
+    }
+    fat32_fs_t* fs = fat32_mount(dev, 0);
+    if (!fs) {
+        kprintf("[FAT32] ata0 is not FAT32 (mkfs.fat -F 32)\n");
+        return;
+    }
+    int rc = write_text(fs, "/MYOS.TXT", text);
+    kprintf("[FAT32] ata0: /MYOS.TXT written (%d)\n", rc);
+    fat32_ls(fs, "/");
+    fat32_unmount(fs);
+    blockdev_dump();
+}
+
+static void fat32_bench_thread(void* arg) {
+    (void)arg;
+
+    blockdev_t* dev = ramdisk_create("fat0", FB_DISK_SECTORS);
+    if (!dev || fat32_format(dev, "MYOS") != 0) return;
+    fat32_fs_t* fs = fat32_mount(dev, 0);
+    if (!fs) return;
+
+    uint8_t* buf = (uint8_t*)kmalloc(FB_CHUNK);
+    fb_result_t wt, wb;
+    if (write_pass(fs, "/DATA.BIN", 1, buf, &wt) || write_pass(fs, "/DATA.BIN", 0, buf, &wb)) {
+        kfree(buf);
+        fat32_unmount(fs);
+        return;
+    }
+    kprintf("[FAT32] %u KB seq write: write-through %u reqs / %u sectors (%llu us), "
+        "write-back+fsync %u reqs / %u sectors (%llu us)\n",
+        FB_TOTAL / 1024, wt.reqs, wt.sectors, wt.us, wb.reqs, wb.sectors, wb.us);
+    kprintf("[FAT32] allocation: %u calls -> %u runs, %u clusters free\n",
+        fs->alloc_calls, fs->alloc_runs, fs->free_count);
+
+    bcache_stats_t s0, s1;
+    bcache_get_stats(fat32_bcache(fs), &s0);
+    int32_t bad = verify(fs, "/DATA.BIN", buf);
+    bcache_get_stats(fat32_bcache(fs), &s1);
+    kprintf("[FAT32] read back: %d bad bytes, %u hits / %u misses, %u reqs / %u sectors\n",
+        bad, s1.hits - s0.hits, s1.misses - s0.misses,
+        s1.read_reqs - s0.read_reqs, s1.read_sectors - s0.read_sectors);
+
+    char text[256];
+    uint32_t ratio = wb.reqs ? wt.reqs / wb.reqs : 0;
+    ksnprintf(text, sizeof(text),
+        "seq write %u KB: write-through %u reqs, write-back %u reqs (x%u fewer), verify %s\n",
+        FB_TOTAL / 1024, wt.reqs, wb.reqs, ratio, bad ? "FAIL" : "OK");
+    int rc = fat32_mkdir(fs, "/LOGS");
+    if (rc == 0) rc = write_text(fs, "/LOGS/RESULT.TXT", text);
+    if (rc) kprintf("[FAT32] /LOGS/RESULT.TXT failed (%d)\n", rc);
+    fat32_ls(fs, "/");
+    fat32_ls(fs, "/LOGS");
+
+    age_check(fs, buf);
+
+    // 재마운트 후에도 같은 내용인지 (FAT/디렉터리가 장치에 제대로 반영됐는지)
+    rc = fat32_unmount(fs);
+    fs = fat32_mount(dev, 0);
+    if (fs) {
+        bad = verify(fs, "/DATA.BIN", buf);
+        kprintf("[FAT32] remount (%d): /DATA.BIN %d bad bytes, %u clusters free\n", rc, bad, fs->free_count);
+        print_text(fs, "/LOGS/RESULT.TXT");
+        fat32_unmount(fs);
+    }
+    kfree(buf);
+
+    ata_report(text);
+}
+
+void fat32_bench(void) {
+    if (!cmdline_bench("fat32")) return;
+    if (tsc_hz() == 0) {
+        kprintf("[FAT32] TSC not calibrated\n");
+        return;
+    }
+    thread_create("fat32-bench", fat32_bench_thread, 0, PRIO_NORMAL + 2);
+}
@@ -0,0 +1,160 @@
+#include "file.h"
+#include "../block/blockdev.h"
+#include "../memory/heap.h"
+#include "../lib/errno.h"
+#include "../lib/string.h"
+
+file_t* file_alloc(const char* name, const file_ops_t* ops, void* priv, uint64_t size) {
+    file_t* f = (file_t*)kmalloc(sizeof(file_t));
+    uint32_t i = 0;
+    for (; name[i] && i < FILE_NAME_LEN - 1; i++) f->name[i] = name[i];
+    f->name[i] = 0;
+    f->ops = ops;
+    f->priv = priv;
+    f->size = size;
+    f->refcount = 1;
+    return f;
+}
+
+void file_get(file_t* f) {
+    __sync_fetch_and_add(&f->refcount, 1);
+}
+
+void file_put(file_t* f) {
+    if (__sync_sub_and_fetch(&f->refcount, 1) != 0) return;
+    if (f->ops->release) f->ops->release(f);
+    kfree(f);
+}
+
+int32_t file_read(file_t* f, void* buf, uint32_t len, uint64_t off) {
+    if (!f->ops->read) return -EBADF;
+    if (len == 0) return 0;
+    return f->ops->read(f, buf, len, off);
+}
+
+int32_t file_write(file_t* f, const void* buf, uint32_t len, uint64_t off) {
+    if (!f->ops->write) return -EBADF;
+    if (len == 0) return 0;
+    return f->ops->write(f, buf, len, off);
+}
+
+int32_t file_fsync(file_t* f) {
+    if (!f->ops->sync) return 0;
+    return f->ops->sync(f, 0, (uint32_t)f->size);
+}
+
+// -------------------------
+// ramfile: 고정 용량 버퍼, size는 쓴 만큼 증가
+// -------------------------
+typedef struct ramfile {
+    uint8_t* data;
+    uint32_t capacity;
+} ramfile_t;
+
+static int32_t ramfile_read(file_t* f, void* buf, uint32_t len, uint64_t off) {
+    ramfile_t* rf = (ramfile_t*)f->priv;
+    if (off >= f->size) return 0;
+
+    uint32_t avail = (uint32_t)(f->size - off);
+    if (len > avail) len = avail;
+    memcpy(buf, rf->data + (uint32_t)off, len);
+    return (int32_t)len;
+}
+
+static int32_t ramfile_write(file_t* f, const void* buf, uint32_t len, uint64_t off) {
+    ramfile_t* rf = (ramfile_t*)f->priv;
+    if (off >= rf->capacity) return -ENOSPC;
+
+    uint32_t room = rf->capacity - (uint32_t)off;
+    if (len > room) len = room;
+
+    // 구멍은 0으로 (ramfile_create에서 0으로 채워 둠)
+    memcpy(rf->data + (uint32_t)off, buf, len);
+    if (off + len > f->size) f->size = off + len;
+    return (int32_t)len;
+}
+
+static void ramfile_release(file_t* f) {
+    ramfile_t* rf = (ramfile_t*)f->priv;
+    kfree(rf->data);
+    kfree(rf);
+}
+
+static const file_ops_t g_ramfile_ops = {
+    .read = ramfile_read,
+    .write = ramfile_write,
+    .release = ramfile_release,
+};
+
+file_t* ramfile_create(const char* name, uint32_t capacity) {
+    ramfile_t* rf = (ramfile_t*)kmalloc(sizeof(ramfile_t));
+    rf->data = (uint8_t*)kmalloc(capacity);
+    rf->capacity = capacity;
+    memset(rf->data, 0, capacity);
+    return file_alloc(name, &g_ramfile_ops, rf, 0);
+}
+
+// -------------------------
+// 블록 장치 파일
+// -------------------------
+static int32_t bdev_file_io(file_t* f, uint8_t* buf, uint32_t len, uint64_t off, int write) {
+    blockdev_t* dev = (blockdev_t*)f->priv;
+    if (off >= f->size) return write ? -ENOSPC : 0;
+
+    uint64_t avail = f->size - off;
+    if (len > avail) len = (uint32_t)avail;
+
+    uint8_t bounce[SECTOR_SIZE];
+    uint32_t done = 0;
+
+    while (done < len) {
+        uint32_t lba = (uint32_t)((off + done) >> 9);
+        uint32_t in = (uint32_t)(off + done) & (SECTOR_SIZE - 1);
+        uint32_t left = len - done;
+        int rc;
+
+        if (in == 0 && left >= SECTOR_SIZE) {
+            // 섹터 정렬된 가운데 구간: 버퍼로 바로
+            uint32_t n = left / SECTOR_SIZE;
+            rc = write ? blockdev_write(dev, lba, n, buf + done)
+                       : blockdev_read(dev, lba, n, buf + done);
+            if (rc) return done ? (int32_t)done : rc;
+            done += n * SECTOR_SIZE;
+            continue;
+        }
+
+        // 앞뒤 부분 섹터: bounce 버퍼로 read(-modify-write)
+        uint32_t chunk = SECTOR_SIZE - in;
+        if (chunk > left) chunk = left;
+
+        rc = blockdev_read(dev, lba, 1, bounce);
+        if (rc) return done ? (int32_t)done : rc;
+        if (write) {
+            memcpy(bounce + in, buf + done, chunk);
+            rc = blockdev_write(dev, lba, 1, bounce);
+            if (rc) return done ? (int32_t)done : rc;
+        } else {
+            memcpy(buf + done, bounce + in, chunk);
+        }
+        done += chunk;
+    }
+    return (int32_t)done;
+}
+
+static int32_t bdev_file_read(file_t* f, void* buf, uint32_t len, uint64_t off) {
+    return bdev_file_io(f, (uint8_t*)buf, len, off, 0);
+}
+
+static int32_t bdev_file_write(file_t* f, const void* buf, uint32_t len, uint64_t off) {
+    return bdev_file_io(f, (uint8_t*)buf, len, off, 1);
+}
+
+static const file_ops_t g_bdev_file_ops = {
+    .read = bdev_file_read,
+    .write = bdev_file_write,
+    .release = 0,
+};
+
+file_t* blockdev_file_open(blockdev_t* dev) {
+    return file_alloc(dev->name, &g_bdev_file_ops, dev, (uint64_t)dev->nr_sectors * SECTOR_SIZE);
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <stdint.h>
+
+// 열린 파일 객체: 위치 지정 read/write를 구현체(ops)에 위임
+// 구현체: 메모리 파일(ramfile), 블록 장치 파일. 참조 카운트가 0이 되면 release 후 해제.
+#define FILE_NAME_LEN 16
+
+struct file;
+
+typedef struct file_ops {
+    // 처리한 바이트 수 (EOF면 0), 실패 시 -errno. 스레드 컨텍스트에서 호출되며 잠들 수 있다.
+    int32_t (*read)(struct file* f, void* buf, uint32_t len, uint64_t off);
+    int32_t (*write)(struct file* f, const void* buf, uint32_t len, uint64_t off);
+    void (*release)(struct file* f);
+
+    // 아래는 선택 사항 (0이면 splice가 read/write 복사로 대신하고, get_page가 없으면 mmap 불가)
+    // 페이지 캐시의 index번째 페이지를 참조(+1)로 빌려줌 (없으면 만들어서). 실패 시 0
+    uint32_t (*get_page)(struct file* f, uint32_t index);
+    // 물리 페이지 [off, off+len)을 pos에 쓴다. 가능하면 복사 없이 참조로 받는다 (호출자 참조는 그대로)
+    int32_t (*write_page)(struct file* f, uint32_t page, uint32_t off, uint32_t len, uint64_t pos);
+    // 캐시에 이미 있는 index번째 페이지만 참조(+1)로 (없으면 만들지 않고 0). mmap fault-around용
+    uint32_t (*find_page)(struct file* f, uint32_t index);
+    // [off, off+len)의 캐시 내용을 뒤쪽 저장소에 반영 (msync). 성공 0, 실패 -errno
+    int32_t (*sync)(struct file* f, uint64_t off, uint32_t len);
+} file_ops_t;
+
+typedef struct file {
+    char name[FILE_NAME_LEN];
+    const file_ops_t* ops;
+    void* priv;
+    uint64_t size;
+    volatile uint32_t refcount;
+} file_t;
+
+// ops/priv/size를 가진 새 파일 객체 (refcount 1)
+file_t* file_alloc(const char* name, const file_ops_t* ops, void* priv, uint64_t size);
+
+void file_get(file_t* f);
+void file_put(file_t* f);
+
+int32_t file_read(file_t* f, void* buf, uint32_t len, uint64_t off);
+int32_t file_write(file_t* f, const void* buf, uint32_t len, uint64_t off);
+
+// 파일 내용 전체를 뒤쪽 저장소까지 반영 (fsync). sync op가 없으면 0
+int32_t file_fsync(file_t* f);
+
+// 최대 capacity 바이트까지 커지는 메모리 파일
+file_t* ramfile_create(const char* name, uint32_t capacity);
+
+struct blockdev;
+
+// 블록 장치를 바이트 단위 파일로 (섹터 경계가 아닌 부분은 read-modify-write)
+file_t* blockdev_file_open(struct blockdev* dev);
@@ -0,0 +1,263 @@
+#include "pipe.h"
+#include "../sync/mutex.h"
+#include "../sched/wait.h"
+#include "../memory/heap.h"
+#include "../memory/pmm.h"
+#include "../lib/errno.h"
+#include "../lib/string.h"
+#include "../../arch/x86/cpu/irqflags.h"
+
+typedef struct pipe {
+    mutex_t lock;
+    pipe_buf_t bufs[PIPE_BUFFERS];
+    uint32_t head;                      // 다음에 채울 슬롯 (계속 증가, & (PIPE_BUFFERS-1))
+    uint32_t tail;                      // 다음에 읽을 슬롯
+    uint32_t bytes;
+
+    uint32_t readers;
+    uint32_t writers;
+    wait_queue_t rd_wait;               // 데이터 대기
+    wait_queue_t wr_wait;               // 빈 슬롯 대기
+} pipe_t;
+
+static pipe_stats_t g_stats;
+
+static inline pipe_buf_t* slot(pipe_t* p, uint32_t i) {
+    return &p->bufs[i & (PIPE_BUFFERS - 1)];
+}
+
+static inline int pipe_full(const pipe_t* p) {
+    return p->head - p->tail >= PIPE_BUFFERS;
+}
+
+// 단일 CPU: 인터럽트를 끈 채 lock을 놓고 잠들어 그 사이의 wake_up을 놓치지 않는다
+static void pipe_wait(pipe_t* p, wait_queue_t* wq) {
+    uint32_t flags = irq_save();
+    mutex_unlock(&p->lock);
+    wait_queue_sleep(wq);
+    irq_restore(flags);
+    mutex_lock(&p->lock);
+}
+
+// 슬롯이 빌 때까지 대기. 읽는 쪽이 없으면 -EPIPE
+static int wait_writable(pipe_t* p) {
+    while (pipe_full(p)) {
+        if (!p->readers) return -EPIPE;
+        g_stats.writer_waits++;
+        pipe_wait(p, &p->wr_wait);
+    }
+    return p->readers ? 0 : -EPIPE;
+}
+
+// 데이터가 올 때까지 대기. 쓰는 쪽이 모두 닫혔고 비었으면 0
+static int wait_readable(pipe_t* p) {
+    while (p->head == p->tail) {
+        if (!p->writers) return 0;
+        g_stats.reader_waits++;
+        pipe_wait(p, &p->rd_wait);
+    }
+    return 1;
+}
+
+static void release_head(pipe_t* p) {
+    pmm_unref(slot(p, p->tail)->page);
+    p->tail++;
+    wake_up_one(&p->wr_wait);
+}
+
+int32_t pipe_write_copy(pipe_t* p, const void* buf, uint32_t len) {
+    const uint8_t* src = (const uint8_t*)buf;
+    uint32_t done = 0;
+
+    mutex_lock(&p->lock);
+    while (done < len) {
+        if (!p->readers) break;
+
+        // 마지막 슬롯이 파이프 소유 페이지면 남은 자리에 이어 쓴다
+        pipe_buf_t* b = 0;
+        if (p->head != p->tail) {
+            b = slot(p, p->head - 1);
+            if (!(b->flags & PIPE_BUF_CAN_MERGE) || b->off + b->len >= PAGE_SIZE) b = 0;
+        }
+        if (!b) {
+            int r = wait_writable(p);
+            if (r < 0) break;
+            uint32_t page = pmm_alloc_frame();
+            if (!page) {
+                mutex_unlock(&p->lock);
+                return done ? (int32_t)done : -ENOMEM;
+            }
+            b = slot(p, p->head);
+            b->page = page;
+            b->off = 0;
+            b->len = 0;
+            b->flags = PIPE_BUF_CAN_MERGE;
+            p->head++;
+            g_stats.pages_allocated++;
+        }
+
+        uint32_t n = PAGE_SIZE - (b->off + b->len);
+        if (n > len - done) n = len - done;
+        memcpy((uint8_t*)b->page + b->off + b->len, src + done, n);
+        b->len += n;
+        p->bytes += n;
+        done += n;
+        wake_up_one(&p->rd_wait);
+    }
+    g_stats.bytes_copied_in += done;
+    int32_t ret = done ? (int32_t)done : -EPIPE;
+    mutex_unlock(&p->lock);
+    return ret;
+}
+
+int32_t pipe_add_page(pipe_t* p, uint32_t page, uint32_t off, uint32_t len) {
+    mutex_lock(&p->lock);
+    int r = wait_writable(p);
+    if (r < 0) {
+        mutex_unlock(&p->lock);
+        return r;
+    }
+
+    pipe_buf_t* b = slot(p, p->head);
+    b->page = page;
+    b->off = (uint16_t)off;
+    b->len = (uint16_t)len;
+    b->flags = 0;
+    p->head++;
+    p->bytes += len;
+    g_stats.pages_referenced++;
+    wake_up_one(&p->rd_wait);
+    mutex_unlock(&p->lock);
+    return (int32_t)len;
+}
+
+int32_t pipe_take_buf(pipe_t* p, pipe_buf_t* out, uint32_t max, int wait) {
+    mutex_lock(&p->lock);
+    if (!wait && p->head == p->tail && p->writers) {
+        mutex_unlock(&p->lock);
+        return -EAGAIN;
+    }
+    if (!wait_readable(p)) {
+        mutex_unlock(&p->lock);
+        return 0;
+    }
+
+    pipe_buf_t* b = slot(p, p->tail);
+    if (b->len <= max) {
+        // 슬롯째 넘김 (참조도 그대로 이동)
+        *out = *b;
+        p->tail++;
+        wake_up_one(&p->wr_wait);
+    } else {
+        pmm_ref(b->page);
+        out->page = b->page;
+        out->off = b->off;
+        out->len = (uint16_t)max;
+        out->flags = 0;
+        b->off += (uint16_t)max;
+        b->len -= (uint16_t)max;
+    }
+    // 꺼낸 쪽은 공유 참조이므로 이어 쓰지 않는다
+    out->flags &= ~PIPE_BUF_CAN_MERGE;
+    p->bytes -= out->len;
+    mutex_unlock(&p->lock);
+    return out->len;
+}
+
+// -------------------------
+// file_t 연결
+// -------------------------
+
+static int32_t pipe_read(file_t* f, void* buf, uint32_t len, uint64_t off) {
+    (void)off;
+    pipe_t* p = (pipe_t*)f->priv;
+    uint8_t* dst = (uint8_t*)buf;
+    uint32_t done = 0;
+
+    mutex_lock(&p->lock);
+    if (!wait_readable(p)) {
+        mutex_unlock(&p->lock);
+        return 0;
+    }
+
+    // 있는 만큼만 읽고 돌아간다 (read() 의미)
+    while (done < len && p->head != p->tail) {
+        pipe_buf_t* b = slot(p, p->tail);
+        uint32_t n = b->len < len - done ? b->len : len - done;
+        memcpy(dst + done, (const uint8_t*)b->page + b->off, n);
+        b->off += (uint16_t)n;
+        b->len -= (uint16_t)n;
+        p->bytes -= n;
+        done += n;
+        if (b->len == 0) release_head(p);
+    }
+    g_stats.bytes_copied_out += done;
+    mutex_unlock(&p->lock);
+    return (int32_t)done;
+}
+
+static int32_t pipe_write(file_t* f, const void* buf, uint32_t len, uint64_t off) {
+    (void)off;
+    return pipe_write_copy((pipe_t*)f->priv, buf, len);
+}
+
+static void pipe_free(pipe_t* p) {
+    while (p->head != p->tail) {
+        pmm_unref(slot(p, p->tail)->page);
+        p->tail++;
+    }
+    kfree(p);
+}
+
+static void pipe_release_end(file_t* f, int reader) {
+    pipe_t* p = (pipe_t*)f->priv;
+    mutex_lock(&p->lock);
+    if (reader) p->readers--;
+    else p->writers--;
+    int last = !p->readers && !p->writers;
+    // 상대편 대기자가 EOF / -EPIPE를 보도록
+    wake_up_all(&p->rd_wait);
+    wake_up_all(&p->wr_wait);
+    mutex_unlock(&p->lock);
+    if (last) pipe_free(p);
+}
+
+static void pipe_release_rd(file_t* f) { pipe_release_end(f, 1); }
+static void pipe_release_wr(file_t* f) { pipe_release_end(f, 0); }
+
+static const file_ops_t g_pipe_rd_ops = {
+    .read = pipe_read,
+    .write = 0,
+    .release = pipe_release_rd,
+};
+
+static const file_ops_t g_pipe_wr_ops = {
+    .read = 0,
+    .write = pipe_write,
+    .release = pipe_release_wr,
+};
+
+int pipe_create(file_t** rd, file_t** wr) {
+    pipe_t* p = (pipe_t*)kmalloc(sizeof(pipe_t));
+    if (!p) return -ENOMEM;
+    memset(p, 0, sizeof(*p));
+    mutex_init(&p->lock, "pipe");
+    wait_queue_init(&p->rd_wait);
+    wait_queue_init(&p->wr_wait);
+    p->readers = 1;
+    p->writers = 1;
+
+    *rd = file_alloc("pipe:r", &g_pipe_rd_ops, p, 0);
+    *wr = file_alloc("pipe:w", &g_pipe_wr_ops, p, 0);
+    g_stats.created++;
+    return 0;
+}
+
+pipe_t* pipe_from_file(file_t* f) {
+    if (f->ops == &g_pipe_rd_ops || f->ops == &g_pipe_wr_ops) return (pipe_t*)f->priv;
+    return 0;
+}
+
+void pipe_get_stats(pipe_stats_t* out) {
+    *out = g_stats;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <stdint.h>
+#include "file.h"
+
+// 파이프 = 페이지 참조 ring
+// - 슬롯 하나는 (물리 페이지, off, len). write()는 마지막 슬롯이 파이프 소유 페이지이고 자리가
+//   남았으면 이어 쓰고, 아니면 새 페이지를 할당해 복사한다 (복사 1회)
+// - splice/vmsplice는 다른 곳(페이지 캐시, 유저 페이지, 다른 파이프)의 페이지를 참조 카운트만
+//   올려 슬롯에 넣는다. 이런 슬롯은 공유 페이지이므로 뒤에 이어 쓰지 않는다
+// - read()는 슬롯에서 복사해 가고 다 읽은 페이지의 참조를 놓는다
+// 읽기 끝/쓰기 끝은 별개의 file_t. 상대 끝이 모두 닫히면 read는 0(EOF), write는 -EPIPE.
+
+#define PIPE_BUFFERS 16                 // 2의 거듭제곱 (최대 64KB)
+
+// pipe_buf_t->flags
+#define PIPE_BUF_CAN_MERGE 0x1          // 파이프가 할당한 페이지: 뒤에 이어 쓸 수 있음
+
+typedef struct pipe_buf {
+    uint32_t page;
+    uint16_t off;
+    uint16_t len;
+    uint32_t flags;
+} pipe_buf_t;
+
+struct pipe;
+
+// 성공 0, 실패 -errno. *rd, *wr은 각각 refcount 1
+int pipe_create(file_t** rd, file_t** wr);
+
+// f가 파이프의 한 끝이면 그 파이프 (아니면 0)
+struct pipe* pipe_from_file(file_t* f);
+
+// ---- splice 구현용 (스레드 컨텍스트, 필요하면 잠듦) ----
+
+// 페이지 참조 하나를 슬롯으로 넘긴다 (성공 시 호출자의 참조를 가져감). 슬롯이 빌 때까지 대기.
+// 성공 len, 읽는 쪽이 없으면 -EPIPE (참조는 호출자에게 남음)
+int32_t pipe_add_page(struct pipe* p, uint32_t page, uint32_t off, uint32_t len);
+
+// 맨 앞 슬롯에서 최대 max 바이트를 참조째 꺼냄 (슬롯보다 작으면 참조를 하나 더 만들어 나눔).
+// wait이면 데이터가 올 때까지 대기, 아니면 비었을 때 -EAGAIN.
+// 꺼낸 바이트 수, 쓰는 쪽이 모두 닫혔고 비었으면 0
+int32_t pipe_take_buf(struct pipe* p, pipe_buf_t* out, uint32_t max, int wait);
+
+// 블로킹 복사 쓰기 (write()와 같음)
+int32_t pipe_write_copy(struct pipe* p, const void* buf, uint32_t len);
+
+typedef struct pipe_stats {
+    uint32_t created;
+    uint32_t bytes_copied_in;           // write()
+    uint32_t bytes_copied_out;          // read()
+    uint32_t pages_allocated;           // write()가 새로 할당한 페이지
+    uint32_t pages_referenced;          // splice/vmsplice로 들어온 페이지 참조
+    uint32_t reader_waits;
+    uint32_t writer_waits;
+} pipe_stats_t;
+
+void pipe_get_stats(pipe_stats_t* out);
@@ -0,0 +1,275 @@
+#include "procfs.h"
+#include "../memory/heap.h"
+#include "../memory/pmm.h"
+#include "../sched/thread.h"
+#include "../sched/cputime.h"
+#include "../sched/kstack.h"
+#include "../time/time.h"
+#include "../time/vdso.h"
+#include "../console/kprintf.h"
+#include "../lib/errno.h"
+#include "../lib/string.h"
+#include "../lib/div64.h"
+#include "../../arch/x86/cpu/tsc.h"
+#include "../../arch/x86/cpu/smp.h"
+#include "../../arch/x86/interrupt/irq.h"
+#include "../syscall/syscall.h"
+#include <stdarg.h>
+
+// 넘친 파일 끝에 붙이는 "(truncated N bytes)" 안내문 자리
+#define PROCFS_TRUNC_ROOM 32
+
+typedef struct proc_entry {
+    char name[PROCFS_NAME_LEN];
+    proc_show_t show;
+} proc_entry_t;
+
+// 열린 procfs 파일: 생성 버퍼는 open 때 한 번만 할당
+typedef struct proc_handle {
+    const proc_entry_t* entry;
+    proc_seq_t seq;
+} proc_handle_t;
+
+static proc_entry_t g_entries[PROCFS_MAX_ENTRIES];
+static uint32_t g_nr_entries = 0;
+
+void proc_printf(proc_seq_t* s, const char* fmt, ...) {
+    uint32_t room = s->size - s->len;
+    va_list args;
+    va_start(args, fmt);
+    int n = kvsnprintf(s->buf + s->len, room, fmt, args);
+    va_end(args);
+
+    if (n < 0) return;
+    if ((uint32_t)n >= room) {
+        // room - 1 바이트만 들어가고 NUL로 끝남
+        s->overflow += (uint32_t)n - (room - 1);
+        s->len = s->size - 1;
+    } else {
+        s->len += (uint32_t)n;
+    }
+}
+
+static const proc_entry_t* find_entry(const char* name) {
+    for (uint32_t i = 0; i < g_nr_entries; i++) {
+        if (strcmp(g_entries[i].name, name) == 0) return &g_entries[i];
+    }
+    return 0;
+}
+
+int procfs_register(const char* name, proc_show_t show) {
+    if (find_entry(name)) return -EEXIST;
+    if (g_nr_entries >= PROCFS_MAX_ENTRIES) return -ENOSPC;
+
+    proc_entry_t* e = &g_entries[g_nr_entries];
+    uint32_t i = 0;
+    for (; name[i] && i < PROCFS_NAME_LEN - 1; i++) e->name[i] = name[i];
+    e->name[i] = 0;
+    e->show = show;
+    g_nr_entries++;
+    return 0;
+}
+
+static void generate(proc_handle_t* h) {
+    h->seq.len = 0;
+    h->seq.overflow = 0;
+    h->seq.buf[0] = 0;
+    // 안내문 자리를 남겨 두고 생성: 꽉 찬 뒤에 붙이면 1바이트밖에 없어 안내문이 사라진다
+    h->seq.size = PROCFS_BUF_SIZE - PROCFS_TRUNC_ROOM;
+    h->entry->show(&h->seq);
+    h->seq.size = PROCFS_BUF_SIZE;
+    if (h->seq.overflow) proc_printf(&h->seq, "\n(truncated %u bytes)\n", h->seq.overflow);
+}
+
+// off == 0에서 새로 생성, 이어지는 읽기는 같은 스냅샷에서 복사
+static int32_t procfs_read(file_t* f, void* buf, uint32_t len, uint64_t off) {
+    proc_handle_t* h = (proc_handle_t*)f->priv;
+    if (off == 0) {
+        generate(h);
+        f->size = h->seq.len;
+    }
+    if (off >= h->seq.len) return 0;
+
+    uint32_t avail = h->seq.len - (uint32_t)off;
+    if (len > avail) len = avail;
+    memcpy(buf, h->seq.buf + (uint32_t)off, len);
+    return (int32_t)len;
+}
+
+static void procfs_release(file_t* f) {
+    proc_handle_t* h = (proc_handle_t*)f->priv;
+    kfree(h->seq.buf);
+    kfree(h);
+}
+
+static const file_ops_t g_procfs_ops = {
+    .read = procfs_read,
+    .write = 0,
+    .release = procfs_release,
+};
+
+file_t* procfs_open(const char* name) {
+    const proc_entry_t* e = find_entry(name);
+    if (!e) return 0;
+
+    proc_handle_t* h = (proc_handle_t*)kmalloc(sizeof(proc_handle_t));
+    h->entry = e;
+    h->seq.buf = (char*)kmalloc(PROCFS_BUF_SIZE);
+    h->seq.size = PROCFS_BUF_SIZE;
+    h->seq.len = 0;
+    h->seq.overflow = 0;
+    return file_alloc(e->name, &g_procfs_ops, h, 0);
+}
+
+void procfs_list(proc_seq_t* s) {
+    for (uint32_t i = 0; i < g_nr_entries; i++) proc_printf(s, "%s\n", g_entries[i].name);
+}
+
+int procfs_cat(const char* name) {
+    file_t* f = procfs_open(name);
+    if (!f) return -ENOENT;
+
+    // 콘솔 출력은 kprintf 버퍼 단위로 나눠서
+    char chunk[KPRINTF_BUF_SIZE - 1];
+    uint64_t off = 0;
+    for (;;) {
+        int32_t n = file_read(f, chunk, sizeof(chunk), off);
+        if (n <= 0) break;
+        kprintf("%.*s", (int)n, chunk);
+        off += (uint32_t)n;
+    }
+    file_put(f);
+    return 0;
+}
+
+// -------------------------
+// 기본 파일
+// -------------------------
+
+// cycle → "초.밀리초" 출력용
+static void cycles_to_sec_ms(uint64_t cycles, uint32_t* sec, uint32_t* ms) {
+    uint64_t us = tsc_cycles_to_us(cycles);
+    uint32_t rem_us = div_u64_u32(&us, 1000000);
+    *sec = (uint32_t)us;
+    *ms = rem_us / 1000;
+}
+
+static void show_meminfo(proc_seq_t* s) {
+    uint32_t heap_total = heap_end_addr() - heap_start_addr();
+    uint32_t frames = pmm_total_frames();
+    uint32_t free_frames = pmm_free_frames();
+
+    proc_printf(s, "HeapTotal:   %8u kB\n", heap_total / 1024);
+    proc_printf(s, "HeapUsed:    %8u kB\n", heap_used() / 1024);
+    proc_printf(s, "HeapFree:    %8u kB\n", heap_free() / 1024);
+    proc_printf(s, "FramesTotal: %8u kB\n", frames * (PAGE_SIZE / 1024));
+    proc_printf(s, "FramesFree:  %8u kB\n", free_frames * (PAGE_SIZE / 1024));
+    proc_printf(s, "FramesUsed:  %8u kB\n", (frames - free_frames) * (PAGE_SIZE / 1024));
+
+    kstack_stats_t ks;
+    kstack_get_stats(&ks);
+    proc_printf(s, "KStackCached:%8u\n", ks.cached);
+    proc_printf(s, "KStackMaxHWM:%8u B\n", ks.max_high_water);
+}
+
+static const char* vector_name(uint32_t v) {
+    if (v == IRQ_BASE) return "timer";
+    if (v == IRQ_BASE + 1) return "keyboard";
+    if (v == SYSCALL_VECTOR) return "syscall";
+    if (v >= IRQ_BASE && v < IRQ_VECTOR_BASE) return "pic";
+    return "vector";
+}
+
+static void show_interrupts(proc_seq_t* s) {
+    proc_printf(s, " vec       count  avg_cycles  name\n");
+    for (uint32_t v = 0; v < 256; v++) {
+        uint64_t cycles;
+        uint32_t count = cputime_vector_stats(v, &cycles);
+        if (!count) continue;
+        div_u64_u32(&cycles, count);
+        proc_printf(s, " %3u  %10u  %10llu  %s\n", v, count, cycles, vector_name(v));
+    }
+}
+
+static void show_sched(proc_seq_t* s) {
+    sched_stats_t st;
+    sched_get_stats(&st);
+    proc_printf(s, "switches:  %u\n", st.switches);
+    proc_printf(s, "threads:   %u\n", st.nr_threads);
+    proc_printf(s, "ready:     %u\n", st.nr_ready);
+    proc_printf(s, "blocked:   %u\n", st.nr_blocked);
+    proc_printf(s, "sleepers:  %u\n", st.nr_sleepers);
+
+    for (uint32_t c = 0; c < MAX_CPUS; c++) {
+        uint64_t t[CPUTIME_NR];
+        uint32_t switches, irqs;
+        cputime_cpu_totals(c, t, &switches, &irqs);
+        proc_printf(s, "cpu%u:", c);
+        for (int k = 0; k < CPUTIME_NR; k++) {
+            uint32_t sec, ms;
+            cycles_to_sec_ms(t[k], &sec, &ms);
+            proc_printf(s, " %s=%u.%03u", cputime_category_name(k), sec, ms);
+        }
+        proc_printf(s, " switches=%u irqs=%u\n", switches, irqs);
+    }
+}
+
+static void thread_row(thread_t* t, void* arg) {
+    proc_seq_t* s = (proc_seq_t*)arg;
+    uint64_t total = 0;
+    for (int k = 0; k < CPUTIME_NR; k++) total += t->acct.t[k];
+
+    uint32_t sec, ms, wsec, wms;
+    cycles_to_sec_ms(total, &sec, &ms);
+    cycles_to_sec_ms(t->acct.wait, &wsec, &wms);
+    proc_printf(s, "%4u %-15s %-5s %3d %3d %6u.%03u %6u.%03u %8u %8u %5u\n",
+        t->tid, t->name, thread_state_name(t->state), t->priority, t->base_priority,
+        sec, ms, wsec, wms, t->acct.nvcsw, t->acct.nivcsw, kstack_high_water(t->stack));
+}
+
+static void show_threads(proc_seq_t* s) {
+    proc_printf(s, " tid name            state pri base    cpu(s)   wait(s)    nvcsw   nivcsw stack\n");
+    sched_for_each_thread(thread_row, s);
+}
+
+static void show_timer(proc_seq_t* s) {
+    sched_stats_t st;
+    sched_get_stats(&st);
+    const vdso_time_t* vd = vdso_data();
+
+    proc_printf(s, "hz:         %u\n", time_get_hz());
+    proc_printf(s, "ticks:      %llu\n", timer_ticks());
+    proc_printf(s, "tsc_hz:     %u\n", tsc_hz());
+    proc_printf(s, "clock_ns:   %llu\n", clock_monotonic_ns());
+    if (vd) proc_printf(s, "vdso:       seq=%u mult=%u shift=%u\n", vd->seq, vd->mult, vd->shift);
+    proc_printf(s, "sleepers:   %u\n", st.nr_sleepers);
+    proc_printf(s, "next_wake:  %llu\n", st.next_wake);
+}
+
+// Linux /proc/uptime 형식: 가동 시간, idle 시간 (초)
+static void show_uptime(proc_seq_t* s) {
+    uint64_t ns = clock_monotonic_ns();
+    uint32_t rem = div_u64_u32(&ns, 1000000000u);
+
+    uint64_t t[CPUTIME_NR];
+    cputime_cpu_totals(cpu_id(), t, 0, 0);
+    uint32_t isec, ims;
+    cycles_to_sec_ms(t[CPUTIME_IDLE], &isec, &ims);
+
+    proc_printf(s, "%u.%02u %u.%02u\n", (uint32_t)ns, rem / 10000000u, isec, ims / 10);
+}
+
+static void show_kmsg(proc_seq_t* s) {
+    s->len = klog_copy(s->buf, s->size);
+}
+
+void procfs_init(void) {
+    procfs_register("meminfo", show_meminfo);
+    procfs_register("interrupts", show_interrupts);
+    procfs_register("sched", show_sched);
+    procfs_register("threads", show_threads);
+    procfs_register("timer", show_timer);
+    procfs_register("uptime", show_uptime);
+    procfs_register("kmsg", show_kmsg);
+    kprintf("[PROCFS] %u entries\n", g_nr_entries);
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <stdint.h>
+#include "file.h"
+
+// procfs: 읽을 때마다 내용을 새로 만드는 통계 파일
+// - 각 파일은 이름 + show 함수. show는 proc_printf로 버퍼에 텍스트를 쌓는다
+// - procfs_open이 파일당 PROCFS_BUF_SIZE 버퍼를 한 번 할당하고, 읽기는 off == 0일 때
+//   그 버퍼에 다시 생성한 뒤 복사만 한다 (읽기 경로에 할당/콘솔 출력 없음)
+// - 한 번의 생성 결과를 이어 읽으므로 off를 늘려 가며 읽는 동안 내용이 섞이지 않는다
+
+#define PROCFS_BUF_SIZE    8192
+#define PROCFS_MAX_ENTRIES 32
+#define PROCFS_NAME_LEN    16
+
+typedef struct proc_seq {
+    char* buf;
+    uint32_t size;
+    uint32_t len;               // NUL 제외
+    uint32_t overflow;          // 버퍼가 모자라 잘린 바이트 수
+} proc_seq_t;
+
+typedef void (*proc_show_t)(proc_seq_t* s);
+
+// 버퍼 끝에 포맷해 붙임 (넘치면 잘림)
+void proc_printf(proc_seq_t* s, const char* fmt, ...);
+
+// 기본 파일 등록: meminfo, interrupts, sched, threads, timer, uptime, kmsg
+void procfs_init(void);
+
+// 성공 0, 실패 -errno (-EEXIST, -ENOSPC)
+int procfs_register(const char* name, proc_show_t show);
+
+// 없으면 0. 읽기 전용 file_t (file_put으로 닫음)
+file_t* procfs_open(const char* name);
+
+// 파일 이름 목록을 한 줄씩 (kmsg 등 콘솔 명령용)
+void procfs_list(proc_seq_t* s);
+
+// 파일 내용을 콘솔로 출력 (TTY 명령 "cat"). 성공 0, 없으면 -ENOENT
+int procfs_cat(const char* name);
@@ -0,0 +1,156 @@
+#include "shmem.h"
+#include "../memory/heap.h"
+#include "../memory/pmm.h"
+#include "../lib/errno.h"
+#include "../lib/string.h"
+
+typedef struct shmem {
+    uint32_t* pages;                    // 물리 페이지 (0이면 아직 없음 = 0으로 읽힘)
+    uint32_t nr_pages;                  // 최대 페이지 수
+} shmem_t;
+
+static shmem_stats_t g_stats;
+
+// index번째 페이지 (없으면 0으로 채운 새 페이지). 실패 시 0
+static uint32_t page_lookup(shmem_t* sh, uint32_t index) {
+    if (index >= sh->nr_pages) return 0;
+    if (!sh->pages[index]) {
+        uint32_t page = pmm_alloc_frame();
+        if (!page) return 0;
+        memset((void*)page, 0, PAGE_SIZE);
+        sh->pages[index] = page;
+        __sync_fetch_and_add(&g_stats.pages, 1);
+    }
+    return sh->pages[index];
+}
+
+static int32_t shmem_read(file_t* f, void* buf, uint32_t len, uint64_t off) {
+    shmem_t* sh = (shmem_t*)f->priv;
+    if (off >= f->size) return 0;
+
+    uint64_t avail = f->size - off;
+    if (len > avail) len = (uint32_t)avail;
+
+    uint8_t* dst = (uint8_t*)buf;
+    uint32_t pos = (uint32_t)off;
+    uint32_t done = 0;
+    while (done < len) {
+        uint32_t in = pos & (PAGE_SIZE - 1);
+        uint32_t n = PAGE_SIZE - in;
+        if (n > len - done) n = len - done;
+
+        uint32_t page = sh->pages[pos >> PAGE_SHIFT];
+        if (page) memcpy(dst + done, (const uint8_t*)page + in, n);
+        else memset(dst + done, 0, n);
+
+        pos += n;
+        done += n;
+    }
+    __sync_fetch_and_add(&g_stats.bytes_copied, done);
+    return (int32_t)done;
+}
+
+static int32_t shmem_write(file_t* f, const void* buf, uint32_t len, uint64_t off) {
+    shmem_t* sh = (shmem_t*)f->priv;
+    uint64_t cap = (uint64_t)sh->nr_pages * PAGE_SIZE;
+    if (off >= cap) return -ENOSPC;
+    if (len > cap - off) len = (uint32_t)(cap - off);
+
+    const uint8_t* src = (const uint8_t*)buf;
+    uint32_t pos = (uint32_t)off;
+    uint32_t done = 0;
+    while (done < len) {
+        uint32_t in = pos & (PAGE_SIZE - 1);
+        uint32_t n = PAGE_SIZE - in;
+        if (n > len - done) n = len - done;
+
+        uint32_t page = page_lookup(sh, pos >> PAGE_SHIFT);
+        if (!page) break;
+        memcpy((uint8_t*)page + in, src + done, n);
+
+        pos += n;
+        done += n;
+    }
+    if (!done) return -ENOMEM;
+    if (off + done > f->size) f->size = off + done;
+    __sync_fetch_and_add(&g_stats.bytes_copied, done);
+    return (int32_t)done;
+}
+
+static uint32_t shmem_get_page(file_t* f, uint32_t index) {
+    uint32_t page = page_lookup((shmem_t*)f->priv, index);
+    if (!page) return 0;
+    pmm_ref(page);
+    __sync_fetch_and_add(&g_stats.pages_lent, 1);
+    return page;
+}
+
+static uint32_t shmem_find_page(file_t* f, uint32_t index) {
+    shmem_t* sh = (shmem_t*)f->priv;
+    if (index >= sh->nr_pages || !sh->pages[index]) return 0;
+    pmm_ref(sh->pages[index]);
+    return sh->pages[index];
+}
+
+static int32_t shmem_write_page(file_t* f, uint32_t page, uint32_t off, uint32_t len, uint64_t pos) {
+    shmem_t* sh = (shmem_t*)f->priv;
+    uint32_t index = (uint32_t)(pos >> PAGE_SHIFT);
+
+    // 전체 페이지 + 정렬 + 호출자만 참조 중이면 캐시 페이지를 바꿔 끼운다.
+    // 다른 곳(다른 파일의 캐시, 유저 매핑)과 공유 중인 페이지를 끼우면 한쪽의 쓰기가
+    // 다른 쪽에 보이므로 그때는 복사한다. 기존 캐시 페이지가 mmap 되어 있으면(참조 > 1)
+    // 바꿔 끼운 뒤 매핑이 옛 페이지를 계속 보게 되므로 역시 복사한다.
+    uint32_t old = index < sh->nr_pages ? sh->pages[index] : 0;
+    if (off == 0 && len == PAGE_SIZE && (pos & (PAGE_SIZE - 1)) == 0 && index < sh->nr_pages &&
+        pmm_owns(page) && pmm_refcount(page) == 1 && (!old || pmm_refcount(old) == 1)) {
+        pmm_ref(page);
+        sh->pages[index] = page;
+        if (old) pmm_unref(old);
+        else __sync_fetch_and_add(&g_stats.pages, 1);
+        if (pos + PAGE_SIZE > f->size) f->size = pos + PAGE_SIZE;
+        __sync_fetch_and_add(&g_stats.pages_moved, 1);
+        return (int32_t)len;
+    }
+    return shmem_write(f, (const uint8_t*)page + off, len, pos);
+}
+
+static void shmem_release(file_t* f) {
+    shmem_t* sh = (shmem_t*)f->priv;
+    for (uint32_t i = 0; i < sh->nr_pages; i++) {
+        if (!sh->pages[i]) continue;
+        pmm_unref(sh->pages[i]);
+        __sync_fetch_and_sub(&g_stats.pages, 1);
+    }
+    kfree(sh->pages);
+    kfree(sh);
+}
+
+static const file_ops_t g_shmem_ops = {
+    .read = shmem_read,
+    .write = shmem_write,
+    .release = shmem_release,
+    .get_page = shmem_get_page,
+    .write_page = shmem_write_page,
+    .find_page = shmem_find_page,
+};
+
+file_t* shmem_file_create(const char* name, uint32_t max_size) {
+    shmem_t* sh = (shmem_t*)kmalloc(sizeof(shmem_t));
+    if (!sh) return 0;
+    sh->nr_pages = PAGE_ALIGN_UP(max_size) >> PAGE_SHIFT;
+    sh->pages = (uint32_t*)kmalloc(sh->nr_pages * sizeof(uint32_t));
+    if (!sh->pages) {
+        kfree(sh);
+        return 0;
+    }
+    memset(sh->pages, 0, sh->nr_pages * sizeof(uint32_t));
+    return file_alloc(name, &g_shmem_ops, sh, 0);
+}
+
+int shmem_is(file_t* f) {
+    return f->ops == &g_shmem_ops;
+}
+
+void shmem_get_stats(shmem_stats_t* out) {
+    *out = g_stats;
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <stdint.h>
+#include "file.h"
+
+// 페이지 캐시 파일 (tmpfs / 공유 메모리)
+// 내용은 파일 페이지 배열 자체이고 뒤에 저장 장치가 없다. read/write는 페이지에 복사하고,
+// get_page는 페이지를 참조로 빌려준다 (splice로 파이프에 싣기, mmap으로 유저 PTE에 매핑).
+// 캐시가 곧 내용이므로 sync(msync)가 필요 없다.
+// write_page는 페이지 정렬된 전체 페이지이고 호출자만 참조하는 페이지라면 복사 없이
+// 캐시 페이지를 그 페이지로 바꿔 끼운다 (splice SPLICE_F_MOVE).
+
+// max_size 바이트(페이지 단위로 올림)까지 커지는 파일. 실패 시 0
+file_t* shmem_file_create(const char* name, uint32_t max_size);
+
+// f가 shmem 파일이면 1
+int shmem_is(file_t* f);
+
+typedef struct shmem_stats {
+    uint32_t pages;                     // 현재 캐시 페이지 수 (전체 파일)
+    uint32_t pages_moved;               // write_page가 복사 없이 받은 페이지
+    uint32_t pages_lent;                // get_page 호출
+    uint32_t bytes_copied;              // read/write/write_page 복사
+} shmem_stats_t;
+
+void shmem_get_stats(shmem_stats_t* out);
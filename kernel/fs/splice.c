@@ -0,0 +1,235 @@
+#include "splice.h"
+#include "pipe.h"
+#include "shmem.h"
+#include "procfs.h"
+#include "../memory/pmm.h"
+#include "../memory/vma.h"
+#include "../lib/errno.h"
+
+static splice_stats_t g_stats;
+
+// 파일 → 파이프
+static int32_t splice_to_pipe(file_t* in, uint64_t pos, struct pipe* out, uint32_t len) {
+    uint32_t done = 0;
+    int32_t err = 0;
+
+    while (done < len) {
+        uint64_t at = pos + done;
+        uint32_t in_page = (uint32_t)at & (PAGE_SIZE - 1);
+        uint32_t n = PAGE_SIZE - in_page;
+        if (n > len - done) n = len - done;
+
+        if (in->ops->get_page) {
+            // 페이지 캐시: 캐시 페이지 참조를 그대로 싣는다
+            if (at >= in->size) break;
+            if (n > in->size - at) n = (uint32_t)(in->size - at);
+
+            uint32_t page = in->ops->get_page(in, (uint32_t)(at >> PAGE_SHIFT));
+            if (!page) {
+                err = -ENOMEM;
+                break;
+            }
+            int32_t r = pipe_add_page(out, page, in_page, n);
+            if (r < 0) {
+                pmm_unref(page);
+                err = r;
+                break;
+            }
+            g_stats.pages_zero_copy++;
+            g_stats.bytes_zero_copy += n;
+            done += n;
+            continue;
+        }
+
+        // 그 외: 새 페이지에 읽어서 싣는다 (복사 1회)
+        uint32_t page = pmm_alloc_frame();
+        if (!page) {
+            err = -ENOMEM;
+            break;
+        }
+        n = len - done < PAGE_SIZE ? len - done : PAGE_SIZE;
+        int32_t r = file_read(in, (void*)page, n, at);
+        if (r <= 0) {
+            pmm_unref(page);
+            err = r;
+            break;
+        }
+        int32_t w = pipe_add_page(out, page, 0, (uint32_t)r);
+        if (w < 0) {
+            pmm_unref(page);
+            err = w;
+            break;
+        }
+        g_stats.bytes_copied += (uint32_t)r;
+        done += (uint32_t)r;
+
+        // 짧은 읽기(소켓 등)면 더 기다리지 않고 돌아간다
+        if ((uint32_t)r < n) break;
+    }
+    return done ? (int32_t)done : err;
+}
+
+// 파이프 → 파일/소켓/파이프
+static int32_t splice_from_pipe(struct pipe* in, file_t* out, uint64_t pos, uint32_t len) {
+    struct pipe* pout = pipe_from_file(out);
+    uint32_t done = 0;
+    int32_t err = 0;
+
+    while (done < len) {
+        pipe_buf_t b;
+        int32_t r = pipe_take_buf(in, &b, len - done, done == 0);
+        if (r <= 0) {
+            if (r < 0 && r != -EAGAIN) err = r;
+            break;
+        }
+
+        if (pout) {
+            // 슬롯 참조 이동
+            r = pipe_add_page(pout, b.page, b.off, b.len);
+            if (r < 0) {
+                pmm_unref(b.page);
+                err = r;
+                break;
+            }
+            g_stats.pages_zero_copy++;
+            g_stats.bytes_zero_copy += b.len;
+        } else if (out->ops->write_page) {
+            r = out->ops->write_page(out, b.page, b.off, b.len, pos + done);
+            pmm_unref(b.page);
+            if (r <= 0) {
+                err = r < 0 ? r : -EIO;
+                break;
+            }
+            g_stats.pages_zero_copy++;
+            g_stats.bytes_zero_copy += (uint32_t)r;
+        } else {
+            r = file_write(out, (const void*)(b.page + b.off), b.len, pos + done);
+            pmm_unref(b.page);
+            if (r <= 0) {
+                err = r < 0 ? r : -EIO;
+                break;
+            }
+            g_stats.bytes_copied += (uint32_t)r;
+        }
+        // 짧게 쓰였으면 파이프에서 꺼낸 나머지는 버려진다 (write()의 부분 쓰기와 같음)
+        done += (uint32_t)r;
+        if ((uint32_t)r < b.len) break;
+    }
+    return done ? (int32_t)done : err;
+}
+
+int32_t splice(file_t* in, uint64_t* off_in, file_t* out, uint64_t* off_out, uint32_t len) {
+    struct pipe* pin = pipe_from_file(in);
+    struct pipe* pout = pipe_from_file(out);
+    if (!pin && !pout) return -EINVAL;
+    if ((pin && off_in) || (pout && off_out)) return -EINVAL;
+    if (len == 0) return 0;
+
+    g_stats.calls++;
+    int32_t r;
+    if (pin) {
+        r = splice_from_pipe(pin, out, off_out ? *off_out : 0, len);
+        if (r > 0 && off_out) *off_out += (uint32_t)r;
+    } else {
+        r = splice_to_pipe(in, off_in ? *off_in : 0, pout, len);
+        if (r > 0 && off_in) *off_in += (uint32_t)r;
+    }
+    return r;
+}
+
+int32_t vmsplice(file_t* pipe, const void* buf, uint32_t len) {
+    struct pipe* p = pipe_from_file(pipe);
+    if (!p) return -EINVAL;
+
+    vm_space_t* vs = vm_current_space();
+    uint32_t addr = (uint32_t)buf;
+    uint32_t done = 0;
+    int32_t err = 0;
+    g_stats.calls++;
+
+    while (done < len) {
+        uint32_t a = addr + done;
+        uint32_t n = PAGE_SIZE - (a & (PAGE_SIZE - 1));
+        if (n > len - done) n = len - done;
+        int user = a >= USER_SPACE_START;
+
+        // 전체 페이지: 참조로 싣는다 (유저 페이지는 COW로 공유, 커널은 pmm 프레임일 때만)
+        uint32_t page = 0;
+        if (n == PAGE_SIZE) {
+            if (user) {
+                page = vm_share_user_page(vs, a);
+                if (!page) {
+                    err = -EFAULT;
+                    break;
+                }
+            } else if (pmm_owns(a)) {
+                pmm_ref(a);
+                page = a;
+            }
+        }
+        if (page) {
+            int32_t r = pipe_add_page(p, page, 0, PAGE_SIZE);
+            if (r < 0) {
+                pmm_unref(page);
+                err = r;
+                break;
+            }
+            g_stats.pages_zero_copy++;
+            g_stats.bytes_zero_copy += PAGE_SIZE;
+            done += n;
+            continue;
+        }
+
+        // 부분 페이지 (또는 refcount가 없는 커널 메모리): 복사
+        int32_t r;
+        if (user) {
+            uint32_t copy = pmm_alloc_frame();
+            if (!copy) {
+                err = -ENOMEM;
+                break;
+            }
+            if (vm_copy_from(vs, (void*)copy, a, n) < 0) {
+                pmm_unref(copy);
+                err = -EFAULT;
+                break;
+            }
+            r = pipe_add_page(p, copy, 0, n);
+            if (r < 0) pmm_unref(copy);
+        } else {
+            r = pipe_write_copy(p, (const void*)a, n);
+        }
+        if (r <= 0) {
+            err = r < 0 ? r : -EPIPE;
+            break;
+        }
+        g_stats.bytes_copied += (uint32_t)r;
+        done += (uint32_t)r;
+    }
+    return done ? (int32_t)done : err;
+}
+
+void splice_get_stats(splice_stats_t* out) {
+    *out = g_stats;
+}
+
+// procfs "splice"
+static void show_splice(proc_seq_t* s) {
+    pipe_stats_t ps;
+    shmem_stats_t sh;
+    pipe_get_stats(&ps);
+    shmem_get_stats(&sh);
+
+    proc_printf(s, "pipes created:    %u\n", ps.created);
+    proc_printf(s, "pipe copy in/out: %u / %u B\n", ps.bytes_copied_in, ps.bytes_copied_out);
+    proc_printf(s, "pipe pages:       %u allocated, %u referenced\n", ps.pages_allocated, ps.pages_referenced);
+    proc_printf(s, "pipe waits:       %u reader, %u writer\n", ps.reader_waits, ps.writer_waits);
+    proc_printf(s, "splice calls:     %u\n", g_stats.calls);
+    proc_printf(s, "splice zero-copy: %u pages, %u B\n", g_stats.pages_zero_copy, g_stats.bytes_zero_copy);
+    proc_printf(s, "splice copied:    %u B\n", g_stats.bytes_copied);
+    proc_printf(s, "shmem pages:      %u (moved in %u, lent %u)\n", sh.pages, sh.pages_moved, sh.pages_lent);
+    proc_printf(s, "shmem copied:     %u B\n", sh.bytes_copied);
+}
+
+void splice_init(void) {
+    procfs_register("splice", show_splice);
+}
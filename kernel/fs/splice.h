@@ -0,0 +1,37 @@
+#pragma once
+#include <stdint.h>
+#include "file.h"
+
+// splice / vmsplice: 파이프를 중간 버퍼로 삼아 페이지를 참조째 옮긴다
+// - 파일 → 파이프: get_page가 있는 파일(페이지 캐시)은 캐시 페이지 참조를 싣는다 (복사 0회).
+//   없으면 새 페이지에 read (복사 1회)
+// - 파이프 → 파일/소켓: write_page가 있으면 페이지 참조를 넘긴다 (소켓 송신 버퍼, 캐시 페이지 교체).
+//   없으면 write 복사
+// - 파이프 → 파이프: 슬롯 참조 이동
+// - 부분 페이지만 복사로 처리된다. 캐시 페이지 교체는 정렬된 전체 페이지이고 파이프만 참조하는
+//   페이지일 때 (Linux SPLICE_F_MOVE에 해당, 조건이 맞으면 항상 옮긴다)
+
+// in 또는 out 중 하나는 파이프 (파이프 쪽 off는 0이어야 함). 파이프가 아닌 쪽은 *off에서
+// 읽고/쓰고 *off를 전진 (off가 0이면 위치 0: 소켓 등).
+// 파이프가 비면 첫 조각은 기다리고, 이후에는 있는 만큼만 옮기고 돌아온다.
+// 옮긴 바이트 수 (입력이 EOF면 0), 실패 시 -errno
+int32_t splice(file_t* in, uint64_t* off_in, file_t* out, uint64_t* off_out, uint32_t len);
+
+// buf(현재 주소 공간의 유저 주소 또는 커널 주소)를 파이프에 싣는다.
+// 페이지 전체가 들어가는 구간은 페이지 참조로 (유저 페이지는 COW로 공유), 나머지는 복사
+int32_t vmsplice(file_t* pipe, const void* buf, uint32_t len);
+
+typedef struct splice_stats {
+    uint32_t calls;
+    uint32_t pages_zero_copy;           // 참조로 옮긴 페이지 조각
+    uint32_t bytes_zero_copy;
+    uint32_t bytes_copied;              // 복사로 대신한 바이트
+} splice_stats_t;
+
+void splice_get_stats(splice_stats_t* out);
+
+// procfs "splice" 등록 (pipe/splice/shmem 카운터)
+void splice_init(void);
+
+// pipe/splice 처리량 비교 (write+read vs vmsplice+splice, read+send vs splice → socket)
+void splice_bench(void);
@@ -0,0 +1,208 @@
+#include "splice.h"
+#include "pipe.h"
+#include "shmem.h"
+#include "../net/net.h"
+#include "../net/socket.h"
+#include "../sched/thread.h"
+#include "../sync/semaphore.h"
+#include "../memory/heap.h"
+#include "../memory/pmm.h"
+#include "../lib/div64.h"
+#include "../lib/cmdline.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/tsc.h"
+
+// 4MB를 각 경로로 옮긴 시간으로 MB/s 비교
+#define SB_TOTAL    (4u * 1024 * 1024)
+#define SB_CHUNK    (16u * 1024)
+#define SB_PIPE_MAX (PIPE_BUFFERS * PAGE_SIZE)
+#define SB_TCP_PORT 5010
+
+static semaphore_t g_done;
+static file_t* g_wr;
+static uint32_t g_sink_bytes;
+
+static uint32_t mb_per_sec(uint32_t bytes, uint64_t cycles) {
+    uint64_t us = tsc_cycles_to_us(cycles);
+    if (us == 0) us = 1;
+    uint64_t bps = (uint64_t)bytes * 1000000ull;
+    div_u64_u32(&bps, (uint32_t)us);
+    return (uint32_t)(bps >> 20);
+}
+
+// ---- 1) write() → read(): 바이트마다 두 번 복사 ----
+static void copy_writer(void* arg) {
+    (void)arg;
+    uint8_t* buf = (uint8_t*)kmalloc(SB_CHUNK);
+    for (uint32_t i = 0; i < SB_CHUNK; i++) buf[i] = (uint8_t)i;
+    for (uint32_t sent = 0; sent < SB_TOTAL; sent += SB_CHUNK) {
+        if (file_write(g_wr, buf, SB_CHUNK, 0) < 0) break;
+    }
+    kfree(buf);
+    file_put(g_wr);
+    sem_up(&g_done);
+}
+
+// ---- 2) vmsplice(페이지 넘김) → splice → 페이지 캐시 파일: 복사 0회 ----
+static void gift_writer(void* arg) {
+    (void)arg;
+    for (uint32_t sent = 0; sent < SB_TOTAL; sent += PAGE_SIZE) {
+        uint32_t page = pmm_alloc_frame();
+        if (!page) break;
+        *(uint32_t*)page = sent;
+        int32_t r = vmsplice(g_wr, (const void*)page, PAGE_SIZE);
+        // 자기 참조를 놓으면 파이프만 남은 소유자가 되어 캐시에 그대로 끼워질 수 있다
+        pmm_unref(page);
+        if (r < 0) break;
+    }
+    file_put(g_wr);
+    sem_up(&g_done);
+}
+
+static void bench_pipe(file_t* shm) {
+    file_t* rd;
+    if (pipe_create(&rd, &g_wr) < 0) return;
+
+    uint8_t* buf = (uint8_t*)kmalloc(SB_CHUNK);
+    uint32_t got = 0;
+    uint64_t t0 = rdtsc();
+    thread_create("pipe-writer", copy_writer, 0, PRIO_NORMAL);
+    for (;;) {
+        int32_t n = file_read(rd, buf, SB_CHUNK, 0);
+        if (n <= 0) break;
+        got += (uint32_t)n;
+    }
+    sem_down(&g_done);
+    uint64_t copy_cycles = rdtsc() - t0;
+    file_put(rd);
+    kfree(buf);
+
+    if (pipe_create(&rd, &g_wr) < 0) return;
+    shmem_stats_t before, after;
+    shmem_get_stats(&before);
+    uint64_t off = 0;
+    t0 = rdtsc();
+    thread_create("pipe-gift", gift_writer, 0, PRIO_NORMAL);
+    for (;;) {
+        int32_t n = splice(rd, 0, shm, &off, SB_PIPE_MAX);
+        if (n <= 0) break;
+    }
+    sem_down(&g_done);
+    uint64_t move_cycles = rdtsc() - t0;
+    file_put(rd);
+    shmem_get_stats(&after);
+
+    // 페이지 순서 확인: 각 페이지 첫 word = 스트림 오프셋
+    uint32_t bad = 0;
+    for (uint32_t at = 0; at < (uint32_t)off; at += 64 * PAGE_SIZE) {
+        uint32_t v = 0;
+        file_read(shm, &v, sizeof(v), at);
+        if (v != at) bad++;
+    }
+
+    kprintf("[SPLICE] write+read   %u KB: %u MB/s\n", got >> 10, mb_per_sec(got, copy_cycles));
+    kprintf("[SPLICE] vmsplice+splice->shmem %u KB: %u MB/s (moved %u pages, copied %u B, bad %u)\n",
+        (uint32_t)off >> 10, mb_per_sec((uint32_t)off, move_cycles),
+        after.pages_moved - before.pages_moved, after.bytes_copied - before.bytes_copied, bad);
+}
+
+// ---- 3) 페이지 캐시 파일 → TCP: read+send vs splice(file→pipe→socket) ----
+static void tcp_sink(void* arg) {
+    sock_t* ls = (sock_t*)arg;
+    int err;
+    sock_t* c = sock_accept(ls, &err);
+    uint32_t total = 0;
+    if (c) {
+        uint8_t* buf = (uint8_t*)kmalloc(SB_CHUNK);
+        for (;;) {
+            int32_t n = sock_recv(c, buf, SB_CHUNK);
+            if (n <= 0) break;
+            total += (uint32_t)n;
+        }
+        kfree(buf);
+        sock_close(c);
+    }
+    g_sink_bytes = total;
+    sem_up(&g_done);
+}
+
+static uint32_t bench_sendfile(file_t* shm, uint16_t port, int use_splice) {
+    sock_t* ls = sock_create(SOCK_STREAM);
+    if (sock_bind(ls, port) < 0 || sock_listen(ls, 1) < 0) {
+        sock_close(ls);
+        return 0;
+    }
+    thread_create("splice-sink", tcp_sink, ls, PRIO_NORMAL + 1);
+
+    sock_t* s = sock_create(SOCK_STREAM);
+    if (sock_connect(s, IP4_LOOPBACK, port) < 0) {
+        sock_close(s);
+        sock_close(ls);
+        sem_down(&g_done);
+        return 0;
+    }
+    file_t* sf = sock_file_open(s);
+
+    uint64_t size = shm->size;
+    uint64_t off = 0;
+    uint64_t t0 = rdtsc();
+    if (use_splice) {
+        file_t *rd, *wr;
+        pipe_create(&rd, &wr);
+        while (off < size) {
+            // 파이프 용량만큼 싣고 바로 소켓으로 비운다 (같은 스레드라 파이프가 차면 안 됨)
+            int32_t n = splice(shm, &off, wr, 0, SB_PIPE_MAX);
+            if (n <= 0) break;
+            while (n > 0) {
+                int32_t m = splice(rd, 0, sf, 0, (uint32_t)n);
+                if (m <= 0) break;
+                n -= m;
+            }
+        }
+        file_put(wr);
+        file_put(rd);
+    } else {
+        uint8_t* buf = (uint8_t*)kmalloc(SB_CHUNK);
+        while (off < size) {
+            int32_t n = file_read(shm, buf, SB_CHUNK, off);
+            if (n <= 0) break;
+            if (file_write(sf, buf, (uint32_t)n, 0) != n) break;
+            off += (uint32_t)n;
+        }
+        kfree(buf);
+    }
+    file_put(sf);
+    sem_down(&g_done);
+    uint64_t cycles = rdtsc() - t0;
+    sock_close(ls);
+    return mb_per_sec(g_sink_bytes, cycles);
+}
+
+static void splice_bench_thread(void* arg) {
+    (void)arg;
+    sem_init(&g_done, 0);
+
+    file_t* shm = shmem_file_create("splice-shm", SB_TOTAL);
+    bench_pipe(shm);
+
+    uint32_t copy = bench_sendfile(shm, SB_TCP_PORT, 0);
+    uint32_t copy_bytes = g_sink_bytes;
+    uint32_t zc = bench_sendfile(shm, SB_TCP_PORT + 1, 1);
+    kprintf("[SPLICE] shmem->tcp %u KB: read+send %u MB/s, splice %u MB/s (recv %u/%u KB)\n",
+        (uint32_t)shm->size >> 10, copy, zc, copy_bytes >> 10, g_sink_bytes >> 10);
+
+    splice_stats_t ss;
+    splice_get_stats(&ss);
+    kprintf("[SPLICE] calls=%u zero-copy %u pages / %u KB, copied %u KB\n",
+        ss.calls, ss.pages_zero_copy, ss.bytes_zero_copy >> 10, ss.bytes_copied >> 10);
+    file_put(shm);
+}
+
+void splice_bench(void) {
+    if (!cmdline_bench("splice")) return;
+    if (tsc_hz() == 0) {
+        kprintf("[SPLICE] TSC not calibrated\n");
+        return;
+    }
+    thread_create("splice-bench", splice_bench_thread, 0, PRIO_NORMAL);
+}
@@ -0,0 +1,412 @@
+#include "uring.h"
+#include "../fs/file.h"
+#include "../proc/process.h"
+#include "../memory/heap.h"
+#include "../memory/pmm.h"
+#include "../memory/vma.h"
+#include "../sched/thread.h"
+#include "../sched/wait.h"
+#include "../sched/workqueue.h"
+#include "../time/time.h"
+#include "../sync/semaphore.h"
+#include "../lib/errno.h"
+#include "../lib/string.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/irqflags.h"
+
+#define load_acquire(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define store_release(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+// 다른 주소 공간의 버퍼는 bounce 버퍼로 복사하므로 한 번에 처리할 최대 크기
+#define IORING_MAX_IO (64u * 1024)
+
+struct io_ring {
+    uint32_t id;
+    uint32_t flags;
+
+    // 공유 영역 (커널은 identity map 주소로 접근)
+    io_rings_t* rings;
+    io_uring_sqe_t* sqes;
+    io_uring_cqe_t* cqes;
+    uint32_t sq_mask;
+    uint32_t cq_mask;
+    uint32_t* frames;
+    uint32_t nr_frames;
+
+    vm_space_t* vs;             // 버퍼 주소 해석용 (0이면 커널 주소)
+    uint32_t user_addr;
+
+    file_t* files[IORING_MAX_FILES];
+    uint32_t nr_files;
+
+    wait_queue_t cq_wait;       // min_complete / destroy 대기
+    volatile uint32_t inflight;
+
+    // SQPOLL: poll 스레드가 sq_tail을 감시, 한동안 비면 NEED_WAKEUP을 켜고 잠듦
+    thread_t* sq_thread;
+    wait_queue_t sq_wait;
+    volatile int sq_stop;
+    semaphore_t sq_exited;
+
+    uint32_t enters;
+    uint32_t submitted;
+    uint32_t completed;
+    uint32_t sq_wakeups;
+};
+
+// SQE 하나에 대응하는 커널 요청 (workqueue에서 실행)
+typedef struct io_req {
+    delayed_work_t dwork;       // 첫 멤버 (work → req 캐스트)
+    io_ring_t* ring;
+    io_uring_sqe_t sqe;
+} io_req_t;
+
+static io_ring_t* g_rings[IORING_MAX_RINGS];
+static workqueue_t* g_io_wq = 0;
+
+static uint32_t roundup_pow2(uint32_t v) {
+    uint32_t p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+// CQE 기록 (여러 worker가 동시에 완료할 수 있으므로 인터럽트 off 구간에서)
+static void io_post_cqe(io_ring_t* ring, uint64_t user_data, int32_t res) {
+    uint32_t f = irq_save();
+
+    io_rings_t* r = ring->rings;
+    uint32_t tail = r->cq_tail;
+    if (tail - load_acquire(&r->cq_head) > ring->cq_mask) {
+        // 소비자가 CQ를 비우지 않음: 완료는 버리고 개수만 알린다
+        r->cq_overflow++;
+    } else {
+        io_uring_cqe_t* cqe = &ring->cqes[tail & ring->cq_mask];
+        cqe->user_data = user_data;
+        cqe->res = res;
+        cqe->flags = 0;
+        store_release(&r->cq_tail, tail + 1);
+    }
+
+    ring->completed++;
+    ring->inflight--;
+    if (!wait_queue_empty(&ring->cq_wait)) wake_up_all(&ring->cq_wait);
+
+    irq_restore(f);
+}
+
+static int32_t io_rw(io_ring_t* ring, const io_uring_sqe_t* sqe) {
+    if (sqe->fd < 0 || (uint32_t)sqe->fd >= ring->nr_files || !ring->files[sqe->fd]) return -EBADF;
+    file_t* file = ring->files[sqe->fd];
+    int write = (sqe->opcode == IORING_OP_WRITE);
+
+    // 커널 링: 버퍼를 그대로 사용
+    if (!ring->vs) {
+        return write ? file_write(file, (const void*)sqe->addr, sqe->len, sqe->off)
+                     : file_read(file, (void*)sqe->addr, sqe->len, sqe->off);
+    }
+
+    // 프로세스 링: worker는 다른 주소 공간에서 돌 수 있으므로 page table을 따라 복사
+    if (sqe->len > IORING_MAX_IO) return -EINVAL;
+    uint8_t* bounce = (uint8_t*)kmalloc(sqe->len ? sqe->len : 1);
+    int32_t res;
+
+    if (write) {
+        res = vm_copy_from(ring->vs, bounce, sqe->addr, sqe->len);
+        if (res == 0) res = file_write(file, bounce, sqe->len, sqe->off);
+    } else {
+        res = file_read(file, bounce, sqe->len, sqe->off);
+        if (res > 0) {
+            int rc = vm_copy_to(ring->vs, sqe->addr, bounce, (uint32_t)res);
+            if (rc) res = rc;
+        }
+    }
+
+    kfree(bounce);
+    return res;
+}
+
+static void io_req_work(work_t* w) {
+    io_req_t* req = (io_req_t*)w;
+    int32_t res;
+
+    switch (req->sqe.opcode) {
+        case IORING_OP_READ:
+        case IORING_OP_WRITE:
+            res = io_rw(req->ring, &req->sqe);
+            break;
+        case IORING_OP_TIMEOUT:
+            res = -ETIME;
+            break;
+        default:
+            res = -EINVAL;
+            break;
+    }
+
+    io_post_cqe(req->ring, req->sqe.user_data, res);
+    kfree(req);
+}
+
+// SQE 하나 처리 시작 (NOP/잘못된 요청은 즉시 완료)
+static void io_issue(io_ring_t* ring, const io_uring_sqe_t* sqe) {
+    __sync_fetch_and_add(&ring->inflight, 1);
+
+    switch (sqe->opcode) {
+        case IORING_OP_NOP:
+            io_post_cqe(ring, sqe->user_data, 0);
+            return;
+        case IORING_OP_READ:
+        case IORING_OP_WRITE:
+        case IORING_OP_TIMEOUT:
+            break;
+        default:
+            io_post_cqe(ring, sqe->user_data, -EINVAL);
+            return;
+    }
+
+    io_req_t* req = (io_req_t*)kmalloc(sizeof(io_req_t));
+    delayed_work_init(&req->dwork, io_req_work);
+    req->ring = ring;
+    req->sqe = *sqe;
+
+    if (sqe->opcode == IORING_OP_TIMEOUT) {
+        queue_delayed_work(g_io_wq, &req->dwork, (uint32_t)sqe->off);
+    } else {
+        queue_work(g_io_wq, &req->dwork.work);
+    }
+}
+
+// SQ에서 최대 max개를 꺼내 처리. SQ 소비자는 항상 하나 (enter 또는 SQPOLL 스레드)
+static uint32_t io_submit_sqes(io_ring_t* ring, uint32_t max) {
+    io_rings_t* r = ring->rings;
+    uint32_t head = r->sq_head;
+    uint32_t tail = load_acquire(&r->sq_tail);
+    uint32_t avail = tail - head;
+    if (avail > ring->sq_mask + 1) avail = ring->sq_mask + 1;   // 망가진 tail 방어
+    if (avail > max) avail = max;
+
+    for (uint32_t i = 0; i < avail; i++) {
+        // 유저가 슬롯을 다시 채우기 전에 복사해 둔다
+        io_uring_sqe_t sqe = ring->sqes[(head + i) & ring->sq_mask];
+        store_release(&r->sq_head, head + i + 1);
+        io_issue(ring, &sqe);
+    }
+
+    ring->submitted += avail;
+    return avail;
+}
+
+static void io_sq_thread(void* arg) {
+    io_ring_t* ring = (io_ring_t*)arg;
+    io_rings_t* r = ring->rings;
+    uint64_t last_work = timer_ticks();
+
+    while (!ring->sq_stop) {
+        if (io_submit_sqes(ring, ~0u)) {
+            last_work = timer_ticks();
+            thread_yield();
+            continue;
+        }
+
+        if (timer_ticks() - last_work < IORING_SQPOLL_IDLE) {
+            thread_yield();
+            continue;
+        }
+
+        // 잠들기 전 플래그를 먼저 켜고 SQ를 다시 확인 (그 사이 올라온 tail을 놓치지 않도록)
+        uint32_t f = irq_save();
+        __atomic_or_fetch(&r->sq_flags, IORING_SQ_NEED_WAKEUP, __ATOMIC_SEQ_CST);
+        if (load_acquire(&r->sq_tail) == r->sq_head && !ring->sq_stop) {
+            wait_queue_sleep(&ring->sq_wait);
+        }
+        __atomic_and_fetch(&r->sq_flags, ~IORING_SQ_NEED_WAKEUP, __ATOMIC_SEQ_CST);
+        irq_restore(f);
+
+        last_work = timer_ticks();
+    }
+
+    sem_up(&ring->sq_exited);
+}
+
+int32_t io_uring_enter(io_ring_t* ring, uint32_t to_submit, uint32_t min_complete, uint32_t flags) {
+    ring->enters++;
+    int32_t submitted = 0;
+
+    if (ring->flags & IORING_SETUP_SQPOLL) {
+        // 제출은 poll 스레드 몫: 잠들어 있으면 깨우기만
+        if (flags & IORING_ENTER_SQ_WAKEUP) {
+            ring->sq_wakeups++;
+            wake_up_one(&ring->sq_wait);
+        }
+        submitted = (int32_t)to_submit;
+    } else if (to_submit) {
+        submitted = (int32_t)io_submit_sqes(ring, to_submit);
+    }
+
+    if ((flags & IORING_ENTER_GETEVENTS) && min_complete) {
+        io_rings_t* r = ring->rings;
+        if (min_complete > ring->cq_mask + 1) min_complete = ring->cq_mask + 1;
+
+        uint32_t f = irq_save();
+        while (load_acquire(&r->cq_tail) - r->cq_head < min_complete) {
+            wait_queue_sleep(&ring->cq_wait);
+        }
+        irq_restore(f);
+    }
+
+    return submitted;
+}
+
+io_ring_t* io_uring_setup(uint32_t entries, uint32_t flags, process_t* proc, io_uring_params_t* out) {
+    if (entries == 0 || entries > IORING_MAX_ENTRIES) return 0;
+    if (!g_io_wq) {
+        kprintf("[URING] setup before io_uring_init\n");
+        return 0;
+    }
+
+    uint32_t id = 0;
+    while (id < IORING_MAX_RINGS && g_rings[id]) id++;
+    if (id == IORING_MAX_RINGS) return 0;
+
+    uint32_t sq_entries = roundup_pow2(entries);
+    uint32_t cq_entries = sq_entries * 2;
+
+    // [header 페이지][SQE 배열][CQE 배열], 모두 페이지 정렬
+    uint32_t sqes_off = PAGE_SIZE;
+    uint32_t cqes_off = sqes_off + PAGE_ALIGN_UP(sq_entries * sizeof(io_uring_sqe_t));
+    uint32_t size = cqes_off + PAGE_ALIGN_UP(cq_entries * sizeof(io_uring_cqe_t));
+    uint32_t nr_frames = size / PAGE_SIZE;
+
+    // 커널 쪽은 identity map 주소를 쓰므로 물리적으로 연속인 프레임이 필요
+    uint32_t phys = pmm_alloc_contiguous(nr_frames);
+    if (!phys) {
+        kprintf("[URING] setup: no contiguous frames for %u pages\n", nr_frames);
+        return 0;
+    }
+    uint32_t* frames = (uint32_t*)kmalloc(nr_frames * sizeof(uint32_t));
+    for (uint32_t i = 0; i < nr_frames; i++) frames[i] = phys + i * PAGE_SIZE;
+
+    io_ring_t* ring = (io_ring_t*)kmalloc(sizeof(io_ring_t));
+    memset(ring, 0, sizeof(io_ring_t));
+    ring->id = id;
+    ring->flags = flags;
+    ring->frames = frames;
+    ring->nr_frames = nr_frames;
+
+    uint8_t* base = (uint8_t*)frames[0];
+    memset(base, 0, size);
+    ring->rings = (io_rings_t*)base;
+    ring->sqes = (io_uring_sqe_t*)(base + sqes_off);
+    ring->cqes = (io_uring_cqe_t*)(base + cqes_off);
+    ring->sq_mask = sq_entries - 1;
+    ring->cq_mask = cq_entries - 1;
+
+    io_rings_t* r = ring->rings;
+    r->sq_entries = sq_entries;
+    r->cq_entries = cq_entries;
+    r->sqes_off = sqes_off;
+    r->cqes_off = cqes_off;
+
+    wait_queue_init(&ring->cq_wait);
+    wait_queue_init(&ring->sq_wait);
+    sem_init(&ring->sq_exited, 0);
+
+    uint32_t addr = (uint32_t)base;
+    if (proc) {
+        addr = IORING_USER_BASE + id * IORING_USER_STRIDE;
+        if (!vm_map_shared(proc->vm, addr, frames, nr_frames, VMA_READ | VMA_WRITE)) {
+            kprintf("[URING] setup: cannot map ring at 0x%x\n", addr);
+            for (uint32_t j = 0; j < nr_frames; j++) pmm_unref(frames[j]);
+            kfree(frames);
+            kfree(ring);
+            return 0;
+        }
+        ring->vs = proc->vm;
+    }
+    ring->user_addr = addr;
+
+    g_rings[id] = ring;
+
+    if (flags & IORING_SETUP_SQPOLL) {
+        char name[THREAD_NAME_LEN];
+        ksnprintf(name, sizeof(name), "io_sqpoll/%u", id);
+        ring->sq_thread = thread_create(name, io_sq_thread, ring, PRIO_NORMAL);
+    }
+
+    if (out) {
+        out->ring_id = id;
+        out->addr = addr;
+        out->size = size;
+        out->sq_entries = sq_entries;
+        out->cq_entries = cq_entries;
+    }
+
+    kprintf("[URING] ring %u: sq=%u cq=%u pages=%u addr=0x%x%s\n",
+        id, sq_entries, cq_entries, nr_frames, addr,
+        (flags & IORING_SETUP_SQPOLL) ? " sqpoll" : "");
+    return ring;
+}
+
+void io_uring_destroy(io_ring_t* ring) {
+    if (ring->sq_thread) {
+        ring->sq_stop = 1;
+        wake_up_one(&ring->sq_wait);
+        sem_down(&ring->sq_exited);
+    }
+
+    // 진행 중인 요청(타이머 포함)이 모두 완료될 때까지
+    uint32_t f = irq_save();
+    while (ring->inflight) {
+        wait_queue_sleep(&ring->cq_wait);
+    }
+    g_rings[ring->id] = 0;
+    irq_restore(f);
+
+    for (uint32_t i = 0; i < ring->nr_files; i++) {
+        if (ring->files[i]) file_put(ring->files[i]);
+    }
+
+    // 프로세스 매핑은 주소 공간이 사라질 때 자기 참조를 푼다
+    for (uint32_t i = 0; i < ring->nr_frames; i++) pmm_unref(ring->frames[i]);
+    kfree(ring->frames);
+    kfree(ring);
+}
+
+io_ring_t* io_uring_get(uint32_t ring_id) {
+    return ring_id < IORING_MAX_RINGS ? g_rings[ring_id] : 0;
+}
+
+io_ring_t* io_uring_get_owned(uint32_t ring_id, process_t* proc) {
+    io_ring_t* ring = io_uring_get(ring_id);
+    if (!ring || ring->vs != (proc ? proc->vm : 0)) return 0;
+    return ring;
+}
+
+void io_uring_exit(process_t* proc) {
+    for (uint32_t i = 0; i < IORING_MAX_RINGS; i++) {
+        io_ring_t* ring = g_rings[i];
+        if (ring && ring->vs == proc->vm) io_uring_destroy(ring);
+    }
+}
+
+int io_uring_register_files(io_ring_t* ring, file_t** files, uint32_t n) {
+    if (ring->nr_files || n > IORING_MAX_FILES) return -EBUSY;
+
+    for (uint32_t i = 0; i < n; i++) {
+        ring->files[i] = files[i];
+        if (files[i]) file_get(files[i]);
+    }
+    ring->nr_files = n;
+    return 0;
+}
+
+void io_uring_init(void) {
+    for (uint32_t i = 0; i < IORING_MAX_RINGS; i++) g_rings[i] = 0;
+    g_io_wq = workqueue_create("io_uring");
+}
+
+void io_uring_dump(io_ring_t* ring) {
+    io_rings_t* r = ring->rings;
+    kprintf("[URING] ring %u: enters=%u submitted=%u completed=%u inflight=%u overflow=%u sq_wakeups=%u\n",
+        ring->id, ring->enters, ring->submitted, ring->completed, ring->inflight,
+        r->cq_overflow, ring->sq_wakeups);
+}
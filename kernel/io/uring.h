@@ -0,0 +1,158 @@
+#pragma once
+#include <stdint.h>
+#include "../../arch/x86/cpu/cache.h"
+
+// io_uring 방식 비동기 I/O
+// - 제출 큐(SQ)와 완료 큐(CQ)는 커널과 프로세스가 함께 매핑하는 페이지에 있다
+// - 유저는 SQE를 채우고 sq_tail만 올린 뒤 SYS_IO_URING_ENTER 한 번으로 여러 개를 제출
+//   (IORING_SETUP_SQPOLL이면 커널 poll 스레드가 sq_tail을 감시하므로 시스템 콜도 필요 없음)
+// - 커널은 workqueue에서 I/O를 실행하고 cq_tail을 올려 완료를 알린다
+// head/tail은 계속 증가하는 32비트 카운터, 슬롯은 (index & mask)
+
+#define IORING_MAX_ENTRIES 256
+#define IORING_MAX_RINGS   8
+#define IORING_MAX_FILES   16
+
+// 프로세스 주소 공간에 매핑되는 위치 (ring id마다 1MB 창)
+#define IORING_USER_BASE   0xB0000000u
+#define IORING_USER_STRIDE 0x00100000u
+
+// io_uring_setup flags
+#define IORING_SETUP_SQPOLL 0x1
+
+// SQPOLL 스레드가 잠들기 전 빈 poll을 유지하는 시간 (tick)
+#define IORING_SQPOLL_IDLE 50
+
+// rings->sq_flags
+#define IORING_SQ_NEED_WAKEUP 0x1
+
+// enter flags
+#define IORING_ENTER_GETEVENTS  0x1
+#define IORING_ENTER_SQ_WAKEUP  0x2
+
+// opcode
+#define IORING_OP_NOP     0
+#define IORING_OP_READ    1     // files[fd]의 off 위치에서 addr로 len 바이트
+#define IORING_OP_WRITE   2
+#define IORING_OP_TIMEOUT 3     // off tick 뒤 -ETIME으로 완료
+
+typedef struct io_uring_sqe {
+    uint8_t opcode;
+    uint8_t flags;
+    uint16_t ioprio;
+    int32_t fd;                 // 등록된 파일 번호 (io_uring_register_files 순서)
+    uint64_t off;
+    uint32_t addr;              // 버퍼 (링 소유자의 주소 공간)
+    uint32_t len;
+    uint64_t user_data;         // CQE로 그대로 돌려줌
+} io_uring_sqe_t;
+
+typedef struct io_uring_cqe {
+    uint64_t user_data;
+    int32_t res;                // 바이트 수 또는 -errno
+    uint32_t flags;
+} io_uring_cqe_t;
+
+// 공유 영역 첫 페이지. 생산자/소비자가 쓰는 인덱스는 서로 다른 캐시 라인에 둔다.
+typedef struct io_rings {
+    uint32_t sq_head __cacheline_aligned;   // 커널이 씀
+    uint32_t sq_tail __cacheline_aligned;   // 유저가 씀
+    uint32_t sq_flags;                      // IORING_SQ_NEED_WAKEUP (커널이 씀)
+    uint32_t cq_head __cacheline_aligned;   // 유저가 씀
+    uint32_t cq_tail __cacheline_aligned;   // 커널이 씀
+    uint32_t cq_overflow;
+
+    uint32_t sq_entries __cacheline_aligned;
+    uint32_t cq_entries;
+    uint32_t sqes_off;                      // 영역 시작 기준 SQE 배열 위치
+    uint32_t cqes_off;
+} io_rings_t;
+
+// SYS_IO_URING_SETUP이 채워 주는 값
+typedef struct io_uring_params {
+    uint32_t ring_id;
+    uint32_t addr;              // 공유 영역 시작 (호출자 주소 공간)
+    uint32_t size;
+    uint32_t sq_entries;
+    uint32_t cq_entries;
+} io_uring_params_t;
+
+struct process;
+struct file;
+
+// 커널 쪽 링 (불투명)
+typedef struct io_ring io_ring_t;
+
+void io_uring_init(void);
+
+// entries는 2의 거듭제곱으로 올림 (CQ는 2배). proc이 있으면 그 주소 공간에 공유 매핑하고
+// SQE의 addr을 그 공간의 주소로 해석, 0이면 커널 스레드용 (addr은 커널 주소). 실패 시 0
+io_ring_t* io_uring_setup(uint32_t entries, uint32_t flags, struct process* proc, io_uring_params_t* out);
+void io_uring_destroy(io_ring_t* ring);
+
+io_ring_t* io_uring_get(uint32_t ring_id);
+
+// 시스템 콜용: proc(0이면 커널 스레드)이 만든 링일 때만. 다른 프로세스의 링이면 0
+io_ring_t* io_uring_get_owned(uint32_t ring_id, struct process* proc);
+
+// 프로세스 종료: 그 주소 공간을 쓰는 링을 모두 destroy (SQPOLL 스레드 정지 포함).
+// vm_space_destroy 전에 불러야 한다
+void io_uring_exit(struct process* proc);
+
+// files[i]가 SQE의 fd = i가 된다 (참조 +1). 성공 0, 실패 -errno
+int io_uring_register_files(io_ring_t* ring, struct file** files, uint32_t n);
+
+// SYS_IO_URING_ENTER 본체: to_submit개 제출 후 CQ에 min_complete개가 쌓일 때까지 대기
+// 제출한 SQE 수 또는 -errno
+int32_t io_uring_enter(io_ring_t* ring, uint32_t to_submit, uint32_t min_complete, uint32_t flags);
+
+void io_uring_dump(io_ring_t* ring);
+
+// -------------------------
+// 링 사용자 쪽 helper (프로세스든 커널 스레드든 공유 영역 주소만 있으면 사용)
+// -------------------------
+typedef struct io_uring_user {
+    uint32_t ring_id;
+    io_rings_t* rings;
+    io_uring_sqe_t* sqes;
+    io_uring_cqe_t* cqes;
+    uint32_t sq_mask;
+    uint32_t cq_mask;
+    uint32_t sq_local_tail;     // 채웠지만 아직 sq_tail로 공개하지 않은 위치
+} io_uring_user_t;
+
+static inline void io_uring_user_init(io_uring_user_t* u, const io_uring_params_t* p) {
+    u->ring_id = p->ring_id;
+    u->rings = (io_rings_t*)p->addr;
+    u->sqes = (io_uring_sqe_t*)(p->addr + u->rings->sqes_off);
+    u->cqes = (io_uring_cqe_t*)(p->addr + u->rings->cqes_off);
+    u->sq_mask = p->sq_entries - 1;
+    u->cq_mask = p->cq_entries - 1;
+    u->sq_local_tail = u->rings->sq_tail;
+}
+
+// 빈 SQE 슬롯 (가득이면 0)
+static inline io_uring_sqe_t* io_uring_get_sqe(io_uring_user_t* u) {
+    uint32_t head = __atomic_load_n(&u->rings->sq_head, __ATOMIC_ACQUIRE);
+    if (u->sq_local_tail - head > u->sq_mask) return 0;
+    io_uring_sqe_t* sqe = &u->sqes[u->sq_local_tail & u->sq_mask];
+    u->sq_local_tail++;
+    return sqe;
+}
+
+// 채운 SQE들을 커널에 공개, 공개한 개수 반환
+static inline uint32_t io_uring_flush_sq(io_uring_user_t* u) {
+    uint32_t n = u->sq_local_tail - u->rings->sq_tail;
+    __atomic_store_n(&u->rings->sq_tail, u->sq_local_tail, __ATOMIC_RELEASE);
+    return n;
+}
+
+static inline io_uring_cqe_t* io_uring_peek_cqe(io_uring_user_t* u) {
+    uint32_t head = u->rings->cq_head;
+    if (head == __atomic_load_n(&u->rings->cq_tail, __ATOMIC_ACQUIRE)) return 0;
+    return &u->cqes[head & u->cq_mask];
+}
+
+static inline void io_uring_cqe_seen(io_uring_user_t* u) {
+    __atomic_store_n(&u->rings->cq_head, u->rings->cq_head + 1, __ATOMIC_RELEASE);
+}
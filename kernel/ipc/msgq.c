@@ -0,0 +1,139 @@
+#include "msgq.h"
+#include "../memory/heap.h"
+#include "../sched/thread.h"
+#include "../panic/panic.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/irqflags.h"
+#include "../../arch/x86/interrupt/irq.h"
+
+msg_t* msg_alloc(void) {
+    msg_t* m = (msg_t*)pmm_alloc_frame();
+    if (!m) return 0;
+
+    m->type = 0;
+    m->len = 0;
+    m->sender = 0;
+    m->reserved = 0;
+    return m;
+}
+
+void msg_free(msg_t* m) {
+    if (m) pmm_free_frame((uint32_t)m);
+}
+
+msgq_t* msgq_create(const char* name, uint32_t capacity) {
+    uint32_t cap = 1;
+    while (cap < capacity) cap <<= 1;
+
+    msgq_t* q = (msgq_t*)kmalloc_aligned(sizeof(msgq_t), CACHE_LINE_SIZE);
+    if (!mpmc_ring_init(&q->ring, cap)) {
+        panic("msgq_create: bad capacity");
+    }
+
+    wait_queue_init(&q->recv_wait);
+    wait_queue_init(&q->send_wait);
+
+    uint32_t i = 0;
+    if (name) {
+        for (; name[i] && i < MSGQ_NAME_LEN - 1; i++) q->name[i] = name[i];
+    }
+    q->name[i] = 0;
+
+    q->capacity = cap;
+    q->sent = 0;
+    q->received = 0;
+    q->send_blocks = 0;
+    q->recv_blocks = 0;
+    return q;
+}
+
+void msgq_destroy(msgq_t* q) {
+    if (!wait_queue_empty(&q->recv_wait) || !wait_queue_empty(&q->send_wait)) {
+        panic("msgq_destroy: threads still waiting");
+    }
+
+    // 남은 메시지는 큐가 소유하고 있으므로 함께 반환
+    void* m;
+    while (mpmc_ring_pop(&q->ring, &m)) msg_free((msg_t*)m);
+
+    mpmc_ring_destroy(&q->ring);
+    kfree(q);
+}
+
+// 잠든 상대가 있을 때만 스케줄러를 건드린다 (평상시는 head 읽기 한 번)
+static void wake_one(wait_queue_t* wq) {
+    if (!__atomic_load_n(&wq->head, __ATOMIC_ACQUIRE)) return;
+    wake_up_one(wq);
+}
+
+int msgq_try_send(msgq_t* q, msg_t* m) {
+    thread_t* cur = thread_current();
+    m->sender = (cur && !in_irq()) ? cur->tid : 0;
+
+    if (!mpmc_ring_push(&q->ring, m)) return 0;
+
+    __atomic_fetch_add(&q->sent, 1, __ATOMIC_RELAXED);
+    wake_one(&q->recv_wait);
+    return 1;
+}
+
+msg_t* msgq_try_receive(msgq_t* q) {
+    void* m;
+    if (!mpmc_ring_pop(&q->ring, &m)) return 0;
+
+    __atomic_fetch_add(&q->received, 1, __ATOMIC_RELAXED);
+    wake_one(&q->send_wait);
+    return (msg_t*)m;
+}
+
+void msgq_send(msgq_t* q, msg_t* m) {
+    if (in_irq()) {
+        panic("msgq_send: blocking call in IRQ context");
+    }
+
+    for (;;) {
+        if (msgq_try_send(q, m)) return;
+
+        // 인터럽트를 끈 뒤 한 번 더 시도하고 실패하면 그대로 대기 등록:
+        // 그 사이 비운 소비자는 이미 wake_one을 지났거나(재시도가 성공) 아직 호출 전이다(우리를 깨움)
+        uint32_t f = irq_save();
+        if (msgq_try_send(q, m)) {
+            irq_restore(f);
+            return;
+        }
+        q->send_blocks++;
+        wait_queue_sleep(&q->send_wait);
+        irq_restore(f);
+    }
+}
+
+msg_t* msgq_receive(msgq_t* q) {
+    if (in_irq()) {
+        panic("msgq_receive: blocking call in IRQ context");
+    }
+
+    for (;;) {
+        msg_t* m = msgq_try_receive(q);
+        if (m) return m;
+
+        uint32_t f = irq_save();
+        m = msgq_try_receive(q);
+        if (m) {
+            irq_restore(f);
+            return m;
+        }
+        q->recv_blocks++;
+        wait_queue_sleep(&q->recv_wait);
+        irq_restore(f);
+    }
+}
+
+uint32_t msgq_count(const msgq_t* q) {
+    return mpmc_ring_count(&q->ring);
+}
+
+void msgq_dump(const msgq_t* q) {
+    kprintf("[MSGQ] %s: cap=%u queued=%u sent=%u recv=%u blocks(send/recv)=%u/%u\n",
+        q->name, q->capacity, msgq_count(q), q->sent, q->received,
+        q->send_blocks, q->recv_blocks);
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <stdint.h>
+#include "../lib/ring.h"
+#include "../memory/pmm.h"
+#include "../sched/wait.h"
+
+// 메시지 = 물리 페이지 한 장 (커널 identity map이므로 주소 그대로 사용)
+// send는 포인터만 ring에 넣고 소유권을 넘긴다. 보낸 뒤 송신자는 페이지를 건드리면 안 되고,
+// 수신자가 msg_free 하거나 다른 큐로 다시 보낸다. 페이로드 복사는 없다.
+#define MSG_HEADER_SIZE 16
+#define MSG_DATA_MAX    (PAGE_SIZE - MSG_HEADER_SIZE)
+
+typedef struct msg {
+    uint32_t type;
+    uint32_t len;           // data 유효 길이
+    uint32_t sender;        // 송신 스레드 tid
+    uint32_t reserved;
+    uint8_t data[MSG_DATA_MAX];
+} msg_t;
+
+#define MSGQ_NAME_LEN 16
+
+typedef struct msgq {
+    mpmc_ring_t ring;
+
+    // 큐가 실제로 비었거나 가득 찼을 때만 사용
+    wait_queue_t recv_wait;
+    wait_queue_t send_wait;
+
+    char name[MSGQ_NAME_LEN];
+    uint32_t capacity;
+
+    uint32_t sent;
+    uint32_t received;
+    uint32_t send_blocks;   // 가득 차서 잠든 횟수
+    uint32_t recv_blocks;   // 비어서 잠든 횟수
+} msgq_t;
+
+// 페이지 할당 실패 시 0
+msg_t* msg_alloc(void);
+void msg_free(msg_t* m);
+
+// capacity는 2의 거듭제곱으로 올림
+msgq_t* msgq_create(const char* name, uint32_t capacity);
+void msgq_destroy(msgq_t* q);
+
+// 블로킹 (스레드 컨텍스트 전용)
+void msgq_send(msgq_t* q, msg_t* m);
+msg_t* msgq_receive(msgq_t* q);
+
+// 논블로킹 (IRQ 핸들러에서도 호출 가능). 성공 1 / 가득 0, 비었으면 0 반환
+int msgq_try_send(msgq_t* q, msg_t* m);
+msg_t* msgq_try_receive(msgq_t* q);
+
+uint32_t msgq_count(const msgq_t* q);
+void msgq_dump(const msgq_t* q);
@@ -1,11 +1,55 @@
 #include "../drivers/serial/serial.h"
 #include "../drivers/keyboard/keyboard.h"
+#include "../drivers/video/fbcon.h"
 
 #include "panic/panic.h"
 #include "memory/multiboot.h"
 #include "memory/heap.h"
+#include "memory/pmm.h"
+#include "memory/paging.h"
+#include "memory/vma.h"
+#include "loader/elf.h"
+#include "loader/ksym.h"
+#include "proc/process.h"
+#include "sched/thread.h"
+#include "sched/rt.h"
+#include "sched/workqueue.h"
+#include "sched/cputime.h"
+#include "ipc/msgq.h"
+#include "sync/mutex.h"
+#include "sync/semaphore.h"
+#include "sync/futex.h"
+#include "sync/rcu.h"
+#include "io/uring.h"
+#include "fs/file.h"
+#include "fs/procfs.h"
+#include "net/net.h"
+#include "fs/splice.h"
+#include "memory/mmap.h"
+#include "sched/kstack.h"
+#include "block/blockdev.h"
+#include "block/bcache.h"
+#include "fs/fat32.h"
+#include "../drivers/block/ramdisk.h"
+#include "../drivers/block/ata.h"
+#include "syscall/syscall.h"
+#include "lib/errno.h"
+#include "time/time.h"
+#include "time/vdso.h"
+#include "time/latency.h"
+#include "trace/irqsoff.h"
+#include "lib/cmdline.h"
+#include "tty/tty.h"
 
 #include "../arch/x86/cpu/gdt.h"
+#include "../arch/x86/cpu/tss.h"
+#include "../arch/x86/cpu/cr.h"
+#include "../arch/x86/cpu/pat.h"
+#include "../arch/x86/cpu/fpu.h"
+#include "../arch/x86/cpu/tsc.h"
+#include "../arch/x86/cpu/cache.h"
+#include "../arch/x86/cpu/irqflags.h"
+#include "lib/string.h"
 #include "../arch/x86/interrupt/idt.h"
 #include "../arch/x86/interrupt/irq.h"
 #include "../arch/x86/interrupt/pit.h"
@@ -14,6 +58,9 @@
 
 extern uint32_t __kernel_end;
 
+// 커널 힙 크기 (나머지 usable 영역은 pmm 프레임으로 사용)
+#define KERNEL_HEAP_SIZE (8u * 1024 * 1024)
+
 // ---------------------
 // Helpers
 // ---------------------
@@ -34,11 +81,528 @@ static void trigger_pf_null_read(void) {
     (void)v;
 }
 
+// Multiboot 모듈을 ELF 프로세스로 적재 (demand paging 확인용)
+// 세그먼트는 등록만 되고, entry 페이지를 한 번 건드려 그 페이지만 fault-in 되는지 확인
+static process_t* load_boot_modules(uint32_t mb_addr) {
+    process_t* first = 0;
+    uint32_t n = multiboot_module_count(mb_addr);
+    kprintf("[ELF] boot modules=%u\n", n);
+
+    for (uint32_t i = 0; i < n; i++) {
+        const multiboot_module_t* m = multiboot_get_module(mb_addr, i);
+        uint32_t size = m->mod_end - m->mod_start;
+
+        process_t* p = process_create_elf("module", (const uint8_t*)m->mod_start, size);
+        if (!p) {
+            kprintf("[ELF] module %u: load failed\n", i);
+            continue;
+        }
+
+        kprintf("[ELF] module %u: pid=%u size=%u entry=0x%x\n", i, p->pid, size, p->entry);
+
+        process_switch(p);
+        volatile uint8_t first_byte = *(volatile uint8_t*)p->entry;  // #PF -> fault-in
+        (void)first_byte;
+        vm_dump_areas(p->vm);
+        process_switch(0);
+
+        if (!first) first = p;
+    }
+    return first;
+}
+
+// fork + COW 확인: 자식의 쓰기가 부모 페이지를 건드리지 않아야 함
+static void fork_cow_test(process_t* parent) {
+    volatile uint32_t* slot = (volatile uint32_t*)(parent->user_stack - 4);
+
+    process_switch(parent);
+    *slot = 0x1234;                     // zero page -> 새 프레임
+
+    uint32_t before = pmm_free_frames();
+    process_t* child = process_fork(parent);
+    uint32_t fork_frames = before - pmm_free_frames();
+
+    process_switch(child);
+    uint32_t seen = *slot;              // 공유 프레임 읽기
+    *slot = 0x5678;                     // COW 복사
+
+    process_switch(parent);
+    uint32_t mine = *slot;
+    *slot = 0x4321;                     // 마지막 참조자 -> 복사 없이 쓰기 복구
+    process_switch(0);
+
+    kprintf("[FORK] child pid=%u frames(page tables)=%u\n", child->pid, fork_frames);
+    kprintf("  child saw=0x%x parent kept=0x%x cow_copies=%u\n",
+        seen, mine, child->vm->cow_copies);
+
+    if (seen != 0x1234 || mine != 0x1234) {
+        panic("fork COW test failed");
+    }
+
+    process_dump();
+    process_destroy(child);
+}
+
+// lazy FPU 확인: FPU를 쓰는 스레드끼리 번갈아 실행돼도 결과가 섞이지 않아야 함
+static void fpu_worker(void* arg) {
+    int n = (int)arg;
+    volatile double acc = 0.0;
+
+    for (int i = 1; i <= n; i++) {
+        acc += 1.0 / (double)i;
+        if ((i & 0x3FFF) == 0) thread_yield();
+    }
+    kprintf("[FPU] %s: H(%d)*1000=%d\n", thread_current()->name, n, (int)(acc * 1000.0));
+}
+
+// 정수 전용 스레드: FPU 상태 저장/복원 비용을 전혀 내지 않아야 함
+static void int_worker(void* arg) {
+    int n = (int)arg;
+    volatile uint32_t acc = 0;
+
+    for (int i = 1; i <= n; i++) {
+        acc += (uint32_t)i;
+        if ((i & 0x3FFF) == 0) thread_yield();
+    }
+    kprintf("[FPU] %s: sum=%u fpu_area=%s\n", thread_current()->name, acc,
+        thread_current()->fpu ? "yes" : "no");
+}
+
+// 메시지 큐 확인: 작은 큐로 생산자/소비자가 번갈아 잠들고 깨어나며, 순서/내용이 유지되어야 함
+#define IPC_DEMO_MSGS 256
+
+static void ipc_producer(void* arg) {
+    msgq_t* q = (msgq_t*)arg;
+
+    for (uint32_t i = 0; i <= IPC_DEMO_MSGS; i++) {
+        msg_t* m = msg_alloc();
+        if (!m) panic("ipc_producer: out of frames");
+
+        m->type = (i == IPC_DEMO_MSGS) ? 0 : 1;     // type 0 = 종료
+        m->len = sizeof(uint32_t);
+        *(uint32_t*)m->data = i;
+        msgq_send(q, m);                            // 이후 m은 소비자 소유
+    }
+}
+
+static void ipc_consumer(void* arg) {
+    msgq_t* q = (msgq_t*)arg;
+    uint32_t expect = 0;
+    uint32_t errors = 0;
+
+    for (;;) {
+        msg_t* m = msgq_receive(q);
+        int done = (m->type == 0);
+
+        if (*(uint32_t*)m->data != expect++) errors++;
+        msg_free(m);
+        if (done) break;
+    }
+
+    kprintf("[IPC] consumer done: msgs=%u errors=%u\n", expect, errors);
+    msgq_dump(q);
+}
+
+// priority inheritance 확인
+// low가 mutex를 잡은 상태에서 high가 기다리면 low가 high 우선순위로 올라가
+// CPU를 독점하려는 mid보다 먼저 끝나야 한다 (기대 순서: H, M, L 중 H가 M보다 먼저)
+#define PI_PRIO_LOW   18
+#define PI_PRIO_MID   20
+#define PI_PRIO_HIGH  22
+#define PI_PRIO_COORD 24
+
+static mutex_t g_pi_lock;
+static semaphore_t g_pi_done;
+static char g_pi_order[4];
+static uint32_t g_pi_order_len = 0;
+static int g_pi_low_seen = 0;
+
+static void pi_record(char c) {
+    uint32_t f = irq_save();
+    if (g_pi_order_len < sizeof(g_pi_order) - 1) g_pi_order[g_pi_order_len++] = c;
+    irq_restore(f);
+}
+
+static void pi_low(void* arg) {
+    (void)arg;
+    mutex_lock(&g_pi_lock);
+
+    // high가 기다리기 시작할 때까지 mutex를 쥐고 계산
+    while (!mutex_has_waiters(&g_pi_lock)) cpu_relax();
+    g_pi_low_seen = thread_current()->priority;
+
+    mutex_unlock(&g_pi_lock);
+    pi_record('L');
+    sem_up(&g_pi_done);
+}
+
+static void pi_mid(void* arg) {
+    (void)arg;
+    uint64_t until = timer_ticks() + 5;     // 5 tick 동안 CPU 점유
+    while (timer_ticks() < until) cpu_relax();
+    pi_record('M');
+    sem_up(&g_pi_done);
+}
+
+static void pi_high(void* arg) {
+    (void)arg;
+    mutex_lock(&g_pi_lock);
+    pi_record('H');
+    mutex_unlock(&g_pi_lock);
+    sem_up(&g_pi_done);
+}
+
+static void pi_coordinator(void* arg) {
+    (void)arg;
+    mutex_init(&g_pi_lock, "pi-demo");
+    sem_init(&g_pi_done, 0);
+
+    thread_create("pi-low", pi_low, 0, PI_PRIO_LOW);
+    thread_sleep(2);                        // low가 mutex를 잡도록
+
+    thread_create("pi-high", pi_high, 0, PI_PRIO_HIGH);
+    thread_create("pi-mid", pi_mid, 0, PI_PRIO_MID);
+
+    for (int i = 0; i < 3; i++) sem_down(&g_pi_done);
+
+    g_pi_order[g_pi_order_len] = 0;
+    int ok = g_pi_order[0] == 'H' && g_pi_low_seen == PI_PRIO_HIGH;
+    kprintf("[PI] order=%s low ran at prio %d (base %d) -> %s\n",
+        g_pi_order, g_pi_low_seen, PI_PRIO_LOW, ok ? "OK" : "FAILED");
+    mutex_dump(&g_pi_lock);
+}
+
+// futex 기반 락 (0=해제, 1=잠김, 2=잠김+대기자)
+// 경합이 없으면 CAS만으로 끝나고 시스템 콜은 대기자가 있을 때만 발생
+static volatile uint32_t g_ulock = 0;
+static volatile uint32_t g_ulock_counter = 0;
+static volatile uint32_t g_ulock_syscalls = 0;
+
+static void ulock_lock(volatile uint32_t* f) {
+    uint32_t c = __sync_val_compare_and_swap(f, 0, 1);
+    if (c == 0) return;
+
+    if (c != 2) c = __sync_lock_test_and_set(f, 2);
+    while (c != 0) {
+        __sync_fetch_and_add(&g_ulock_syscalls, 1);
+        syscall3(SYS_FUTEX, (uint32_t)f, FUTEX_WAIT, 2);
+        c = __sync_lock_test_and_set(f, 2);
+    }
+}
+
+static void ulock_unlock(volatile uint32_t* f) {
+    if (__sync_fetch_and_sub(f, 1) != 1) {
+        *f = 0;
+        __sync_fetch_and_add(&g_ulock_syscalls, 1);
+        syscall3(SYS_FUTEX, (uint32_t)f, FUTEX_WAKE, 1);
+    }
+}
+
+#define ULOCK_ITERS 20000
+
+static void ulock_worker(void* arg) {
+    semaphore_t* done = (semaphore_t*)arg;
+
+    for (uint32_t i = 0; i < ULOCK_ITERS; i++) {
+        ulock_lock(&g_ulock);
+        uint32_t v = g_ulock_counter;
+        if ((i & 0xFFF) == 0) thread_yield();   // 가끔 락을 쥔 채 양보해 경합 유도
+        g_ulock_counter = v + 1;
+        ulock_unlock(&g_ulock);
+    }
+    sem_up(done);
+}
+
+static void ulock_test(void* arg) {
+    (void)arg;
+    semaphore_t done;
+    sem_init(&done, 0);
+
+    thread_create("ulock-a", ulock_worker, &done, PRIO_NORMAL);
+    thread_create("ulock-b", ulock_worker, &done, PRIO_NORMAL);
+    sem_down(&done);
+    sem_down(&done);
+
+    kprintf("[FUTEX] counter=%u (expect %u) lock ops=%u syscalls=%u\n",
+        g_ulock_counter, 2 * ULOCK_ITERS, 4 * ULOCK_ITERS, g_ulock_syscalls);
+    futex_dump_stats();
+}
+
+// 실시간 태스크 데모: 주기마다 work tick만큼 CPU를 쓰고 다음 주기를 기다림
+// rt-c는 5번째 잡마다 budget보다 오래 실행해 throttle/deadline miss를 일으킴
+#define RT_DEMO_TICKS 200
+
+typedef struct {
+    uint32_t work;          // 잡당 실행 tick
+    uint32_t overrun_every; // N번째 잡마다 budget 초과 (0이면 없음)
+} rt_demo_arg_t;
+
+static void rt_spin_ticks(uint32_t ticks) {
+    uint64_t until = timer_ticks() + ticks;
+    while (timer_ticks() < until) cpu_relax();
+}
+
+static void rt_demo_task(void* arg) {
+    rt_demo_arg_t* a = (rt_demo_arg_t*)arg;
+    uint64_t stop = timer_ticks() + RT_DEMO_TICKS;
+
+    for (uint32_t job = 1; timer_ticks() < stop; job++) {
+        uint32_t work = a->work;
+        if (a->overrun_every && job % a->overrun_every == 0) work = thread_current()->rt->budget * 2;
+        rt_spin_ticks(work);
+        rt_wait_next_period();
+    }
+}
+
+static void rt_report(void* arg) {
+    (void)arg;
+    thread_sleep(RT_DEMO_TICKS - 10);
+    rt_dump();
+}
+
+// ---------------------
+// workqueue 데모: 블록되는 work 동안 다른 worker가 CPU를 이어받는지 확인
+// ---------------------
+static volatile uint32_t g_wq_slow_busy = 0;
+static volatile uint32_t g_wq_overlap = 0;
+
+static void wq_slow_work(work_t* w) {
+    (void)w;
+    g_wq_slow_busy = 1;
+    thread_sleep(5);
+    g_wq_slow_busy = 0;
+}
+
+static void wq_fast_work(work_t* w) {
+    (void)w;
+    if (g_wq_slow_busy) g_wq_overlap++;
+}
+
+static void wq_delayed_fn(work_t* w) {
+    (void)w;
+    kprintf("[WQ] delayed work ran at tick %llu\n", timer_ticks());
+}
+
+static void wq_demo(void* arg) {
+    (void)arg;
+    static work_t slow, fast[4];
+    static delayed_work_t later;
+
+    work_init(&slow, wq_slow_work);
+    for (int i = 0; i < 4; i++) work_init(&fast[i], wq_fast_work);
+    delayed_work_init(&later, wq_delayed_fn);
+
+    uint64_t t0 = timer_ticks();
+    queue_work(system_wq, &slow);
+    for (int i = 0; i < 4; i++) queue_work(system_wq, &fast[i]);
+    queue_delayed_work(system_wq, &later, 20);
+    kprintf("[WQ] demo: queued slow + 4 fast + delayed(20) at tick %llu\n", t0);
+
+    flush_work(&slow);
+    kprintf("[WQ] demo: %u/4 fast works ran while slow work was blocked\n", g_wq_overlap);
+
+    flush_delayed_work(&later);
+    workqueue_dump();
+}
+
+// ---------------------
+// io_uring 데모: 배치 제출(enter 1회) + SQPOLL(시스템 콜 없이 제출)
+// ---------------------
+#define URING_DEMO_IOS 16
+
+static uint8_t g_uring_wbuf[URING_DEMO_IOS][SECTOR_SIZE];
+static uint8_t g_uring_rbuf[URING_DEMO_IOS][SECTOR_SIZE];
+
+// user_data로 요청 종류를 구분: 0..99 섹터 쓰기/100..199 섹터 읽기, 200..299 로그 쓰기, 300 NOP, 1000 timeout
+static int32_t uring_expected(uint64_t user_data) {
+    if (user_data == 1000) return -ETIME;
+    if (user_data == 300) return 0;
+    if (user_data >= 200) return 64;
+    return SECTOR_SIZE;
+}
+
+// CQ에서 n개를 꺼내 (완료 순서는 제출 순서와 다를 수 있음) 실패 수를 반환
+static uint32_t uring_reap(io_uring_user_t* u, uint32_t n) {
+    uint32_t bad = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        io_uring_cqe_t* cqe;
+        while ((cqe = io_uring_peek_cqe(u)) == 0) thread_sleep(1);
+        if (cqe->res != uring_expected(cqe->user_data)) {
+            kprintf("[URING] op %llu: res=%d\n", cqe->user_data, cqe->res);
+            bad++;
+        }
+        io_uring_cqe_seen(u);
+    }
+    return bad;
+}
+
+static void uring_demo(void* arg) {
+    (void)arg;
+
+    blockdev_t* ram0 = ramdisk_create("ram0", 256);
+    if (!ram0) return;
+    file_t* files[2] = { blockdev_file_open(ram0), ramfile_create("log", 16 * 1024) };
+
+    // 1) 일반 링: 쓰기 16개 + timeout 1개를 enter 한 번에, 읽기 16개를 또 한 번에
+    io_uring_params_t p;
+    int32_t id = syscall3(SYS_IO_URING_SETUP, 32, 0, (uint32_t)&p);
+    if (id < 0) {
+        kprintf("[URING] setup failed (%d)\n", id);
+        return;
+    }
+    io_ring_t* ring = io_uring_get((uint32_t)id);
+    io_uring_register_files(ring, files, 2);
+
+    io_uring_user_t u;
+    io_uring_user_init(&u, &p);
+
+    for (uint32_t i = 0; i < URING_DEMO_IOS; i++) {
+        memset(g_uring_wbuf[i], (int)(0x40 + i), SECTOR_SIZE);
+        io_uring_sqe_t* sqe = io_uring_get_sqe(&u);
+        sqe->opcode = IORING_OP_WRITE;
+        sqe->fd = 0;
+        sqe->off = (uint64_t)i * SECTOR_SIZE * 3;       // 흩어진 섹터
+        sqe->addr = (uint32_t)g_uring_wbuf[i];
+        sqe->len = SECTOR_SIZE;
+        sqe->user_data = i;
+    }
+    uint32_t n = io_uring_flush_sq(&u);
+    int32_t sub = syscall4(SYS_IO_URING_ENTER, (uint32_t)id, n, n, IORING_ENTER_GETEVENTS);
+    uint32_t bad = uring_reap(&u, n);
+
+    io_uring_sqe_t* t = io_uring_get_sqe(&u);
+    t->opcode = IORING_OP_TIMEOUT;
+    t->off = 5;
+    t->user_data = 1000;
+    for (uint32_t i = 0; i < URING_DEMO_IOS; i++) {
+        io_uring_sqe_t* sqe = io_uring_get_sqe(&u);
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = 0;
+        sqe->off = (uint64_t)i * SECTOR_SIZE * 3;
+        sqe->addr = (uint32_t)g_uring_rbuf[i];
+        sqe->len = SECTOR_SIZE;
+        sqe->user_data = 100 + i;
+    }
+    n = io_uring_flush_sq(&u);
+    sub += syscall4(SYS_IO_URING_ENTER, (uint32_t)id, n, n, IORING_ENTER_GETEVENTS);
+    bad += uring_reap(&u, n);
+
+    if (memcmp(g_uring_wbuf, g_uring_rbuf, sizeof(g_uring_wbuf)) != 0) bad++;
+    kprintf("[URING] batch: %d SQEs with 2 enter syscalls, errors=%u\n", sub, bad);
+    io_uring_dump(ring);
+
+    // 2) SQPOLL 링: poll 스레드가 SQ를 보므로 시스템 콜 없이 제출
+    io_uring_params_t pp;
+    int32_t pid = syscall3(SYS_IO_URING_SETUP, 16, IORING_SETUP_SQPOLL, (uint32_t)&pp);
+    if (pid < 0) return;
+    io_ring_t* pring = io_uring_get((uint32_t)pid);
+    io_uring_register_files(pring, &files[1], 1);
+
+    io_uring_user_t pu;
+    io_uring_user_init(&pu, &pp);
+    for (uint32_t i = 0; i < 8; i++) {
+        io_uring_sqe_t* sqe = io_uring_get_sqe(&pu);
+        sqe->opcode = IORING_OP_WRITE;
+        sqe->fd = 0;
+        sqe->off = (uint64_t)i * 64;
+        sqe->addr = (uint32_t)"sqpoll-log-record..............................................";
+        sqe->len = 64;
+        sqe->user_data = 200 + i;
+    }
+    io_uring_flush_sq(&pu);
+    bad = uring_reap(&pu, 8);
+
+    // poll 스레드가 idle로 잠든 뒤에는 NEED_WAKEUP을 보고 enter로 깨운다
+    thread_sleep(IORING_SQPOLL_IDLE + 10);
+    io_uring_sqe_t* nop = io_uring_get_sqe(&pu);
+    nop->opcode = IORING_OP_NOP;
+    nop->user_data = 300;
+    io_uring_flush_sq(&pu);
+    if (pu.rings->sq_flags & IORING_SQ_NEED_WAKEUP) {
+        syscall4(SYS_IO_URING_ENTER, (uint32_t)pid, 1, 0, IORING_ENTER_SQ_WAKEUP);
+    }
+    bad += uring_reap(&pu, 1);
+
+    kprintf("[URING] sqpoll: 9 SQEs, log size=%llu, errors=%u\n", files[1]->size, bad);
+    io_uring_dump(pring);
+    blockdev_dump();
+
+    io_uring_destroy(pring);
+    io_uring_destroy(ring);
+    file_put(files[0]);
+    file_put(files[1]);
+}
+
+// 한 줄씩 읽어서 그대로 출력, 빈 줄에서 ^D(EOF)면 키보드 통계
+// 명령: top(CPU 사용), heap(할당 프로파일), mark/leaks(기준점 이후 늘어난 callsite),
+//       latency [load](wakeup 지연 측정, load면 배경 부하 전부), irqsoff [on|off|reset](인터럽트 꺼짐 구간)
+static void tty_echo_demo(void* arg) {
+    (void)arg;
+    char line[TTY_LINE_MAX + 1];
+
+    for (;;) {
+        int32_t n = tty_read(line, TTY_LINE_MAX);
+        if (n == 0) {
+            kbd_dump_stats();
+            continue;
+        }
+        if (line[n - 1] == '\n') n--;
+        line[n] = 0;
+        if (strcmp(line, "top") == 0) {
+            cputime_top(32);
+            continue;
+        }
+        if (strncmp(line, "heap", 4) == 0 && (line[4] == 0 || line[4] == ' ')) {
+            const char* arg = line[4] ? line + 5 : line + 4;
+            if (strcmp(arg, "on") == 0) heap_profile_enable(1);
+            else if (strcmp(arg, "off") == 0) heap_profile_enable(0);
+            else heap_profile_report();
+            continue;
+        }
+        if (strcmp(line, "mark") == 0) {
+            heap_profile_mark();
+            continue;
+        }
+        if (strcmp(line, "leaks") == 0) {
+            heap_leak_report();
+            continue;
+        }
+        if (strcmp(line, "latency") == 0 || strcmp(line, "latency load") == 0) {
+            latency_config_t cfg = { 500, 1, line[7] ? LATENCY_LOAD_ALL : 0 };
+            if (latency_run(&cfg, 0) == -EBUSY) kprintf("latency: already running\n");
+            continue;
+        }
+        if (strncmp(line, "irqsoff", 7) == 0) {
+            const char* arg = line[7] == ' ' ? line + 8 : line + 7;
+            if (strcmp(arg, "on") == 0) irqsoff_start();
+            else if (strcmp(arg, "off") == 0) irqsoff_stop();
+            else if (strcmp(arg, "reset") == 0) irqsoff_reset();
+            else irqsoff_report();
+            continue;
+        }
+        if (strcmp(line, "ls") == 0) {
+            char names[256];
+            proc_seq_t s = { names, sizeof(names), 0, 0 };
+            procfs_list(&s);
+            kprintf("%s", names);
+            continue;
+        }
+        if (strncmp(line, "cat ", 4) == 0) {
+            const char* name = line + 4;
+            if (strncmp(name, "/proc/", 6) == 0) name += 6;
+            if (procfs_cat(name) < 0) kprintf("cat: %s: no such file\n", name);
+            continue;
+        }
+        kprintf("[TTY] read %d bytes: \"%s\"\n", n, line);
+    }
+}
+
 // ---------------------
 // kernel_main
 // ---------------------
 void kernel_main(uint32_t magic, uint32_t mb_addr) {
-    // 화면/시리얼 준비
+    // 화면/시리얼 준비 (GRUB이 그래픽 모드를 설정했으면 첫 출력부터 framebuffer 콘솔로)
+    fbcon_probe(mb_addr);
     kprintf_clear_console();
     serial_init();
     kprintf("[INFO] kernel_main entered\n");
@@ -46,6 +610,7 @@ void kernel_main(uint32_t magic, uint32_t mb_addr) {
     // 기본 플랫폼 초기화
     kprintf("[INFO] loading GDT...\n");
     gdt_init();
+    tss_init();
     kprintf("[INFO] GDT loaded\n");
 
     kprintf("[INFO] loading IDT...\n");
@@ -64,7 +629,9 @@ void kernel_main(uint32_t magic, uint32_t mb_addr) {
 
     // 인터럽트 활성화 (키보드 입력을 받기 위해 필요)
     kprintf("[INFO] Enabling interrupts (sti)\n");
-    __asm__ __volatile__("sti");
+    irq_enable();
+
+    tsc_calibrate();
 
     // -------------------------
     // STEP2: Multiboot mmap
@@ -76,6 +643,8 @@ void kernel_main(uint32_t magic, uint32_t mb_addr) {
 
     kprintf("[MB] magic OK\n");
     kprintf("[MB] mb_addr=0x%x\n", mb_addr);
+    cmdline_init(multiboot_cmdline(mb_addr));
+    kprintf("[MB] cmdline=\"%s\"\n", cmdline_raw());
     kprintf("[MEM] __kernel_end=0x%x\n", (uint32_t)&__kernel_end);
 
     multiboot_dump_memory_map(mb_addr);
@@ -96,14 +665,52 @@ void kernel_main(uint32_t magic, uint32_t mb_addr) {
     uint32_t heap_start = align_up((uint32_t)&__kernel_end, 16);
     if (heap_start < base) heap_start = base;
 
-    kprintf("[HEAP] heap_start=0x%x\n", heap_start);
-    kprintf("[HEAP] heap_end=0x%x\n", end);
+    // GRUB 모듈은 커널 뒤에 적재되므로 덮어쓰지 않도록 건너뜀
+    uint32_t mods_end = multiboot_modules_end(mb_addr);
+    if (mods_end > heap_start) heap_start = align_up(mods_end, 16);
+
+    // 커널 심볼 테이블도 GRUB이 커널 뒤에 올려 둔다 (ksym이 그 자리에서 읽음)
+    uint32_t syms_end = multiboot_symbols_end(mb_addr);
+    if (syms_end > heap_start) heap_start = align_up(syms_end, 16);
+    ksym_init(mb_addr);
+
+    // 커널 identity map 범위 안의 메모리만 사용
+    if (end > KERNEL_SPACE_END) end = KERNEL_SPACE_END;
 
     if (end <= heap_start) {
         panic("Heap range invalid BEFORE heap_init");
     }
 
-    heap_init(heap_start, end);
+    // 앞쪽은 힙, 나머지는 물리 프레임 (영역이 작으면 반씩)
+    uint32_t heap_end = heap_start + KERNEL_HEAP_SIZE;
+    if (heap_end > end || heap_end - heap_start > (end - heap_start) / 2) {
+        heap_end = heap_start + (end - heap_start) / 2;
+    }
+    heap_end = PAGE_ALIGN_DOWN(heap_end);
+
+    kprintf("[HEAP] heap_start=0x%x\n", heap_start);
+    kprintf("[HEAP] heap_end=0x%x\n", heap_end);
+
+    heap_init(heap_start, heap_end);
+    // 프로파일러는 kmalloc마다 callsite 해시를 거치므로 기본은 꺼 둔다 (부팅 옵션 heapprof 또는 콘솔 heap on)
+    if (cmdline_has("heapprof")) heap_profile_enable(1);
+
+    sched_init();
+    cputime_init();
+    rt_init(RT_POLICY_EDF);
+    rcu_init();
+    workqueue_init();
+    kbd_start();
+    cputime_report_start(CPUTIME_REPORT_SECS * time_get_hz());
+    procfs_init();
+    net_init();
+    splice_init();
+    irqsoff_init();
+    irqsoff_boot();
+    bcache_init();
+    ata_init();
+    fpu_init();
+    string_init();
 
     void* a = kmalloc(16);
     void* b = kmalloc(256);
@@ -116,15 +723,136 @@ void kernel_main(uint32_t magic, uint32_t mb_addr) {
     kprintf("  used=%u\n", heap_used());
     kprintf("  free=%u\n", heap_free());
 
+    // -------------------------
+    // STEP3.5: 물리 프레임 + paging
+    // -------------------------
+    pmm_init(heap_end, end);
+    pat_init();
+    paging_init();
+    tss_set_df_cr3(read_cr3());
+    fbcon_init();
+    kstack_init();
+    vm_init();
+    vdso_init();
+    process_init();
+
+    process_t* init = load_boot_modules(mb_addr);
+    if (init) fork_cow_test(init);
+
+    // -------------------------
+    // STEP3.6: 스레드 + lazy FPU
+    // -------------------------
+    thread_create("fpu-a", fpu_worker, (void*)100000, PRIO_NORMAL);
+    thread_create("fpu-b", fpu_worker, (void*)200000, PRIO_NORMAL);
+    thread_create("int-c", int_worker, (void*)200000, PRIO_NORMAL);
+
+    // -------------------------
+    // STEP3.7: 메시지 큐 IPC (zero-copy 페이지 전달)
+    // -------------------------
+    msgq_t* demo_q = msgq_create("demo", 4);
+    thread_create("ipc-cons", ipc_consumer, demo_q, PRIO_NORMAL + 1);
+    thread_create("ipc-prod", ipc_producer, demo_q, PRIO_NORMAL);
+
+    // -------------------------
+    // STEP3.8: mutex(PI) / semaphore / futex
+    // -------------------------
+    syscall_init();
+    irq_entry_bench();  // 부팅 옵션 bench=irq
+    thread_create("pi-coord", pi_coordinator, 0, PI_PRIO_COORD);
+    thread_create("ulock", ulock_test, 0, PRIO_NORMAL + 1);
+
+    // -------------------------
+    // STEP3.9: 실시간 클래스 (EDF, admission control, budget throttle)
+    // -------------------------
+    {
+        static rt_demo_arg_t rt_a = { 1, 0 };
+        static rt_demo_arg_t rt_b = { 3, 0 };
+        static rt_demo_arg_t rt_c = { 5, 5 };
+
+        rt_thread_create("rt-a", rt_demo_task, &rt_a, 10, 2, 10);     // U=20%
+        rt_thread_create("rt-b", rt_demo_task, &rt_b, 20, 5, 20);     // U=25%
+        rt_thread_create("rt-c", rt_demo_task, &rt_c, 40, 8, 30);     // U=26.7% (D<T)
+        rt_thread_create("rt-over", rt_demo_task, &rt_a, 10, 4, 10);  // +40% -> 거부
+        thread_create("rt-report", rt_report, 0, PRIO_NORMAL + 2);
+    }
+
+    // -------------------------
+    // STEP3.10: RCU (read-mostly 테이블) vs rwlock reader 비용 (부팅 옵션 bench=rcu)
+    // -------------------------
+    rcu_stress();
+
+    // -------------------------
+    // STEP3.11: workqueue (per-CPU worker pool, concurrency management, delayed work)
+    // -------------------------
+    thread_create("wq-demo", wq_demo, 0, PRIO_NORMAL + 1);
+
+    // -------------------------
+    // STEP3.12: io_uring 방식 비동기 I/O (ramdisk + 메모리 파일)
+    // -------------------------
+    io_uring_init();
+    thread_create("uring-demo", uring_demo, 0, PRIO_NORMAL + 1);
+
+    // -------------------------
+    // STEP3.13: 시간 페이지(vDSO) 읽기 vs clock_gettime 시스템 콜 (부팅 옵션 bench=vdso)
+    // -------------------------
+    vdso_bench();
+
+    // -------------------------
+    // STEP3.14: 키보드 → TTY line discipline → 블로킹 읽기
+    // -------------------------
+    thread_create("tty-echo", tty_echo_demo, 0, PRIO_NORMAL);
+
+    // -------------------------
+    // STEP3.15: framebuffer 콘솔 전체 화면 redraw 비용 (SSE vs rep movsd, WC 매핑, 부팅 옵션 bench=fbcon)
+    // -------------------------
+    fbcon_bench();
+
+    // -------------------------
+    // STEP3.16: loopback UDP/TCP (pbuf 풀, 페이지 참조 전송, checksum, 부팅 옵션 bench=net)
+    // -------------------------
+    net_bench();
+
+    // -------------------------
+    // STEP3.17: 파이프 + splice/vmsplice (페이지 참조로 파일/소켓 간 이동, 부팅 옵션 bench=splice)
+    // -------------------------
+    splice_bench();
+
+    // -------------------------
+    // STEP3.18: mmap (페이지 캐시 직접 매핑, fault-around, shared/private/anonymous 공유, msync/munmap, 부팅 옵션 bench=mmap)
+    // -------------------------
+    mmap_bench();
+
+    // -------------------------
+    // STEP3.19: 커널 스택 캐시 (guard 페이지, high-water mark) + 스레드 생성/종료 비용 (부팅 옵션 bench=kstack)
+    // -------------------------
+    kstack_bench();
+
+    // -------------------------
+    // STEP3.20: wakeup 지연 측정 (부팅 옵션 latency[=loops] latency.load=alloc,irq,log)
+    // -------------------------
+    latency_boot();
+
+    // -------------------------
+    // STEP3.21: FAT32 + write-back 버퍼 캐시 (flusher, 요청 병합, fsync) + ATA 디스크 (부팅 옵션 bench=fat32, fat32.report)
+    // -------------------------
+    fat32_bench();
+
     // -------------------------
     // STEP4: kprintf 테스트
     // -------------------------
     kprintf("kprintf test: dec=%d hex=%x str=%s %%\n", -123, 0xBEEF, "OK");
+    kprintf("kprintf test: [%5d] [%-5d] [%08x] [%.3u] [%llu] [%llx] [%p]\n",
+        42, 42, 0xBEEF, 7u, 1234567890123ull, 0x123456789ABCull, (void*)0xB8000);
+    {
+        char line[16];
+        int n = ksnprintf(line, sizeof(line), "%s-%04u", "truncated-output", 7u);
+        kprintf("ksnprintf test: \"%s\" (len=%d)\n", line, n);
+    }
 
     // 부팅 화면 메시지 (일반 정보)
     kprintf_puts_at(2, 2, "MYOS Phase1 Test Kernel");
     kprintf_puts_at(4, 2, "See console for logs.");
-    kprintf_puts_at(6, 2, "Type keys to test keyboard!");
+    kprintf_puts_at(6, 2, "Type a line and press Enter (^D = stats)");
 
     kprintf("[INFO] Phase1 platform up. Entering idle loop.\n");
     kprintf("[INFO] Keyboard ready - type keys to test input.\n");
@@ -136,10 +864,12 @@ void kernel_main(uint32_t magic, uint32_t mb_addr) {
     // trigger_pf_null_write();
     // trigger_pf_null_read();
 
+    // (선택) memcpy/memset 대역폭 측정
+    // string_bench();
+
     // -------------------------
-    // idle loop (키보드 입력은 IRQ로 처리됨)
+    // idle loop (키보드 입력은 IRQ로 처리됨, 다른 스레드가 없을 때만 실행)
     // -------------------------
-    while (1) {
-        __asm__ __volatile__("hlt");
-    }
+    sched_dump();
+    sched_idle();
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "cmdline.h"
+#include "string.h"
+
+static char g_raw[CMDLINE_MAX];
+// 토큰마다 '\0'으로 끊고 '='도 '\0'으로 바꾼 사본: "key\0value\0key\0\0..."
+static char g_buf[CMDLINE_MAX];
+static uint32_t g_len = 0;
+
+void cmdline_init(const char* s) {
+    g_len = 0;
+    g_raw[0] = 0;
+    if (!s) return;
+
+    uint32_t n = 0;
+    while (s[n] && n < CMDLINE_MAX - 1) {
+        g_raw[n] = s[n];
+        n++;
+    }
+    g_raw[n] = 0;
+
+    const char* p = g_raw;
+    while (*p == ' ') p++;
+    if (*p == '/') {
+        while (*p && *p != ' ') p++;
+    }
+
+    // 공백 → 토큰 구분, 토큰의 첫 '='만 key/value 구분
+    // 값 없는 key는 한 바이트씩 늘어나므로 ("a a a" → "a\0\0a\0\0...") g_raw보다 길어질 수 있다
+    int in_tok = 0, seen_eq = 0;
+    uint32_t tok_start = 0;
+    for (; *p; p++) {
+        char c = *p;
+        if (c == ' ' || c == '\t') {
+            if (in_tok) {
+                if (!seen_eq) g_buf[g_len++] = 0;      // 값 없는 key → 빈 값
+                g_buf[g_len++] = 0;
+            }
+            in_tok = seen_eq = 0;
+            continue;
+        }
+        // 이 글자 + 종료용 '\0' 두 개가 들어갈 자리가 없으면 잘린 토큰은 버리고 멈춘다
+        if (g_len + 3 > CMDLINE_MAX) {
+            if (in_tok) g_len = tok_start;
+            in_tok = 0;
+            break;
+        }
+        if (!in_tok) tok_start = g_len;
+        in_tok = 1;
+        if (c == '=' && !seen_eq) {
+            seen_eq = 1;
+            c = 0;
+        }
+        g_buf[g_len++] = c;
+    }
+    if (in_tok) {
+        if (!seen_eq) g_buf[g_len++] = 0;
+        g_buf[g_len++] = 0;
+    }
+}
+
+const char* cmdline_raw(void) {
+    return g_raw;
+}
+
+const char* cmdline_get(const char* key) {
+    uint32_t i = 0;
+    while (i < g_len) {
+        const char* k = &g_buf[i];
+        i += strlen(k) + 1;
+        const char* v = &g_buf[i];
+        i += strlen(v) + 1;
+        if (strcmp(k, key) == 0) return v;
+    }
+    return 0;
+}
+
+int cmdline_has(const char* key) {
+    return cmdline_get(key) != 0;
+}
+
+uint32_t cmdline_get_u32(const char* key, uint32_t def) {
+    const char* v = cmdline_get(key);
+    if (!v || *v < '0' || *v > '9') return def;
+
+    uint32_t n = 0;
+    for (; *v >= '0' && *v <= '9'; v++) n = n * 10 + (uint32_t)(*v - '0');
+    return *v ? def : n;
+}
+
+int cmdline_list_has(const char* key, const char* item) {
+    const char* v = cmdline_get(key);
+    if (!v) return 0;
+
+    size_t len = strlen(item);
+    while (*v) {
+        const char* end = v;
+        while (*end && *end != ',') end++;
+        if ((size_t)(end - v) == len && strncmp(v, item, len) == 0) return 1;
+        v = *end ? end + 1 : end;
+    }
+    return 0;
+}
+
+int cmdline_bench(const char* name) {
+    return cmdline_list_has("bench", name) || cmdline_list_has("bench", "all");
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <stdint.h>
+
+// 부팅 옵션 (multiboot cmdline). 공백으로 나뉜 "key" 또는 "key=value"
+// 예: /boot/kernel.bin latency=2000 latency.load=alloc,irq,log
+// 첫 토큰이 '/'로 시작하면 커널 경로로 보고 건너뛴다
+
+#define CMDLINE_MAX 256
+
+// 문자열을 내부 버퍼로 복사 (heap 이전, GRUB 메모리를 덮어쓰기 전에 호출). 0이면 빈 옵션
+void cmdline_init(const char* s);
+const char* cmdline_raw(void);
+
+// key가 있으면 값 (값 없는 key는 ""), 없으면 0
+const char* cmdline_get(const char* key);
+int cmdline_has(const char* key);
+
+// 10진수 값. key가 없거나 숫자가 아니면 def
+uint32_t cmdline_get_u32(const char* key, uint32_t def);
+
+// 쉼표 목록 값에 item이 있는가 (예: latency.load=alloc,irq 에서 "irq")
+int cmdline_list_has(const char* key, const char* item);
+
+// 부팅 벤치 선택: bench=splice,mmap,... 에 name이 있거나 bench=all. 기본은 아무것도 돌리지 않는다
+int cmdline_bench(const char* name);
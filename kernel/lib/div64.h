@@ -0,0 +1,18 @@
+#pragma once
+#include <stdint.h>
+
+// 64비트 / 32비트 나눗셈 (libgcc의 __udivdi3 없이)
+// *n을 몫으로 바꾸고 나머지를 반환한다. 상위 32비트를 먼저 나눈 뒤
+// (나머지:하위 32비트)를 divl 한 번으로 나누므로 몫이 항상 32비트에 들어간다.
+static inline uint32_t div_u64_u32(uint64_t* n, uint32_t base) {
+    uint32_t hi = (uint32_t)(*n >> 32);
+    uint32_t lo = (uint32_t)*n;
+    uint32_t qhi = hi / base;
+    uint32_t rem = hi % base;
+    uint32_t qlo;
+
+    __asm__ ("divl %4" : "=a"(qlo), "=d"(rem) : "a"(lo), "d"(rem), "rm"(base));
+
+    *n = ((uint64_t)qhi << 32) | qlo;
+    return rem;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+// 커널 내부/시스템 콜 에러 코드 (Linux 번호와 동일, 음수로 반환)
+#define EPERM      1
+#define ENOENT     2
+#define EINTR      4
+#define EIO        5
+#define EBADF      9
+#define EAGAIN    11
+#define ENOMEM    12
+#define EFAULT    14
+#define EBUSY     16
+#define EEXIST    17
+#define ENODEV    19
+#define ENOTDIR   20
+#define EISDIR    21
+#define EINVAL    22
+#define EFBIG     27
+#define ENOSPC    28
+#define EPIPE     32
+#define ENOSYS    38
+#define ETIME     62
+#define EMSGSIZE  90
+#define EADDRINUSE 98
+#define ECONNRESET 104
+#define EISCONN   106
+#define ENOTCONN  107
+#define ETIMEDOUT 110
+#define ECONNREFUSED 111
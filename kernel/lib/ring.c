@@ -0,0 +1,143 @@
+#include "ring.h"
+#include "../memory/heap.h"
+
+#define load_acquire(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define load_relaxed(p)     __atomic_load_n((p), __ATOMIC_RELAXED)
+#define store_release(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+static int is_pow2(uint32_t v) {
+    return v && (v & (v - 1)) == 0;
+}
+
+// -------------------------
+// SPSC
+// -------------------------
+int spsc_ring_init(spsc_ring_t* r, uint32_t capacity) {
+    if (!is_pow2(capacity) || capacity > 0x80000000u) return 0;
+
+    r->slots = (void**)kmalloc_aligned(capacity * sizeof(void*), CACHE_LINE_SIZE);
+    r->mask = capacity - 1;
+    r->head = 0;
+    r->cached_tail = 0;
+    r->tail = 0;
+    r->cached_head = 0;
+    return 1;
+}
+
+void spsc_ring_destroy(spsc_ring_t* r) {
+    kfree(r->slots);
+    r->slots = 0;
+}
+
+int spsc_ring_push(spsc_ring_t* r, void* item) {
+    uint32_t h = r->head;
+
+    if (h - r->cached_tail > r->mask) {
+        r->cached_tail = load_acquire(&r->tail);
+        if (h - r->cached_tail > r->mask) return 0;
+    }
+
+    r->slots[h & r->mask] = item;
+    store_release(&r->head, h + 1);     // 슬롯 쓰기가 head 공개보다 먼저 보이도록
+    return 1;
+}
+
+int spsc_ring_pop(spsc_ring_t* r, void** out) {
+    uint32_t t = r->tail;
+
+    if (t == r->cached_head) {
+        r->cached_head = load_acquire(&r->head);
+        if (t == r->cached_head) return 0;
+    }
+
+    *out = r->slots[t & r->mask];
+    store_release(&r->tail, t + 1);     // 슬롯을 읽은 뒤에야 생산자가 재사용
+    return 1;
+}
+
+uint32_t spsc_ring_count(const spsc_ring_t* r) {
+    return load_acquire(&r->head) - load_acquire(&r->tail);
+}
+
+// -------------------------
+// MPMC
+// -------------------------
+// 슬롯 seq 규칙 (pos = 이 슬롯을 노리는 인덱스):
+//   seq == pos       : 비어 있음, 생산자 차례
+//   seq == pos + 1   : 채워짐, 소비자 차례
+//   pop 후 seq = pos + capacity (다음 바퀴의 생산자 차례)
+int mpmc_ring_init(mpmc_ring_t* r, uint32_t capacity) {
+    if (!is_pow2(capacity) || capacity > 0x80000000u) return 0;
+
+    r->cells = (mpmc_cell_t*)kmalloc_aligned(capacity * sizeof(mpmc_cell_t), CACHE_LINE_SIZE);
+    r->mask = capacity - 1;
+    for (uint32_t i = 0; i < capacity; i++) {
+        r->cells[i].seq = i;
+        r->cells[i].data = 0;
+    }
+    r->enq = 0;
+    r->deq = 0;
+    return 1;
+}
+
+void mpmc_ring_destroy(mpmc_ring_t* r) {
+    kfree(r->cells);
+    r->cells = 0;
+}
+
+int mpmc_ring_push(mpmc_ring_t* r, void* item) {
+    uint32_t pos = load_relaxed(&r->enq);
+    mpmc_cell_t* cell;
+
+    for (;;) {
+        cell = &r->cells[pos & r->mask];
+        int32_t dif = (int32_t)(load_acquire(&cell->seq) - pos);
+
+        if (dif == 0) {
+            // 슬롯 선점: 실패하면 pos가 최신 enq로 갱신됨
+            if (__atomic_compare_exchange_n(&r->enq, &pos, pos + 1, 0,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (dif < 0) {
+            return 0;                   // 한 바퀴 전 데이터가 아직 소비되지 않음 = 가득
+        } else {
+            pos = load_relaxed(&r->enq);
+        }
+    }
+
+    cell->data = item;
+    store_release(&cell->seq, pos + 1);
+    return 1;
+}
+
+int mpmc_ring_pop(mpmc_ring_t* r, void** out) {
+    uint32_t pos = load_relaxed(&r->deq);
+    mpmc_cell_t* cell;
+
+    for (;;) {
+        cell = &r->cells[pos & r->mask];
+        int32_t dif = (int32_t)(load_acquire(&cell->seq) - (pos + 1));
+
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&r->deq, &pos, pos + 1, 0,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (dif < 0) {
+            return 0;                   // 비어 있음 (또는 생산자가 아직 쓰는 중)
+        } else {
+            pos = load_relaxed(&r->deq);
+        }
+    }
+
+    *out = cell->data;
+    store_release(&cell->seq, pos + r->mask + 1);
+    return 1;
+}
+
+uint32_t mpmc_ring_count(const mpmc_ring_t* r) {
+    uint32_t e = load_acquire(&r->enq);
+    uint32_t d = load_acquire(&r->deq);
+    return e - d;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <stdint.h>
+#include "../../arch/x86/cpu/cache.h"
+
+// 고정 크기 lock-free ring (슬롯은 void*, 용량은 2의 거듭제곱)
+// 인덱스는 계속 증가하는 32비트 카운터이고 슬롯 위치는 (index & mask).
+// 락/irq_save가 없으므로 IRQ 핸들러와 스레드 사이에서도 그대로 쓸 수 있다.
+
+// -------------------------
+// SPSC: 생산자 1 + 소비자 1
+// -------------------------
+// 생산자/소비자가 쓰는 필드를 서로 다른 캐시 라인에 두고,
+// 상대 인덱스는 캐시해 두었다가 가득/빈 것처럼 보일 때만 다시 읽는다.
+typedef struct spsc_ring {
+    void** slots;
+    uint32_t mask;
+
+    uint32_t head __cacheline_aligned;  // 생산자: 다음에 쓸 위치
+    uint32_t cached_tail;
+
+    uint32_t tail __cacheline_aligned;  // 소비자: 다음에 읽을 위치
+    uint32_t cached_head;
+} __cacheline_aligned spsc_ring_t;
+
+// capacity가 2의 거듭제곱이 아니면 0
+int spsc_ring_init(spsc_ring_t* r, uint32_t capacity);
+void spsc_ring_destroy(spsc_ring_t* r);
+
+// 성공 1, 가득/비어 있으면 0
+int spsc_ring_push(spsc_ring_t* r, void* item);
+int spsc_ring_pop(spsc_ring_t* r, void** out);
+
+uint32_t spsc_ring_count(const spsc_ring_t* r);
+
+// -------------------------
+// MPMC: 생산자/소비자 여러 개 (슬롯별 sequence 번호, bounded Vyukov queue)
+// -------------------------
+typedef struct mpmc_cell {
+    uint32_t seq;
+    void* data;
+} mpmc_cell_t;
+
+typedef struct mpmc_ring {
+    mpmc_cell_t* cells;
+    uint32_t mask;
+
+    uint32_t enq __cacheline_aligned;
+    uint32_t deq __cacheline_aligned;
+} __cacheline_aligned mpmc_ring_t;
+
+int mpmc_ring_init(mpmc_ring_t* r, uint32_t capacity);
+void mpmc_ring_destroy(mpmc_ring_t* r);
+
+int mpmc_ring_push(mpmc_ring_t* r, void* item);
+int mpmc_ring_pop(mpmc_ring_t* r, void** out);
+
+// 동시 push/pop 중에는 근삿값
+uint32_t mpmc_ring_count(const mpmc_ring_t* r);
@@ -0,0 +1,227 @@
+#include "string.h"
+#include "../../arch/x86/cpu/cpuid.h"
+#include "../../arch/x86/cpu/fpu.h"
+#include "../console/kprintf.h"
+
+// 이 크기 이상에서만 SSE2 사용 (소유자 FXSAVE 비용을 상쇄할 만큼 커야 함)
+#define SSE_MIN_BYTES 1024
+
+// 이 크기 이상 복사는 non-temporal store (캐시 오염 방지)
+#define SSE_NT_BYTES  (256u * 1024)
+
+static int g_use_sse2 = 0;
+
+void string_init(void) {
+    g_use_sse2 = fpu_available() && (cpuid_features_edx() & CPUID_EDX_SSE2);
+    kprintf("[STRING] memcpy/memset: %s\n", string_impl_name());
+}
+
+int string_sse2_enabled(void) {
+    return g_use_sse2;
+}
+
+const char* string_impl_name(void) {
+    return g_use_sse2 ? "rep movsd + sse2" : "rep movsd";
+}
+
+// -------------------------
+// rep movs/stos
+// -------------------------
+void* memcpy_rep(void* dst, const void* src, size_t n) {
+    void* ret = dst;
+    size_t dwords = n >> 2;
+    size_t bytes = n & 3;
+
+    __asm__ __volatile__("rep movsl" : "+D"(dst), "+S"(src), "+c"(dwords) : : "memory");
+    __asm__ __volatile__("rep movsb" : "+D"(dst), "+S"(src), "+c"(bytes) : : "memory");
+    return ret;
+}
+
+void* memset_rep(void* dst, int c, size_t n) {
+    void* ret = dst;
+    uint32_t v = (uint8_t)c * 0x01010101u;
+    size_t dwords = n >> 2;
+    size_t bytes = n & 3;
+
+    __asm__ __volatile__("rep stosl" : "+D"(dst), "+c"(dwords) : "a"(v) : "memory");
+    __asm__ __volatile__("rep stosb" : "+D"(dst), "+c"(bytes) : "a"(v) : "memory");
+    return ret;
+}
+
+void* memsetw(void* dst, uint16_t v, size_t count) {
+    void* ret = dst;
+    __asm__ __volatile__("rep stosw" : "+D"(dst), "+c"(count) : "a"(v) : "memory");
+    return ret;
+}
+
+// -------------------------
+// SSE2 (목적지 16바이트 정렬 후 64바이트 단위)
+// -------------------------
+__attribute__((target("sse2")))
+void* memcpy_sse2(void* dst, const void* src, size_t n) {
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+
+    size_t head = (16 - ((uint32_t)d & 15)) & 15;
+    if (head > n) head = n;
+    memcpy_rep(d, s, head);
+    d += head;
+    s += head;
+    n -= head;
+
+    size_t blocks = n >> 6;
+
+    if (n >= SSE_NT_BYTES) {
+        for (; blocks; blocks--, d += 64, s += 64) {
+            __asm__ __volatile__(
+                "movdqu   (%1), %%xmm0\n\t"
+                "movdqu 16(%1), %%xmm1\n\t"
+                "movdqu 32(%1), %%xmm2\n\t"
+                "movdqu 48(%1), %%xmm3\n\t"
+                "movntdq %%xmm0,   (%0)\n\t"
+                "movntdq %%xmm1, 16(%0)\n\t"
+                "movntdq %%xmm2, 32(%0)\n\t"
+                "movntdq %%xmm3, 48(%0)\n\t"
+                : : "r"(d), "r"(s) : "xmm0", "xmm1", "xmm2", "xmm3", "memory");
+        }
+        __asm__ __volatile__("sfence" : : : "memory");
+    } else {
+        for (; blocks; blocks--, d += 64, s += 64) {
+            __asm__ __volatile__(
+                "movdqu   (%1), %%xmm0\n\t"
+                "movdqu 16(%1), %%xmm1\n\t"
+                "movdqu 32(%1), %%xmm2\n\t"
+                "movdqu 48(%1), %%xmm3\n\t"
+                "movdqa %%xmm0,   (%0)\n\t"
+                "movdqa %%xmm1, 16(%0)\n\t"
+                "movdqa %%xmm2, 32(%0)\n\t"
+                "movdqa %%xmm3, 48(%0)\n\t"
+                : : "r"(d), "r"(s) : "xmm0", "xmm1", "xmm2", "xmm3", "memory");
+        }
+    }
+
+    memcpy_rep(d, s, n & 63);
+    return dst;
+}
+
+__attribute__((target("sse2")))
+void* memset_sse2(void* dst, int c, size_t n) {
+    uint8_t* d = (uint8_t*)dst;
+
+    size_t head = (16 - ((uint32_t)d & 15)) & 15;
+    if (head > n) head = n;
+    memset_rep(d, c, head);
+    d += head;
+    n -= head;
+
+    uint32_t pattern[4] __attribute__((aligned(16)));
+    pattern[0] = pattern[1] = pattern[2] = pattern[3] = (uint8_t)c * 0x01010101u;
+    __asm__ __volatile__("movdqa (%0), %%xmm0" : : "r"(pattern) : "xmm0", "memory");
+
+    for (size_t blocks = n >> 6; blocks; blocks--, d += 64) {
+        __asm__ __volatile__(
+            "movdqa %%xmm0,   (%0)\n\t"
+            "movdqa %%xmm0, 16(%0)\n\t"
+            "movdqa %%xmm0, 32(%0)\n\t"
+            "movdqa %%xmm0, 48(%0)\n\t"
+            : : "r"(d) : "memory");
+    }
+
+    memset_rep(d, c, n & 63);
+    return dst;
+}
+
+// -------------------------
+// Public API
+// -------------------------
+void* memcpy(void* dst, const void* src, size_t n) {
+    if (n >= SSE_MIN_BYTES && g_use_sse2 && kernel_fpu_begin()) {
+        memcpy_sse2(dst, src, n);
+        kernel_fpu_end();
+        return dst;
+    }
+    return memcpy_rep(dst, src, n);
+}
+
+void* memmove(void* dst, const void* src, size_t n) {
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+
+    // 앞으로 복사해도 원본을 덮어쓰지 않는 경우
+    if (d <= s || d >= s + n) return memcpy(dst, src, n);
+
+    // 겹치는 역방향: 끝에서부터 남는 바이트, 그다음 dword (DF=1)
+    size_t bytes = n & 3;
+    size_t dwords = n >> 2;
+    d += n - 1;
+    s += n - 1;
+
+    __asm__ __volatile__(
+        "std\n\t"
+        "rep movsb\n\t"
+        "sub $3, %%esi\n\t"
+        "sub $3, %%edi\n\t"
+        "mov %3, %%ecx\n\t"
+        "rep movsl\n\t"
+        "cld"
+        : "+D"(d), "+S"(s), "+c"(bytes)
+        : "r"(dwords)
+        : "memory");
+    return dst;
+}
+
+void* memset(void* dst, int c, size_t n) {
+    if (n >= SSE_MIN_BYTES && g_use_sse2 && kernel_fpu_begin()) {
+        memset_sse2(dst, c, n);
+        kernel_fpu_end();
+        return dst;
+    }
+    return memset_rep(dst, c, n);
+}
+
+int memcmp(const void* a, const void* b, size_t n) {
+    const uint8_t* p = (const uint8_t*)a;
+    const uint8_t* q = (const uint8_t*)b;
+
+    // 같은 동안은 dword 단위로 건너뜀
+    while (n >= 4 && *(const uint32_t*)p == *(const uint32_t*)q) {
+        p += 4;
+        q += 4;
+        n -= 4;
+    }
+    for (; n; n--, p++, q++) {
+        if (*p != *q) return (int)*p - (int)*q;
+    }
+    return 0;
+}
+
+size_t strlen(const char* s) {
+    const char* p = s;
+
+    // dword 정렬까지 바이트 단위
+    for (; ((uint32_t)p & 3) != 0; p++) {
+        if (*p == 0) return (size_t)(p - s);
+    }
+
+    // 0 바이트를 포함한 dword 검출: (x - 0x01..) & ~x & 0x80..
+    const uint32_t* w = (const uint32_t*)p;
+    while (((*w - 0x01010101u) & ~*w & 0x80808080u) == 0) w++;
+
+    for (p = (const char*)w; *p; p++) { }
+    return (size_t)(p - s);
+}
+
+int strcmp(const char* a, const char* b) {
+    while (*a && *a == *b) {
+        a++;
+        b++;
+    }
+    return (int)(uint8_t)*a - (int)(uint8_t)*b;
+}
+
+int strncmp(const char* a, const char* b, size_t n) {
+    for (; n; n--, a++, b++) {
+        if (*a != *b || !*a) return (int)(uint8_t)*a - (int)(uint8_t)*b;
+    }
+    return 0;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// 커널 문자열/메모리 함수
+// 작은 크기는 rep movsd/stosd, 큰 크기는 (CPU가 SSE2를 지원하면) SSE2 경로 사용.
+// SSE 경로는 kernel_fpu_begin()으로 스레드 FPU 상태를 보호하며, IRQ 컨텍스트에서는 항상 정수 경로.
+
+// CPUID로 구현 선택 (fpu_init 이후 1회)
+void string_init(void);
+const char* string_impl_name(void);
+int string_sse2_enabled(void);
+
+void* memcpy(void* dst, const void* src, size_t n);
+void* memmove(void* dst, const void* src, size_t n);
+void* memset(void* dst, int c, size_t n);
+int memcmp(const void* a, const void* b, size_t n);
+size_t strlen(const char* s);
+int strcmp(const char* a, const char* b);
+int strncmp(const char* a, const char* b, size_t n);
+
+// 16비트 단위 채우기 (VGA 텍스트 셀 등)
+void* memsetw(void* dst, uint16_t v, size_t count);
+
+// 개별 구현 (벤치마크/특수 용도)
+void* memcpy_rep(void* dst, const void* src, size_t n);
+void* memset_rep(void* dst, int c, size_t n);
+void* memcpy_sse2(void* dst, const void* src, size_t n);   // kernel_fpu_begin 구간에서만
+void* memset_sse2(void* dst, int c, size_t n);             // kernel_fpu_begin 구간에서만
+
+// 크기별 memcpy/memset 대역폭 측정 (tsc_calibrate 이후)
+void string_bench(void);
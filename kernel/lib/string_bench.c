@@ -0,0 +1,76 @@
+#include "string.h"
+#include "../memory/heap.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/tsc.h"
+#include "../../arch/x86/cpu/fpu.h"
+
+// 크기별로 총 BENCH_TOTAL 바이트를 처리하는 데 걸린 TSC로 대역폭 계산
+#define BENCH_MAX   (1024u * 1024)
+#define BENCH_TOTAL (8u * 1024 * 1024)
+
+typedef enum { BENCH_COPY_REP, BENCH_COPY_SSE, BENCH_COPY_API, BENCH_SET_REP, BENCH_SET_SSE, BENCH_SET_API } bench_op_t;
+
+static uint32_t bench_run(bench_op_t op, uint8_t* dst, const uint8_t* src, uint32_t size) {
+    uint32_t iters = BENCH_TOTAL / size;
+    int sse = (op == BENCH_COPY_SSE || op == BENCH_SET_SSE);
+
+    if (sse && (!string_sse2_enabled() || !kernel_fpu_begin())) return 0;
+
+    uint64_t start = rdtsc();
+    for (uint32_t i = 0; i < iters; i++) {
+        switch (op) {
+            case BENCH_COPY_REP: memcpy_rep(dst, src, size); break;
+            case BENCH_COPY_SSE: memcpy_sse2(dst, src, size); break;
+            case BENCH_COPY_API: memcpy(dst, src, size); break;
+            case BENCH_SET_REP:  memset_rep(dst, 0, size); break;
+            case BENCH_SET_SSE:  memset_sse2(dst, 0, size); break;
+            case BENCH_SET_API:  memset(dst, 0, size); break;
+        }
+    }
+    uint64_t elapsed = rdtsc() - start;
+
+    if (sse) kernel_fpu_end();
+
+    // MB/s = total / (cycles / hz). 64비트 나눗셈(libgcc)을 피하려고 32비트로 정리
+    uint32_t cycles = (elapsed >> 32) ? 0xFFFFFFFFu : (uint32_t)elapsed;
+    uint32_t kb = (iters * size) >> 10;
+    uint32_t cyc_per_kb = cycles / kb;
+    if (cyc_per_kb == 0) cyc_per_kb = 1;
+    return (tsc_hz() >> 10) / cyc_per_kb;
+}
+
+void string_bench(void) {
+    if (tsc_hz() == 0) {
+        kprintf("[BENCH] TSC not calibrated\n");
+        return;
+    }
+
+    uint8_t* src = (uint8_t*)kmalloc_aligned(BENCH_MAX, 64);
+    uint8_t* dst = (uint8_t*)kmalloc_aligned(BENCH_MAX, 64);
+
+    // 정확성 먼저: 정렬이 어긋난 복사, 겹치는 memmove
+    for (uint32_t i = 0; i < BENCH_MAX; i++) src[i] = (uint8_t)(i * 7);
+    memcpy(dst + 3, src + 1, BENCH_MAX - 8);
+    memmove(src + 5, src, 4096);
+    if (memcmp(dst + 3, src + 1, 4) != 0 || src[5 + 4095] != (uint8_t)(4095 * 7) ||
+        strlen("bench") != 5) {
+        kprintf("[BENCH] string sanity check failed\n");
+    }
+
+    kprintf("[BENCH] memcpy/memset MB/s (impl=%s)\n", string_impl_name());
+    kprintf("  %8s %8s %8s %8s %8s %8s %8s\n",
+        "size", "cpy-rep", "cpy-sse", "memcpy", "set-rep", "set-sse", "memset");
+
+    for (uint32_t size = 64; size <= BENCH_MAX; size <<= 2) {
+        kprintf("  %8u %8u %8u %8u %8u %8u %8u\n", size,
+            bench_run(BENCH_COPY_REP, dst, src, size),
+            bench_run(BENCH_COPY_SSE, dst, src, size),
+            bench_run(BENCH_COPY_API, dst, src, size),
+            bench_run(BENCH_SET_REP, dst, src, size),
+            bench_run(BENCH_SET_SSE, dst, src, size),
+            bench_run(BENCH_SET_API, dst, src, size));
+    }
+
+    kfree(dst);
+    kfree(src);
+}
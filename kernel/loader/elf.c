@@ -0,0 +1,97 @@
+#include "elf.h"
+#include "../memory/pmm.h"
+#include "../console/kprintf.h"
+
+static int elf_check_header(const uint8_t* image, uint32_t size) {
+    if (size < sizeof(elf32_ehdr_t)) {
+        kprintf("[ELF] image too small (%u bytes)\n", size);
+        return 0;
+    }
+
+    const elf32_ehdr_t* eh = (const elf32_ehdr_t*)image;
+
+    if (*(const uint32_t*)eh->e_ident != ELF_MAGIC) {
+        kprintf("[ELF] bad magic\n");
+        return 0;
+    }
+    if (eh->e_ident[4] != ELFCLASS32 || eh->e_ident[5] != ELFDATA2LSB) {
+        kprintf("[ELF] not ELF32 little-endian\n");
+        return 0;
+    }
+    if (eh->e_type != ET_EXEC || eh->e_machine != EM_386) {
+        kprintf("[ELF] unsupported type=%u machine=%u\n", eh->e_type, eh->e_machine);
+        return 0;
+    }
+    if (eh->e_phentsize != sizeof(elf32_phdr_t) || eh->e_phnum == 0) {
+        kprintf("[ELF] bad program headers\n");
+        return 0;
+    }
+
+    uint32_t ph_end = eh->e_phoff + (uint32_t)eh->e_phnum * sizeof(elf32_phdr_t);
+    if (ph_end < eh->e_phoff || ph_end > size) {
+        kprintf("[ELF] program headers out of range\n");
+        return 0;
+    }
+    return 1;
+}
+
+static int elf_map_segment(vm_space_t* vs, const uint8_t* image, uint32_t size,
+                           const elf32_phdr_t* ph) {
+    if (ph->p_memsz == 0) return 1;
+
+    uint32_t seg_end = ph->p_vaddr + ph->p_memsz;
+    uint32_t file_end = ph->p_offset + ph->p_filesz;
+
+    if (ph->p_filesz > ph->p_memsz || seg_end < ph->p_vaddr ||
+        file_end < ph->p_offset || file_end > size) {
+        kprintf("[ELF] segment out of range vaddr=0x%x\n", ph->p_vaddr);
+        return 0;
+    }
+    // 아래 1GB는 커널 identity map: 0x08048000 같은 보통의 i386 링크 주소는 받을 수 없다
+    if (ph->p_vaddr < USER_SPACE_START) {
+        kprintf("[ELF] segment 0x%x below user space 0x%x (link with user/user.ld)\n",
+            ph->p_vaddr, USER_SPACE_START);
+        return 0;
+    }
+    // 페이지 내 오프셋이 파일과 메모리에서 같아야 페이지 단위로 대응시킬 수 있음
+    if ((ph->p_vaddr & ~PAGE_MASK) != (ph->p_offset & ~PAGE_MASK)) {
+        kprintf("[ELF] misaligned segment vaddr=0x%x off=0x%x\n", ph->p_vaddr, ph->p_offset);
+        return 0;
+    }
+
+    uint32_t start = PAGE_ALIGN_DOWN(ph->p_vaddr);
+    uint32_t end = PAGE_ALIGN_UP(seg_end);
+    uint32_t lead = ph->p_vaddr - start;
+
+    uint32_t flags = 0;
+    if (ph->p_flags & PF_R) flags |= VMA_READ;
+    if (ph->p_flags & PF_W) flags |= VMA_WRITE;
+    if (ph->p_flags & PF_X) flags |= VMA_EXEC;
+
+    // 파일 내용은 [start, p_vaddr + p_filesz), 그 뒤 .bss는 fault 시 0으로 채워짐
+    if (!vm_map_area(vs, start, end, flags, image, ph->p_offset - lead, ph->p_filesz + lead)) {
+        kprintf("[ELF] cannot map segment 0x%x-0x%x\n", start, end);
+        return 0;
+    }
+    return 1;
+}
+
+int elf_load(vm_space_t* vs, const uint8_t* image, uint32_t size, uint32_t* out_entry) {
+    if (!elf_check_header(image, size)) return 0;
+
+    const elf32_ehdr_t* eh = (const elf32_ehdr_t*)image;
+    const elf32_phdr_t* ph = (const elf32_phdr_t*)(image + eh->e_phoff);
+
+    for (uint16_t i = 0; i < eh->e_phnum; i++) {
+        if (ph[i].p_type != PT_LOAD) continue;
+        if (!elf_map_segment(vs, image, size, &ph[i])) return 0;
+    }
+
+    if (!vm_find_area(vs, eh->e_entry)) {
+        kprintf("[ELF] entry 0x%x not in any segment\n", eh->e_entry);
+        return 0;
+    }
+
+    *out_entry = eh->e_entry;
+    return 1;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <stdint.h>
+#include "../memory/vma.h"
+
+#define ELF_MAGIC   0x464C457F  // "\x7FELF" (little endian)
+#define ELFCLASS32  1
+#define ELFDATA2LSB 1
+#define ET_EXEC     2
+#define EM_386      3
+
+#define PT_LOAD     1
+
+#define SHT_SYMTAB  2
+#define SHT_STRTAB  3
+
+#define STT_FUNC    2
+#define ELF32_ST_TYPE(info) ((info) & 0xF)
+
+#define PF_X        0x1
+#define PF_W        0x2
+#define PF_R        0x4
+
+typedef struct {
+    uint8_t  e_ident[16];
+    uint16_t e_type;
+    uint16_t e_machine;
+    uint32_t e_version;
+    uint32_t e_entry;
+    uint32_t e_phoff;
+    uint32_t e_shoff;
+    uint32_t e_flags;
+    uint16_t e_ehsize;
+    uint16_t e_phentsize;
+    uint16_t e_phnum;
+    uint16_t e_shentsize;
+    uint16_t e_shnum;
+    uint16_t e_shstrndx;
+} __attribute__((packed)) elf32_ehdr_t;
+
+typedef struct {
+    uint32_t p_type;
+    uint32_t p_offset;
+    uint32_t p_vaddr;
+    uint32_t p_paddr;
+    uint32_t p_filesz;
+    uint32_t p_memsz;
+    uint32_t p_flags;
+    uint32_t p_align;
+} __attribute__((packed)) elf32_phdr_t;
+
+typedef struct {
+    uint32_t sh_name;
+    uint32_t sh_type;
+    uint32_t sh_flags;
+    uint32_t sh_addr;
+    uint32_t sh_offset;
+    uint32_t sh_size;
+    uint32_t sh_link;
+    uint32_t sh_info;
+    uint32_t sh_addralign;
+    uint32_t sh_entsize;
+} __attribute__((packed)) elf32_shdr_t;
+
+typedef struct {
+    uint32_t st_name;
+    uint32_t st_value;
+    uint32_t st_size;
+    uint8_t  st_info;
+    uint8_t  st_other;
+    uint16_t st_shndx;
+} __attribute__((packed)) elf32_sym_t;
+
+// ELF32 실행 파일을 vs에 적재 (복사 없음)
+// PT_LOAD 세그먼트를 VMA로 등록만 하고, 실제 페이지는 #PF 시 image에서 채워진다.
+// image는 프로세스 수명 동안 유지되어야 함 (initrd 모듈 등)
+// 성공 1 / 실패 0
+int elf_load(vm_space_t* vs, const uint8_t* image, uint32_t size, uint32_t* out_entry);
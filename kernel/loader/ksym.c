@@ -0,0 +1,53 @@
+#include "ksym.h"
+#include "elf.h"
+#include "../memory/multiboot.h"
+#include "../console/kprintf.h"
+
+static const elf32_sym_t* g_syms = 0;
+static uint32_t g_nsyms = 0;
+static const char* g_strtab = 0;
+static uint32_t g_strtab_size = 0;
+
+void ksym_init(uint32_t mb_addr) {
+    multiboot_info_t* mb = (multiboot_info_t*)mb_addr;
+    if ((mb->flags & (1 << 5)) == 0) {
+        kprintf("[KSYM] no ELF section headers from bootloader\n");
+        return;
+    }
+
+    uint32_t num = mb->syms[0];
+    uint32_t size = mb->syms[1];
+    uint32_t addr = mb->syms[2];
+    if (size < sizeof(elf32_shdr_t)) return;
+
+    for (uint32_t i = 0; i < num; i++) {
+        const elf32_shdr_t* sh = (const elf32_shdr_t*)(addr + i * size);
+        if (sh->sh_type != SHT_SYMTAB || !sh->sh_addr || sh->sh_link >= num) continue;
+
+        const elf32_shdr_t* str = (const elf32_shdr_t*)(addr + sh->sh_link * size);
+        if (!str->sh_addr) continue;
+
+        g_syms = (const elf32_sym_t*)sh->sh_addr;
+        g_nsyms = sh->sh_size / sizeof(elf32_sym_t);
+        g_strtab = (const char*)str->sh_addr;
+        g_strtab_size = str->sh_size;
+        break;
+    }
+
+    kprintf("[KSYM] %u symbols\n", g_nsyms);
+}
+
+const char* ksym_lookup(uint32_t addr, uint32_t* off) {
+    // 정렬되어 있지 않으므로 선형 탐색: 진단 경로에서만 쓴다
+    const elf32_sym_t* best = 0;
+    for (uint32_t i = 0; i < g_nsyms; i++) {
+        const elf32_sym_t* s = &g_syms[i];
+        if (ELF32_ST_TYPE(s->st_info) != STT_FUNC || s->st_value > addr) continue;
+        if (s->st_size && addr >= s->st_value + s->st_size) continue;
+        if (!best || s->st_value > best->st_value) best = s;
+    }
+
+    if (!best || best->st_name >= g_strtab_size) return 0;
+    if (off) *off = addr - best->st_value;
+    return g_strtab + best->st_name;
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <stdint.h>
+
+// 커널 심볼 조회 (진단 출력용)
+// GRUB이 Multiboot로 넘겨 준 커널 ELF의 .symtab/.strtab을 그대로 사용한다 (복사 없음).
+// heap/pmm이 그 영역을 덮지 않도록 kernel_main이 multiboot_symbols_end() 뒤부터 쓴다.
+
+void ksym_init(uint32_t mb_addr);
+
+// addr을 포함하는 함수 이름 (off에 함수 시작부터의 오프셋). 모르면 0
+const char* ksym_lookup(uint32_t addr, uint32_t* off);
@@ -1,74 +1,397 @@
-#include "heap.h"
-#include "../panic/panic.h"
-#include "../console/kprintf.h"
-
-static uint32_t g_heap_start = 0;
-static uint32_t g_heap_end   = 0;
-static uint32_t g_heap_cur   = 0;
-
-static inline uint32_t align_up(uint32_t v, uint32_t align) {
-    if (align == 0) return v;
-    uint32_t mask = align - 1;
-    return (v + mask) & ~mask;
-}
-
-void heap_init(uint32_t heap_start, uint32_t heap_end) {
-    // 기본 정렬
-    heap_start = align_up(heap_start, 16);
-
-    if (heap_end <= heap_start) {
-        panic("heap_init: invalid range");
-    }
-
-    g_heap_start = heap_start;
-    g_heap_end = heap_end;
-    g_heap_cur = heap_start;
-
-    kprintf("[HEAP] init\n");
-    kprintf("  start=0x%x\n", g_heap_start);
-    kprintf("  end  =0x%x\n", g_heap_end);
-}
-
-void *kmalloc(size_t size) {
-    return kmalloc_aligned(size, 16);
-}
-
-void *kmalloc_aligned(size_t size, uint32_t align) {
-    if (g_heap_start == 0) {
-        panic("kmalloc: heap not initialized");
-    }
-
-    if (size == 0) {
-        return (void*)0;
-    }
-
-    uint32_t cur = align_up(g_heap_cur, align);
-    uint32_t next = cur + (uint32_t)size;
-
-    // overflow + bounds check
-    if (next < cur || next > g_heap_end) {
-        kprintf("[HEAP] OOM\n");
-        kprintf("  cur=0x%x\n", g_heap_cur);
-        kprintf("  req=0x%x\n", (uint32_t)size);
-        kprintf("  end=0x%x\n", g_heap_end);
-        panic("kmalloc: out of memory");
-    }
-
-    g_heap_cur = next;
-    return (void*)cur;
-}
-
-uint32_t heap_used(void) {
-    if (g_heap_start == 0) return 0;
-    return g_heap_cur - g_heap_start;
-}
-
-uint32_t heap_free(void) {
-    if (g_heap_start == 0) return 0;
-    return g_heap_end - g_heap_cur;
-}
-
-uint32_t heap_start_addr(void) { return g_heap_start; }
-uint32_t heap_end_addr(void) { return g_heap_end; }
-
-
+#include "heap.h"
+#include "../panic/panic.h"
+#include "../console/kprintf.h"
+#include "../loader/ksym.h"
+#include "../../arch/x86/cpu/irqflags.h"
+
+// 블록 헤더 (16바이트: 기본 정렬 유지)
+// 크기 클래스(16B..4KB, 2의 거듭제곱)는 클래스별 free list로 재사용,
+// 그보다 큰 블록은 large free list에서 first-fit 재사용
+#define HEAP_MAGIC_USED 0x48454150   // "HEAP"
+#define HEAP_MAGIC_FREE 0x46524545   // "FREE"
+#define HEAP_MAGIC_PROF 0x48505246   // "HPRF": 프로파일 중 할당 (callsite 통계에 반영된 블록)
+
+#define HEAP_MIN_SHIFT 4             // 16B
+#define HEAP_MAX_SHIFT 12            // 4KB
+#define HEAP_CLASSES   (HEAP_MAX_SHIFT - HEAP_MIN_SHIFT + 1)
+#define HEAP_LARGE     HEAP_CLASSES  // 통계 배열에서 large 블록 자리
+
+// callsite 해시 테이블 (open addressing, 2의 거듭제곱)
+#define HEAP_PROF_SITES  256
+#define HEAP_PROF_REPORT 16          // 보고서에 출력할 callsite 수
+
+typedef struct heap_block {
+    uint32_t size;                // 블록 본문 크기 (클래스 크기 또는 large 크기)
+    uint32_t magic;
+    union {
+        struct heap_block* next;  // free 상태: free list 연결
+        uint32_t req;             // 사용 중: 요청 크기 (내부 단편화 계산용)
+    };
+    uint32_t caller;              // 할당한 곳 (kmalloc의 return address)
+} heap_block_t;
+
+typedef struct heap_site {
+    uint32_t caller;              // 0이면 빈 슬롯
+    uint32_t live_bytes;          // 블록 크기 기준
+    uint32_t live_count;
+    uint32_t peak_bytes;
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t mark_bytes;          // heap_profile_mark() 시점의 live_bytes
+    uint32_t mark_count;
+} heap_site_t;
+
+// 크기 클래스별 사용 현황 (항상 유지)
+typedef struct heap_class_stat {
+    uint32_t live;                // 사용 중 블록 수
+    uint32_t live_bytes;          // 사용 중 블록 본문 합
+    uint32_t req_bytes;           // 그중 실제 요청 바이트 합
+    uint32_t free_blocks;         // free list 길이
+} heap_class_stat_t;
+
+static uint32_t g_heap_start = 0;
+static uint32_t g_heap_end   = 0;
+static uint32_t g_heap_cur   = 0;
+
+static heap_block_t* g_free_class[HEAP_CLASSES];
+static heap_block_t* g_free_large = 0;
+static uint32_t g_free_bytes = 0;    // free list에 있는 본문 바이트 합
+
+static heap_class_stat_t g_class_stat[HEAP_CLASSES + 1];
+
+static int g_prof_on = 0;
+static heap_site_t g_sites[HEAP_PROF_SITES];
+static uint32_t g_sites_used = 0;
+static uint32_t g_sites_dropped = 0;  // 테이블이 가득 차서 추적 못 한 할당
+
+static inline uint32_t align_up(uint32_t v, uint32_t align) {
+    if (align == 0) return v;
+    uint32_t mask = align - 1;
+    return (v + mask) & ~mask;
+}
+
+static inline heap_block_t* block_of(void* p) {
+    return (heap_block_t*)((uint32_t)p - sizeof(heap_block_t));
+}
+
+static inline void* body_of(heap_block_t* b) {
+    return (void*)((uint32_t)b + sizeof(heap_block_t));
+}
+
+// size -> 클래스 인덱스 (large면 -1)
+static int size_class(size_t size) {
+    if (size > (1u << HEAP_MAX_SHIFT)) return -1;
+
+    int shift = HEAP_MIN_SHIFT;
+    while ((1u << shift) < size) shift++;
+    return shift - HEAP_MIN_SHIFT;
+}
+
+void heap_init(uint32_t heap_start, uint32_t heap_end) {
+    // 기본 정렬
+    heap_start = align_up(heap_start, 16);
+
+    if (heap_end <= heap_start) {
+        panic("heap_init: invalid range");
+    }
+
+    g_heap_start = heap_start;
+    g_heap_end = heap_end;
+    g_heap_cur = heap_start;
+
+    for (int i = 0; i < HEAP_CLASSES; i++) g_free_class[i] = 0;
+    g_free_large = 0;
+    g_free_bytes = 0;
+
+    for (int i = 0; i <= HEAP_CLASSES; i++) {
+        g_class_stat[i].live = 0;
+        g_class_stat[i].live_bytes = 0;
+        g_class_stat[i].req_bytes = 0;
+        g_class_stat[i].free_blocks = 0;
+    }
+
+    kprintf("[HEAP] init\n");
+    kprintf("  start=0x%x\n", g_heap_start);
+    kprintf("  end  =0x%x\n", g_heap_end);
+}
+
+// free list에서 정렬 조건을 만족하는 블록 꺼내기
+static heap_block_t* take_free(heap_block_t** head, uint32_t size, uint32_t align) {
+    for (heap_block_t** link = head; *link; link = &(*link)->next) {
+        heap_block_t* b = *link;
+        if (b->size < size) continue;
+        if (((uint32_t)body_of(b) & (align - 1)) != 0) continue;
+
+        *link = b->next;
+        g_free_bytes -= b->size;
+        return b;
+    }
+    return 0;
+}
+
+static heap_site_t* site_find(uint32_t caller, int create) {
+    uint32_t h = (caller >> 2) * 2654435761u;
+    for (uint32_t i = 0; i < HEAP_PROF_SITES; i++) {
+        heap_site_t* st = &g_sites[(h + i) & (HEAP_PROF_SITES - 1)];
+        if (st->caller == caller) return st;
+        if (st->caller == 0) {
+            if (!create) return 0;
+            st->caller = caller;
+            g_sites_used++;
+            return st;
+        }
+    }
+    return 0;
+}
+
+// 사용 중으로 바뀐 블록을 통계에 반영 (heap 잠금 = 인터럽트 off 상태)
+static void account_alloc(heap_block_t* b, int cls) {
+    heap_class_stat_t* cs = &g_class_stat[cls >= 0 ? cls : HEAP_LARGE];
+    cs->live++;
+    cs->live_bytes += b->size;
+    cs->req_bytes += b->req;
+
+    b->magic = HEAP_MAGIC_USED;
+    if (!g_prof_on) return;
+
+    heap_site_t* st = site_find(b->caller, 1);
+    if (!st) {
+        g_sites_dropped++;
+        return;
+    }
+    st->live_bytes += b->size;
+    st->live_count++;
+    st->allocs++;
+    if (st->live_bytes > st->peak_bytes) st->peak_bytes = st->live_bytes;
+    b->magic = HEAP_MAGIC_PROF;
+}
+
+static void account_free(heap_block_t* b, int cls) {
+    heap_class_stat_t* cs = &g_class_stat[cls >= 0 ? cls : HEAP_LARGE];
+    cs->live--;
+    cs->live_bytes -= b->size;
+    cs->req_bytes -= b->req;
+    cs->free_blocks++;
+
+    // 프로파일 켜기 전에 할당된 블록은 callsite 통계에 없다
+    if (b->magic != HEAP_MAGIC_PROF) return;
+    heap_site_t* st = site_find(b->caller, 0);
+    if (!st) return;
+    st->live_bytes -= b->size;
+    st->live_count--;
+    st->frees++;
+}
+
+static void* heap_alloc(size_t size, uint32_t align, uint32_t caller) {
+    if (g_heap_start == 0) {
+        panic("kmalloc: heap not initialized");
+    }
+
+    if (size == 0) {
+        return (void*)0;
+    }
+
+    if (align < 16) align = 16;
+
+    uint32_t flags = irq_save();
+
+    int cls = size_class(size);
+    uint32_t bsize = (cls >= 0) ? (1u << (cls + HEAP_MIN_SHIFT)) : align_up((uint32_t)size, 16);
+
+    heap_block_t* b = (cls >= 0)
+        ? take_free(&g_free_class[cls], bsize, align)
+        : take_free(&g_free_large, bsize, align);
+
+    if (b) {
+        g_class_stat[cls >= 0 ? cls : HEAP_LARGE].free_blocks--;
+    } else {
+        // 헤더 뒤 본문이 align에 맞도록 bump
+        uint32_t body = align_up(g_heap_cur + sizeof(heap_block_t), align);
+        uint32_t next = body + bsize;
+
+        // overflow + bounds check
+        if (body < g_heap_cur || next < body || next > g_heap_end) {
+            kprintf("[HEAP] OOM\n");
+            kprintf("  cur=0x%x\n", g_heap_cur);
+            kprintf("  req=0x%x\n", (uint32_t)size);
+            kprintf("  end=0x%x\n", g_heap_end);
+            kprintf("  caller=0x%x\n", caller);
+            heap_profile_report();
+            panic("kmalloc: out of memory");
+        }
+
+        g_heap_cur = next;
+        b = block_of((void*)body);
+        b->size = bsize;
+    }
+
+    b->req = (uint32_t)size;
+    b->caller = caller;
+    account_alloc(b, cls);
+    irq_restore(flags);
+    return body_of(b);
+}
+
+// callsite는 kmalloc을 부른 곳 (heap_alloc은 static이라 호출자 프레임이 그대로)
+void* kmalloc(size_t size) {
+    return heap_alloc(size, 16, (uint32_t)__builtin_return_address(0));
+}
+
+void* kmalloc_aligned(size_t size, uint32_t align) {
+    return heap_alloc(size, align, (uint32_t)__builtin_return_address(0));
+}
+
+void kfree(void* p) {
+    if (!p) return;
+
+    heap_block_t* b = block_of(p);
+    if ((uint32_t)p < g_heap_start || (uint32_t)p >= g_heap_cur ||
+        (b->magic != HEAP_MAGIC_USED && b->magic != HEAP_MAGIC_PROF)) {
+        kprintf("[HEAP] bad kfree ptr=0x%x\n", (uint32_t)p);
+        panic("kfree: invalid pointer or double free");
+    }
+
+    uint32_t flags = irq_save();
+    int cls = size_class(b->size);
+    account_free(b, cls);
+    b->magic = HEAP_MAGIC_FREE;
+
+    heap_block_t** head = (cls >= 0) ? &g_free_class[cls] : &g_free_large;
+    b->next = *head;
+    *head = b;
+    g_free_bytes += b->size;
+    irq_restore(flags);
+}
+
+uint32_t heap_used(void) {
+    if (g_heap_start == 0) return 0;
+    return g_heap_cur - g_heap_start - g_free_bytes;
+}
+
+uint32_t heap_free(void) {
+    if (g_heap_start == 0) return 0;
+    return g_heap_end - g_heap_cur + g_free_bytes;
+}
+
+uint32_t heap_start_addr(void) { return g_heap_start; }
+uint32_t heap_end_addr(void) { return g_heap_end; }
+
+// ---- 프로파일러 ----
+
+void heap_profile_enable(int on) {
+    uint32_t f = irq_save();
+    g_prof_on = on;
+    irq_restore(f);
+}
+
+void heap_profile_mark(void) {
+    uint32_t f = irq_save();
+    for (uint32_t i = 0; i < HEAP_PROF_SITES; i++) {
+        g_sites[i].mark_bytes = g_sites[i].live_bytes;
+        g_sites[i].mark_count = g_sites[i].live_count;
+    }
+    irq_restore(f);
+}
+
+static void print_site(const char* tag, const heap_site_t* st) {
+    uint32_t off = 0;
+    const char* name = ksym_lookup(st->caller, &off);
+    if (name) {
+        kprintf("[HEAP] %s %s+0x%x", tag, name, off);
+    } else {
+        kprintf("[HEAP] %s 0x%x", tag, st->caller);
+    }
+}
+
+static uint32_t site_key(const heap_site_t* st, int since_mark) {
+    return since_mark ? st->live_bytes - st->mark_bytes : st->live_bytes;
+}
+
+// live_bytes(또는 mark 이후 증가분) 내림차순 상위 n개 인덱스. 힙을 쓰지 않는다 (OOM 경로)
+static uint32_t top_sites(uint16_t* idx, uint32_t n, int since_mark) {
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < HEAP_PROF_SITES; i++) {
+        const heap_site_t* st = &g_sites[i];
+        if (!st->caller) continue;
+        if (since_mark && st->live_count <= st->mark_count) continue;
+
+        uint32_t key = site_key(st, since_mark);
+        if (k == n && key <= site_key(&g_sites[idx[n - 1]], since_mark)) continue;
+
+        // 가득 찼으면 마지막 자리를 밀어내고 삽입 정렬
+        uint32_t j = (k < n) ? k++ : n - 1;
+        while (j > 0 && site_key(&g_sites[idx[j - 1]], since_mark) < key) {
+            idx[j] = idx[j - 1];
+            j--;
+        }
+        idx[j] = (uint16_t)i;
+    }
+    return k;
+}
+
+void heap_profile_report(void) {
+    uint16_t idx[HEAP_PROF_REPORT];
+    heap_site_t sites[HEAP_PROF_REPORT];
+    heap_class_stat_t cls[HEAP_CLASSES + 1];
+
+    // 스냅샷만 인터럽트 off로 뜨고 출력은 밖에서 (OOM 경로에서는 이미 off)
+    uint32_t f = irq_save();
+    uint32_t n = top_sites(idx, HEAP_PROF_REPORT, 0);
+    for (uint32_t i = 0; i < n; i++) sites[i] = g_sites[idx[i]];
+    for (int c = 0; c <= HEAP_CLASSES; c++) cls[c] = g_class_stat[c];
+    uint32_t large_free = 0;
+    for (heap_block_t* b = g_free_large; b; b = b->next) large_free += b->size;
+    uint32_t used = heap_used();
+    uint32_t free = heap_free();
+    uint32_t bump = g_heap_cur - g_heap_start;
+    uint32_t free_list = g_free_bytes;
+    irq_restore(f);
+
+    kprintf("[HEAP] used=%u free=%u bump=%u/%u free-list=%u sites=%u dropped=%u%s\n",
+        used, free, bump, g_heap_end - g_heap_start, free_list,
+        g_sites_used, g_sites_dropped, g_prof_on ? "" : " (profiling off)");
+
+    // 크기 클래스별 단편화: 내부 = 블록 크기 대비 요청 크기 손실, 외부 = free list에 묶인 블록
+    kprintf("[HEAP] class    live  live(B)   req(B) int-frag  free  free(B)\n");
+    for (int c = 0; c <= HEAP_CLASSES; c++) {
+        const heap_class_stat_t* cs = &cls[c];
+        if (!cs->live && !cs->free_blocks) continue;
+
+        uint32_t waste = cs->live_bytes ? (cs->live_bytes - cs->req_bytes) * 100 / cs->live_bytes : 0;
+        uint32_t free_bytes;
+        if (c < HEAP_CLASSES) {
+            free_bytes = cs->free_blocks << (c + HEAP_MIN_SHIFT);
+            kprintf("[HEAP] %5u", 1u << (c + HEAP_MIN_SHIFT));
+        } else {
+            free_bytes = large_free;
+            kprintf("[HEAP] large");
+        }
+        kprintf(" %7u %8u %8u %7u%% %5u %8u\n",
+            cs->live, cs->live_bytes, cs->req_bytes, waste, cs->free_blocks, free_bytes);
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        print_site("site", &sites[i]);
+        kprintf(" live=%u in %u peak=%u allocs=%u frees=%u\n",
+            sites[i].live_bytes, sites[i].live_count, sites[i].peak_bytes,
+            sites[i].allocs, sites[i].frees);
+    }
+}
+
+void heap_leak_report(void) {
+    uint16_t idx[HEAP_PROF_REPORT];
+
+    uint32_t f = irq_save();
+    uint32_t n = top_sites(idx, HEAP_PROF_REPORT, 1);
+    heap_site_t snap[HEAP_PROF_REPORT];
+    for (uint32_t i = 0; i < n; i++) snap[i] = g_sites[idx[i]];
+    irq_restore(f);
+
+    kprintf("[HEAP] leak candidates since mark: %u site(s)\n", n);
+    for (uint32_t i = 0; i < n; i++) {
+        print_site("grew", &snap[i]);
+        kprintf(" +%u bytes +%u blocks (live=%u)\n",
+            snap[i].live_bytes - snap[i].mark_bytes, snap[i].live_count - snap[i].mark_count,
+            snap[i].live_bytes);
+    }
+}
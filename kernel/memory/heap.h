@@ -1,13 +1,27 @@
-#pragma once
-#include <stdint.h>
-#include <stddef.h>
-
-void heap_init(uint32_t heap_start, uint32_t heap_end);
-void* kmalloc(size_t size);
-void* kmalloc_aligned(size_t size, uint32_t align);
-
-uint32_t heap_used(void);
-uint32_t heap_free(void);
-uint32_t heap_start_addr(void);
-uint32_t heap_end_addr(void);
-
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+void heap_init(uint32_t heap_start, uint32_t heap_end);
+void* kmalloc(size_t size);
+void* kmalloc_aligned(size_t size, uint32_t align);
+
+// kmalloc/kmalloc_aligned로 받은 블록 반환 (크기 클래스별 free list로 재사용)
+void kfree(void* p);
+
+uint32_t heap_used(void);
+uint32_t heap_free(void);
+uint32_t heap_start_addr(void);
+uint32_t heap_end_addr(void);
+
+// ---- 할당 프로파일러 ----
+// 모든 블록 헤더에 호출 위치(kmalloc의 return address)와 요청 크기가 기록된다.
+// 켜 두면 callsite별 live 바이트/개수/peak를 해시 테이블로 유지한다 (이전 할당은 통계 밖).
+void heap_profile_enable(int on);
+
+// 크기 클래스별 단편화 + live 바이트 상위 callsite (심볼 이름은 ksym). OOM 시 panic 전에도 출력
+void heap_profile_report(void);
+
+// 기준점 기록 → 이후 heap_leak_report()는 그 뒤로 live가 늘어난 callsite만 출력
+void heap_profile_mark(void);
+void heap_leak_report(void);
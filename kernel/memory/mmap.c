@@ -0,0 +1,227 @@
+#include "mmap.h"
+#include "pmm.h"
+#include "../fs/file.h"
+#include "../fs/shmem.h"
+#include "../console/kprintf.h"
+#include "../lib/errno.h"
+#include "../lib/string.h"
+
+static mmap_stats_t g_stats;
+static uint32_t g_fault_around = MMAP_FAULT_AROUND_DEFAULT;
+
+void mmap_set_fault_around(uint32_t pages) {
+    uint32_t p = 1;
+    if (!pages) {
+        g_fault_around = 0;
+        return;
+    }
+    while (p * 2 <= pages && p < 1024) p *= 2;
+    g_fault_around = p;
+}
+
+// va에 대응하는 파일 페이지 번호
+static inline uint32_t file_index(const vm_area_t* a, uint32_t va) {
+    return (a->file_off + (va - a->start)) >> PAGE_SHIFT;
+}
+
+// va 페이지가 파일 끝 안쪽인가 (마지막 부분 페이지 포함)
+static inline int within_eof(const vm_area_t* a, uint32_t va) {
+    return (uint64_t)a->file_off + (va - a->start) < a->file->size;
+}
+
+// 캐시 페이지를 그대로 매핑할 때의 PTE 플래그
+// (shared 쓰기 가능이면 바로 쓰기 허용, private은 RO로 두고 첫 쓰기에서 COW)
+static uint32_t cache_pte_flags(const vm_area_t* a) {
+    uint32_t flags = PAGE_USER;
+    if (a->flags & VMA_WRITE) flags |= (a->flags & VMA_SHARED) ? PAGE_WRITE : PAGE_COW;
+    return flags;
+}
+
+// fault 난 페이지가 속한 정렬된 창에서, 이미 캐시에 있고 아직 매핑 안 된 이웃 페이지를 같이 매핑.
+// 순차 읽기의 fault 수가 창 크기만큼 줄어든다. 캐시에 없는 페이지는 만들지 않는다.
+static void fault_around(vm_space_t* vs, vm_area_t* a, uint32_t va) {
+    file_t* f = a->file;
+    if (g_fault_around <= 1 || !f->ops->find_page) return;
+
+    uint32_t span = g_fault_around * PAGE_SIZE;
+    uint32_t lo = va & ~(span - 1);
+    uint32_t hi = lo + span;
+    if (lo < a->start) lo = a->start;
+    if (hi > a->end || hi < lo) hi = a->end;
+
+    uint32_t flags = cache_pte_flags(a);
+    for (uint32_t v = lo; v < hi; v += PAGE_SIZE) {
+        if (v == va) continue;
+        if (!within_eof(a, v)) break;
+
+        pte_t* pte = paging_get_pte(vs->pd, v, 0);
+        if (pte && (*pte & PAGE_PRESENT)) continue;
+
+        uint32_t page = f->ops->find_page(f, file_index(a, v));
+        if (!page) continue;
+        if (!paging_map(vs->pd, v, page, flags)) {
+            pmm_unref(page);
+            break;
+        }
+        vs->resident_pages++;
+        vs->inplace_pages++;
+        g_stats.fault_around_pages++;
+    }
+}
+
+int mmap_file_fault(vm_space_t* vs, vm_area_t* a, uint32_t va, int is_write) {
+    file_t* f = a->file;
+
+    // 파일 끝 너머 (Linux라면 SIGBUS)
+    if (!within_eof(a, va)) return 0;
+
+    uint32_t page = f->ops->get_page(f, file_index(a, va));
+    if (!page) {
+        kprintf("[MMAP] %s: no page (va=0x%x)\n", f->name, va);
+        return 0;
+    }
+
+    // private 매핑의 첫 접근이 쓰기: 캐시 페이지를 복사한 자기 페이지로 바로 매핑
+    if (is_write && !(a->flags & VMA_SHARED)) {
+        uint32_t frame = pmm_alloc_frame();
+        if (!frame) {
+            pmm_unref(page);
+            kprintf("[MMAP] out of frames (va=0x%x)\n", va);
+            return 0;
+        }
+        memcpy((void*)frame, (const void*)page, PAGE_SIZE);
+        pmm_unref(page);
+        if (!paging_map(vs->pd, va, frame, PAGE_USER | PAGE_WRITE)) {
+            pmm_unref(frame);
+            return 0;
+        }
+        vs->resident_pages++;
+        g_stats.private_copies++;
+        return 1;
+    }
+
+    // get_page의 참조는 PTE가 가져간다 (munmap / 주소 공간 해제에서 놓음)
+    if (!paging_map(vs->pd, va, page, cache_pte_flags(a))) {
+        pmm_unref(page);
+        return 0;
+    }
+    vs->resident_pages++;
+    vs->inplace_pages++;
+    g_stats.file_faults++;
+
+    if (!is_write) fault_around(vs, a, va);
+    return 1;
+}
+
+// [MMAP_BASE, MMAP_END)에서 len이 들어가는 첫 빈 구간
+static uint32_t find_free(vm_space_t* vs, uint32_t len) {
+    uint32_t cand = MMAP_BASE;
+    for (vm_area_t* a = vs->areas; a; a = a->next) {
+        if (a->end <= cand) continue;
+        if (a->start >= cand + len) break;
+        cand = a->end;
+    }
+    if (cand + len < cand || cand + len > MMAP_END) return 0;
+    return cand;
+}
+
+int32_t vm_mmap(vm_space_t* vs, uint32_t addr, uint32_t len, uint32_t prot, uint32_t flags,
+                file_t* f, uint32_t off, uint32_t* out) {
+    int shared = (flags & MAP_SHARED) != 0;
+    if (shared == ((flags & MAP_PRIVATE) != 0)) return -EINVAL;
+    if (len == 0 || (off & ~PAGE_MASK)) return -EINVAL;
+    len = PAGE_ALIGN_UP(len);
+    if (len == 0) return -ENOMEM;
+
+    prot &= VMA_READ | VMA_WRITE | VMA_EXEC;
+
+    if (flags & MAP_ANONYMOUS) {
+        if (f) return -EINVAL;
+        off = 0;
+    } else {
+        if (!f) return -EBADF;
+        if (!f->ops->get_page) return -ENODEV;
+    }
+
+    if (flags & MAP_FIXED) {
+        if ((addr & ~PAGE_MASK) || addr < USER_SPACE_START || addr + len < addr || addr + len > USER_SPACE_END) {
+            return -EINVAL;
+        }
+        vm_unmap(vs, addr, addr + len);
+    } else {
+        addr = find_free(vs, len);
+        if (!addr) return -ENOMEM;
+    }
+
+    // anonymous 공유: 내부 shmem 파일을 만들어 파일 매핑으로 다룬다 (fork 후에도 같은 페이지)
+    file_t* backing = f;
+    if ((flags & MAP_ANONYMOUS) && shared) {
+        backing = shmem_file_create("anon-shm", len);
+        if (!backing) return -ENOMEM;
+        backing->size = len;
+    } else if (backing) {
+        file_get(backing);
+    }
+
+    vm_area_t* a = vm_map_area(vs, addr, addr + len, prot | (shared ? VMA_SHARED : 0), 0, 0, 0);
+    if (!a) {
+        if (backing) file_put(backing);
+        return -ENOMEM;
+    }
+    a->file = backing;
+    a->file_off = off;
+    g_stats.maps++;
+
+    if (flags & MAP_POPULATE) vm_populate(vs, addr, addr + len, 0);
+
+    *out = addr;
+    return 0;
+}
+
+int32_t vm_munmap(vm_space_t* vs, uint32_t addr, uint32_t len) {
+    if (len == 0) return -EINVAL;
+    uint32_t end = PAGE_ALIGN_UP(addr + len);
+    if (end <= addr || !vm_unmap(vs, addr, end)) return -EINVAL;
+    g_stats.unmaps++;
+    return 0;
+}
+
+int32_t vm_msync(vm_space_t* vs, uint32_t addr, uint32_t len, uint32_t flags) {
+    if ((addr & ~PAGE_MASK) || ((flags & MS_ASYNC) && (flags & MS_SYNC))) return -EINVAL;
+    uint32_t end = PAGE_ALIGN_UP(addr + len);
+    if (end < addr) return -ENOMEM;
+
+    // 매핑이 캐시 페이지 자체이므로 MS_INVALIDATE는 할 일이 없고,
+    // 쓰기 반영 스레드가 없어 MS_ASYNC도 MS_SYNC처럼 바로 반영한다
+    int32_t synced = 0;
+    uint32_t va = addr;
+    while (va < end) {
+        vm_area_t* a = vm_find_area(vs, va);
+        if (!a) return -ENOMEM;
+        uint32_t stop = a->end < end ? a->end : end;
+
+        if (!a->file || !(a->flags & VMA_SHARED)) {
+            va = stop;
+            continue;
+        }
+        for (; va < stop; va += PAGE_SIZE) {
+            pte_t* pte = paging_get_pte(vs->pd, va, 0);
+            if (!pte || (*pte & (PAGE_PRESENT | PAGE_DIRTY)) != (PAGE_PRESENT | PAGE_DIRTY)) continue;
+
+            *pte &= ~PAGE_DIRTY;
+            paging_flush(vs->pd, va);
+            if (a->file->ops->sync) {
+                uint64_t pos = (uint64_t)a->file_off + (va - a->start);
+                int32_t r = a->file->ops->sync(a->file, pos, PAGE_SIZE);
+                if (r < 0) return r;
+            }
+            synced++;
+        }
+    }
+    g_stats.msync_pages += (uint32_t)synced;
+    return synced;
+}
+
+void mmap_get_stats(mmap_stats_t* out) {
+    *out = g_stats;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <stdint.h>
+#include "vma.h"
+
+// mmap: 파일의 페이지 캐시 페이지를 유저 주소 공간에 그대로 매핑
+// - 파일 매핑은 file_ops.get_page가 있는 파일만 (페이지 캐시 = shmem). 읽기/쓰기 복사가 없다
+// - MAP_SHARED: PTE가 캐시 페이지를 직접 가리킨다. 쓰기는 곧바로 파일 내용이고 다른 매핑/
+//   file_read에도 보인다. 하드웨어 dirty 비트로 msync가 바뀐 페이지를 찾는다
+// - MAP_PRIVATE: 읽기는 캐시 페이지를 RO(+COW)로 매핑, 첫 쓰기에서 복사본으로 분리
+// - MAP_ANONYMOUS | MAP_SHARED: 내부 shmem 파일을 만들어 매핑. fork한 자식과 같은 페이지를 쓴다
+// - 페이지는 #PF(isr_handler → vm_handle_fault)에서 채운다. 읽기 fault는 이웃의 이미 캐시된
+//   페이지도 함께 매핑한다 (fault-around, 정렬된 창 단위)
+
+// prot = VMA_READ / VMA_WRITE / VMA_EXEC (Linux PROT_* 값과 같음)
+
+// flags
+#define MAP_SHARED    0x01
+#define MAP_PRIVATE   0x02
+#define MAP_FIXED     0x10              // addr에 그대로 (기존 매핑은 제거)
+#define MAP_ANONYMOUS 0x20
+#define MAP_POPULATE  0x8000            // 돌아가기 전에 모든 페이지를 fault-in
+
+// msync flags
+#define MS_ASYNC      0x1
+#define MS_INVALIDATE 0x2
+#define MS_SYNC       0x4
+
+// 주소를 지정하지 않은 매핑이 놓이는 범위 (유저 스택 아래)
+#define MMAP_BASE 0x60000000u
+#define MMAP_END  0xB0000000u
+
+// fault-around 창 기본값 (페이지 수, 2의 거듭제곱)
+#define MMAP_FAULT_AROUND_DEFAULT 16
+
+struct file;
+
+// len 바이트를 매핑해 *out에 시작 주소. 성공 0, 실패 -errno
+// f/off는 파일 매핑일 때만 (off는 페이지 정렬, VMA가 파일 참조를 하나 가짐)
+int32_t vm_mmap(vm_space_t* vs, uint32_t addr, uint32_t len, uint32_t prot, uint32_t flags,
+                struct file* f, uint32_t off, uint32_t* out);
+
+// [addr, addr + len) 매핑 해제. 성공 0, 실패 -EINVAL
+int32_t vm_munmap(vm_space_t* vs, uint32_t addr, uint32_t len);
+
+// 공유 파일 매핑의 dirty 페이지를 찾아 dirty 비트를 지우고 파일 sync로 반영.
+// 반영한 페이지 수, 매핑되지 않은 구간이 있으면 -ENOMEM
+int32_t vm_msync(vm_space_t* vs, uint32_t addr, uint32_t len, uint32_t flags);
+
+// fault-around 창 크기 (0이면 끔, 2의 거듭제곱으로 내림)
+void mmap_set_fault_around(uint32_t pages);
+
+// vma.c의 fault 경로에서 호출 (a->file이 있는 영역의 비어 있는 페이지)
+int mmap_file_fault(vm_space_t* vs, vm_area_t* a, uint32_t va, int is_write);
+
+typedef struct mmap_stats {
+    uint32_t maps;
+    uint32_t unmaps;
+    uint32_t file_faults;               // 캐시 페이지를 매핑한 fault
+    uint32_t private_copies;            // private 매핑의 첫 쓰기 fault (복사본 생성)
+    uint32_t fault_around_pages;        // fault 한 번에 같이 매핑된 이웃 페이지
+    uint32_t msync_pages;               // msync가 반영한 dirty 페이지
+} mmap_stats_t;
+
+void mmap_get_stats(mmap_stats_t* out);
+
+// 파일 매핑 읽기 (fault 수 / fault-around / populate) vs file_read 복사, 공유/COW/anonymous 공유 확인
+void mmap_bench(void);
@@ -0,0 +1,158 @@
+#include "mmap.h"
+#include "pmm.h"
+#include "heap.h"
+#include "../fs/file.h"
+#include "../fs/shmem.h"
+#include "../panic/panic.h"
+#include "../lib/div64.h"
+#include "../lib/cmdline.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/tsc.h"
+
+// 8MB 페이지 캐시 파일을 read 복사 / mmap(fault 방식별)으로 훑는 비용 비교 + 공유/COW 확인
+#define MB_FILE_SIZE (8u * 1024 * 1024)
+#define MB_CHUNK     (64u * 1024)
+
+static uint32_t mb_per_sec(uint32_t bytes, uint64_t cycles) {
+    uint64_t us = tsc_cycles_to_us(cycles);
+    if (us == 0) us = 1;
+    uint64_t bps = (uint64_t)bytes * 1000000ull;
+    div_u64_u32(&bps, (uint32_t)us);
+    return (uint32_t)(bps >> 20);
+}
+
+static uint32_t sum_words(const uint32_t* p, uint32_t bytes) {
+    uint32_t s = 0;
+    for (uint32_t i = 0; i < bytes / 4; i++) s += p[i];
+    return s;
+}
+
+static void expect(int cond, const char* what) {
+    if (!cond) {
+        kprintf("[MMAP] FAILED: %s\n", what);
+        panic("mmap test failed");
+    }
+}
+
+// 매핑 한 번을 두 번 훑는다: 첫 회(fault 포함)와 두 번째(이미 매핑됨 = 메모리 속도)
+static void scan_mapping(vm_space_t* vs, file_t* f, const char* label, uint32_t fault_around,
+                         uint32_t flags, uint32_t expected) {
+    mmap_stats_t s0, s1;
+    mmap_set_fault_around(fault_around);
+    mmap_get_stats(&s0);
+
+    uint64_t t0 = rdtsc();
+    uint32_t addr;
+    int32_t r = vm_mmap(vs, 0, MB_FILE_SIZE, VMA_READ, MAP_PRIVATE | flags, f, 0, &addr);
+    expect(r == 0, "mmap file");
+    uint32_t sum = sum_words((const uint32_t*)addr, MB_FILE_SIZE);
+    uint64_t first = rdtsc() - t0;
+
+    t0 = rdtsc();
+    uint32_t sum2 = sum_words((const uint32_t*)addr, MB_FILE_SIZE);
+    uint64_t second = rdtsc() - t0;
+    mmap_get_stats(&s1);
+
+    expect(sum == expected && sum2 == expected, "mapped contents");
+    kprintf("[MMAP] %-14s first %4u MB/s, again %4u MB/s (faults %u, around %u)\n",
+        label, mb_per_sec(MB_FILE_SIZE, first), mb_per_sec(MB_FILE_SIZE, second),
+        s1.file_faults - s0.file_faults, s1.fault_around_pages - s0.fault_around_pages);
+    vm_munmap(vs, addr, MB_FILE_SIZE);
+}
+
+void mmap_bench(void) {
+    if (!cmdline_bench("mmap")) return;
+    file_t* f = shmem_file_create("mmap-data", MB_FILE_SIZE);
+    uint32_t* chunk = (uint32_t*)kmalloc(MB_CHUNK);
+    uint32_t expected = 0;
+    for (uint32_t off = 0; off < MB_FILE_SIZE; off += MB_CHUNK) {
+        for (uint32_t i = 0; i < MB_CHUNK / 4; i++) {
+            chunk[i] = off / 4 + i;
+            expected += chunk[i];
+        }
+        file_write(f, chunk, MB_CHUNK, off);
+    }
+
+    vm_space_t* prev = vm_current_space();
+    vm_space_t* a = vm_space_create();
+    vm_space_activate(a);
+
+    // 1) read 복사: 커널 버퍼로 64KB씩
+    uint64_t t0 = rdtsc();
+    uint32_t sum = 0;
+    for (uint32_t off = 0; off < MB_FILE_SIZE; off += MB_CHUNK) {
+        file_read(f, chunk, MB_CHUNK, off);
+        sum += sum_words(chunk, MB_CHUNK);
+    }
+    uint64_t copy = rdtsc() - t0;
+    expect(sum == expected, "file_read contents");
+    kprintf("[MMAP] %-14s %4u MB/s\n", "read copy", mb_per_sec(MB_FILE_SIZE, copy));
+
+    // 2) mmap: 페이지마다 fault / fault-around 16 / MAP_POPULATE
+    scan_mapping(a, f, "fault/page", 0, 0, expected);
+    scan_mapping(a, f, "fault-around", MMAP_FAULT_AROUND_DEFAULT, 0, expected);
+    scan_mapping(a, f, "populate", MMAP_FAULT_AROUND_DEFAULT, MAP_POPULATE, expected);
+    mmap_set_fault_around(MMAP_FAULT_AROUND_DEFAULT);
+
+    // 3) MAP_SHARED: 다른 주소 공간과 file_read가 같은 페이지를 본다, msync가 dirty 페이지를 찾는다
+    vm_space_t* b = vm_space_create();
+    uint32_t wa, rb;
+    expect(vm_mmap(a, 0, 64 * 1024, VMA_READ | VMA_WRITE, MAP_SHARED, f, 0, &wa) == 0, "mmap shared rw");
+    expect(vm_mmap(b, 0, 64 * 1024, VMA_READ, MAP_SHARED, f, 0, &rb) == 0, "mmap shared ro");
+    ((volatile uint32_t*)wa)[1024 * 3] = 0xCAFEF00D;
+
+    vm_space_activate(b);
+    uint32_t seen_b = ((volatile uint32_t*)rb)[1024 * 3];
+    vm_space_activate(a);
+    uint32_t seen_file = 0;
+    file_read(f, &seen_file, 4, 3 * PAGE_SIZE);
+    int32_t dirty = vm_msync(a, wa, 64 * 1024, MS_SYNC);
+    int32_t dirty_again = vm_msync(a, wa, 64 * 1024, MS_SYNC);
+    expect(seen_b == 0xCAFEF00D && seen_file == 0xCAFEF00D, "shared mapping coherence");
+    kprintf("[MMAP] shared: other space + file_read see write, msync dirty=%d then %d\n", dirty, dirty_again);
+
+    // 4) MAP_PRIVATE 쓰기: 복사본으로 분리, 파일은 그대로
+    uint32_t pa;
+    expect(vm_mmap(a, 0, 64 * 1024, VMA_READ | VMA_WRITE, MAP_PRIVATE, f, 0, &pa) == 0, "mmap private rw");
+    uint32_t before = ((volatile uint32_t*)pa)[1];
+    ((volatile uint32_t*)pa)[1] = 0x5555AAAA;
+    uint32_t in_file = 0;
+    file_read(f, &in_file, 4, 4);
+    expect(before == 1 && in_file == 1, "private mapping COW");
+    kprintf("[MMAP] private: write stays in copy (file word=%u, cow_copies=%u)\n", in_file, a->cow_copies);
+
+    // 5) anonymous 공유: fork한 자식의 쓰기가 부모에게 보인다 (private anonymous는 안 보임)
+    uint32_t sa, pv;
+    expect(vm_mmap(a, 0, 16 * 1024, VMA_READ | VMA_WRITE, MAP_SHARED | MAP_ANONYMOUS, 0, 0, &sa) == 0, "mmap anon shared");
+    expect(vm_mmap(a, 0, 16 * 1024, VMA_READ | VMA_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, 0, 0, &pv) == 0, "mmap anon private");
+    *(volatile uint32_t*)sa = 1;
+    *(volatile uint32_t*)pv = 1;
+    vm_space_t* child = vm_space_fork(a);
+    vm_space_activate(child);
+    *(volatile uint32_t*)sa = 2;
+    *(volatile uint32_t*)(sa + PAGE_SIZE) = 3;          // fork 뒤에 처음 건드린 페이지도 공유
+    *(volatile uint32_t*)pv = 2;
+    vm_space_activate(a);
+    expect(*(volatile uint32_t*)sa == 2 && *(volatile uint32_t*)(sa + PAGE_SIZE) == 3, "anon shared across fork");
+    expect(*(volatile uint32_t*)pv == 1, "anon private across fork");
+    kprintf("[MMAP] anon shared: parent sees child's writes, private stays 1\n");
+
+    // 6) munmap 가운데 구멍: VMA가 둘로 나뉘고 뒤쪽은 파일 오프셋을 유지
+    expect(vm_munmap(a, wa + 16 * 1024, 16 * 1024) == 0, "munmap hole");
+    vm_area_t* tail = vm_find_area(a, wa + 32 * 1024);
+    expect(!vm_find_area(a, wa + 16 * 1024) && tail && tail->file_off == 32 * 1024, "munmap split");
+    expect(((volatile uint32_t*)(wa + 32 * 1024))[0] == 32 * 1024 / 4, "tail contents");
+    vm_dump_areas(a);
+
+    mmap_stats_t st;
+    mmap_get_stats(&st);
+    kprintf("[MMAP] maps=%u unmaps=%u file_faults=%u private_copies=%u around=%u msync=%u\n",
+        st.maps, st.unmaps, st.file_faults, st.private_copies, st.fault_around_pages, st.msync_pages);
+
+    vm_space_activate(prev);
+    vm_space_destroy(child);
+    vm_space_destroy(b);
+    vm_space_destroy(a);
+    kfree(chunk);
+    file_put(f);
+}
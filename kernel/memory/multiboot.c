@@ -1,78 +1,122 @@
-#include "multiboot.h"
-#include "../console/kprintf.h"
-#include "../panic/panic.h"
-
-void multiboot_dump_memory_map(uint32_t mb_addr) {
-    multiboot_info_t* mb = (multiboot_info_t*)mb_addr;
-
-    kprintf("[MMAP] Found =0x%x\n", mb->flags);
-
-    // bit6: mmap_* fields are valid
-    if ((mb->flags & (1 << 6)) == 0) {
-        kprintf("[MB] mmap not available (flags bit6 not set)\n");
-        return;
-    }
-
-    kprintf("[MB] mmap_addr=0x%x mmap_length=0x%x\n", mb->mmap_addr, mb->mmap_length);
-
-    uint32_t mmap_end = mb->mmap_addr + mb->mmap_length;
-    multiboot_mmap_entry_t* e = (multiboot_mmap_entry_t*)mb->mmap_addr;
-
-    while ((uint32_t)e < mmap_end) {
-        // 64-bit 주소를 출력하기 위해 상/하위 32비트 분리
-        uint32_t addr_hi = (uint32_t)(e->addr >> 32);
-        uint32_t addr_lo = (uint32_t)(e->addr & 0xFFFFFFFF);
-        uint32_t len_hi = (uint32_t)(e->len >> 32);
-        uint32_t len_lo = (uint32_t)(e->len & 0xFFFFFFFF);
-
-        if (addr_hi == 0 && len_hi == 0) {
-            // 32-bit 범위 내면 간단히 출력
-            kprintf("  [MB] entry addr=0x%x len=0x%x type=0x%x %s\n",
-                addr_lo, len_lo, e->type,
-                e->type == 1 ? "(usable)" : "(reserved)");
-        } else {
-            // 64-bit 주소면 상/하위 분리 출력
-            kprintf("  [MB] entry addr=0x%x%08x len=0x%x%08x type=0x%x %s\n",
-                addr_hi, addr_lo, len_hi, len_lo, e->type,
-                e->type == 1 ? "(usable)" : "(reserved)");
-        }
-
-        // advance: size field + entry body
-        e = (multiboot_mmap_entry_t*)((uint32_t)e + e->size + sizeof(e->size));
-    }
-}
-
-int multiboot_find_largest_usable(uint32_t mb_addr, uint32_t* out_base, uint32_t* out_end) {
-    multiboot_info_t* mb = (multiboot_info_t*)mb_addr;
-
-    if ((mb->flags & (1 << 6)) == 0) {
-        return 0;
-    }
-
-    uint32_t mmap_end = mb->mmap_addr + mb->mmap_length;
-    multiboot_mmap_entry_t* e = (multiboot_mmap_entry_t*)mb->mmap_addr;
-
-    uint64_t best_len = 0;
-    uint64_t best_base = 0;
-
-    while ((uint32_t)e < mmap_end) {
-        if (e->type == 1 && e->len > best_len) {
-            best_len = e->len;
-            best_base = e->addr;
-        } 
-        e = (multiboot_mmap_entry_t*)((uint32_t)e + e->size + sizeof(e->size));
-    }
-
-    if (best_len == 0) return 0;
-
-    // Phase 1은 32-bit 커널이므로 4GB 미만 usable만 우선 사용
-    if ((best_base >> 32) != 0) return 0;
-    if (((best_base + best_len) >> 32) != 0 ) {
-        best_len =(0x100000000ULL - best_base); // clampt to 4GB
-    }
-
-    *out_base = (uint32_t)best_base;
-    *out_end = (uint32_t)(best_base + best_len);
-    return 1;
-
-}
\ No newline at end of file
+#include "multiboot.h"
+#include "../console/kprintf.h"
+#include "../panic/panic.h"
+#include "../loader/elf.h"
+
+void multiboot_dump_memory_map(uint32_t mb_addr) {
+    multiboot_info_t* mb = (multiboot_info_t*)mb_addr;
+
+    kprintf("[MMAP] Found =0x%x\n", mb->flags);
+
+    // bit6: mmap_* fields are valid
+    if ((mb->flags & (1 << 6)) == 0) {
+        kprintf("[MB] mmap not available (flags bit6 not set)\n");
+        return;
+    }
+
+    kprintf("[MB] mmap_addr=0x%x mmap_length=0x%x\n", mb->mmap_addr, mb->mmap_length);
+
+    uint32_t mmap_end = mb->mmap_addr + mb->mmap_length;
+    multiboot_mmap_entry_t* e = (multiboot_mmap_entry_t*)mb->mmap_addr;
+
+    while ((uint32_t)e < mmap_end) {
+        kprintf("  [MB] entry addr=0x%09llx len=0x%09llx type=0x%x %s\n",
+            e->addr, e->len, e->type,
+            e->type == 1 ? "(usable)" : "(reserved)");
+
+        // advance: size field + entry body
+        e = (multiboot_mmap_entry_t*)((uint32_t)e + e->size + sizeof(e->size));
+    }
+}
+
+int multiboot_find_largest_usable(uint32_t mb_addr, uint32_t* out_base, uint32_t* out_end) {
+    multiboot_info_t* mb = (multiboot_info_t*)mb_addr;
+
+    if ((mb->flags & (1 << 6)) == 0) {
+        return 0;
+    }
+
+    uint32_t mmap_end = mb->mmap_addr + mb->mmap_length;
+    multiboot_mmap_entry_t* e = (multiboot_mmap_entry_t*)mb->mmap_addr;
+
+    uint64_t best_len = 0;
+    uint64_t best_base = 0;
+
+    while ((uint32_t)e < mmap_end) {
+        if (e->type == 1 && e->len > best_len) {
+            best_len = e->len;
+            best_base = e->addr;
+        } 
+        e = (multiboot_mmap_entry_t*)((uint32_t)e + e->size + sizeof(e->size));
+    }
+
+    if (best_len == 0) return 0;
+
+    // Phase 1은 32-bit 커널이므로 4GB 미만 usable만 우선 사용
+    if ((best_base >> 32) != 0) return 0;
+    if (((best_base + best_len) >> 32) != 0 ) {
+        best_len =(0x100000000ULL - best_base); // clampt to 4GB
+    }
+
+    *out_base = (uint32_t)best_base;
+    *out_end = (uint32_t)(best_base + best_len);
+    return 1;
+
+}
+
+uint32_t multiboot_module_count(uint32_t mb_addr) {
+    multiboot_info_t* mb = (multiboot_info_t*)mb_addr;
+
+    // bit3: mods_* fields are valid
+    if ((mb->flags & (1 << 3)) == 0) return 0;
+    return mb->mods_count;
+}
+
+const multiboot_module_t* multiboot_get_module(uint32_t mb_addr, uint32_t index) {
+    multiboot_info_t* mb = (multiboot_info_t*)mb_addr;
+
+    if (index >= multiboot_module_count(mb_addr)) return 0;
+    return &((const multiboot_module_t*)mb->mods_addr)[index];
+}
+
+uint32_t multiboot_modules_end(uint32_t mb_addr) {
+    uint32_t end = 0;
+    uint32_t n = multiboot_module_count(mb_addr);
+
+    for (uint32_t i = 0; i < n; i++) {
+        const multiboot_module_t* m = multiboot_get_module(mb_addr, i);
+        if (m->mod_end > end) end = m->mod_end;
+    }
+    return end;
+}
+
+const char* multiboot_cmdline(uint32_t mb_addr) {
+    multiboot_info_t* mb = (multiboot_info_t*)mb_addr;
+    if ((mb->flags & (1 << 2)) == 0 || mb->cmdline == 0) return 0;
+    return (const char*)mb->cmdline;
+}
+
+uint32_t multiboot_symbols_end(uint32_t mb_addr) {
+    multiboot_info_t* mb = (multiboot_info_t*)mb_addr;
+    if ((mb->flags & (1 << 5)) == 0) return 0;
+
+    uint32_t num = mb->syms[0];
+    uint32_t size = mb->syms[1];
+    uint32_t addr = mb->syms[2];
+    if (size < sizeof(elf32_shdr_t)) return 0;
+
+    // section header table 자체도 보존 대상
+    uint32_t end = addr + num * size;
+    for (uint32_t i = 0; i < num; i++) {
+        const elf32_shdr_t* sh = (const elf32_shdr_t*)(addr + i * size);
+        if (sh->sh_type != SHT_SYMTAB && sh->sh_type != SHT_STRTAB) continue;
+        if (sh->sh_addr && sh->sh_addr + sh->sh_size > end) end = sh->sh_addr + sh->sh_size;
+    }
+    return end;
+}
+
+const multiboot_info_t* multiboot_framebuffer(uint32_t mb_addr) {
+    multiboot_info_t* mb = (multiboot_info_t*)mb_addr;
+    if ((mb->flags & MULTIBOOT_INFO_FRAMEBUFFER) == 0) return 0;
+    return mb;
+}
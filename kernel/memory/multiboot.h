@@ -1,35 +1,92 @@
-#pragma once
-#include <stdint.h>
-
-#define MULTIBOOT_BOOTLOADER_MAGIC 0x2BADB002
-
-typedef struct multiboot_info {
-    uint32_t flags;
-
-    uint32_t mem_lower;
-    uint32_t mem_upper;
-
-    uint32_t boot_device;
-    uint32_t cmdline;
-
-    uint32_t mods_count;
-    uint32_t mods_addr;
-
-    uint32_t syms[4]; // a.out or ELF sections header (unused here)
-
-    uint32_t mmap_length;
-    uint32_t mmap_addr;
-
-    // The rest exists in spec but not used in this phase
-
-} __attribute__((packed)) multiboot_info_t;
-
-typedef struct multiboot_mmap_entry {
-    uint32_t size; // size of the entry excludeing this field
-    uint64_t addr; // base address
-    uint64_t len; // length
-    uint32_t type; // 1=usualbe, other reserved
-} __attribute__((packed)) multiboot_mmap_entry_t;
-
-void multiboot_dump_memory_map(uint32_t mb_addr);
-int multiboot_find_largest_usable(uint32_t mb_addr, uint32_t* out_base, uint32_t* out_end);
+#pragma once
+#include <stdint.h>
+
+#define MULTIBOOT_BOOTLOADER_MAGIC 0x2BADB002
+
+typedef struct multiboot_info {
+    uint32_t flags;
+
+    uint32_t mem_lower;
+    uint32_t mem_upper;
+
+    uint32_t boot_device;
+    uint32_t cmdline;
+
+    uint32_t mods_count;
+    uint32_t mods_addr;
+
+    // flags bit5: 커널 ELF section header table {num, size, addr, shndx}
+    // (GRUB은 .symtab/.strtab 내용도 메모리에 올리고 sh_addr을 채워 준다)
+    uint32_t syms[4];
+
+    uint32_t mmap_length;
+    uint32_t mmap_addr;
+
+    uint32_t drives_length;
+    uint32_t drives_addr;
+    uint32_t config_table;
+    uint32_t boot_loader_name;
+    uint32_t apm_table;
+
+    uint32_t vbe_control_info;
+    uint32_t vbe_mode_info;
+    uint16_t vbe_mode;
+    uint16_t vbe_interface_seg;
+    uint16_t vbe_interface_off;
+    uint16_t vbe_interface_len;
+
+    // flags bit12: framebuffer_* 유효 (헤더의 video mode 요청을 GRUB이 설정한 결과)
+    uint64_t framebuffer_addr;
+    uint32_t framebuffer_pitch;         // 한 줄의 바이트 수 (width * bpp/8 보다 클 수 있음)
+    uint32_t framebuffer_width;
+    uint32_t framebuffer_height;
+    uint8_t framebuffer_bpp;
+    uint8_t framebuffer_type;
+    // type == RGB일 때: 각 색 채널의 비트 위치/크기
+    uint8_t red_field_position;
+    uint8_t red_mask_size;
+    uint8_t green_field_position;
+    uint8_t green_mask_size;
+    uint8_t blue_field_position;
+    uint8_t blue_mask_size;
+} __attribute__((packed)) multiboot_info_t;
+
+#define MULTIBOOT_INFO_FRAMEBUFFER (1u << 12)
+
+#define MULTIBOOT_FRAMEBUFFER_TYPE_INDEXED  0
+#define MULTIBOOT_FRAMEBUFFER_TYPE_RGB      1
+#define MULTIBOOT_FRAMEBUFFER_TYPE_EGA_TEXT 2
+
+// flags bit3: mods_* 유효
+typedef struct multiboot_module {
+    uint32_t mod_start;
+    uint32_t mod_end;
+    uint32_t string;   // module command line
+    uint32_t reserved;
+} __attribute__((packed)) multiboot_module_t;
+
+typedef struct multiboot_mmap_entry {
+    uint32_t size; // size of the entry excludeing this field
+    uint64_t addr; // base address
+    uint64_t len; // length
+    uint32_t type; // 1=usualbe, other reserved
+} __attribute__((packed)) multiboot_mmap_entry_t;
+
+void multiboot_dump_memory_map(uint32_t mb_addr);
+int multiboot_find_largest_usable(uint32_t mb_addr, uint32_t* out_base, uint32_t* out_end);
+
+// 모듈(initrd, 유저 프로그램 등) 조회
+uint32_t multiboot_module_count(uint32_t mb_addr);
+const multiboot_module_t* multiboot_get_module(uint32_t mb_addr, uint32_t index);
+
+// 모든 모듈의 끝 주소 (heap/pmm이 모듈을 덮어쓰지 않도록). 모듈이 없으면 0
+uint32_t multiboot_modules_end(uint32_t mb_addr);
+
+// GRUB이 설정한 framebuffer 정보 (flags bit12). 없으면 0
+const multiboot_info_t* multiboot_framebuffer(uint32_t mb_addr);
+
+// 부팅 옵션 문자열 (flags bit2). 없으면 0
+const char* multiboot_cmdline(uint32_t mb_addr);
+
+// GRUB이 올려 둔 커널 심볼 테이블(.symtab/.strtab)의 끝 주소. 없으면 0
+uint32_t multiboot_symbols_end(uint32_t mb_addr);
@@ -0,0 +1,116 @@
+#include "paging.h"
+#include "pmm.h"
+#include "../panic/panic.h"
+#include "../console/kprintf.h"
+#include "../lib/string.h"
+#include "../../arch/x86/cpu/cr.h"
+
+static pde_t* g_kernel_pd = 0;
+static pde_t* g_current_pd = 0;
+
+static uint32_t alloc_table(void) {
+    uint32_t phys = pmm_alloc_frame();
+    if (phys) memset((void*)phys, 0, PAGE_SIZE);
+    return phys;
+}
+
+static int is_kernel_pde(uint32_t idx) {
+    return idx < PDE_INDEX(USER_SPACE_START) || idx >= PDE_INDEX(USER_SPACE_END);
+}
+
+void paging_init(void) {
+    g_kernel_pd = (pde_t*)alloc_table();
+    if (!g_kernel_pd) {
+        panic("paging_init: out of frames");
+    }
+
+    // 첫 4MB는 4KB 단위로 매핑: page 0을 비워 NULL 역참조를 #PF로 잡기 위함
+    pte_t* pt0 = (pte_t*)alloc_table();
+    if (!pt0) {
+        panic("paging_init: out of frames");
+    }
+    for (uint32_t i = 1; i < 1024; i++) {
+        pt0[i] = (i << 12) | PAGE_PRESENT | PAGE_WRITE;
+    }
+    g_kernel_pd[0] = (uint32_t)pt0 | PAGE_PRESENT | PAGE_WRITE;
+
+    // 나머지 커널 영역은 4MB 페이지로 identity map (page table 불필요)
+    for (uint32_t i = 1; i < PDE_INDEX(KERNEL_SPACE_END); i++) {
+        g_kernel_pd[i] = (i << 22) | PAGE_PS | PAGE_PRESENT | PAGE_WRITE;
+    }
+
+    write_cr4(read_cr4() | CR4_PSE);
+    paging_switch(g_kernel_pd);
+    write_cr0(read_cr0() | CR0_PG | CR0_WP);
+
+    kprintf("[PAGING] enabled, kernel identity map 0x0-0x%x\n", KERNEL_SPACE_END);
+}
+
+pde_t* paging_kernel_directory(void) {
+    return g_kernel_pd;
+}
+
+pde_t* paging_create_directory(void) {
+    pde_t* pd = (pde_t*)alloc_table();
+    if (!pd) return 0;
+
+    for (uint32_t i = 0; i < 1024; i++) {
+        if (is_kernel_pde(i)) pd[i] = g_kernel_pd[i];
+    }
+    return pd;
+}
+
+pte_t* paging_get_pte(pde_t* pd, uint32_t vaddr, int create) {
+    pde_t* pde = &pd[PDE_INDEX(vaddr)];
+
+    if (*pde & PAGE_PRESENT) {
+        if (*pde & PAGE_PS) return 0;
+    } else {
+        if (!create) return 0;
+
+        uint32_t pt = alloc_table();
+        if (!pt) return 0;
+
+        // 권한은 PTE에서 제어하므로 PDE는 넓게 허용
+        uint32_t flags = PAGE_PRESENT | PAGE_WRITE;
+        if (!is_kernel_pde(PDE_INDEX(vaddr))) flags |= PAGE_USER;
+        *pde = pt | flags;
+    }
+
+    pte_t* pt = (pte_t*)(*pde & 0xFFFFF000);
+    return &pt[PTE_INDEX(vaddr)];
+}
+
+int paging_map(pde_t* pd, uint32_t vaddr, uint32_t paddr, uint32_t flags) {
+    pte_t* pte = paging_get_pte(pd, vaddr, 1);
+    if (!pte) return 0;
+
+    *pte = (paddr & 0xFFFFF000) | (flags & 0xFFF) | PAGE_PRESENT;
+    paging_flush(pd, vaddr);
+    return 1;
+}
+
+void paging_unmap(pde_t* pd, uint32_t vaddr) {
+    pte_t* pte = paging_get_pte(pd, vaddr, 0);
+    if (!pte) return;
+
+    *pte = 0;
+    paging_flush(pd, vaddr);
+}
+
+void paging_switch(pde_t* pd) {
+    g_current_pd = pd;
+    write_cr3((uint32_t)pd);
+}
+
+pde_t* paging_current_directory(void) {
+    return g_current_pd;
+}
+
+void paging_flush(pde_t* pd, uint32_t vaddr) {
+    if (pd == g_current_pd) invlpg(vaddr);
+}
+
+void paging_flush_all(pde_t* pd) {
+    if (pd == g_current_pd) write_cr3((uint32_t)pd);
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <stdint.h>
+
+// PDE/PTE flag bits
+#define PAGE_PRESENT  0x001
+#define PAGE_WRITE    0x002
+#define PAGE_USER     0x004
+#define PAGE_PWT      0x008
+#define PAGE_PCD      0x010
+#define PAGE_ACCESSED 0x020
+#define PAGE_DIRTY    0x040
+#define PAGE_PS       0x080   // PDE: 4MB page
+#define PAGE_PAT      0x080   // PTE: PAT index 상위 비트 (PDE에서는 PAGE_PS와 같은 자리)
+#define PAGE_GLOBAL   0x100
+#define PAGE_COW      0x200   // available bit: copy-on-write 공유 페이지
+
+#define PTE_FRAME(e)  ((uint32_t)(e) & 0xFFFFF000)
+
+// 가상 주소 공간 배치
+//   [0, 1GB)       커널 identity map (모든 page directory가 공유)
+//   [1GB, 3GB)     유저 영역 (프로세스별)
+//   [3GB, 4GB)     커널 MMIO 영역 (framebuffer 등, 공유)
+#define KERNEL_SPACE_END 0x40000000u
+#define USER_SPACE_START 0x40000000u
+#define USER_SPACE_END   0xC0000000u
+
+#define PDE_INDEX(va) ((uint32_t)(va) >> 22)
+#define PTE_INDEX(va) (((uint32_t)(va) >> 12) & 0x3FF)
+
+typedef uint32_t pde_t;
+typedef uint32_t pte_t;
+
+// 커널 page directory 구성 + CR3 로드 + paging enable (pmm_init 이후 호출)
+void paging_init(void);
+
+pde_t* paging_kernel_directory(void);
+
+// 커널 영역 PDE를 공유하는 새 page directory (유저 영역은 비어 있음)
+pde_t* paging_create_directory(void);
+
+// vaddr의 PTE 포인터. create=1이면 page table이 없을 때 할당
+// (4MB 커널 페이지 영역이거나 할당 실패 시 0)
+pte_t* paging_get_pte(pde_t* pd, uint32_t vaddr, int create);
+
+// 4KB 매핑 (성공 1 / 실패 0)
+int paging_map(pde_t* pd, uint32_t vaddr, uint32_t paddr, uint32_t flags);
+void paging_unmap(pde_t* pd, uint32_t vaddr);
+
+// 현재 활성 page directory 전환
+void paging_switch(pde_t* pd);
+pde_t* paging_current_directory(void);
+
+// pd가 현재 CR3라면 해당 vaddr TLB 무효화
+void paging_flush(pde_t* pd, uint32_t vaddr);
+
+// pd가 현재 CR3라면 전체 TLB 무효화 (CR3 reload)
+void paging_flush_all(pde_t* pd);
@@ -0,0 +1,169 @@
+#include "pmm.h"
+#include "heap.h"
+#include "../panic/panic.h"
+#include "../console/kprintf.h"
+#include "../lib/string.h"
+#include "../../arch/x86/cpu/irqflags.h"
+
+static uint32_t  g_pmm_base   = 0;
+static uint32_t  g_pmm_frames = 0;
+static uint32_t  g_pmm_free   = 0;
+static uint32_t* g_bitmap     = 0;   // bit=1 : 사용중
+static uint32_t  g_hint       = 0;   // 다음 검색 시작 word (next-fit)
+static uint16_t* g_refcount   = 0;   // 프레임별 참조 수 (할당 시 1)
+
+void pmm_init(uint32_t base, uint32_t end) {
+    base = PAGE_ALIGN_UP(base);
+    end  = PAGE_ALIGN_DOWN(end);
+
+    if (end <= base) {
+        panic("pmm_init: invalid range");
+    }
+
+    g_pmm_base   = base;
+    g_pmm_frames = (end - base) >> PAGE_SHIFT;
+    g_pmm_free   = g_pmm_frames;
+
+    uint32_t words = (g_pmm_frames + 31) / 32;
+    g_bitmap = (uint32_t*)kmalloc(words * sizeof(uint32_t));
+    memset(g_bitmap, 0, words * sizeof(uint32_t));
+
+    g_refcount = (uint16_t*)kmalloc(g_pmm_frames * sizeof(uint16_t));
+    memset(g_refcount, 0, g_pmm_frames * sizeof(uint16_t));
+
+    // 마지막 word의 범위 밖 비트는 사용중으로 표시
+    uint32_t tail = g_pmm_frames & 31;
+    if (tail) g_bitmap[words - 1] = ~((1u << tail) - 1);
+
+    kprintf("[PMM] init\n");
+    kprintf("  base=0x%x\n", g_pmm_base);
+    kprintf("  frames=%u (%u KB)\n", g_pmm_frames, g_pmm_frames * 4);
+}
+
+uint32_t pmm_alloc_frame(void) {
+    if (g_bitmap == 0) {
+        panic("pmm_alloc_frame: pmm not initialized");
+    }
+
+    uint32_t words = (g_pmm_frames + 31) / 32;
+    uint32_t flags = irq_save();
+
+    for (uint32_t n = 0; n < words; n++) {
+        uint32_t w = g_hint + n;
+        if (w >= words) w -= words;
+
+        uint32_t bits = g_bitmap[w];
+        if (bits == 0xFFFFFFFF) continue;
+
+        uint32_t bit = (uint32_t)__builtin_ctz(~bits);
+        g_bitmap[w] = bits | (1u << bit);
+        g_hint = w;
+        g_pmm_free--;
+        g_refcount[w * 32 + bit] = 1;
+
+        irq_restore(flags);
+        return g_pmm_base + ((w * 32 + bit) << PAGE_SHIFT);
+    }
+
+    irq_restore(flags);
+    return 0;
+}
+
+static inline int frame_used(uint32_t idx) {
+    return (g_bitmap[idx / 32] >> (idx & 31)) & 1;
+}
+
+uint32_t pmm_alloc_contiguous(uint32_t n) {
+    if (n == 0) return 0;
+    if (n == 1) return pmm_alloc_frame();
+
+    uint32_t flags = irq_save();
+
+    // first-fit: 사용 중인 프레임을 만나면 그 다음부터 다시 센다
+    uint32_t run = 0;
+    for (uint32_t idx = 0; idx < g_pmm_frames; idx++) {
+        if (frame_used(idx)) {
+            run = 0;
+            continue;
+        }
+        if (++run < n) continue;
+
+        uint32_t first = idx + 1 - n;
+        for (uint32_t i = first; i <= idx; i++) {
+            g_bitmap[i / 32] |= 1u << (i & 31);
+            g_refcount[i] = 1;
+        }
+        g_pmm_free -= n;
+
+        irq_restore(flags);
+        return g_pmm_base + (first << PAGE_SHIFT);
+    }
+
+    irq_restore(flags);
+    return 0;
+}
+
+void pmm_free_frame(uint32_t phys) {
+    if (!pmm_owns(phys) || (phys & ~PAGE_MASK)) {
+        kprintf("[PMM] bad free phys=0x%x\n", phys);
+        panic("pmm_free_frame: invalid frame");
+    }
+
+    uint32_t idx = (phys - g_pmm_base) >> PAGE_SHIFT;
+    uint32_t w = idx / 32;
+    uint32_t mask = 1u << (idx & 31);
+
+    if ((g_bitmap[w] & mask) == 0) {
+        kprintf("[PMM] double free phys=0x%x\n", phys);
+        panic("pmm_free_frame: double free");
+    }
+
+    uint32_t flags = irq_save();
+    g_bitmap[w] &= ~mask;
+    g_refcount[idx] = 0;
+    g_pmm_free++;
+    if (w < g_hint) g_hint = w;
+    irq_restore(flags);
+}
+
+void pmm_ref(uint32_t phys) {
+    if (!pmm_owns(phys)) return;   // pmm 밖 프레임(모듈 이미지 등)은 카운트하지 않음
+
+    uint32_t idx = (phys - g_pmm_base) >> PAGE_SHIFT;
+    if (g_refcount[idx] == 0 || g_refcount[idx] == 0xFFFF) {
+        kprintf("[PMM] bad ref phys=0x%x count=%u\n", phys, g_refcount[idx]);
+        panic("pmm_ref: invalid refcount");
+    }
+    uint32_t flags = irq_save();
+    g_refcount[idx]++;
+    irq_restore(flags);
+}
+
+void pmm_unref(uint32_t phys) {
+    if (!pmm_owns(phys)) return;
+
+    uint32_t idx = (phys - g_pmm_base) >> PAGE_SHIFT;
+    if (g_refcount[idx] == 0) {
+        kprintf("[PMM] unref of free frame phys=0x%x\n", phys);
+        panic("pmm_unref: frame not allocated");
+    }
+    uint32_t flags = irq_save();
+    int last = (--g_refcount[idx] == 0);
+    if (last) g_refcount[idx] = 1;   // pmm_free_frame이 다시 0으로 정리
+    irq_restore(flags);
+
+    if (last) pmm_free_frame(PAGE_ALIGN_DOWN(phys));
+}
+
+uint32_t pmm_refcount(uint32_t phys) {
+    if (!pmm_owns(phys)) return 0;
+    return g_refcount[(phys - g_pmm_base) >> PAGE_SHIFT];
+}
+
+int pmm_owns(uint32_t phys) {
+    return phys >= g_pmm_base &&
+           ((phys - g_pmm_base) >> PAGE_SHIFT) < g_pmm_frames;
+}
+
+uint32_t pmm_total_frames(void) { return g_pmm_frames; }
+uint32_t pmm_free_frames(void) { return g_pmm_free; }
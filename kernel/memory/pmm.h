@@ -0,0 +1,31 @@
+#pragma once
+#include <stdint.h>
+
+#define PAGE_SIZE  4096u
+#define PAGE_SHIFT 12
+#define PAGE_MASK  (~(PAGE_SIZE - 1))
+
+#define PAGE_ALIGN_DOWN(x) ((uint32_t)(x) & PAGE_MASK)
+#define PAGE_ALIGN_UP(x)   (((uint32_t)(x) + PAGE_SIZE - 1) & PAGE_MASK)
+
+// 물리 프레임 할당자 (bitmap)
+// [base, end) 범위의 4KB 프레임을 관리. 반환 주소는 물리 주소 (커널은 identity map)
+void pmm_init(uint32_t base, uint32_t end);
+
+// 프레임 1개 할당 (실패 시 0). 참조 카운트 1로 시작
+uint32_t pmm_alloc_frame(void);
+void pmm_free_frame(uint32_t phys);
+
+// 물리적으로 연속된 n개 프레임 (첫 프레임 주소, 실패 시 0). 각 프레임은 따로 free/unref 한다
+uint32_t pmm_alloc_contiguous(uint32_t n);
+
+// 프레임 참조 카운트 (COW 공유용). unref가 0이 되면 프레임 반환
+void pmm_ref(uint32_t phys);
+void pmm_unref(uint32_t phys);
+uint32_t pmm_refcount(uint32_t phys);
+
+// 해당 물리 주소가 pmm 관리 범위인지
+int pmm_owns(uint32_t phys);
+
+uint32_t pmm_total_frames(void);
+uint32_t pmm_free_frames(void);
@@ -0,0 +1,501 @@
+#include "vma.h"
+#include "pmm.h"
+#include "heap.h"
+#include "mmap.h"
+#include "../fs/file.h"
+#include "../panic/panic.h"
+#include "../console/kprintf.h"
+#include "../lib/string.h"
+#include "../lib/errno.h"
+
+// #PF error code bits
+#define PF_PROTECTION 0x1
+#define PF_WRITE      0x2
+#define PF_USER       0x4
+
+static vm_space_t g_kernel_space;
+static vm_space_t* g_current_space = 0;
+
+// 모든 주소 공간이 공유하는 읽기 전용 zero page
+// 아직 쓰지 않은 anonymous 페이지는 이 프레임을 가리키고, 첫 쓰기에서 COW로 분리된다.
+static uint32_t g_zero_page = 0;
+
+static void page_zero(uint32_t phys) {
+    memset((void*)phys, 0, PAGE_SIZE);
+}
+
+static void page_copy(uint32_t dst, uint32_t src) {
+    memcpy((void*)dst, (const void*)src, PAGE_SIZE);
+}
+
+void vm_init(void) {
+    g_kernel_space.pd = paging_kernel_directory();
+    g_kernel_space.areas = 0;
+    g_kernel_space.resident_pages = 0;
+    g_kernel_space.inplace_pages = 0;
+    g_kernel_space.cow_copies = 0;
+    g_current_space = &g_kernel_space;
+
+    g_zero_page = pmm_alloc_frame();
+    if (!g_zero_page) {
+        panic("vm_init: cannot allocate zero page");
+    }
+    page_zero(g_zero_page);
+}
+
+vm_space_t* vm_kernel_space(void) { return &g_kernel_space; }
+vm_space_t* vm_current_space(void) { return g_current_space; }
+uint32_t vm_zero_page(void) { return g_zero_page; }
+
+vm_space_t* vm_space_create(void) {
+    vm_space_t* vs = (vm_space_t*)kmalloc(sizeof(vm_space_t));
+    vs->pd = paging_create_directory();
+    if (!vs->pd) {
+        panic("vm_space_create: out of frames");
+    }
+    vs->areas = 0;
+    vs->resident_pages = 0;
+    vs->inplace_pages = 0;
+    vs->cow_copies = 0;
+    return vs;
+}
+
+void vm_space_activate(vm_space_t* vs) {
+    if (g_current_space == vs) return;
+    g_current_space = vs;
+    paging_switch(vs->pd);
+}
+
+// PTE가 가리키는 프레임의 참조 해제 (zero page와 pmm 밖 프레임은 카운트 대상 아님)
+static void pte_release(pte_t e) {
+    uint32_t phys = PTE_FRAME(e);
+    if (phys != g_zero_page) pmm_unref(phys);
+}
+
+static void pte_share(pte_t e) {
+    uint32_t phys = PTE_FRAME(e);
+    if (phys != g_zero_page) pmm_ref(phys);
+}
+
+vm_space_t* vm_space_fork(vm_space_t* parent) {
+    vm_space_t* child = vm_space_create();
+
+    // VMA 목록 복제 (backing은 같은 이미지를 공유)
+    vm_area_t** tail = &child->areas;
+    for (vm_area_t* a = parent->areas; a; a = a->next) {
+        vm_area_t* c = (vm_area_t*)kmalloc(sizeof(vm_area_t));
+        *c = *a;
+        c->next = 0;
+        if (c->file) file_get(c->file);
+        *tail = c;
+        tail = &c->next;
+    }
+
+    // 유저 page table만 복사: 쓰기 가능 페이지는 양쪽 모두 RO + COW로 바꾸고 프레임 공유
+    for (uint32_t pdi = PDE_INDEX(USER_SPACE_START); pdi < PDE_INDEX(USER_SPACE_END); pdi++) {
+        pde_t pde = parent->pd[pdi];
+        if (!(pde & PAGE_PRESENT)) continue;
+
+        pte_t* ppt = (pte_t*)PTE_FRAME(pde);
+        uint32_t cpt_phys = pmm_alloc_frame();
+        if (!cpt_phys) {
+            panic("vm_space_fork: out of frames");
+        }
+        pte_t* cpt = (pte_t*)cpt_phys;
+
+        for (uint32_t i = 0; i < 1024; i++) {
+            pte_t e = ppt[i];
+            if (e & PAGE_PRESENT) {
+                if (e & PAGE_WRITE) {
+                    // VMA_SHARED 영역은 양쪽이 같은 프레임에 계속 쓴다
+                    vm_area_t* a = vm_find_area(parent, (pdi << 22) | (i << 12));
+                    if (!a || !(a->flags & VMA_SHARED)) {
+                        e = (e & ~PAGE_WRITE) | PAGE_COW;
+                        ppt[i] = e;
+                    }
+                }
+                pte_share(e);
+            }
+            cpt[i] = e;
+        }
+        child->pd[pdi] = cpt_phys | (pde & 0xFFF);
+    }
+
+    child->resident_pages = parent->resident_pages;
+    child->inplace_pages = parent->inplace_pages;
+
+    // 부모 매핑의 쓰기 권한을 내렸으므로 TLB 정리
+    paging_flush_all(parent->pd);
+    return child;
+}
+
+void vm_space_destroy(vm_space_t* vs) {
+    if (vs == &g_kernel_space) {
+        panic("vm_space_destroy: kernel space");
+    }
+    if (vs == g_current_space) {
+        vm_space_activate(&g_kernel_space);
+    }
+
+    for (uint32_t pdi = PDE_INDEX(USER_SPACE_START); pdi < PDE_INDEX(USER_SPACE_END); pdi++) {
+        pde_t pde = vs->pd[pdi];
+        if (!(pde & PAGE_PRESENT)) continue;
+
+        pte_t* pt = (pte_t*)PTE_FRAME(pde);
+        for (uint32_t i = 0; i < 1024; i++) {
+            if (pt[i] & PAGE_PRESENT) pte_release(pt[i]);
+        }
+        pmm_free_frame(PTE_FRAME(pde));
+    }
+    pmm_free_frame((uint32_t)vs->pd);
+
+    vm_area_t* a = vs->areas;
+    while (a) {
+        vm_area_t* next = a->next;
+        if (a->file) file_put(a->file);
+        kfree(a);
+        a = next;
+    }
+    kfree(vs);
+}
+
+vm_area_t* vm_map_area(vm_space_t* vs, uint32_t start, uint32_t end, uint32_t flags,
+                       const uint8_t* file_base, uint32_t file_off, uint32_t file_size) {
+    if ((start & ~PAGE_MASK) || (end & ~PAGE_MASK) || end <= start) return 0;
+    if (start < USER_SPACE_START || end > USER_SPACE_END) return 0;
+
+    // 정렬된 리스트에서 삽입 위치 탐색 + 겹침 검사
+    vm_area_t* prev = 0;
+    vm_area_t* next = vs->areas;
+    while (next && next->start < start) {
+        prev = next;
+        next = next->next;
+    }
+    if (prev && prev->end > start) return 0;
+    if (next && next->start < end) return 0;
+
+    vm_area_t* a = (vm_area_t*)kmalloc(sizeof(vm_area_t));
+    a->start = start;
+    a->end = end;
+    a->flags = flags;
+    a->file_base = file_base;
+    a->file_off = file_off;
+    a->file_size = file_base ? file_size : 0;
+    a->file = 0;
+    a->next = next;
+
+    if (prev) prev->next = a;
+    else vs->areas = a;
+    return a;
+}
+
+vm_area_t* vm_find_area(vm_space_t* vs, uint32_t addr) {
+    for (vm_area_t* a = vs->areas; a; a = a->next) {
+        if (addr < a->start) return 0;
+        if (addr < a->end) return a;
+    }
+    return 0;
+}
+
+// [start, end)의 present PTE를 모두 해제 (page table이 없는 4MB 구간은 건너뜀)
+static void vm_release_range(vm_space_t* vs, uint32_t start, uint32_t end) {
+    uint32_t va = start;
+    while (va < end) {
+        pte_t* pte = paging_get_pte(vs->pd, va, 0);
+        if (!pte) {
+            uint32_t next = (va & 0xFFC00000u) + 0x400000u;
+            if (next <= va) break;
+            va = next;
+            continue;
+        }
+        if (*pte & PAGE_PRESENT) {
+            pte_t e = *pte;
+            paging_unmap(vs->pd, va);
+            pte_release(e);
+            vs->resident_pages--;
+        }
+        va += PAGE_SIZE;
+    }
+}
+
+// 영역 앞부분을 new_start까지 잘라냄 (파일 오프셋도 같이 전진)
+static void vm_area_advance(vm_area_t* a, uint32_t new_start) {
+    uint32_t delta = new_start - a->start;
+    a->file_off += delta;
+    a->file_size = a->file_size > delta ? a->file_size - delta : 0;
+    a->start = new_start;
+}
+
+int vm_unmap(vm_space_t* vs, uint32_t start, uint32_t end) {
+    if ((start & ~PAGE_MASK) || (end & ~PAGE_MASK) || end <= start) return 0;
+    if (start < USER_SPACE_START || end > USER_SPACE_END) return 0;
+
+    vm_area_t** link = &vs->areas;
+    while (*link) {
+        vm_area_t* a = *link;
+        if (a->start >= end) break;
+        if (a->end <= start) {
+            link = &a->next;
+            continue;
+        }
+
+        uint32_t s = a->start > start ? a->start : start;
+        uint32_t e = a->end < end ? a->end : end;
+        vm_release_range(vs, s, e);
+
+        if (s == a->start && e == a->end) {
+            // 통째로 제거
+            *link = a->next;
+            if (a->file) file_put(a->file);
+            kfree(a);
+            continue;
+        }
+
+        if (s == a->start) {
+            vm_area_advance(a, e);
+        } else if (e == a->end) {
+            a->end = s;
+        } else {
+            // 가운데 구멍: 뒤쪽을 새 VMA로 분리
+            vm_area_t* tail = (vm_area_t*)kmalloc(sizeof(vm_area_t));
+            *tail = *a;
+            if (tail->file) file_get(tail->file);
+            vm_area_advance(tail, e);
+            a->end = s;
+            a->next = tail;
+            link = &tail->next;
+            continue;
+        }
+        link = &a->next;
+    }
+    return 1;
+}
+
+// 비어 있는 페이지를 채워 매핑 (va는 페이지 정렬)
+static int vm_fault_in(vm_space_t* vs, vm_area_t* a, uint32_t va, int is_write) {
+    if (a->file) return mmap_file_fault(vs, a, va, is_write);
+
+    uint32_t off = va - a->start;
+    uint32_t avail = 0;
+    if (off < a->file_size) {
+        avail = a->file_size - off;
+        if (avail > PAGE_SIZE) avail = PAGE_SIZE;
+    }
+
+    uint32_t pte_flags = PAGE_USER;
+    if (a->flags & VMA_WRITE) pte_flags |= PAGE_WRITE;
+
+    // 파일 내용이 없는 페이지의 읽기: 공유 zero page를 RO로 매핑 (쓰기 시 COW)
+    if (avail == 0 && !is_write) {
+        uint32_t zflags = PAGE_USER;
+        if (a->flags & VMA_WRITE) zflags |= PAGE_COW;
+        if (!paging_map(vs->pd, va, g_zero_page, zflags)) return 0;
+        vs->resident_pages++;
+        return 1;
+    }
+
+    // 읽기 전용 + 페이지 전체가 파일 내용 + 원본이 페이지 정렬이면 복사 없이 그대로 매핑
+    if (avail == PAGE_SIZE && !(a->flags & VMA_WRITE)) {
+        uint32_t src = (uint32_t)(a->file_base + a->file_off + off);
+        if ((src & ~PAGE_MASK) == 0 && src < KERNEL_SPACE_END) {
+            if (!paging_map(vs->pd, va, src, pte_flags)) return 0;
+            vs->resident_pages++;
+            vs->inplace_pages++;
+            return 1;
+        }
+    }
+
+    uint32_t frame = pmm_alloc_frame();
+    if (!frame) {
+        kprintf("[VM] out of frames (va=0x%x)\n", va);
+        return 0;
+    }
+
+    uint8_t* dst = (uint8_t*)frame;
+    memcpy(dst, a->file_base + a->file_off + off, avail);
+    memset(dst + avail, 0, PAGE_SIZE - avail);
+
+    if (!paging_map(vs->pd, va, frame, pte_flags)) {
+        pmm_free_frame(frame);
+        return 0;
+    }
+    vs->resident_pages++;
+    return 1;
+}
+
+// COW 페이지에 대한 쓰기 (va는 페이지 정렬)
+static int vm_resolve_cow(vm_space_t* vs, uint32_t va) {
+    pte_t* pte = paging_get_pte(vs->pd, va, 0);
+    if (!pte || !(*pte & PAGE_PRESENT) || !(*pte & PAGE_COW)) return 0;
+
+    uint32_t old = PTE_FRAME(*pte);
+    uint32_t flags = (*pte & 0xFFF & ~PAGE_COW) | PAGE_WRITE;
+
+    // 마지막 참조자라면 복사 없이 쓰기 권한만 복구
+    if (old != g_zero_page && pmm_refcount(old) == 1) {
+        *pte = old | flags;
+        paging_flush(vs->pd, va);
+        return 1;
+    }
+
+    uint32_t frame = pmm_alloc_frame();
+    if (!frame) {
+        kprintf("[VM] out of frames on COW (va=0x%x)\n", va);
+        return 0;
+    }
+
+    if (old == g_zero_page) page_zero(frame);
+    else page_copy(frame, old);
+
+    *pte = frame | flags;
+    paging_flush(vs->pd, va);
+    pte_release(old);
+    vs->cow_copies++;
+    return 1;
+}
+
+int vm_map_shared(vm_space_t* vs, uint32_t start, const uint32_t* frames, uint32_t n, uint32_t flags) {
+    uint32_t end = start + n * PAGE_SIZE;
+    if (!vm_map_area(vs, start, end, flags | VMA_SHARED, 0, 0, 0)) return 0;
+
+    uint32_t pte_flags = PAGE_USER;
+    if (flags & VMA_WRITE) pte_flags |= PAGE_WRITE;
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (!paging_map(vs->pd, start + i * PAGE_SIZE, frames[i], pte_flags)) {
+            // 이미 매핑한 페이지의 참조와 VMA를 되돌린다 (호출자가 프레임을 해제해도 PTE가 남지 않게)
+            vm_unmap(vs, start, end);
+            return 0;
+        }
+        pmm_ref(frames[i]);
+        vs->resident_pages++;
+    }
+    return 1;
+}
+
+static int vm_fault_on(vm_space_t* vs, uint32_t addr, uint32_t err) {
+    if (addr < USER_SPACE_START || addr >= USER_SPACE_END) return 0;
+
+    vm_area_t* a = vm_find_area(vs, addr);
+    if (!a) return 0;
+
+    int is_write = (err & PF_WRITE) != 0;
+    if (is_write && !(a->flags & VMA_WRITE)) return 0;
+
+    uint32_t va = PAGE_ALIGN_DOWN(addr);
+
+    // present 페이지의 권한 위반: COW 쓰기만 해결 대상
+    if (err & PF_PROTECTION) {
+        return is_write ? vm_resolve_cow(vs, va) : 0;
+    }
+
+    return vm_fault_in(vs, a, va, is_write);
+}
+
+int vm_populate(vm_space_t* vs, uint32_t start, uint32_t end, int is_write) {
+    for (uint32_t va = PAGE_ALIGN_DOWN(start); va < end; va += PAGE_SIZE) {
+        pte_t* pte = paging_get_pte(vs->pd, va, 0);
+        int present = pte && (*pte & PAGE_PRESENT);
+        if (present && (!is_write || (*pte & PAGE_WRITE))) continue;
+
+        uint32_t err = PF_USER | (is_write ? PF_WRITE : 0) | (present ? PF_PROTECTION : 0);
+        if (!vm_fault_on(vs, va, err)) return 0;
+    }
+    return 1;
+}
+
+int vm_handle_fault(uint32_t addr, uint32_t err) {
+    vm_space_t* vs = g_current_space;
+    if (!vs) return 0;
+    return vm_fault_on(vs, addr, err);
+}
+
+// uaddr가 속한 페이지의 커널 주소 (identity map). 없거나 권한이 안 맞으면 fault-in 후 재시도
+static uint8_t* vm_user_page(vm_space_t* vs, uint32_t uaddr, int is_write) {
+    for (int attempt = 0; attempt < 2; attempt++) {
+        pte_t* pte = paging_get_pte(vs->pd, uaddr, 0);
+        if (pte && (*pte & PAGE_PRESENT) && (*pte & PAGE_USER) && (!is_write || (*pte & PAGE_WRITE))) {
+            return (uint8_t*)(PTE_FRAME(*pte) | (uaddr & ~PAGE_MASK));
+        }
+
+        uint32_t err = PF_USER | (is_write ? PF_WRITE : 0);
+        if (pte && (*pte & PAGE_PRESENT)) err |= PF_PROTECTION;
+        if (!vm_fault_on(vs, uaddr, err)) return 0;
+    }
+    return 0;
+}
+
+static int vm_copy(vm_space_t* vs, uint32_t uaddr, uint8_t* kbuf, uint32_t len, int to_user) {
+    if (uaddr < USER_SPACE_START || uaddr + len < uaddr || uaddr + len > USER_SPACE_END) return -EFAULT;
+
+    while (len) {
+        uint32_t chunk = PAGE_SIZE - (uaddr & ~PAGE_MASK);
+        if (chunk > len) chunk = len;
+
+        uint8_t* p = vm_user_page(vs, uaddr, to_user);
+        if (!p) return -EFAULT;
+
+        if (to_user) memcpy(p, kbuf, chunk);
+        else memcpy(kbuf, p, chunk);
+
+        uaddr += chunk;
+        kbuf += chunk;
+        len -= chunk;
+    }
+    return 0;
+}
+
+int vm_copy_from(vm_space_t* vs, void* dst, uint32_t uaddr, uint32_t len) {
+    return vm_copy(vs, uaddr, (uint8_t*)dst, len, 0);
+}
+
+int vm_copy_to(vm_space_t* vs, uint32_t uaddr, const void* src, uint32_t len) {
+    return vm_copy(vs, uaddr, (uint8_t*)src, len, 1);
+}
+
+uint32_t vm_share_user_page(vm_space_t* vs, uint32_t uaddr) {
+    if (uaddr < USER_SPACE_START || uaddr >= USER_SPACE_END) return 0;
+    if (!vm_user_page(vs, uaddr, 0)) return 0;
+
+    uint32_t va = PAGE_ALIGN_DOWN(uaddr);
+    pte_t* pte = paging_get_pte(vs->pd, va, 0);
+    if (!pte || !(*pte & PAGE_PRESENT)) return 0;
+
+    // fork와 같은 방식: 양쪽(유저 매핑과 커널 참조)이 같은 프레임을 읽고, 유저가 쓰면 복사
+    if (*pte & PAGE_WRITE) {
+        vm_area_t* a = vm_find_area(vs, va);
+        if (!a || !(a->flags & VMA_SHARED)) {
+            *pte = (*pte & ~PAGE_WRITE) | PAGE_COW;
+            paging_flush(vs->pd, va);
+        }
+    }
+
+    uint32_t phys = PTE_FRAME(*pte);
+    pmm_ref(phys);
+    return phys;
+}
+
+void vm_dump_areas(vm_space_t* vs) {
+    kprintf("[VM] space pd=0x%x resident=%u inplace=%u cow=%u\n",
+        (uint32_t)vs->pd, vs->resident_pages, vs->inplace_pages, vs->cow_copies);
+
+    for (vm_area_t* a = vs->areas; a; a = a->next) {
+        if (a->file) {
+            kprintf("  [VMA] 0x%x-0x%x %c%c%c%c mmap=%s+0x%x\n",
+                a->start, a->end,
+                (a->flags & VMA_READ)  ? 'r' : '-',
+                (a->flags & VMA_WRITE) ? 'w' : '-',
+                (a->flags & VMA_EXEC)  ? 'x' : '-',
+                (a->flags & VMA_SHARED) ? 's' : 'p',
+                a->file->name, a->file_off);
+            continue;
+        }
+        kprintf("  [VMA] 0x%x-0x%x %c%c%c%c file=%u\n",
+            a->start, a->end,
+            (a->flags & VMA_READ)  ? 'r' : '-',
+            (a->flags & VMA_WRITE) ? 'w' : '-',
+            (a->flags & VMA_EXEC)  ? 'x' : '-',
+            (a->flags & VMA_SHARED) ? 's' : 'p',
+            a->file_size);
+    }
+}
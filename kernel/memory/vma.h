@@ -0,0 +1,91 @@
+#pragma once
+#include <stdint.h>
+#include "paging.h"
+
+// VMA 권한 플래그
+#define VMA_READ  0x1
+#define VMA_WRITE 0x2
+#define VMA_EXEC  0x4
+#define VMA_SHARED 0x8  // fork 시 COW 없이 같은 프레임을 쓰기 가능하게 공유 (커널과 공유하는 링 등)
+
+struct file;
+
+// 가상 메모리 영역 (virtual memory area)
+// [start, end) 범위는 등록만 되고 실제 프레임은 첫 접근(#PF) 시 채워진다.
+//   - [start, start + file_size): file_base + file_off 에서 읽음 (initrd 이미지 등)
+//   - 나머지: 0으로 채움 (.bss / anonymous)
+//   - file이 있으면 mmap된 파일: file_off부터 파일의 페이지 캐시 페이지를 그대로 매핑 (mmap.h)
+typedef struct vm_area {
+    uint32_t start;
+    uint32_t end;
+    uint32_t flags;
+
+    const uint8_t* file_base;   // 0이면 anonymous
+    uint32_t file_off;          // start에 대응하는 파일 오프셋
+    uint32_t file_size;         // start부터 파일에서 채울 바이트 수
+
+    struct file* file;          // mmap 파일 (참조 보유). VMA_SHARED면 캐시 페이지 공유, 아니면 COW
+
+    struct vm_area* next;       // start 기준 오름차순
+} vm_area_t;
+
+typedef struct vm_space {
+    pde_t* pd;
+    vm_area_t* areas;
+
+    uint32_t resident_pages;    // fault-in 된 페이지 수
+    uint32_t inplace_pages;     // 복사 없이 원본 페이지를 그대로 매핑한 수
+    uint32_t cow_copies;        // COW 쓰기로 복사된 페이지 수
+} vm_space_t;
+
+// 커널 주소 공간 등록 (paging_init 이후 1회)
+void vm_init(void);
+
+vm_space_t* vm_kernel_space(void);
+vm_space_t* vm_current_space(void);
+
+// 새 유저 주소 공간 (커널 영역 공유, 유저 영역 비어 있음)
+vm_space_t* vm_space_create(void);
+void vm_space_activate(vm_space_t* vs);
+
+// fork용 복제: VMA와 page table만 복사하고 프레임은 COW로 공유 (비용 = page table 크기)
+vm_space_t* vm_space_fork(vm_space_t* parent);
+
+// 유저 프레임 참조 해제 + page table / VMA 반환
+void vm_space_destroy(vm_space_t* vs);
+
+// 공유 zero page의 물리 주소
+uint32_t vm_zero_page(void);
+
+// 영역 등록 (start/end는 페이지 정렬, 유저 영역 내, 기존 영역과 겹치면 실패)
+vm_area_t* vm_map_area(vm_space_t* vs, uint32_t start, uint32_t end, uint32_t flags,
+                       const uint8_t* file_base, uint32_t file_off, uint32_t file_size);
+
+vm_area_t* vm_find_area(vm_space_t* vs, uint32_t addr);
+
+// [start, end)의 매핑과 VMA를 제거 (걸친 VMA는 잘라내거나 둘로 나눔, 프레임 참조 해제).
+// 페이지 정렬된 유저 영역이 아니면 0, 성공 1 (빈 구간이어도 1)
+int vm_unmap(vm_space_t* vs, uint32_t start, uint32_t end);
+
+// [start, end)의 페이지를 미리 fault-in (MAP_POPULATE). 하나라도 실패하면 0
+int vm_populate(vm_space_t* vs, uint32_t start, uint32_t end, int is_write);
+
+// 이미 가진 프레임들을 [start, start + n * PAGE_SIZE)에 VMA_SHARED로 매핑 (프레임 참조 +1)
+// 주소 공간이 사라질 때 참조가 풀리므로 호출자는 자기 참조를 따로 관리한다.
+// 성공 1 / 실패 0 (실패 시 VMA도 매핑도 남기지 않음)
+int vm_map_shared(vm_space_t* vs, uint32_t start, const uint32_t* frames, uint32_t n, uint32_t flags);
+
+// #PF 처리: 해결했으면 1, 진짜 fault면 0
+int vm_handle_fault(uint32_t addr, uint32_t err);
+
+// 현재 활성화되지 않은 주소 공간의 유저 메모리 복사 (page table을 직접 따라가며 필요하면 fault-in)
+// worker 스레드 등이 다른 프로세스의 버퍼를 다룰 때 사용. 성공 0, 실패 -EFAULT
+int vm_copy_from(vm_space_t* vs, void* dst, uint32_t uaddr, uint32_t len);
+int vm_copy_to(vm_space_t* vs, uint32_t uaddr, const void* src, uint32_t len);
+
+// uaddr가 속한 유저 페이지를 커널이 참조로 빌려감 (vmsplice). 없으면 fault-in하고,
+// 쓰기 가능한 private 페이지는 COW로 바꿔 이후의 유저 쓰기가 새 프레임으로 가게 한다.
+// 성공 시 프레임 물리 주소 (참조 +1, 호출자가 pmm_unref), 실패 시 0
+uint32_t vm_share_user_page(vm_space_t* vs, uint32_t uaddr);
+
+void vm_dump_areas(vm_space_t* vs);
@@ -0,0 +1,100 @@
+#include "checksum.h"
+#include "pbuf.h"
+#include "net.h"
+
+// 64비트 누산기를 32비트 부분합으로 (캐리를 다시 더함)
+static inline uint32_t fold64(uint64_t acc) {
+    acc = (acc & 0xFFFFFFFFu) + (acc >> 32);
+    acc = (acc & 0xFFFFFFFFu) + (acc >> 32);
+    return (uint32_t)acc;
+}
+
+uint32_t csum_partial(const void* buf, uint32_t len, uint32_t sum) {
+    const uint8_t* p = (const uint8_t*)buf;
+    uint64_t acc = sum;
+
+    // 32바이트 단위: 32비트 덧셈 8개 (컴파일러가 add/adc 쌍으로 만든다)
+    while (len >= 32) {
+        const uint32_t* w = (const uint32_t*)p;
+        acc += w[0];
+        acc += w[1];
+        acc += w[2];
+        acc += w[3];
+        acc += w[4];
+        acc += w[5];
+        acc += w[6];
+        acc += w[7];
+        p += 32;
+        len -= 32;
+    }
+    while (len >= 4) {
+        acc += *(const uint32_t*)p;
+        p += 4;
+        len -= 4;
+    }
+    if (len >= 2) {
+        acc += *(const uint16_t*)p;
+        p += 2;
+        len -= 2;
+    }
+    // 홀수 마지막 바이트는 16비트 워드의 앞 바이트 (little-endian에서 하위 바이트)
+    if (len) acc += *p;
+
+    return fold64(acc);
+}
+
+uint16_t csum_fold(uint32_t sum) {
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    return (uint16_t)~sum;
+}
+
+uint32_t csum_pseudo(uint32_t src, uint32_t dst, uint8_t proto, uint16_t len) {
+    uint64_t acc = 0;
+    acc += htonl(src);
+    acc += htonl(dst);
+    acc += htons((uint16_t)proto);
+    acc += htons(len);
+    return fold64(acc);
+}
+
+// 부분합을 8비트 회전 (홀수 바이트 위치에서 시작한 구간의 합을 짝수 기준으로 맞춤)
+static inline uint32_t csum_rotate8(uint32_t sum) {
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    return ((sum & 0xFF) << 8) | (sum >> 8);
+}
+
+uint32_t csum_pbuf(const pbuf_t* p, uint32_t off, uint32_t sum) {
+    uint32_t odd = 0;
+    if (off < p->len) {
+        uint32_t n = p->len - off;
+        sum = csum_partial(p->data + off, n, sum);
+        odd = n & 1;
+        off = 0;
+    } else {
+        off -= p->len;
+    }
+
+    if (off < p->frag_len) {
+        const uint8_t* frag = (const uint8_t*)p->frag_page + p->frag_off + off;
+        uint32_t part = csum_partial(frag, p->frag_len - off, 0);
+        if (odd) part = csum_rotate8(part);
+        uint64_t acc = (uint64_t)sum + part;
+        sum = fold64(acc);
+    }
+    return sum;
+}
+
+uint32_t csum_partial_ref(const void* buf, uint32_t len, uint32_t sum) {
+    const uint8_t* p = (const uint8_t*)buf;
+    while (len >= 2) {
+        sum += (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+        if (sum & 0x80000000u) sum = (sum & 0xFFFF) + (sum >> 16);
+        p += 2;
+        len -= 2;
+    }
+    if (len) sum += p[0];
+    while (sum >> 16) sum = (sum & 0xFFFF) + (sum >> 16);
+    return sum;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <stdint.h>
+
+// 인터넷 checksum (RFC 1071)
+// 1의 보수 합은 바이트 순서와 무관하므로 little-endian 32비트 단위로 64비트 누산기에 더한 뒤
+// 마지막에 16비트로 접는다. 32바이트 단위로 풀어 add/adc 체인이 되게 한다.
+
+// buf의 부분합을 sum에 더함 (결과는 접기 전 32비트 부분합)
+uint32_t csum_partial(const void* buf, uint32_t len, uint32_t sum);
+
+// 부분합을 16비트로 접고 보수 (헤더에 그대로 저장할 값)
+uint16_t csum_fold(uint32_t sum);
+
+// TCP/UDP pseudo header 부분합 (주소는 호스트 순서)
+uint32_t csum_pseudo(uint32_t src, uint32_t dst, uint8_t proto, uint16_t len);
+
+struct pbuf;
+
+// pbuf의 off 이후 전체(선형 + frag) 부분합
+uint32_t csum_pbuf(const struct pbuf* p, uint32_t off, uint32_t sum);
+
+// 비교용 16비트 단위 구현
+uint32_t csum_partial_ref(const void* buf, uint32_t len, uint32_t sum);
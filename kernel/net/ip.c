@@ -0,0 +1,100 @@
+#include "ip.h"
+#include "net.h"
+#include "checksum.h"
+#include "udp.h"
+#include "tcp.h"
+#include "../lib/errno.h"
+
+static ip_stats_t g_stats;
+static uint16_t g_ip_id = 0;
+
+uint32_t ip_route_src(uint32_t dst) {
+    netif_t* nif = netif_route(dst);
+    return nif ? nif->ip : 0;
+}
+
+uint32_t ip_route_mtu(uint32_t dst) {
+    netif_t* nif = netif_route(dst);
+    return nif ? nif->mtu : 0;
+}
+
+int ip_output(pbuf_t* p, uint32_t src, uint32_t dst, uint8_t proto) {
+    netif_t* nif = netif_route(dst);
+    if (!nif) {
+        g_stats.out_no_route++;
+        pbuf_free(p);
+        return -EINVAL;
+    }
+
+    uint32_t total = pbuf_total_len(p) + IP_HDR_LEN;
+    if (total > nif->mtu) {
+        // 단편화는 지원하지 않음: 상위 계층이 MTU에 맞춰 자른다
+        g_stats.out_too_big++;
+        pbuf_free(p);
+        return -EINVAL;
+    }
+
+    ip_hdr_t* ip = (ip_hdr_t*)pbuf_push(p, IP_HDR_LEN);
+    if (!ip) {
+        pbuf_free(p);
+        return -ENOSPC;
+    }
+
+    ip->ver_ihl = 0x45;
+    ip->tos = 0;
+    ip->tot_len = htons((uint16_t)total);
+    ip->id = htons(g_ip_id++);
+    ip->frag_off = htons(IP_DF);
+    ip->ttl = IP_TTL;
+    ip->proto = proto;
+    ip->csum = 0;
+    ip->src = htonl(src ? src : nif->ip);
+    ip->dst = htonl(dst);
+    ip->csum = csum_fold(csum_partial(ip, IP_HDR_LEN, 0));
+
+    g_stats.out_packets++;
+    return nif->xmit(nif, p);
+}
+
+void ip_input(netif_t* nif, pbuf_t* p) {
+    (void)nif;
+    g_stats.in_packets++;
+
+    // 헤더는 항상 선형 영역에 있다 (frag는 payload 전용)
+    if (p->len < IP_HDR_LEN) goto bad;
+    ip_hdr_t* ip = (ip_hdr_t*)p->data;
+    uint32_t hlen = (uint32_t)(ip->ver_ihl & 0xF) * 4;
+    uint32_t total = ntohs(ip->tot_len);
+    if ((ip->ver_ihl >> 4) != 4 || hlen < IP_HDR_LEN || hlen > p->len) goto bad;
+    if (total < hlen || total > pbuf_total_len(p)) goto bad;
+    if (csum_fold(csum_partial(ip, hlen, 0)) != 0) goto bad;
+
+    if (ntohs(ip->frag_off) & (IP_MF | 0x1FFF)) {
+        g_stats.in_frags++;
+        pbuf_free(p);
+        return;
+    }
+
+    uint32_t src = ntohl(ip->src);
+    uint32_t dst = ntohl(ip->dst);
+    uint8_t proto = ip->proto;
+
+    pbuf_trim(p, total);
+    pbuf_pull(p, hlen);
+
+    switch (proto) {
+        case IPPROTO_UDP: udp_input(p, src, dst); return;
+        case IPPROTO_TCP: tcp_input(p, src, dst); return;
+    }
+    g_stats.in_no_proto++;
+    pbuf_free(p);
+    return;
+
+bad:
+    g_stats.in_bad_hdr++;
+    pbuf_free(p);
+}
+
+void ip_get_stats(ip_stats_t* out) {
+    *out = g_stats;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <stdint.h>
+#include "pbuf.h"
+#include "netif.h"
+
+#define IP_HDR_LEN  20
+#define IP_TTL      64
+
+typedef struct ip_hdr {
+    uint8_t ver_ihl;                    // 상위 4비트 version(4), 하위 4비트 헤더 길이(4바이트 단위)
+    uint8_t tos;
+    uint16_t tot_len;
+    uint16_t id;
+    uint16_t frag_off;                  // flags(3) + offset(13)
+    uint8_t ttl;
+    uint8_t proto;
+    uint16_t csum;
+    uint32_t src;
+    uint32_t dst;
+} __attribute__((packed)) ip_hdr_t;
+
+#define IP_DF 0x4000
+#define IP_MF 0x2000
+
+typedef struct ip_stats {
+    uint32_t in_packets;
+    uint32_t in_bad_hdr;                // version/길이/checksum 오류
+    uint32_t in_no_proto;
+    uint32_t in_frags;                  // 단편 (재조립 미지원, drop)
+    uint32_t out_packets;
+    uint32_t out_no_route;
+    uint32_t out_too_big;
+} ip_stats_t;
+
+// p 앞에 IP 헤더를 붙여 라우팅된 인터페이스로 송신 (p 소유권을 가져감)
+// src가 0이면 인터페이스 주소. 성공 0, 실패 -errno
+int ip_output(pbuf_t* p, uint32_t src, uint32_t dst, uint8_t proto);
+
+// 헤더 검증 후 상위 프로토콜로 (net lock 보유, p 소유권을 가져감)
+void ip_input(netif_t* nif, pbuf_t* p);
+
+// dst로 보낼 때 쓸 출발 주소 (경로 없으면 0)
+uint32_t ip_route_src(uint32_t dst);
+
+// dst 경로의 MTU (경로 없으면 0)
+uint32_t ip_route_mtu(uint32_t dst);
+
+void ip_get_stats(ip_stats_t* out);
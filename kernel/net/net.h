@@ -0,0 +1,34 @@
+#pragma once
+#include <stdint.h>
+
+// 최소 IPv4 스택 공통 정의
+// - 프로토콜 상태(소켓, TCP 제어 블록)는 net lock(mutex) 하나로 보호한다
+// - 수신 처리는 netif backlog → workqueue(softirq 계정)에서, 송신은 호출 스레드에서
+// - 데이터는 pbuf 풀 + 페이지 참조로 전달해 스택 안에서는 payload를 복사하지 않는다
+
+// 바이트 순서 (x86은 little-endian)
+static inline uint16_t htons(uint16_t v) { return (uint16_t)((v << 8) | (v >> 8)); }
+static inline uint16_t ntohs(uint16_t v) { return htons(v); }
+static inline uint32_t htonl(uint32_t v) { return __builtin_bswap32(v); }
+static inline uint32_t ntohl(uint32_t v) { return __builtin_bswap32(v); }
+
+// 호스트 순서 IPv4 주소
+#define IP4(a, b, c, d) (((uint32_t)(a) << 24) | ((uint32_t)(b) << 16) | ((uint32_t)(c) << 8) | (uint32_t)(d))
+#define IP4_LOOPBACK    IP4(127, 0, 0, 1)
+
+#define IPPROTO_TCP 6
+#define IPPROTO_UDP 17
+
+struct wait_queue;
+
+// 스택 초기화: pbuf 풀, loopback 인터페이스, procfs "net" (workqueue_init/procfs_init 이후)
+void net_init(void);
+
+void net_lock(void);
+void net_unlock(void);
+
+// net lock을 놓고 wq에서 잠든 뒤 다시 잡는다 (조건은 호출자가 loop로 재확인)
+void net_wait(struct wait_queue* wq);
+
+// loopback 처리량/지연 + checksum 벤치마크 (스레드 생성 후 바로 반환)
+void net_bench(void);
@@ -0,0 +1,221 @@
+#include "net.h"
+#include "socket.h"
+#include "checksum.h"
+#include "../sched/thread.h"
+#include "../sync/semaphore.h"
+#include "../memory/heap.h"
+#include "../memory/pmm.h"
+#include "../fs/procfs.h"
+#include "../lib/cmdline.h"
+#include "../lib/div64.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/tsc.h"
+
+#define BENCH_UDP_PORT   7
+#define BENCH_TCP_PORT   5001
+#define BENCH_PINGS      200
+#define BENCH_PING_SIZE  64
+#define BENCH_STREAM     (4u * 1024 * 1024)
+#define BENCH_WRITE      (16u * 1024)
+
+static semaphore_t g_server_ready;
+static semaphore_t g_server_done;
+static uint32_t g_sink_bytes;
+static uint32_t g_sink_errors;
+
+static uint32_t mb_per_sec(uint32_t bytes, uint64_t cycles) {
+    uint64_t us = tsc_cycles_to_us(cycles);
+    if (us == 0) us = 1;
+    uint64_t bps = (uint64_t)bytes * 1000000ull;
+    div_u64_u32(&bps, (uint32_t)us);
+    return (uint32_t)(bps >> 20);
+}
+
+// ---- checksum: 32비트/64비트 누산 vs 16비트 단위 ----
+static void bench_csum(void) {
+    const uint32_t size = 1460;
+    const uint32_t iters = 4096;
+    uint8_t* buf = (uint8_t*)kmalloc(size + 1);
+    for (uint32_t i = 0; i < size + 1; i++) buf[i] = (uint8_t)(i * 31 + 7);
+
+    // 정렬/홀수 길이 포함 정확성
+    for (uint32_t len = 0; len <= 64; len++) {
+        if (csum_fold(csum_partial(buf + 1, len, 0)) != csum_fold(csum_partial_ref(buf + 1, len, 0))) {
+            kprintf("[NET] csum mismatch len=%u\n", len);
+            break;
+        }
+    }
+
+    volatile uint32_t sink = 0;
+    uint64_t t0 = rdtsc();
+    for (uint32_t i = 0; i < iters; i++) sink += csum_partial(buf, size, 0);
+    uint64_t t1 = rdtsc();
+    for (uint32_t i = 0; i < iters; i++) sink += csum_partial_ref(buf, size, 0);
+    uint64_t t2 = rdtsc();
+    (void)sink;
+
+    kprintf("[NET] csum %uB: opt %u MB/s, ref %u MB/s\n", size,
+        mb_per_sec(size * iters, t1 - t0), mb_per_sec(size * iters, t2 - t1));
+    kfree(buf);
+}
+
+// ---- UDP ping-pong 왕복 지연 ----
+static void udp_echo(void* arg) {
+    (void)arg;
+    sock_t* s = sock_create(SOCK_DGRAM);
+    sock_bind(s, BENCH_UDP_PORT);
+    sem_up(&g_server_ready);
+
+    uint8_t buf[BENCH_PING_SIZE];
+    for (uint32_t i = 0; i < BENCH_PINGS; i++) {
+        uint32_t ip;
+        uint16_t port;
+        int32_t n = sock_recvfrom(s, buf, sizeof(buf), &ip, &port);
+        if (n < 0) break;
+        sock_sendto(s, buf, (uint32_t)n, ip, port);
+    }
+    sock_close(s);
+    sem_up(&g_server_done);
+}
+
+static void bench_udp(void) {
+    thread_create("udp-echo", udp_echo, 0, PRIO_NORMAL + 1);
+    sem_down(&g_server_ready);
+
+    sock_t* s = sock_create(SOCK_DGRAM);
+    uint8_t buf[BENCH_PING_SIZE];
+    for (uint32_t i = 0; i < sizeof(buf); i++) buf[i] = (uint8_t)i;
+
+    uint64_t min = ~0ull, max = 0, total = 0;
+    uint32_t ok = 0;
+    for (uint32_t i = 0; i < BENCH_PINGS; i++) {
+        uint64_t t0 = rdtsc();
+        if (sock_sendto(s, buf, sizeof(buf), IP4_LOOPBACK, BENCH_UDP_PORT) < 0) break;
+        if (sock_recvfrom(s, buf, sizeof(buf), 0, 0) != (int32_t)sizeof(buf)) break;
+        uint64_t d = rdtsc() - t0;
+        if (d < min) min = d;
+        if (d > max) max = d;
+        total += d;
+        ok++;
+    }
+    sock_close(s);
+    sem_down(&g_server_done);
+
+    if (!ok) {
+        kprintf("[NET] udp ping-pong failed\n");
+        return;
+    }
+    div_u64_u32(&total, ok);
+    kprintf("[NET] udp rtt %uB x%u: min %llu us, avg %llu us, max %llu us\n", BENCH_PING_SIZE, ok,
+        tsc_cycles_to_us(min), tsc_cycles_to_us(total), tsc_cycles_to_us(max));
+}
+
+// ---- TCP 스트림 처리량 ----
+static void tcp_sink(void* arg) {
+    sock_t* ls = (sock_t*)arg;
+    int err;
+    sock_t* c = sock_accept(ls, &err);
+    if (!c) {
+        kprintf("[NET] accept failed: %d\n", err);
+        sem_up(&g_server_done);
+        return;
+    }
+
+    uint8_t* buf = (uint8_t*)kmalloc(BENCH_WRITE);
+    uint32_t total = 0, errors = 0;
+    for (;;) {
+        int32_t n = sock_recv(c, buf, BENCH_WRITE);
+        if (n <= 0) {
+            if (n < 0) errors++;
+            break;
+        }
+        // 송신 측 패턴: 스트림 오프셋의 하위 바이트
+        for (int32_t i = 0; i < n; i += 509) {
+            if (buf[i] != (uint8_t)(total + (uint32_t)i)) errors++;
+        }
+        total += (uint32_t)n;
+    }
+    kfree(buf);
+    sock_close(c);
+
+    g_sink_bytes = total;
+    g_sink_errors = errors;
+    sem_up(&g_server_done);
+}
+
+// zero_copy: 같은 물리 페이지를 sock_send_page로 반복해서 보냄 (송신 측 복사 0회)
+static void bench_tcp(int zero_copy) {
+    // 앞 실행의 연결이 아직 LAST_ACK일 수 있으므로 포트를 나눈다
+    uint16_t port = (uint16_t)(BENCH_TCP_PORT + zero_copy);
+    sock_t* ls = sock_create(SOCK_STREAM);
+    int r = sock_bind(ls, port);
+    if (r == 0) r = sock_listen(ls, 4);
+    if (r < 0) {
+        kprintf("[NET] tcp listen failed: %d\n", r);
+        sock_close(ls);
+        return;
+    }
+    thread_create("tcp-sink", tcp_sink, ls, PRIO_NORMAL + 1);
+
+    sock_t* s = sock_create(SOCK_STREAM);
+    r = sock_connect(s, IP4_LOOPBACK, port);
+    if (r < 0) {
+        kprintf("[NET] tcp connect failed: %d\n", r);
+        sock_close(s);
+        sock_close(ls);
+        sem_down(&g_server_done);
+        return;
+    }
+
+    uint8_t* buf = 0;
+    uint32_t page = 0;
+    if (zero_copy) {
+        page = pmm_alloc_frame();
+        for (uint32_t i = 0; i < PAGE_SIZE; i++) ((uint8_t*)page)[i] = (uint8_t)i;
+    } else {
+        buf = (uint8_t*)kmalloc(BENCH_WRITE);
+        for (uint32_t i = 0; i < BENCH_WRITE; i++) buf[i] = (uint8_t)i;
+    }
+
+    uint64_t t0 = rdtsc();
+    uint32_t sent = 0;
+    while (sent < BENCH_STREAM) {
+        int32_t n = zero_copy ? sock_send_page(s, page, 0, PAGE_SIZE) : sock_send(s, buf, BENCH_WRITE);
+        if (n <= 0) {
+            kprintf("[NET] tcp send failed: %d\n", n);
+            break;
+        }
+        sent += (uint32_t)n;
+    }
+    sock_close(s);
+    sem_down(&g_server_done);
+    uint64_t cycles = rdtsc() - t0;
+
+    if (page) pmm_unref(page);
+    if (buf) kfree(buf);
+    sock_close(ls);
+
+    kprintf("[NET] tcp %s %u KB: %u MB/s (recv %u KB, errors %u)\n", zero_copy ? "sendpage" : "send",
+        sent >> 10, mb_per_sec(g_sink_bytes, cycles), g_sink_bytes >> 10, g_sink_errors);
+}
+
+static void net_bench_thread(void* arg) {
+    (void)arg;
+    sem_init(&g_server_ready, 0);
+    sem_init(&g_server_done, 0);
+
+    bench_csum();
+    bench_udp();
+    bench_tcp(0);
+    bench_tcp(1);
+    procfs_cat("net");
+}
+
+void net_bench(void) {
+    if (!cmdline_bench("net")) return;
+    if (tsc_hz() == 0) {
+        kprintf("[NET] TSC not calibrated\n");
+        return;
+    }
+    thread_create("net-bench", net_bench_thread, 0, PRIO_NORMAL);
+}
@@ -0,0 +1,102 @@
+#include "netif.h"
+#include "net.h"
+#include "ip.h"
+#include "../lib/ring.h"
+#include "../sched/workqueue.h"
+#include "../panic/panic.h"
+#include "../console/kprintf.h"
+
+static netif_t g_lo;
+static netif_t* g_netifs = 0;
+
+// backlog 항목: pbuf + 받은 인터페이스 (항목은 미리 만든 배열에서 빌려 씀)
+typedef struct rx_item {
+    netif_t* nif;
+    pbuf_t* p;
+} rx_item_t;
+
+static rx_item_t g_items[NETIF_BACKLOG];
+static mpmc_ring_t g_backlog;           // 처리 대기 rx_item_t*
+static mpmc_ring_t g_item_free;
+static work_t g_rx_work;
+
+static void net_rx_work(work_t* w) {
+    (void)w;
+    void* item;
+    uint32_t n = 0;
+
+    net_lock();
+    while (n < NETIF_RX_BUDGET && mpmc_ring_pop(&g_backlog, &item)) {
+        rx_item_t* it = (rx_item_t*)item;
+        netif_t* nif = it->nif;
+        pbuf_t* p = it->p;
+        mpmc_ring_push(&g_item_free, it);
+
+        nif->rx_packets++;
+        nif->rx_bytes += pbuf_total_len(p);
+        ip_input(nif, p);
+        n++;
+    }
+    net_unlock();
+
+    // 예산을 다 쓰면 다른 work에 양보하고 다시 등록
+    if (mpmc_ring_count(&g_backlog)) queue_work(system_wq, &g_rx_work);
+}
+
+void netif_rx(netif_t* nif, pbuf_t* p) {
+    void* item;
+    if (!mpmc_ring_pop(&g_item_free, &item)) {
+        nif->drops++;
+        pbuf_free(p);
+        return;
+    }
+    rx_item_t* it = (rx_item_t*)item;
+    it->nif = nif;
+    it->p = p;
+    mpmc_ring_push(&g_backlog, it);
+    queue_work(system_wq, &g_rx_work);
+}
+
+// loopback: 송신 pbuf를 그대로 수신 backlog로 (송신 측이 checksum을 계산했으므로 검증 생략)
+static int lo_xmit(netif_t* nif, pbuf_t* p) {
+    nif->tx_packets++;
+    nif->tx_bytes += pbuf_total_len(p);
+    p->flags |= PBUF_CSUM_VALID;
+    netif_rx(nif, p);
+    return 0;
+}
+
+void netif_init(void) {
+    if (!mpmc_ring_init(&g_backlog, NETIF_BACKLOG) || !mpmc_ring_init(&g_item_free, NETIF_BACKLOG)) {
+        panic("netif_init: ring init failed");
+    }
+    for (uint32_t i = 0; i < NETIF_BACKLOG; i++) mpmc_ring_push(&g_item_free, &g_items[i]);
+    work_init(&g_rx_work, net_rx_work);
+
+    g_lo.name[0] = 'l';
+    g_lo.name[1] = 'o';
+    g_lo.name[2] = 0;
+    g_lo.ip = IP4_LOOPBACK;
+    g_lo.netmask = IP4(255, 0, 0, 0);
+    g_lo.mtu = LOOPBACK_MTU;
+    g_lo.xmit = lo_xmit;
+    g_lo.next = g_netifs;
+    g_netifs = &g_lo;
+
+    kprintf("[NET] lo 127.0.0.1/8 mtu=%u\n", g_lo.mtu);
+}
+
+netif_t* netif_route(uint32_t dst) {
+    for (netif_t* nif = g_netifs; nif; nif = nif->next) {
+        if ((dst & nif->netmask) == (nif->ip & nif->netmask)) return nif;
+    }
+    return 0;
+}
+
+netif_t* netif_loopback(void) {
+    return &g_lo;
+}
+
+void netif_for_each(void (*fn)(netif_t* nif, void* arg), void* arg) {
+    for (netif_t* nif = g_netifs; nif; nif = nif->next) fn(nif, arg);
+}
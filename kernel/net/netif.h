@@ -0,0 +1,43 @@
+#pragma once
+#include <stdint.h>
+#include "pbuf.h"
+
+// 네트워크 인터페이스
+// 송신: ip_output → netif->xmit (호출 스레드, net lock 보유)
+// 수신: 드라이버가 netif_rx로 backlog ring에 넣으면 net-rx work가 한 번에 최대
+//       NETIF_RX_BUDGET개씩 net lock을 잡고 ip_input으로 올린다
+
+#define NETIF_NAME_LEN   8
+#define NETIF_BACKLOG    256            // 2의 거듭제곱
+#define NETIF_RX_BUDGET  64
+
+// loopback MTU: 페이지 하나(MSS 4096) + IP/TCP 헤더
+#define LOOPBACK_MTU     (4096 + 40)
+
+typedef struct netif {
+    char name[NETIF_NAME_LEN];
+    uint32_t ip;                        // 호스트 순서
+    uint32_t netmask;
+    uint32_t mtu;
+    int (*xmit)(struct netif* nif, pbuf_t* p);      // p 소유권을 가져감. 성공 0
+
+    uint32_t tx_packets;
+    uint32_t tx_bytes;
+    uint32_t rx_packets;
+    uint32_t rx_bytes;
+    uint32_t drops;
+
+    struct netif* next;
+} netif_t;
+
+void netif_init(void);
+
+// dst로 가는 인터페이스 (없으면 0)
+netif_t* netif_route(uint32_t dst);
+
+// 수신 패킷을 backlog로 (IRQ 컨텍스트에서도 호출 가능). 가득이면 drop
+void netif_rx(netif_t* nif, pbuf_t* p);
+
+netif_t* netif_loopback(void);
+
+void netif_for_each(void (*fn)(netif_t* nif, void* arg), void* arg);
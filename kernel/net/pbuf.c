@@ -0,0 +1,139 @@
+#include "pbuf.h"
+#include "../memory/heap.h"
+#include "../memory/pmm.h"
+#include "../lib/ring.h"
+#include "../lib/string.h"
+#include "../panic/panic.h"
+#include "../console/kprintf.h"
+
+static pbuf_t* g_pbufs;
+static mpmc_ring_t g_free;
+static pbuf_stats_t g_stats;
+
+void pbuf_init(void) {
+    g_pbufs = (pbuf_t*)kmalloc(PBUF_POOL_SIZE * sizeof(pbuf_t));
+    uint8_t* bufs = (uint8_t*)kmalloc_aligned(PBUF_POOL_SIZE * PBUF_BUF_SIZE, 64);
+    if (!mpmc_ring_init(&g_free, PBUF_POOL_SIZE)) {
+        panic("pbuf_init: ring init failed");
+    }
+
+    for (uint32_t i = 0; i < PBUF_POOL_SIZE; i++) {
+        pbuf_t* p = &g_pbufs[i];
+        memset(p, 0, sizeof(*p));
+        p->buf = bufs + i * PBUF_BUF_SIZE;
+        mpmc_ring_push(&g_free, p);
+    }
+
+    memset(&g_stats, 0, sizeof(g_stats));
+    g_stats.min_free = PBUF_POOL_SIZE;
+    kprintf("[PBUF] pool %u x %u bytes (headroom %u)\n", PBUF_POOL_SIZE, PBUF_BUF_SIZE, PBUF_HEADROOM);
+}
+
+pbuf_t* pbuf_alloc(uint32_t len) {
+    if (len > PBUF_BUF_SIZE - PBUF_HEADROOM) return 0;
+
+    void* item;
+    if (!mpmc_ring_pop(&g_free, &item)) {
+        __sync_fetch_and_add(&g_stats.failures, 1);
+        return 0;
+    }
+
+    pbuf_t* p = (pbuf_t*)item;
+    p->next = 0;
+    p->data = p->buf + PBUF_HEADROOM;
+    p->len = len;
+    p->frag_page = 0;
+    p->frag_off = 0;
+    p->frag_len = 0;
+    p->flags = 0;
+    p->src_ip = 0;
+    p->src_port = 0;
+
+    __sync_fetch_and_add(&g_stats.allocs, 1);
+    uint32_t used = __sync_add_and_fetch(&g_stats.in_use, 1);
+    if (PBUF_POOL_SIZE - used < g_stats.min_free) g_stats.min_free = PBUF_POOL_SIZE - used;
+    return p;
+}
+
+void pbuf_free(pbuf_t* p) {
+    if (p->frag_page) {
+        pmm_unref(p->frag_page);
+        p->frag_page = 0;
+    }
+    __sync_fetch_and_add(&g_stats.frees, 1);
+    __sync_fetch_and_sub(&g_stats.in_use, 1);
+    mpmc_ring_push(&g_free, p);
+}
+
+uint8_t* pbuf_push(pbuf_t* p, uint32_t n) {
+    if ((uint32_t)(p->data - p->buf) < n) return 0;
+    p->data -= n;
+    p->len += n;
+    return p->data;
+}
+
+void pbuf_pull(pbuf_t* p, uint32_t n) {
+    uint32_t k = n < p->len ? n : p->len;
+    p->data += k;
+    p->len -= k;
+    n -= k;
+    if (n) {
+        if (n > p->frag_len) n = p->frag_len;
+        p->frag_off += n;
+        p->frag_len -= n;
+    }
+}
+
+void pbuf_trim(pbuf_t* p, uint32_t len) {
+    if (len >= pbuf_total_len(p)) return;
+
+    if (len <= p->len) {
+        p->len = len;
+        if (p->frag_page) {
+            pmm_unref(p->frag_page);
+            p->frag_page = 0;
+        }
+        p->frag_off = 0;
+        p->frag_len = 0;
+    } else {
+        p->frag_len = (uint16_t)(len - p->len);
+    }
+}
+
+void pbuf_attach_page(pbuf_t* p, uint32_t phys, uint32_t off, uint32_t len) {
+    if (p->frag_page) {
+        panic("pbuf_attach_page: pbuf already has a page");
+    }
+    pmm_ref(phys);
+    p->frag_page = PAGE_ALIGN_DOWN(phys);
+    p->frag_off = (uint16_t)off;
+    p->frag_len = (uint16_t)len;
+    __sync_fetch_and_add(&g_stats.page_refs, 1);
+}
+
+uint32_t pbuf_copy_out(const pbuf_t* p, uint32_t off, void* dst, uint32_t n) {
+    uint8_t* d = (uint8_t*)dst;
+    uint32_t done = 0;
+
+    if (off < p->len) {
+        uint32_t k = p->len - off;
+        if (k > n) k = n;
+        memcpy(d, p->data + off, k);
+        done = k;
+        off = 0;
+    } else {
+        off -= p->len;
+    }
+
+    if (done < n && off < p->frag_len) {
+        uint32_t k = p->frag_len - off;
+        if (k > n - done) k = n - done;
+        memcpy(d + done, (const uint8_t*)p->frag_page + p->frag_off + off, k);
+        done += k;
+    }
+    return done;
+}
+
+void pbuf_get_stats(pbuf_stats_t* out) {
+    *out = g_stats;
+}
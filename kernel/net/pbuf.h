@@ -0,0 +1,66 @@
+#pragma once
+#include <stdint.h>
+
+// 패킷 버퍼
+// - 부팅 시 PBUF_POOL_SIZE개를 미리 할당하고 lock-free MPMC ring으로 빌려준다 (경로상 kmalloc 없음)
+// - 선형 영역 앞에 PBUF_HEADROOM을 비워 두어 하위 계층 헤더를 복사 없이 앞에 붙인다 (pbuf_push)
+// - payload는 선형 영역 뒤에 페이지 참조(frag) 하나를 둘 수 있다: TCP 송신 버퍼 페이지를
+//   pmm 참조 카운트만 올려 그대로 실어 보내고, 수신 측 소켓 큐까지 같은 페이지가 간다
+
+#define PBUF_POOL_SIZE 256              // 2의 거듭제곱 (ring 용량)
+#define PBUF_BUF_SIZE  2048
+#define PBUF_HEADROOM  128              // 링크 + IP(옵션 포함) + TCP 헤더 여유
+
+// pbuf->flags
+#define PBUF_CSUM_VALID 0x1             // 수신 checksum 검증 생략 가능 (loopback: 송신 측이 계산함)
+
+typedef struct pbuf {
+    struct pbuf* next;                  // 큐 연결 (backlog, 소켓 수신 큐)
+    uint8_t* data;                      // 현재 선형 영역 시작
+    uint32_t len;                       // 선형 영역 길이
+    uint8_t* buf;                       // 풀 버퍼 (PBUF_BUF_SIZE)
+
+    uint32_t frag_page;                 // 선형 영역 뒤 payload 페이지 (물리 주소, 0이면 없음)
+    uint16_t frag_off;
+    uint16_t frag_len;
+
+    uint16_t flags;
+    uint16_t src_port;                  // 수신 시 프로토콜 계층이 채움 (UDP recvfrom)
+    uint32_t src_ip;
+} pbuf_t;
+
+typedef struct pbuf_stats {
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t failures;                  // 풀 고갈
+    uint32_t in_use;
+    uint32_t min_free;                  // 최저 여유 개수
+    uint32_t page_refs;                 // frag로 붙인 페이지 참조 누적
+} pbuf_stats_t;
+
+void pbuf_init(void);
+
+// headroom 뒤 len 바이트 선형 영역 (len > PBUF_BUF_SIZE - PBUF_HEADROOM 이거나 풀이 비면 0)
+pbuf_t* pbuf_alloc(uint32_t len);
+void pbuf_free(pbuf_t* p);
+
+// 앞에 n바이트를 붙이고 새 시작 주소 반환 (headroom 부족 시 0)
+uint8_t* pbuf_push(pbuf_t* p, uint32_t n);
+
+// 앞 n바이트 제거 (선형 영역을 넘으면 frag에서 계속)
+void pbuf_pull(pbuf_t* p, uint32_t n);
+
+// 전체 길이를 len으로 줄임 (IP total length 뒤의 패딩 제거)
+void pbuf_trim(pbuf_t* p, uint32_t len);
+
+// 페이지 [off, off+len)을 payload로 참조 (pmm 참조 +1, 해제 시 -1)
+void pbuf_attach_page(pbuf_t* p, uint32_t phys, uint32_t off, uint32_t len);
+
+static inline uint32_t pbuf_total_len(const pbuf_t* p) {
+    return p->len + p->frag_len;
+}
+
+// off부터 n바이트를 dst로 (선형 + frag). 복사한 바이트 수
+uint32_t pbuf_copy_out(const pbuf_t* p, uint32_t off, void* dst, uint32_t n);
+
+void pbuf_get_stats(pbuf_stats_t* out);
@@ -0,0 +1,297 @@
+#include "socket.h"
+#include "net.h"
+#include "netif.h"
+#include "ip.h"
+#include "udp.h"
+#include "tcp.h"
+#include "../sync/mutex.h"
+#include "../memory/heap.h"
+#include "../fs/procfs.h"
+#include "../fs/file.h"
+#include "../../arch/x86/cpu/irqflags.h"
+#include "../lib/errno.h"
+#include "../lib/string.h"
+#include "../console/kprintf.h"
+
+static mutex_t g_net_lock;
+
+void net_lock(void) {
+    mutex_lock(&g_net_lock);
+}
+
+void net_unlock(void) {
+    mutex_unlock(&g_net_lock);
+}
+
+// 단일 CPU: 인터럽트를 끈 채 lock을 놓고 잠들므로 그 사이의 wake_up을 놓치지 않는다
+// (wake_up은 net lock을 잡은 쪽에서만 부르고, lock을 잡으려면 이 스레드가 잠들어야 함)
+void net_wait(struct wait_queue* wq) {
+    uint32_t flags = irq_save();
+    mutex_unlock(&g_net_lock);
+    wait_queue_sleep(wq);
+    irq_restore(flags);
+    mutex_lock(&g_net_lock);
+}
+
+// -------------------------
+// 소켓 공통
+// -------------------------
+
+sock_t* sock_alloc(int type) {
+    sock_t* s = (sock_t*)kmalloc(sizeof(sock_t));
+    if (!s) return 0;
+    memset(s, 0, sizeof(*s));
+    s->type = type;
+    s->refcount = 1;
+    s->rcvbuf = SOCK_RCVBUF;
+    wait_queue_init(&s->rx_wait);
+    wait_queue_init(&s->tx_wait);
+    return s;
+}
+
+void sock_get(sock_t* s) {
+    __sync_fetch_and_add(&s->refcount, 1);
+}
+
+void sock_put(sock_t* s) {
+    if (__sync_sub_and_fetch(&s->refcount, 1) != 0) return;
+
+    while (s->rx_head) {
+        pbuf_t* p = s->rx_head;
+        s->rx_head = p->next;
+        pbuf_free(p);
+    }
+    if (s->type == SOCK_STREAM) tcp_release(s);
+    kfree(s);
+}
+
+void sock_queue_rx(sock_t* s, pbuf_t* p) {
+    p->next = 0;
+    if (s->rx_tail) s->rx_tail->next = p;
+    else s->rx_head = p;
+    s->rx_tail = p;
+    s->rx_bytes += pbuf_total_len(p);
+    wake_up_one(&s->rx_wait);
+}
+
+uint32_t sock_dequeue_rx(sock_t* s, void* buf, uint32_t len, int stream) {
+    uint8_t* dst = (uint8_t*)buf;
+    uint32_t done = 0;
+
+    while (s->rx_head && done < len) {
+        pbuf_t* p = s->rx_head;
+        uint32_t avail = pbuf_total_len(p);
+        uint32_t n = avail < len - done ? avail : len - done;
+        pbuf_copy_out(p, 0, dst + done, n);
+        done += n;
+
+        // datagram은 남은 부분을 버린다 (버퍼보다 크면 잘림)
+        if (n < avail && stream) {
+            pbuf_pull(p, n);
+            s->rx_bytes -= n;
+            break;
+        }
+        s->rx_bytes -= avail;
+        s->rx_head = p->next;
+        if (!s->rx_head) s->rx_tail = 0;
+        pbuf_free(p);
+        if (!stream) break;
+    }
+    return done;
+}
+
+// -------------------------
+// 소켓 API
+// -------------------------
+
+sock_t* sock_create(int type) {
+    if (type != SOCK_STREAM && type != SOCK_DGRAM) return 0;
+    sock_t* s = sock_alloc(type);
+    if (s && type == SOCK_STREAM) tcp_sock_init(s);
+    return s;
+}
+
+int sock_bind(sock_t* s, uint16_t port) {
+    net_lock();
+    int r = s->type == SOCK_STREAM ? tcp_bind(s, port) : udp_bind(s, port);
+    net_unlock();
+    return r;
+}
+
+int sock_listen(sock_t* s, uint32_t backlog) {
+    if (s->type != SOCK_STREAM) return -EINVAL;
+    net_lock();
+    int r = tcp_listen(s, backlog);
+    net_unlock();
+    return r;
+}
+
+sock_t* sock_accept(sock_t* s, int* err) {
+    if (s->type != SOCK_STREAM) {
+        *err = -EINVAL;
+        return 0;
+    }
+    net_lock();
+    sock_t* c = tcp_accept(s, err);
+    net_unlock();
+    return c;
+}
+
+int sock_connect(sock_t* s, uint32_t ip, uint16_t port) {
+    if (s->type != SOCK_STREAM) return -EINVAL;
+    net_lock();
+    int r = tcp_connect(s, ip, port);
+    net_unlock();
+    return r;
+}
+
+int32_t sock_send(sock_t* s, const void* buf, uint32_t len) {
+    if (s->type != SOCK_STREAM) return -EINVAL;
+    net_lock();
+    int32_t r = tcp_send(s, buf, len);
+    net_unlock();
+    return r;
+}
+
+int32_t sock_send_page(sock_t* s, uint32_t phys, uint32_t off, uint32_t len) {
+    if (s->type != SOCK_STREAM) return -EINVAL;
+    net_lock();
+    int32_t r = tcp_send_page(s, phys, off, len);
+    net_unlock();
+    return r;
+}
+
+int32_t sock_recv(sock_t* s, void* buf, uint32_t len) {
+    if (s->type != SOCK_STREAM) return sock_recvfrom(s, buf, len, 0, 0);
+    net_lock();
+    int32_t r = tcp_recv(s, buf, len);
+    net_unlock();
+    return r;
+}
+
+int32_t sock_sendto(sock_t* s, const void* buf, uint32_t len, uint32_t ip, uint16_t port) {
+    if (s->type != SOCK_DGRAM) return -EINVAL;
+    net_lock();
+    int32_t r = udp_sendto(s, buf, len, ip, port);
+    net_unlock();
+    return r;
+}
+
+int32_t sock_recvfrom(sock_t* s, void* buf, uint32_t len, uint32_t* ip, uint16_t* port) {
+    if (s->type != SOCK_DGRAM) return -EINVAL;
+    net_lock();
+    if (!s->local_port) {
+        net_unlock();
+        return -EINVAL;
+    }
+    while (!s->rx_head) net_wait(&s->rx_wait);
+
+    if (ip) *ip = s->rx_head->src_ip;
+    if (port) *port = s->rx_head->src_port;
+    int32_t r = (int32_t)sock_dequeue_rx(s, buf, len, 0);
+    net_unlock();
+    return r;
+}
+
+void sock_close(sock_t* s) {
+    net_lock();
+    s->user_closed = 1;
+    if (s->type == SOCK_STREAM) {
+        tcp_close(s);
+    } else {
+        udp_unhash(s);
+        while (s->rx_head) {
+            pbuf_t* p = s->rx_head;
+            s->rx_head = p->next;
+            pbuf_free(p);
+        }
+        s->rx_tail = 0;
+        s->rx_bytes = 0;
+    }
+    sock_put(s);
+    net_unlock();
+}
+
+// -------------------------
+// file_t 연결 (splice)
+// -------------------------
+
+static int32_t sock_file_read(file_t* f, void* buf, uint32_t len, uint64_t off) {
+    (void)off;
+    return sock_recv((sock_t*)f->priv, buf, len);
+}
+
+static int32_t sock_file_write(file_t* f, const void* buf, uint32_t len, uint64_t off) {
+    (void)off;
+    return sock_send((sock_t*)f->priv, buf, len);
+}
+
+static int32_t sock_file_write_page(file_t* f, uint32_t page, uint32_t off, uint32_t len, uint64_t pos) {
+    (void)pos;
+    return sock_send_page((sock_t*)f->priv, page, off, len);
+}
+
+static void sock_file_release(file_t* f) {
+    sock_close((sock_t*)f->priv);
+}
+
+static const file_ops_t g_sock_file_ops = {
+    .read = sock_file_read,
+    .write = sock_file_write,
+    .release = sock_file_release,
+    .get_page = 0,
+    .write_page = sock_file_write_page,
+};
+
+file_t* sock_file_open(sock_t* s) {
+    return file_alloc(s->type == SOCK_STREAM ? "tcp" : "udp", &g_sock_file_ops, s, 0);
+}
+
+// -------------------------
+// procfs "net"
+// -------------------------
+
+static void netif_row(netif_t* nif, void* arg) {
+    proc_seq_t* s = (proc_seq_t*)arg;
+    proc_printf(s, "%-4s mtu=%u rx=%u/%uB tx=%u/%uB drops=%u\n", nif->name, nif->mtu,
+        nif->rx_packets, nif->rx_bytes, nif->tx_packets, nif->tx_bytes, nif->drops);
+}
+
+static void tcp_row(sock_t* sk, void* arg) {
+    proc_seq_t* s = (proc_seq_t*)arg;
+    const tcp_pcb_t* tp = &sk->tcp;
+    proc_printf(s, "  %5u -> %5u %-11s snd=%u/%u wnd=%u rx=%u rtx=%u ref=%u\n",
+        sk->local_port, sk->remote_port, tcp_state_name(tp->state),
+        tp->snd_nxt - tp->snd_una, tp->snd_bytes, tp->snd_wnd, sk->rx_bytes, tp->retransmits, sk->refcount);
+}
+
+static void show_net(proc_seq_t* s) {
+    pbuf_stats_t ps;
+    ip_stats_t is;
+    tcp_stats_t ts;
+    pbuf_get_stats(&ps);
+    ip_get_stats(&is);
+    tcp_get_stats(&ts);
+
+    netif_for_each(netif_row, s);
+    proc_printf(s, "pbuf: in_use=%u min_free=%u allocs=%u failures=%u page_refs=%u\n",
+        ps.in_use, ps.min_free, ps.allocs, ps.failures, ps.page_refs);
+    proc_printf(s, "ip:   in=%u bad=%u noproto=%u frags=%u out=%u noroute=%u toobig=%u\n",
+        is.in_packets, is.in_bad_hdr, is.in_no_proto, is.in_frags,
+        is.out_packets, is.out_no_route, is.out_too_big);
+    proc_printf(s, "udp:  in=%u errors=%u\n", udp_in_datagrams(), udp_in_errors());
+    proc_printf(s, "tcp:  active=%u passive=%u in=%u out=%u rtx=%u rst=%u badcsum=%u ooo=%u\n",
+        ts.active_opens, ts.passive_opens, ts.segs_in, ts.segs_out,
+        ts.retransmits, ts.resets_sent, ts.bad_csum, ts.ooo_drops);
+
+    net_lock();
+    tcp_for_each(tcp_row, s);
+    net_unlock();
+}
+
+void net_init(void) {
+    mutex_init(&g_net_lock, "net");
+    pbuf_init();
+    netif_init();
+    procfs_register("net", show_net);
+}
@@ -0,0 +1,159 @@
+#pragma once
+#include <stdint.h>
+#include "pbuf.h"
+#include "../sched/wait.h"
+#include "../sched/workqueue.h"
+
+// 커널 소켓 (UDP datagram / TCP stream)
+// 모든 함수는 스레드 컨텍스트 전용이며 내부에서 net lock을 잡는다.
+// 수신 데이터는 pbuf 그대로 소켓 큐에 쌓이고 recv에서 한 번만 복사한다.
+// TCP 송신 버퍼는 페이지 조각 ring: send는 사용자 데이터를 페이지에 한 번 복사하고,
+// 세그먼트는 그 페이지를 참조로 붙여 보낸다 (sock_send_page는 복사 없이 페이지 자체를 넘김).
+
+#define SOCK_STREAM 1
+#define SOCK_DGRAM  2
+
+#define SOCK_RCVBUF     65535           // 윈도 스케일 없음: TCP 광고 윈도 상한
+#define SOCK_SNDBUF     (64u * 1024)
+#define TCP_SND_CHUNKS  32              // 송신 버퍼 페이지 조각 수 (2의 거듭제곱)
+
+#define SOCK_EPHEMERAL_BASE 49152
+
+// TCP 상태
+enum {
+    TCP_CLOSED = 0,
+    TCP_LISTEN,
+    TCP_SYN_SENT,
+    TCP_SYN_RCVD,
+    TCP_ESTABLISHED,
+    TCP_FIN_WAIT_1,
+    TCP_FIN_WAIT_2,
+    TCP_CLOSING,
+    TCP_CLOSE_WAIT,
+    TCP_LAST_ACK,
+};
+
+// 송신 버퍼 조각: page의 [off, off+len). shared면 외부 페이지 참조라 뒤에 이어 쓰지 않는다
+typedef struct tcp_chunk {
+    uint32_t page;
+    uint16_t off;
+    uint16_t len;
+    uint32_t shared;
+} tcp_chunk_t;
+
+struct sock;
+
+typedef struct tcp_pcb {
+    int state;
+
+    uint32_t iss;
+    uint32_t snd_una;                   // 가장 오래된 미확인 seq
+    uint32_t snd_nxt;                   // 다음에 보낼 seq
+    uint32_t snd_wnd;                   // 상대가 광고한 윈도
+    uint32_t snd_max;                   // 보낸 적 있는 가장 큰 seq (go-back-N 뒤 늦게 온 ACK 허용)
+    uint32_t snd_bytes;                 // snd_una부터 버퍼에 있는 데이터 (FIN 제외)
+    uint16_t mss;
+
+    uint32_t irs;
+    uint32_t rcv_nxt;
+    uint32_t rcv_adv;                   // 마지막으로 광고한 윈도
+
+    uint32_t fin_queued;                // 사용자가 닫음: 데이터를 다 보낸 뒤 FIN
+    uint32_t fin_sent;                  // fin_seq가 정해짐 (재전송 중에도 유지)
+    uint32_t fin_seq;
+    uint32_t fin_received;
+
+    tcp_chunk_t snd[TCP_SND_CHUNKS];
+    uint32_t snd_head;                  // 계속 증가하는 인덱스 (슬롯은 & (TCP_SND_CHUNKS-1))
+    uint32_t snd_tail;
+
+    uint32_t rto;                       // tick
+    uint32_t rtx_count;                 // 연속 재전송 횟수
+    uint32_t rtx_armed;                 // 타이머가 소켓 참조 하나를 가짐
+    uint64_t rtx_deadline;              // 이 tick 전에 만료되면 남은 시간만큼 다시 건다
+
+    // LISTEN: 연결이 완료되어 accept를 기다리는 자식, 아직 핸드셰이크 중인 자식 수
+    struct sock* accept_head;
+    struct sock* accept_tail;
+    uint32_t accept_count;
+    uint32_t syn_count;
+    uint32_t backlog;
+    struct sock* parent;                // SYN_RCVD/accept 대기 중인 자식의 listener
+    struct sock* accept_next;
+
+    uint32_t segs_out;
+    uint32_t segs_in;
+    uint32_t retransmits;
+} tcp_pcb_t;
+
+typedef struct sock {
+    delayed_work_t rtx_work;            // 첫 멤버 (work 콜백에서 sock으로 캐스팅)
+
+    int type;
+    volatile uint32_t refcount;
+    uint32_t user_closed;
+    int err;                            // 비동기 오류 (-ECONNRESET 등), 0이면 없음
+
+    uint32_t local_ip;                  // 호스트 순서
+    uint16_t local_port;
+    uint16_t remote_port;
+    uint32_t remote_ip;
+
+    // 수신 큐 (payload만 남은 pbuf)
+    pbuf_t* rx_head;
+    pbuf_t* rx_tail;
+    uint32_t rx_bytes;
+    uint32_t rcvbuf;
+    uint32_t rx_drops;
+
+    wait_queue_t rx_wait;               // recv / accept
+    wait_queue_t tx_wait;               // send 공간 / connect 완료
+
+    struct sock* next;                  // 프로토콜별 소켓 테이블
+
+    tcp_pcb_t tcp;
+} sock_t;
+
+// 성공 시 새 소켓 (refcount 1), type이 잘못되면 0
+sock_t* sock_create(int type);
+
+// 0이면 임시 포트. 성공 0, 실패 -errno
+int sock_bind(sock_t* s, uint16_t port);
+
+int sock_listen(sock_t* s, uint32_t backlog);
+
+// 완료된 연결이 올 때까지 대기. 실패 시 0 (*err에 -errno)
+sock_t* sock_accept(sock_t* s, int* err);
+
+// 3-way handshake 완료까지 대기. 성공 0
+int sock_connect(sock_t* s, uint32_t ip, uint16_t port);
+
+// 보낸/받은 바이트 수 또는 -errno. recv가 0이면 상대가 닫음
+int32_t sock_send(sock_t* s, const void* buf, uint32_t len);
+int32_t sock_recv(sock_t* s, void* buf, uint32_t len);
+
+// 물리 페이지 [off, off+len)을 복사 없이 송신 버퍼에 (pmm 참조 +1, TCP 전용)
+int32_t sock_send_page(sock_t* s, uint32_t phys, uint32_t off, uint32_t len);
+
+int32_t sock_sendto(sock_t* s, const void* buf, uint32_t len, uint32_t ip, uint16_t port);
+int32_t sock_recvfrom(sock_t* s, void* buf, uint32_t len, uint32_t* ip, uint16_t* port);
+
+// TCP는 FIN을 보내고 종료 절차를 계속 진행 (메모리는 절차가 끝나면 해제)
+void sock_close(sock_t* s);
+
+struct file;
+
+// 소켓을 file_t로 감싼다 (read/write = recv/send, write_page = sock_send_page로 splice 대상).
+// 사용자 참조를 파일이 가져가고 마지막 file_put에서 sock_close
+struct file* sock_file_open(sock_t* s);
+
+// ---- 프로토콜 구현용 (net lock 보유) ----
+sock_t* sock_alloc(int type);
+void sock_get(sock_t* s);
+void sock_put(sock_t* s);
+
+// 수신 큐에 pbuf 추가 후 대기자 깨움
+void sock_queue_rx(sock_t* s, pbuf_t* p);
+
+// 수신 큐에서 최대 len 바이트 복사 (stream: 여러 pbuf에 걸쳐, dgram: 한 개만)
+uint32_t sock_dequeue_rx(sock_t* s, void* buf, uint32_t len, int stream);
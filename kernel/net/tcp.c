@@ -0,0 +1,889 @@
+#include "tcp.h"
+#include "net.h"
+#include "ip.h"
+#include "socket.h"
+#include "checksum.h"
+#include "../memory/pmm.h"
+#include "../time/time.h"
+#include "../lib/errno.h"
+#include "../lib/string.h"
+
+#define TCP_MSS_MAX 4096                // 페이지 하나 = 세그먼트 하나 (pbuf frag 1개)
+
+static sock_t* g_tcp_socks = 0;         // LISTEN + 연결 (lookup은 선형: loopback 소켓 수가 적음)
+static uint16_t g_next_port = SOCK_EPHEMERAL_BASE;
+static uint32_t g_iss = 0x1000;
+static tcp_stats_t g_stats;
+
+static inline int seq_lt(uint32_t a, uint32_t b) { return (int32_t)(a - b) < 0; }
+static inline int seq_leq(uint32_t a, uint32_t b) { return (int32_t)(a - b) <= 0; }
+
+static const char* g_state_names[] = {
+    "CLOSED", "LISTEN", "SYN_SENT", "SYN_RCVD", "ESTABLISHED",
+    "FIN_WAIT_1", "FIN_WAIT_2", "CLOSING", "CLOSE_WAIT", "LAST_ACK",
+};
+
+const char* tcp_state_name(int state) {
+    if (state < 0 || state > TCP_LAST_ACK) return "?";
+    return g_state_names[state];
+}
+
+static uint32_t initial_rto(void) {
+    uint32_t rto = time_get_hz() / 5;
+    return rto ? rto : 1;
+}
+
+static uint32_t new_iss(void) {
+    g_iss += 64000 + (uint32_t)timer_ticks();
+    return g_iss;
+}
+
+// -------------------------
+// 소켓 테이블
+// -------------------------
+
+static sock_t* port_user(uint16_t port) {
+    for (sock_t* s = g_tcp_socks; s; s = s->next) {
+        if (s->local_port == port) return s;
+    }
+    return 0;
+}
+
+static void hash_sock(sock_t* s) {
+    s->next = g_tcp_socks;
+    g_tcp_socks = s;
+    sock_get(s);
+}
+
+static void unhash_sock(sock_t* s) {
+    for (sock_t** pp = &g_tcp_socks; *pp; pp = &(*pp)->next) {
+        if (*pp == s) {
+            *pp = s->next;
+            s->next = 0;
+            sock_put(s);
+            return;
+        }
+    }
+}
+
+// 연결 4-tuple 일치 우선, 없으면 같은 포트의 listener
+static sock_t* lookup(uint32_t src, uint16_t sport, uint32_t dst, uint16_t dport) {
+    sock_t* listener = 0;
+    for (sock_t* s = g_tcp_socks; s; s = s->next) {
+        if (s->local_port != dport) continue;
+        if (s->tcp.state == TCP_LISTEN) {
+            listener = s;
+            continue;
+        }
+        if (s->remote_port == sport && s->remote_ip == src && s->local_ip == dst) return s;
+    }
+    return listener;
+}
+
+int tcp_bind(sock_t* s, uint16_t port) {
+    if (s->local_port) return -EINVAL;
+
+    if (port == 0) {
+        for (uint32_t tries = 0; tries < 65536 - SOCK_EPHEMERAL_BASE; tries++) {
+            uint16_t cand = g_next_port++;
+            if (g_next_port == 0) g_next_port = SOCK_EPHEMERAL_BASE;
+            if (!port_user(cand)) {
+                port = cand;
+                break;
+            }
+        }
+        if (port == 0) return -EADDRINUSE;
+    } else if (port_user(port)) {
+        return -EADDRINUSE;
+    }
+
+    s->local_port = port;
+    hash_sock(s);
+    return 0;
+}
+
+// -------------------------
+// 송신
+// -------------------------
+
+static uint32_t rcv_window(const sock_t* s) {
+    uint32_t w = s->rx_bytes < s->rcvbuf ? s->rcvbuf - s->rx_bytes : 0;
+    return w > 0xFFFF ? 0xFFFF : w;
+}
+
+static void fill_hdr(tcp_hdr_t* th, uint16_t sport, uint16_t dport, uint32_t seq, uint32_t ack,
+                     uint8_t flags, uint16_t wnd) {
+    th->sport = htons(sport);
+    th->dport = htons(dport);
+    th->seq = htonl(seq);
+    th->ack = htonl(ack);
+    th->off = (TCP_HDR_LEN / 4) << 4;
+    th->flags = flags;
+    th->wnd = htons(wnd);
+    th->csum = 0;
+    th->urg = 0;
+}
+
+// 헤더만 선형 영역에, payload는 송신 버퍼 페이지를 참조로 붙인다 (복사 없음)
+static int send_segment(sock_t* s, uint32_t seq, uint8_t flags, uint32_t page, uint32_t off, uint32_t len) {
+    pbuf_t* p = pbuf_alloc(0);
+    if (!p) return -ENOMEM;
+
+    tcp_hdr_t* th = (tcp_hdr_t*)pbuf_push(p, TCP_HDR_LEN);
+    uint16_t wnd = (uint16_t)rcv_window(s);
+    uint32_t ack = (flags & TCP_ACK) ? s->tcp.rcv_nxt : 0;
+    fill_hdr(th, s->local_port, s->remote_port, seq, ack, flags, wnd);
+    if (len) pbuf_attach_page(p, page, off, len);
+
+    uint16_t seglen = (uint16_t)(TCP_HDR_LEN + len);
+    th->csum = csum_fold(csum_pbuf(p, 0, csum_pseudo(s->local_ip, s->remote_ip, IPPROTO_TCP, seglen)));
+
+    if (flags & TCP_ACK) s->tcp.rcv_adv = wnd;
+    s->tcp.segs_out++;
+    g_stats.segs_out++;
+    return ip_output(p, s->local_ip, s->remote_ip, IPPROTO_TCP);
+}
+
+static void send_ack(sock_t* s) {
+    send_segment(s, s->tcp.snd_nxt, TCP_ACK, 0, 0, 0);
+}
+
+// 소켓이 없는 세그먼트에 대한 RST (RFC 793 3.4)
+static void send_reset(uint32_t src, uint16_t sport, uint32_t dst, uint16_t dport,
+                       uint32_t seq, uint32_t ack, uint8_t flags) {
+    pbuf_t* p = pbuf_alloc(0);
+    if (!p) return;
+
+    tcp_hdr_t* th = (tcp_hdr_t*)pbuf_push(p, TCP_HDR_LEN);
+    fill_hdr(th, sport, dport, seq, ack, flags, 0);
+    th->csum = csum_fold(csum_partial(th, TCP_HDR_LEN, csum_pseudo(src, dst, IPPROTO_TCP, TCP_HDR_LEN)));
+
+    g_stats.resets_sent++;
+    g_stats.segs_out++;
+    ip_output(p, src, dst, IPPROTO_TCP);
+}
+
+// 재전송 타이머: 이미 걸려 있으면 만료 시각만 미룬다 (ACK마다 cancel/재등록하지 않음)
+static void rtx_arm(sock_t* s) {
+    tcp_pcb_t* tp = &s->tcp;
+    tp->rtx_deadline = timer_ticks() + tp->rto;
+    if (tp->rtx_armed) return;
+    tp->rtx_armed = 1;
+    sock_get(s);
+    queue_delayed_work(system_wq, &s->rtx_work, tp->rto);
+}
+
+static void rtx_disarm(sock_t* s) {
+    if (s->tcp.rtx_armed && cancel_delayed_work(&s->rtx_work)) {
+        s->tcp.rtx_armed = 0;
+        sock_put(s);
+    }
+    // 이미 worker로 넘어갔으면 콜백이 할 일이 없음을 보고 참조를 놓는다
+}
+
+// 송신 버퍼에서 snd_una 기준 off 위치의 조각
+static tcp_chunk_t* chunk_at(tcp_pcb_t* tp, uint32_t off, uint32_t* in_chunk) {
+    for (uint32_t i = tp->snd_tail; i != tp->snd_head; i++) {
+        tcp_chunk_t* c = &tp->snd[i & (TCP_SND_CHUNKS - 1)];
+        if (off < c->len) {
+            *in_chunk = off;
+            return c;
+        }
+        off -= c->len;
+    }
+    return 0;
+}
+
+static int has_outstanding(const tcp_pcb_t* tp) {
+    if (tp->state == TCP_SYN_SENT || tp->state == TCP_SYN_RCVD) return 1;
+    // 미확인/미전송 데이터 (0 윈도 probe, 풀 고갈로 못 보낸 세그먼트 포함)
+    if (tp->snd_nxt != tp->snd_una || tp->snd_bytes) return 1;
+    return tp->fin_queued && (!tp->fin_sent || seq_leq(tp->snd_una, tp->fin_seq));
+}
+
+// 윈도가 허락하는 만큼 보내고, 데이터를 다 보냈고 닫는 중이면 FIN
+// probe: 0 윈도라도 1바이트를 밀어 넣어 상대의 윈도 갱신을 받아낸다
+static void tcp_output(sock_t* s, int probe) {
+    tcp_pcb_t* tp = &s->tcp;
+    if (tp->state < TCP_ESTABLISHED) return;
+
+    for (;;) {
+        uint32_t in_flight = tp->snd_nxt - tp->snd_una;
+        if (in_flight >= tp->snd_bytes) break;
+
+        uint32_t win = tp->snd_wnd > in_flight ? tp->snd_wnd - in_flight : 0;
+        if (win == 0) {
+            if (!probe || in_flight) break;
+            win = 1;
+        }
+        probe = 0;
+
+        uint32_t coff;
+        tcp_chunk_t* c = chunk_at(tp, in_flight, &coff);
+        uint32_t n = c->len - coff;
+        if (n > tp->mss) n = tp->mss;
+        if (n > win) n = win;
+
+        if (send_segment(s, tp->snd_nxt, TCP_ACK | TCP_PSH, c->page, c->off + coff, n) < 0) break;
+        tp->snd_nxt += n;
+    }
+
+    if (tp->fin_queued && tp->snd_nxt - tp->snd_una == tp->snd_bytes) {
+        if (!tp->fin_sent) {
+            tp->fin_sent = 1;
+            tp->fin_seq = tp->snd_nxt;
+            if (tp->state == TCP_ESTABLISHED) tp->state = TCP_FIN_WAIT_1;
+            else if (tp->state == TCP_CLOSE_WAIT) tp->state = TCP_LAST_ACK;
+        }
+        if (tp->snd_nxt == tp->fin_seq && send_segment(s, tp->fin_seq, TCP_ACK | TCP_FIN, 0, 0, 0) == 0) {
+            tp->snd_nxt++;
+        }
+    }
+
+    if (seq_lt(tp->snd_max, tp->snd_nxt)) tp->snd_max = tp->snd_nxt;
+    if (has_outstanding(tp)) rtx_arm(s);
+}
+
+// -------------------------
+// 연결 종료
+// -------------------------
+
+static void free_rx_queue(sock_t* s) {
+    while (s->rx_head) {
+        pbuf_t* p = s->rx_head;
+        s->rx_head = p->next;
+        pbuf_free(p);
+    }
+    s->rx_tail = 0;
+    s->rx_bytes = 0;
+}
+
+// 핸드셰이크 중이던 자식을 listener에서 떼어냄 (자식의 "미래 사용자" 참조도 놓음)
+static void detach_embryo(sock_t* s) {
+    sock_t* parent = s->tcp.parent;
+    s->tcp.parent = 0;
+    parent->tcp.syn_count--;
+    sock_put(parent);
+    sock_put(s);
+}
+
+// CLOSED로: 타이머/테이블 참조를 놓고 대기자를 깨움 (메모리는 마지막 참조에서 해제)
+static void tcp_done(sock_t* s) {
+    tcp_pcb_t* tp = &s->tcp;
+    int was_embryo = tp->state == TCP_SYN_RCVD && tp->parent;
+
+    tp->state = TCP_CLOSED;
+    wake_up_all(&s->rx_wait);
+    wake_up_all(&s->tx_wait);
+    rtx_disarm(s);
+    unhash_sock(s);
+    if (was_embryo) detach_embryo(s);
+}
+
+static void tcp_abort(sock_t* s, int err) {
+    s->err = err;
+    tcp_done(s);
+}
+
+static void reset_conn(sock_t* s) {
+    send_segment(s, s->tcp.snd_nxt, TCP_RST | TCP_ACK, 0, 0, 0);
+    g_stats.resets_sent++;
+}
+
+// -------------------------
+// 재전송 (go-back-N)
+// -------------------------
+
+static void tcp_rtx_work(work_t* w) {
+    sock_t* s = (sock_t*)w;
+    tcp_pcb_t* tp = &s->tcp;
+
+    net_lock();
+    tp->rtx_armed = 0;
+
+    if (tp->state == TCP_CLOSED || tp->state == TCP_LISTEN || !has_outstanding(tp)) goto out;
+
+    // ACK로 만료 시각이 밀렸으면 남은 시간만큼 다시 건다 (참조는 그대로 넘김)
+    uint64_t now = timer_ticks();
+    if (now < tp->rtx_deadline) {
+        tp->rtx_armed = 1;
+        queue_delayed_work(system_wq, &s->rtx_work, (uint32_t)(tp->rtx_deadline - now));
+        net_unlock();
+        return;
+    }
+
+    if (++tp->rtx_count > TCP_MAX_RETRIES) {
+        reset_conn(s);
+        tcp_abort(s, -ETIMEDOUT);
+        goto out;
+    }
+
+    uint32_t max_rto = time_get_hz() * 4;
+    tp->rto = tp->rto * 2 > max_rto ? max_rto : tp->rto * 2;
+    tp->retransmits++;
+    g_stats.retransmits++;
+
+    if (tp->state == TCP_SYN_SENT) {
+        send_segment(s, tp->iss, TCP_SYN, 0, 0, 0);
+        rtx_arm(s);
+    } else if (tp->state == TCP_SYN_RCVD) {
+        send_segment(s, tp->iss, TCP_SYN | TCP_ACK, 0, 0, 0);
+        rtx_arm(s);
+    } else {
+        // 손실 위치를 모르므로 snd_una부터 다시 (loopback에서는 풀/backlog 고갈 때만 잃는다)
+        tp->snd_nxt = tp->snd_una;
+        tcp_output(s, tp->snd_wnd == 0);
+    }
+
+out:
+    sock_put(s);
+    net_unlock();
+}
+
+void tcp_sock_init(sock_t* s) {
+    delayed_work_init(&s->rtx_work, tcp_rtx_work);
+    s->tcp.rto = initial_rto();
+}
+
+// -------------------------
+// 수신
+// -------------------------
+
+// 새로 확인된 len 바이트만큼 송신 버퍼 앞부분 반환
+static void snd_consume(tcp_pcb_t* tp, uint32_t len) {
+    tp->snd_bytes -= len;
+    while (len) {
+        tcp_chunk_t* c = &tp->snd[tp->snd_tail & (TCP_SND_CHUNKS - 1)];
+        uint32_t k = len < c->len ? len : c->len;
+        c->off += k;
+        c->len -= k;
+        len -= k;
+        if (c->len == 0) {
+            pmm_unref(c->page);
+            tp->snd_tail++;
+        }
+    }
+}
+
+// 3-way handshake가 끝난 자식을 listener의 accept 큐로
+static void embryo_established(sock_t* s) {
+    sock_t* parent = s->tcp.parent;
+    if (parent->tcp.state != TCP_LISTEN) {
+        // listener가 그새 닫힘
+        reset_conn(s);
+        tcp_done(s);
+        detach_embryo(s);
+        return;
+    }
+
+    parent->tcp.syn_count--;
+    s->tcp.accept_next = 0;
+    if (parent->tcp.accept_tail) parent->tcp.accept_tail->tcp.accept_next = s;
+    else parent->tcp.accept_head = s;
+    parent->tcp.accept_tail = s;
+    parent->tcp.accept_count++;
+    wake_up_one(&parent->rx_wait);
+}
+
+static void listen_input(sock_t* ls, tcp_hdr_t* th, uint32_t src, uint32_t dst) {
+    uint32_t seq = ntohl(th->seq);
+    uint8_t flags = th->flags;
+
+    if (flags & TCP_RST) return;
+    if (flags & TCP_ACK) {
+        send_reset(dst, ntohs(th->dport), src, ntohs(th->sport), ntohl(th->ack), 0, TCP_RST);
+        return;
+    }
+    if (!(flags & TCP_SYN)) return;
+    if (ls->tcp.syn_count + ls->tcp.accept_count >= ls->tcp.backlog) return;
+
+    sock_t* c = sock_alloc(SOCK_STREAM);
+    if (!c) return;
+    tcp_sock_init(c);
+
+    tcp_pcb_t* tp = &c->tcp;
+    c->local_ip = dst;
+    c->local_port = ls->local_port;
+    c->remote_ip = src;
+    c->remote_port = ntohs(th->sport);
+    tp->irs = seq;
+    tp->rcv_nxt = seq + 1;
+    tp->iss = new_iss();
+    tp->snd_una = tp->iss;
+    tp->snd_nxt = tp->iss + 1;
+    tp->snd_max = tp->snd_nxt;
+    tp->snd_wnd = ntohs(th->wnd);
+    tp->mss = ls->tcp.mss;
+    tp->rto = initial_rto();
+    tp->state = TCP_SYN_RCVD;
+    tp->parent = ls;
+    sock_get(ls);
+    ls->tcp.syn_count++;
+    hash_sock(c);
+
+    g_stats.passive_opens++;
+    send_segment(c, tp->iss, TCP_SYN | TCP_ACK, 0, 0, 0);
+    rtx_arm(c);
+}
+
+static void syn_sent_input(sock_t* s, tcp_hdr_t* th) {
+    tcp_pcb_t* tp = &s->tcp;
+    uint8_t flags = th->flags;
+    uint32_t ack = ntohl(th->ack);
+
+    if ((flags & TCP_ACK) && ack != tp->iss + 1) {
+        if (!(flags & TCP_RST)) {
+            send_reset(s->local_ip, s->local_port, s->remote_ip, s->remote_port, ack, 0, TCP_RST);
+        }
+        return;
+    }
+    if (flags & TCP_RST) {
+        if (flags & TCP_ACK) tcp_abort(s, -ECONNREFUSED);
+        return;
+    }
+    // 동시 open은 지원하지 않음
+    if (!(flags & TCP_SYN) || !(flags & TCP_ACK)) return;
+
+    tp->irs = ntohl(th->seq);
+    tp->rcv_nxt = tp->irs + 1;
+    tp->snd_una = ack;
+    tp->snd_wnd = ntohs(th->wnd);
+    tp->rtx_count = 0;
+    tp->rto = initial_rto();
+    tp->state = TCP_ESTABLISHED;
+    rtx_disarm(s);
+    send_ack(s);
+    wake_up_all(&s->tx_wait);
+}
+
+// ACK 처리. 세그먼트를 계속 처리하면 1
+static int ack_input(sock_t* s, uint32_t ack, uint16_t wnd) {
+    tcp_pcb_t* tp = &s->tcp;
+
+    if (tp->state == TCP_SYN_RCVD) {
+        if (ack != tp->iss + 1) {
+            send_reset(s->local_ip, s->local_port, s->remote_ip, s->remote_port, ack, 0, TCP_RST);
+            return 0;
+        }
+        tp->snd_una = ack;
+        tp->snd_wnd = wnd;
+        tp->rtx_count = 0;
+        tp->rto = initial_rto();
+        tp->state = TCP_ESTABLISHED;
+        rtx_disarm(s);
+        embryo_established(s);
+        return tp->state != TCP_CLOSED;
+    }
+
+    if (seq_lt(tp->snd_max, ack)) {
+        // 보낸 적 없는 seq에 대한 ACK
+        send_ack(s);
+        return 0;
+    }
+
+    if (seq_lt(tp->snd_una, ack)) {
+        uint32_t acked = ack - tp->snd_una;
+        int fin_acked = tp->fin_sent && seq_lt(tp->fin_seq, ack);
+        uint32_t data = acked - (fin_acked ? 1 : 0);
+        if (data > tp->snd_bytes) data = tp->snd_bytes;
+
+        snd_consume(tp, data);
+        tp->snd_una = ack;
+        if (seq_lt(tp->snd_nxt, ack)) tp->snd_nxt = ack;
+        tp->rtx_count = 0;
+        tp->rto = initial_rto();
+        wake_up_all(&s->tx_wait);
+
+        if (fin_acked) {
+            if (tp->state == TCP_FIN_WAIT_1) {
+                tp->state = TCP_FIN_WAIT_2;
+            } else if (tp->state == TCP_CLOSING || tp->state == TCP_LAST_ACK) {
+                // TIME_WAIT 생략 (loopback: 지연된 중복 세그먼트가 없음)
+                tcp_done(s);
+                return 0;
+            }
+        }
+
+        if (has_outstanding(tp)) rtx_arm(s);
+        else rtx_disarm(s);
+    }
+
+    if (seq_leq(tp->snd_una, ack)) tp->snd_wnd = wnd;
+    return 1;
+}
+
+void tcp_input(pbuf_t* p, uint32_t src, uint32_t dst) {
+    sock_t* s = 0;
+    g_stats.segs_in++;
+    if (p->len < TCP_HDR_LEN) goto drop;
+
+    tcp_hdr_t* th = (tcp_hdr_t*)p->data;
+    uint32_t hlen = (uint32_t)(th->off >> 4) * 4;
+    uint32_t total = pbuf_total_len(p);
+    if (hlen < TCP_HDR_LEN || hlen > p->len) goto drop;
+
+    if (!(p->flags & PBUF_CSUM_VALID)) {
+        if (csum_fold(csum_pbuf(p, 0, csum_pseudo(src, dst, IPPROTO_TCP, (uint16_t)total))) != 0) {
+            g_stats.bad_csum++;
+            goto drop;
+        }
+    }
+
+    uint16_t sport = ntohs(th->sport);
+    uint16_t dport = ntohs(th->dport);
+    uint32_t seq = ntohl(th->seq);
+    uint32_t ack = ntohl(th->ack);
+    uint8_t flags = th->flags;
+    uint16_t wnd = ntohs(th->wnd);
+    uint32_t len = total - hlen;
+
+    s = lookup(src, sport, dst, dport);
+    if (!s) {
+        if (!(flags & TCP_RST)) {
+            if (flags & TCP_ACK) {
+                send_reset(dst, dport, src, sport, ack, 0, TCP_RST);
+            } else {
+                uint32_t seg = len + ((flags & TCP_SYN) ? 1 : 0) + ((flags & TCP_FIN) ? 1 : 0);
+                send_reset(dst, dport, src, sport, 0, seq + seg, TCP_RST | TCP_ACK);
+            }
+        }
+        goto drop;
+    }
+
+    // 처리 중 tcp_done이 테이블 참조를 놓아도 소켓이 살아 있도록
+    sock_get(s);
+    tcp_pcb_t* tp = &s->tcp;
+    tp->segs_in++;
+
+    if (tp->state == TCP_LISTEN) {
+        listen_input(s, th, src, dst);
+        goto drop;
+    }
+    if (tp->state == TCP_SYN_SENT) {
+        syn_sent_input(s, th);
+        goto drop;
+    }
+
+    pbuf_pull(p, hlen);
+
+    // 이미 받은 앞부분(go-back-N 재전송과 겹침)은 잘라냄
+    if (seq_lt(seq, tp->rcv_nxt)) {
+        uint32_t dup = tp->rcv_nxt - seq;
+        if (dup > len) dup = len;
+        pbuf_pull(p, dup);
+        seq += dup;
+        len -= dup;
+    }
+
+    if (flags & TCP_RST) {
+        if (seq == tp->rcv_nxt) {
+            if (tp->state == TCP_SYN_RCVD) tcp_done(s);
+            else tcp_abort(s, -ECONNRESET);
+        }
+        goto drop;
+    }
+
+    // 순서가 어긋난 세그먼트는 버리고 중복 ACK (재조립 큐 없음)
+    if (seq != tp->rcv_nxt && (len || (flags & TCP_FIN))) {
+        g_stats.ooo_drops++;
+        send_ack(s);
+        goto drop;
+    }
+
+    if (flags & TCP_SYN) {
+        // 동기화된 상태의 SYN: 재전송된 SYN-ACK에는 ACK로 답함
+        send_ack(s);
+        goto drop;
+    }
+    if (!(flags & TCP_ACK)) goto drop;
+    if (!ack_input(s, ack, wnd)) goto drop;
+
+    int need_ack = 0;
+    if (len) {
+        need_ack = 1;
+        if (tp->state != TCP_ESTABLISHED && tp->state != TCP_FIN_WAIT_1 && tp->state != TCP_FIN_WAIT_2) {
+            // 상대가 이미 FIN을 보낸 뒤의 데이터
+            goto drop;
+        }
+        if (s->user_closed) {
+            // 읽을 사람이 없음: 연결을 끊는다
+            reset_conn(s);
+            tcp_abort(s, -ECONNRESET);
+            goto drop;
+        }
+        if (s->rx_bytes + len > s->rcvbuf) {
+            // 윈도 초과 (0 윈도 probe 포함): 버리고 현재 윈도를 알려 줌
+            s->rx_drops++;
+            send_ack(s);
+            goto drop;
+        }
+        tp->rcv_nxt += len;
+        p->src_ip = src;
+        p->src_port = sport;
+        sock_queue_rx(s, p);
+        p = 0;
+    }
+
+    if ((flags & TCP_FIN) && !tp->fin_received) {
+        need_ack = 1;
+        tp->rcv_nxt++;
+        tp->fin_received = 1;
+        wake_up_all(&s->rx_wait);
+        switch (tp->state) {
+            case TCP_ESTABLISHED: tp->state = TCP_CLOSE_WAIT; break;
+            case TCP_FIN_WAIT_1: tp->state = TCP_CLOSING; break;
+            case TCP_FIN_WAIT_2:
+                send_ack(s);
+                tcp_done(s);
+                goto drop;
+        }
+    }
+
+    // 보낼 데이터가 있으면 ACK를 실어 보내고, 아무것도 안 나갔으면 순수 ACK
+    uint32_t before = tp->segs_out;
+    tcp_output(s, 0);
+    if (need_ack && tp->segs_out == before) send_ack(s);
+
+drop:
+    if (p) pbuf_free(p);
+    if (s) sock_put(s);
+}
+
+// -------------------------
+// 소켓 연산
+// -------------------------
+
+static uint16_t route_mss(uint32_t dst) {
+    uint32_t mtu = ip_route_mtu(dst);
+    uint32_t mss = mtu > IP_HDR_LEN + TCP_HDR_LEN ? mtu - IP_HDR_LEN - TCP_HDR_LEN : 536;
+    return (uint16_t)(mss > TCP_MSS_MAX ? TCP_MSS_MAX : mss);
+}
+
+int tcp_listen(sock_t* s, uint32_t backlog) {
+    if (s->tcp.state != TCP_CLOSED) return -EISCONN;
+    if (!s->local_port) return -EINVAL;
+
+    s->tcp.backlog = backlog ? backlog : 1;
+    s->tcp.mss = route_mss(IP4_LOOPBACK);
+    s->tcp.state = TCP_LISTEN;
+    return 0;
+}
+
+sock_t* tcp_accept(sock_t* s, int* err) {
+    while (!s->tcp.accept_head) {
+        if (s->tcp.state != TCP_LISTEN) {
+            *err = -EINVAL;
+            return 0;
+        }
+        net_wait(&s->rx_wait);
+    }
+
+    sock_t* c = s->tcp.accept_head;
+    s->tcp.accept_head = c->tcp.accept_next;
+    if (!s->tcp.accept_head) s->tcp.accept_tail = 0;
+    s->tcp.accept_count--;
+    c->tcp.accept_next = 0;
+    c->tcp.parent = 0;
+    sock_put(s);
+
+    *err = 0;
+    return c;                           // 자식의 첫 참조가 그대로 사용자 참조가 됨
+}
+
+int tcp_connect(sock_t* s, uint32_t ip, uint16_t port) {
+    tcp_pcb_t* tp = &s->tcp;
+    if (tp->state != TCP_CLOSED || s->remote_port) return -EISCONN;
+
+    uint32_t src = ip_route_src(ip);
+    if (!src) return -EINVAL;
+    if (!s->local_port) {
+        int r = tcp_bind(s, 0);
+        if (r < 0) return r;
+    }
+
+    s->local_ip = src;
+    s->remote_ip = ip;
+    s->remote_port = port;
+    tp->iss = new_iss();
+    tp->snd_una = tp->iss;
+    tp->snd_nxt = tp->iss + 1;
+    tp->snd_max = tp->snd_nxt;
+    tp->mss = route_mss(ip);
+    tp->rto = initial_rto();
+    tp->state = TCP_SYN_SENT;
+    g_stats.active_opens++;
+
+    send_segment(s, tp->iss, TCP_SYN, 0, 0, 0);
+    rtx_arm(s);
+
+    while (tp->state == TCP_SYN_SENT) net_wait(&s->tx_wait);
+
+    if (tp->state == TCP_CLOSED) return s->err ? s->err : -ECONNREFUSED;
+    return 0;
+}
+
+// 송신 가능 상태가 아니면 -errno
+static int send_state_error(sock_t* s) {
+    if (s->err) return s->err;
+    int st = s->tcp.state;
+    if (st == TCP_ESTABLISHED || st == TCP_CLOSE_WAIT) return 0;
+    if (st == TCP_CLOSED && !s->remote_port) return -ENOTCONN;
+    if (st == TCP_LISTEN || st == TCP_SYN_SENT) return -ENOTCONN;
+    return -EPIPE;
+}
+
+static int chunks_full(const tcp_pcb_t* tp) {
+    return tp->snd_head - tp->snd_tail >= TCP_SND_CHUNKS;
+}
+
+int32_t tcp_send(sock_t* s, const void* buf, uint32_t len) {
+    tcp_pcb_t* tp = &s->tcp;
+    const uint8_t* src = (const uint8_t*)buf;
+    uint32_t sent = 0;
+
+    while (sent < len) {
+        int e = send_state_error(s);
+        if (e) return sent ? (int32_t)sent : e;
+
+        uint32_t space = SOCK_SNDBUF > tp->snd_bytes ? SOCK_SNDBUF - tp->snd_bytes : 0;
+
+        // 마지막 조각 페이지에 남은 자리가 있으면 이어서 쓴다
+        tcp_chunk_t* c = 0;
+        if (tp->snd_head != tp->snd_tail) {
+            c = &tp->snd[(tp->snd_head - 1) & (TCP_SND_CHUNKS - 1)];
+            if (c->shared || c->off + c->len >= PAGE_SIZE) c = 0;
+        }
+        if (!c && space && !chunks_full(tp)) {
+            uint32_t page = pmm_alloc_frame();
+            if (!page) return sent ? (int32_t)sent : -ENOMEM;
+            c = &tp->snd[tp->snd_head & (TCP_SND_CHUNKS - 1)];
+            c->page = page;
+            c->off = 0;
+            c->len = 0;
+            c->shared = 0;
+            tp->snd_head++;
+        }
+        if (!c || !space) {
+            net_wait(&s->tx_wait);
+            continue;
+        }
+
+        uint32_t n = PAGE_SIZE - (c->off + c->len);
+        if (n > space) n = space;
+        if (n > len - sent) n = len - sent;
+        memcpy((uint8_t*)c->page + c->off + c->len, src + sent, n);
+        c->len += n;
+        tp->snd_bytes += n;
+        sent += n;
+
+        tcp_output(s, 0);
+    }
+    return (int32_t)sent;
+}
+
+int32_t tcp_send_page(sock_t* s, uint32_t phys, uint32_t off, uint32_t len) {
+    tcp_pcb_t* tp = &s->tcp;
+    if (len == 0) return 0;
+    if (off >= PAGE_SIZE || len > PAGE_SIZE - off) return -EINVAL;
+
+    for (;;) {
+        int e = send_state_error(s);
+        if (e) return e;
+        if (tp->snd_bytes < SOCK_SNDBUF && !chunks_full(tp)) break;
+        net_wait(&s->tx_wait);
+    }
+
+    pmm_ref(phys);
+    tcp_chunk_t* c = &tp->snd[tp->snd_head & (TCP_SND_CHUNKS - 1)];
+    c->page = PAGE_ALIGN_DOWN(phys);
+    c->off = (uint16_t)off;
+    c->len = (uint16_t)len;
+    c->shared = 1;
+    tp->snd_head++;
+    tp->snd_bytes += len;
+
+    tcp_output(s, 0);
+    return (int32_t)len;
+}
+
+int32_t tcp_recv(sock_t* s, void* buf, uint32_t len) {
+    tcp_pcb_t* tp = &s->tcp;
+
+    while (!s->rx_bytes) {
+        if (tp->fin_received) return 0;
+        if (s->err) return s->err;
+        if (tp->state == TCP_CLOSED || tp->state == TCP_LISTEN || tp->state == TCP_SYN_SENT) return -ENOTCONN;
+        net_wait(&s->rx_wait);
+    }
+
+    uint32_t n = sock_dequeue_rx(s, buf, len, 1);
+
+    // 윈도가 MSS 이상 열렸으면 바로 알려 준다 (상대가 0 윈도 probe를 기다리지 않게)
+    if (tp->state != TCP_CLOSED && rcv_window(s) >= tp->rcv_adv + tp->mss) send_ack(s);
+    return (int32_t)n;
+}
+
+void tcp_close(sock_t* s) {
+    tcp_pcb_t* tp = &s->tcp;
+
+    switch (tp->state) {
+        case TCP_LISTEN:
+            tp->state = TCP_CLOSED;
+            // 아직 accept되지 않은 연결은 RST로 끊는다
+            while (tp->accept_head) {
+                sock_t* c = tp->accept_head;
+                tp->accept_head = c->tcp.accept_next;
+                tp->accept_count--;
+                c->tcp.parent = 0;
+                sock_put(s);
+                if (c->tcp.state != TCP_CLOSED) {
+                    reset_conn(c);
+                    tcp_done(c);
+                }
+                sock_put(c);
+            }
+            tp->accept_tail = 0;
+            tcp_done(s);
+            break;
+
+        case TCP_CLOSED:
+            unhash_sock(s);
+            break;
+
+        case TCP_SYN_SENT:
+            tcp_done(s);
+            break;
+
+        case TCP_ESTABLISHED:
+        case TCP_CLOSE_WAIT:
+            if (s->rx_bytes) {
+                // 읽지 않은 데이터를 버리면 RST (RFC 2525)
+                reset_conn(s);
+                tcp_done(s);
+                break;
+            }
+            tp->fin_queued = 1;
+            tcp_output(s, 0);
+            break;
+
+        default:
+            break;
+    }
+    free_rx_queue(s);
+}
+
+void tcp_release(sock_t* s) {
+    tcp_pcb_t* tp = &s->tcp;
+    while (tp->snd_tail != tp->snd_head) {
+        pmm_unref(tp->snd[tp->snd_tail & (TCP_SND_CHUNKS - 1)].page);
+        tp->snd_tail++;
+    }
+}
+
+void tcp_get_stats(tcp_stats_t* out) {
+    *out = g_stats;
+}
+
+void tcp_for_each(void (*fn)(sock_t* s, void* arg), void* arg) {
+    for (sock_t* s = g_tcp_socks; s; s = s->next) fn(s, arg);
+}
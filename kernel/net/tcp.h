@@ -0,0 +1,67 @@
+#pragma once
+#include <stdint.h>
+#include "pbuf.h"
+
+// TCP (RFC 793 부분 구현)
+// - 순서대로 온 세그먼트만 받고, 순서가 어긋나면 버리고 중복 ACK (송신 측 go-back-N 재전송)
+// - 재전송 타이머는 소켓별 delayed work (RTO 지수 backoff), 0 윈도면 1바이트 probe
+// - 혼잡 제어, 옵션(MSS/윈도 스케일/SACK), TIME_WAIT은 없음 (loopback 전제)
+
+#define TCP_HDR_LEN 20
+
+#define TCP_FIN 0x01
+#define TCP_SYN 0x02
+#define TCP_RST 0x04
+#define TCP_PSH 0x08
+#define TCP_ACK 0x10
+
+#define TCP_MAX_RETRIES 8
+
+typedef struct tcp_hdr {
+    uint16_t sport;
+    uint16_t dport;
+    uint32_t seq;
+    uint32_t ack;
+    uint8_t off;                        // 상위 4비트: 헤더 길이 (4바이트 단위)
+    uint8_t flags;
+    uint16_t wnd;
+    uint16_t csum;
+    uint16_t urg;
+} __attribute__((packed)) tcp_hdr_t;
+
+struct sock;
+
+// IP 계층에서 호출 (net lock 보유, p 소유권을 가져감)
+void tcp_input(pbuf_t* p, uint32_t src, uint32_t dst);
+
+// ---- socket.c에서 호출 (net lock 보유, 대기가 필요하면 net_wait) ----
+void tcp_sock_init(struct sock* s);
+int tcp_bind(struct sock* s, uint16_t port);
+int tcp_listen(struct sock* s, uint32_t backlog);
+struct sock* tcp_accept(struct sock* s, int* err);
+int tcp_connect(struct sock* s, uint32_t ip, uint16_t port);
+int32_t tcp_send(struct sock* s, const void* buf, uint32_t len);
+int32_t tcp_send_page(struct sock* s, uint32_t phys, uint32_t off, uint32_t len);
+int32_t tcp_recv(struct sock* s, void* buf, uint32_t len);
+void tcp_close(struct sock* s);
+
+// 소켓 해제 직전: 송신 버퍼 페이지 반환
+void tcp_release(struct sock* s);
+
+const char* tcp_state_name(int state);
+
+typedef struct tcp_stats {
+    uint32_t active_opens;
+    uint32_t passive_opens;
+    uint32_t resets_sent;
+    uint32_t segs_in;
+    uint32_t segs_out;
+    uint32_t retransmits;
+    uint32_t bad_csum;
+    uint32_t ooo_drops;                 // 순서가 어긋나 버린 세그먼트
+} tcp_stats_t;
+
+void tcp_get_stats(tcp_stats_t* out);
+
+// 열린 TCP 소켓 순회 (procfs)
+void tcp_for_each(void (*fn)(struct sock* s, void* arg), void* arg);
@@ -0,0 +1,128 @@
+#include "udp.h"
+#include "net.h"
+#include "ip.h"
+#include "socket.h"
+#include "checksum.h"
+#include "../lib/errno.h"
+#include "../lib/string.h"
+
+static sock_t* g_udp_socks = 0;
+static uint16_t g_next_port = SOCK_EPHEMERAL_BASE;
+static uint32_t g_in_datagrams = 0;
+static uint32_t g_in_errors = 0;
+
+static sock_t* lookup(uint16_t port) {
+    for (sock_t* s = g_udp_socks; s; s = s->next) {
+        if (s->local_port == port) return s;
+    }
+    return 0;
+}
+
+int udp_bind(sock_t* s, uint16_t port) {
+    if (s->local_port) return -EINVAL;
+
+    if (port == 0) {
+        for (uint32_t tries = 0; tries < 65536 - SOCK_EPHEMERAL_BASE; tries++) {
+            uint16_t cand = g_next_port++;
+            if (g_next_port == 0) g_next_port = SOCK_EPHEMERAL_BASE;
+            if (!lookup(cand)) {
+                port = cand;
+                break;
+            }
+        }
+        if (port == 0) return -EADDRINUSE;
+    } else if (lookup(port)) {
+        return -EADDRINUSE;
+    }
+
+    s->local_port = port;
+    s->next = g_udp_socks;
+    g_udp_socks = s;
+    sock_get(s);                        // 테이블 참조
+    return 0;
+}
+
+void udp_unhash(sock_t* s) {
+    for (sock_t** pp = &g_udp_socks; *pp; pp = &(*pp)->next) {
+        if (*pp == s) {
+            *pp = s->next;
+            s->next = 0;
+            sock_put(s);
+            return;
+        }
+    }
+}
+
+// 데이터그램 하나 = pbuf 하나: 사용자 버퍼에서 pbuf로 한 번만 복사
+int32_t udp_sendto(sock_t* s, const void* buf, uint32_t len, uint32_t ip, uint16_t port) {
+    uint32_t mtu = ip_route_mtu(ip);
+    if (!mtu) return -EINVAL;
+    if (len + UDP_HDR_LEN + IP_HDR_LEN > mtu || len > PBUF_BUF_SIZE - PBUF_HEADROOM) return -EMSGSIZE;
+
+    if (!s->local_port) {
+        int r = udp_bind(s, 0);
+        if (r < 0) return r;
+    }
+
+    pbuf_t* p = pbuf_alloc(len);
+    if (!p) return -ENOMEM;
+    memcpy(p->data, buf, len);
+
+    udp_hdr_t* uh = (udp_hdr_t*)pbuf_push(p, UDP_HDR_LEN);
+    uint16_t ulen = (uint16_t)(len + UDP_HDR_LEN);
+    uint32_t src = ip_route_src(ip);
+    uh->sport = htons(s->local_port);
+    uh->dport = htons(port);
+    uh->len = htons(ulen);
+    uh->csum = 0;
+    uint16_t c = csum_fold(csum_partial(uh, ulen, csum_pseudo(src, ip, IPPROTO_UDP, ulen)));
+    uh->csum = c ? c : 0xFFFF;          // 0은 "checksum 없음"
+
+    int r = ip_output(p, src, ip, IPPROTO_UDP);
+    return r < 0 ? r : (int32_t)len;
+}
+
+void udp_input(pbuf_t* p, uint32_t src, uint32_t dst) {
+    if (p->len < UDP_HDR_LEN) goto bad;
+
+    udp_hdr_t* uh = (udp_hdr_t*)p->data;
+    uint32_t ulen = ntohs(uh->len);
+    if (ulen < UDP_HDR_LEN || ulen > pbuf_total_len(p)) goto bad;
+    pbuf_trim(p, ulen);
+
+    if (uh->csum && !(p->flags & PBUF_CSUM_VALID)) {
+        if (csum_fold(csum_pbuf(p, 0, csum_pseudo(src, dst, IPPROTO_UDP, (uint16_t)ulen))) != 0) goto bad;
+    }
+
+    sock_t* s = lookup(ntohs(uh->dport));
+    if (!s || s->user_closed) {
+        g_in_errors++;
+        pbuf_free(p);
+        return;
+    }
+
+    p->src_ip = src;
+    p->src_port = ntohs(uh->sport);
+    pbuf_pull(p, UDP_HDR_LEN);
+
+    if (s->rx_bytes + pbuf_total_len(p) > s->rcvbuf) {
+        s->rx_drops++;
+        pbuf_free(p);
+        return;
+    }
+    g_in_datagrams++;
+    sock_queue_rx(s, p);
+    return;
+
+bad:
+    g_in_errors++;
+    pbuf_free(p);
+}
+
+uint32_t udp_in_datagrams(void) {
+    return g_in_datagrams;
+}
+
+uint32_t udp_in_errors(void) {
+    return g_in_errors;
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <stdint.h>
+#include "pbuf.h"
+
+#define UDP_HDR_LEN 8
+
+typedef struct udp_hdr {
+    uint16_t sport;
+    uint16_t dport;
+    uint16_t len;
+    uint16_t csum;
+} __attribute__((packed)) udp_hdr_t;
+
+struct sock;
+
+// IP 계층에서 호출 (net lock 보유, p 소유권을 가져감)
+void udp_input(pbuf_t* p, uint32_t src, uint32_t dst);
+
+// ---- socket.c에서 호출 (net lock 보유) ----
+int udp_bind(struct sock* s, uint16_t port);
+int32_t udp_sendto(struct sock* s, const void* buf, uint32_t len, uint32_t ip, uint16_t port);
+void udp_unhash(struct sock* s);
+
+uint32_t udp_in_datagrams(void);
+uint32_t udp_in_errors(void);
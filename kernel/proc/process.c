@@ -0,0 +1,115 @@
+#include "process.h"
+#include "../memory/heap.h"
+#include "../loader/elf.h"
+#include "../time/vdso.h"
+#include "../io/uring.h"
+#include "../console/kprintf.h"
+
+static process_t* g_procs = 0;
+static process_t* g_current = 0;
+static uint32_t g_next_pid = 1;
+
+static void copy_name(char* dst, const char* src) {
+    uint32_t i = 0;
+    if (src) {
+        for (; src[i] && i < PROC_NAME_LEN - 1; i++) dst[i] = src[i];
+    }
+    dst[i] = 0;
+}
+
+static process_t* process_alloc(const char* name, vm_space_t* vm) {
+    process_t* p = (process_t*)kmalloc(sizeof(process_t));
+    p->pid = g_next_pid++;
+    copy_name(p->name, name);
+    p->vm = vm;
+    p->entry = 0;
+    p->user_stack = 0;
+    p->parent = 0;
+
+    p->next = g_procs;
+    g_procs = p;
+    return p;
+}
+
+void process_init(void) {
+    g_procs = 0;
+    g_current = 0;
+    g_next_pid = 1;
+}
+
+process_t* process_create_elf(const char* name, const uint8_t* image, uint32_t size) {
+    vm_space_t* vm = vm_space_create();
+    uint32_t entry = 0;
+
+    if (!elf_load(vm, image, size, &entry)) {
+        vm_space_destroy(vm);
+        return 0;
+    }
+
+    // 스택은 영역만 등록: 읽기는 zero page, 쓰기 시 프레임 할당
+    if (!vm_map_area(vm, USER_STACK_TOP - USER_STACK_SIZE, USER_STACK_TOP,
+                     VMA_READ | VMA_WRITE, 0, 0, 0)) {
+        kprintf("[PROC] %s: stack overlaps a segment\n", name);
+        vm_space_destroy(vm);
+        return 0;
+    }
+
+    // 시간 페이지는 읽기 전용 공유 매핑 (fork하면 그대로 상속)
+    if (!vdso_map(vm)) {
+        kprintf("[PROC] %s: vdso page overlaps a segment\n", name);
+        vm_space_destroy(vm);
+        return 0;
+    }
+
+    process_t* p = process_alloc(name, vm);
+    p->entry = entry;
+    p->user_stack = USER_STACK_TOP;
+    return p;
+}
+
+process_t* process_fork(process_t* parent) {
+    process_t* child = process_alloc(parent->name, vm_space_fork(parent->vm));
+    child->entry = parent->entry;
+    child->user_stack = parent->user_stack;
+    child->parent = parent;
+    return child;
+}
+
+void process_destroy(process_t* p) {
+    if (p == g_current) process_switch(0);
+
+    for (process_t** link = &g_procs; *link; link = &(*link)->next) {
+        if (*link == p) {
+            *link = p->next;
+            break;
+        }
+    }
+
+    // 고아가 된 자식은 부모 연결만 끊음
+    for (process_t* c = g_procs; c; c = c->next) {
+        if (c->parent == p) c->parent = 0;
+    }
+
+    // 링은 ring->vs로 이 주소 공간을 가리키고 SQPOLL 스레드가 계속 읽으므로 먼저 정리
+    io_uring_exit(p);
+    vm_space_destroy(p->vm);
+    kfree(p);
+}
+
+process_t* process_current(void) {
+    return g_current;
+}
+
+void process_switch(process_t* p) {
+    g_current = p;
+    vm_space_activate(p ? p->vm : vm_kernel_space());
+}
+
+void process_dump(void) {
+    kprintf("[PROC] pid  ppid name             resident cow\n");
+    for (process_t* p = g_procs; p; p = p->next) {
+        kprintf("  %u    %u    %s  %u  %u\n",
+            p->pid, p->parent ? p->parent->pid : 0, p->name,
+            p->vm->resident_pages, p->vm->cow_copies);
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <stdint.h>
+#include "../memory/vma.h"
+
+#define PROC_NAME_LEN 16
+
+// 유저 스택 (anonymous, zero page 기반 lazy 할당)
+#define USER_STACK_TOP  USER_SPACE_END
+#define USER_STACK_SIZE (64u * 1024)
+
+typedef struct process {
+    uint32_t pid;
+    char name[PROC_NAME_LEN];
+
+    vm_space_t* vm;         // 프로세스별 page directory + VMA
+    uint32_t entry;         // 유저 진입점
+    uint32_t user_stack;    // 초기 유저 esp
+
+    struct process* parent;
+    struct process* next;   // 전체 프로세스 리스트
+} process_t;
+
+void process_init(void);
+
+// ELF 이미지로 새 프로세스 생성 (세그먼트는 demand paging). 실패 시 0
+process_t* process_create_elf(const char* name, const uint8_t* image, uint32_t size);
+
+// 주소 공간을 COW로 공유하는 자식 생성
+process_t* process_fork(process_t* parent);
+
+// 주소 공간 반환 후 리스트에서 제거
+void process_destroy(process_t* p);
+
+// 현재 프로세스 (커널 컨텍스트면 0)
+process_t* process_current(void);
+
+// 주소 공간 전환 (0이면 커널 주소 공간)
+void process_switch(process_t* p);
+
+void process_dump(void);
@@ -0,0 +1,345 @@
+#include "cputime.h"
+#include "thread.h"
+#include "workqueue.h"
+#include "../sync/mutex.h"
+#include "../lib/div64.h"
+#include "../lib/string.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/tsc.h"
+#include "../../arch/x86/cpu/smp.h"
+#include "../../arch/x86/cpu/irqflags.h"
+
+#define TOP_MAX_ROWS    64
+#define TOP_MAX_VECTORS 8
+
+typedef struct cpu_acct {
+    uint64_t t[CPUTIME_NR];
+    uint64_t last;              // 마지막 계정 시점 (TSC)
+    uint32_t switches;
+    uint32_t irqs;
+    int idle_wait;
+
+    // 지난 보고 시점 값
+    uint64_t report_tsc;
+    uint64_t report_t[CPUTIME_NR];
+    uint32_t report_switches;
+    uint32_t report_irqs;
+} cpu_acct_t;
+
+static cpu_acct_t g_cpu[MAX_CPUS];
+static int g_ready = 0;
+
+// 벡터별 IRQ 횟수/시간 (IRQ storm 확인용)
+static uint32_t g_vec_count[256];
+static uint32_t g_vec_report_count[256];
+static uint64_t g_vec_cycles[256];
+
+// cputime_top 직렬화 (TTY 명령과 주기 보고)
+static mutex_t g_top_lock;
+
+static delayed_work_t g_report_work;
+static uint32_t g_report_period = 0;
+
+static const char* const g_cat_name[CPUTIME_NR] = { "usr", "sys", "irq", "sirq", "idle" };
+
+void cputime_init(void) {
+    uint64_t now = rdtsc();
+    for (uint32_t c = 0; c < MAX_CPUS; c++) {
+        memset(&g_cpu[c], 0, sizeof(cpu_acct_t));
+        g_cpu[c].last = now;
+        g_cpu[c].report_tsc = now;
+    }
+    mutex_init(&g_top_lock, "cputime-top");
+    g_ready = 1;
+}
+
+// 커널 안에서의 현재 상태
+static int kernel_category(const thread_t* t) {
+    if (g_cpu[cpu_id()].idle_wait || !t || t->acct.idle) return CPUTIME_IDLE;
+    if (t->acct.softirq) return CPUTIME_SOFTIRQ;
+    return CPUTIME_SYSTEM;
+}
+
+// [last, now) 구간을 cat 버킷에 더함. 반환값은 구간 길이
+static uint64_t charge(thread_t* t, int cat, uint64_t now) {
+    cpu_acct_t* c = &g_cpu[cpu_id()];
+    uint64_t delta = now - c->last;
+    c->last = now;
+    c->t[cat] += delta;
+
+    // 일반 스레드가 hlt로 기다린 시간은 CPU idle로만 센다
+    if (t && (cat != CPUTIME_IDLE || t->acct.idle)) t->acct.t[cat] += delta;
+    return delta;
+}
+
+void cputime_irq_enter(int from_user) {
+    if (!g_ready) return;
+    thread_t* t = thread_current();
+    charge(t, from_user ? CPUTIME_USER : kernel_category(t), rdtsc());
+    g_cpu[cpu_id()].irqs++;
+}
+
+void cputime_irq_exit(uint32_t vector) {
+    if (!g_ready) return;
+    // IRQ 시간은 CPU 버킷 + 끼어든 스레드의 irq 버킷
+    uint64_t delta = charge(thread_current(), CPUTIME_IRQ, rdtsc());
+    g_vec_count[vector & 0xFF]++;
+    g_vec_cycles[vector & 0xFF] += delta;
+}
+
+void cputime_syscall_enter(int from_user) {
+    if (!g_ready) return;
+    uint32_t f = irq_save();
+    thread_t* t = thread_current();
+    charge(t, from_user ? CPUTIME_USER : kernel_category(t), rdtsc());
+    irq_restore(f);
+}
+
+void cputime_syscall_exit(void) {
+    if (!g_ready) return;
+    uint32_t f = irq_save();
+    thread_t* t = thread_current();
+    charge(t, kernel_category(t), rdtsc());
+    irq_restore(f);
+}
+
+void cputime_switch(thread_t* prev, thread_t* next) {
+    if (!g_ready) return;
+    uint64_t now = rdtsc();
+    charge(prev, kernel_category(prev), now);
+    g_cpu[cpu_id()].switches++;
+
+    // 선점/양보면 prev는 이미 run queue로 돌아가 READY 상태
+    if (prev->state == THREAD_READY) prev->acct.nivcsw++;
+    else prev->acct.nvcsw++;
+
+    if (next->acct.ready_since) {
+        next->acct.wait += now - next->acct.ready_since;
+        next->acct.ready_since = 0;
+    }
+}
+
+void cputime_enqueue(thread_t* t) {
+    if (!g_ready) return;
+    t->acct.ready_since = rdtsc();
+}
+
+void cputime_idle_wait(int waiting) {
+    if (!g_ready) return;
+    thread_t* t = thread_current();
+    charge(t, kernel_category(t), rdtsc());
+    g_cpu[cpu_id()].idle_wait = waiting;
+}
+
+void cputime_softirq_enter(void) {
+    if (!g_ready) return;
+    uint32_t f = irq_save();
+    thread_t* t = thread_current();
+    charge(t, kernel_category(t), rdtsc());
+    t->acct.softirq++;
+    irq_restore(f);
+}
+
+void cputime_softirq_exit(void) {
+    if (!g_ready) return;
+    uint32_t f = irq_save();
+    thread_t* t = thread_current();
+    charge(t, kernel_category(t), rdtsc());
+    if (t->acct.softirq) t->acct.softirq--;
+    irq_restore(f);
+}
+
+void cputime_set_idle(thread_t* t) {
+    t->acct.idle = 1;
+}
+
+// ---- 보고 ----
+
+typedef struct top_row {
+    uint32_t tid;
+    char name[THREAD_NAME_LEN];
+    thread_state_t state;
+    uint64_t delta;             // 이번 구간 사용량 (idle 제외)
+    uint64_t t[CPUTIME_NR];
+    uint64_t wait;
+    uint32_t nvcsw;
+    uint32_t nivcsw;
+} top_row_t;
+
+// 보고용 스냅샷 (g_top_lock 보유 중에만 사용)
+static top_row_t g_rows[TOP_MAX_ROWS];
+static uint32_t g_nrows;
+
+static void collect_row(thread_t* t, void* arg) {
+    (void)arg;
+
+    uint64_t total = 0;
+    for (int i = 0; i < CPUTIME_NR; i++) total += t->acct.t[i];
+    uint64_t delta = total - t->acct.last_total;
+    t->acct.last_total = total;
+    if (t->acct.idle) delta = 0;        // idle 스레드는 항상 맨 아래
+
+    if (g_nrows == TOP_MAX_ROWS) return;
+    top_row_t* r = &g_rows[g_nrows++];
+    r->tid = t->tid;
+    memcpy(r->name, t->name, THREAD_NAME_LEN);
+    r->state = t->state;
+    r->delta = delta;
+    memcpy(r->t, t->acct.t, sizeof(r->t));
+    r->wait = t->acct.wait;
+    r->nvcsw = t->acct.nvcsw;
+    r->nivcsw = t->acct.nivcsw;
+}
+
+static uint32_t cycles_to_ms(uint64_t cycles) {
+    uint64_t us = tsc_cycles_to_us(cycles);
+    div_u64_u32(&us, 1000);
+    return (uint32_t)us;
+}
+
+// part / whole (TSC cycle)의 천분율
+static uint32_t permille(uint64_t part, uint64_t whole_us) {
+    if (!whole_us) return 0;
+    uint64_t us = tsc_cycles_to_us(part) * 1000;
+    div_u64_u32(&us, (uint32_t)whole_us);
+    return (uint32_t)us;
+}
+
+// R 실행 중, Q 런큐 대기, B 잠김, Z 종료
+static char state_char(thread_state_t s) {
+    switch (s) {
+        case THREAD_RUNNING: return 'R';
+        case THREAD_READY:   return 'Q';
+        case THREAD_BLOCKED: return 'B';
+        case THREAD_DEAD:    return 'Z';
+    }
+    return '?';
+}
+
+void cputime_top(uint32_t max_threads) {
+    if (!g_ready || !tsc_hz()) {
+        kprintf("[TOP] no TSC clocksource\n");
+        return;
+    }
+
+    static uint32_t vec_delta[256];
+    cpu_acct_t snap;
+    uint64_t cpu_delta[CPUTIME_NR];
+
+    mutex_lock(&g_top_lock);
+    uint32_t f = irq_save();
+    // 지금까지의 구간을 현재 상태로 마감해서 보고에 포함
+    thread_t* cur = thread_current();
+    charge(cur, kernel_category(cur), rdtsc());
+
+    cpu_acct_t* c = &g_cpu[cpu_id()];
+    snap = *c;
+    for (int i = 0; i < CPUTIME_NR; i++) {
+        cpu_delta[i] = c->t[i] - c->report_t[i];
+        c->report_t[i] = c->t[i];
+    }
+    c->report_tsc = c->last;
+    c->report_switches = c->switches;
+    c->report_irqs = c->irqs;
+    for (uint32_t v = 0; v < 256; v++) {
+        vec_delta[v] = g_vec_count[v] - g_vec_report_count[v];
+        g_vec_report_count[v] = g_vec_count[v];
+    }
+
+    g_nrows = 0;
+    sched_for_each_thread(collect_row, 0);
+    irq_restore(f);
+
+    uint64_t interval_us = tsc_cycles_to_us(snap.last - snap.report_tsc);
+    if (interval_us > 0xFFFFFFFFull) interval_us = 0xFFFFFFFFull;
+
+    kprintf("[TOP] cpu%u interval=%u ms csw=%u irqs=%u:", cpu_id(),
+        (uint32_t)interval_us / 1000, snap.switches - snap.report_switches,
+        snap.irqs - snap.report_irqs);
+    for (int i = 0; i < CPUTIME_NR; i++) {
+        uint32_t pm = permille(cpu_delta[i], interval_us);
+        kprintf(" %s %u.%u%%", g_cat_name[i], pm / 10, pm % 10);
+    }
+    kprintf("\n");
+
+    // CPU 사용량(이번 구간) 내림차순
+    for (uint32_t i = 1; i < g_nrows; i++) {
+        top_row_t r = g_rows[i];
+        uint32_t j = i;
+        while (j > 0 && g_rows[j - 1].delta < r.delta) {
+            g_rows[j] = g_rows[j - 1];
+            j--;
+        }
+        g_rows[j] = r;
+    }
+
+    kprintf("[TOP]  TID NAME             S  %%CPU  USR(ms)  SYS(ms)  IRQ(ms) SIRQ(ms) WAIT(ms)   CSW v/i\n");
+    for (uint32_t i = 0; i < g_nrows && i < max_threads; i++) {
+        top_row_t* r = &g_rows[i];
+        uint32_t pm = permille(r->delta, interval_us);
+        kprintf("[TOP] %4u %-16s %c %3u.%u %8u %8u %8u %8u %8u %5u/%u\n",
+            r->tid, r->name, state_char(r->state), pm / 10, pm % 10,
+            cycles_to_ms(r->t[CPUTIME_USER]), cycles_to_ms(r->t[CPUTIME_SYSTEM]),
+            cycles_to_ms(r->t[CPUTIME_IRQ]), cycles_to_ms(r->t[CPUTIME_SOFTIRQ]),
+            cycles_to_ms(r->wait), r->nvcsw, r->nivcsw);
+    }
+
+    // 이번 구간에 가장 많이 들어온 벡터 (IRQ storm 확인)
+    kprintf("[TOP] vectors:");
+    for (uint32_t n = 0; n < TOP_MAX_VECTORS; n++) {
+        uint32_t best = 0;
+        for (uint32_t v = 1; v < 256; v++) {
+            if (vec_delta[v] > vec_delta[best]) best = v;
+        }
+        if (!vec_delta[best]) break;
+
+        uint64_t avg = g_vec_cycles[best];
+        div_u64_u32(&avg, g_vec_count[best]);
+        kprintf(" 0x%x=%u (%llu cyc)", best, vec_delta[best], avg);
+        vec_delta[best] = 0;
+    }
+    kprintf("\n");
+
+    mutex_unlock(&g_top_lock);
+}
+
+static void report_work(work_t* w) {
+    (void)w;
+    cputime_top(10);
+    if (g_report_period) queue_delayed_work(system_wq, &g_report_work, g_report_period);
+}
+
+void cputime_report_start(uint32_t period_ticks) {
+    if (!g_report_work.work.func) delayed_work_init(&g_report_work, report_work);
+
+    g_report_period = period_ticks;
+    if (period_ticks) {
+        queue_delayed_work(system_wq, &g_report_work, period_ticks);
+    } else {
+        cancel_delayed_work(&g_report_work);
+    }
+}
+
+const char* cputime_category_name(int cat) {
+    if (cat < 0 || cat >= CPUTIME_NR) return "?";
+    return g_cat_name[cat];
+}
+
+void cputime_cpu_totals(uint32_t cpu, uint64_t t[CPUTIME_NR], uint32_t* switches, uint32_t* irqs) {
+    uint32_t f = irq_save();
+    // 마지막 계정 시점 이후 구간은 아직 버킷에 없으므로 지금까지로 정리
+    if (g_ready && cpu == cpu_id()) {
+        thread_t* cur = thread_current();
+        charge(cur, kernel_category(cur), rdtsc());
+    }
+    for (int c = 0; c < CPUTIME_NR; c++) t[c] = g_cpu[cpu].t[c];
+    if (switches) *switches = g_cpu[cpu].switches;
+    if (irqs) *irqs = g_cpu[cpu].irqs;
+    irq_restore(f);
+}
+
+uint32_t cputime_vector_stats(uint32_t vector, uint64_t* cycles) {
+    vector &= 0xFF;
+    if (cycles) *cycles = g_vec_cycles[vector];
+    return g_vec_count[vector];
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <stdint.h>
+
+// TSC 기반 CPU 시간 계정
+// 문맥 전환, IRQ 진입/종료, 시스템 콜 진입/종료, softirq(workqueue/RCU 콜백) 구간마다
+// 직전 시점부터의 TSC 구간을 현재 상태 버킷에 더한다. 스레드별 + CPU별로 모은다.
+
+// 주기 보고 기본 간격 (초)
+#define CPUTIME_REPORT_SECS 30
+
+enum {
+    CPUTIME_USER = 0,
+    CPUTIME_SYSTEM,
+    CPUTIME_IRQ,
+    CPUTIME_SOFTIRQ,            // workqueue work / RCU 콜백 실행 (지연 처리)
+    CPUTIME_IDLE,
+    CPUTIME_NR,
+};
+
+// thread_t에 포함되는 스레드별 계정
+typedef struct cputime {
+    uint64_t t[CPUTIME_NR];     // TSC cycle
+    uint64_t wait;              // run queue 대기 누적 (READY → RUNNING)
+    uint64_t ready_since;       // 마지막 run queue 진입 시점
+    uint64_t last_total;        // 지난 보고 때의 t[] 합 (구간 사용률 계산용)
+    uint32_t nvcsw;             // 자발적 전환 (block/sleep/exit)
+    uint32_t nivcsw;            // 비자발적 전환 (선점/yield)
+    uint16_t softirq;           // softirq 구간 중첩 깊이
+    uint16_t idle;              // idle 스레드 표시
+} cputime_t;
+
+struct thread;
+
+// 부팅 시 기준 시점 설정 (sched_init 이후)
+void cputime_init(void);
+
+// ---- 계정 지점 (인터럽트 off에서 호출) ----
+// IRQ: from_user면 직전 구간은 유저 시간
+void cputime_irq_enter(int from_user);
+void cputime_irq_exit(uint32_t vector);
+
+// 시스템 콜 진입/종료 (종료 구간은 커널 시간)
+void cputime_syscall_enter(int from_user);
+void cputime_syscall_exit(void);
+
+// prev → next 전환 직전 (schedule)
+void cputime_switch(struct thread* prev, struct thread* next);
+
+// 스레드가 run queue에 들어감
+void cputime_enqueue(struct thread* t);
+
+// schedule()이 runnable 스레드 없이 hlt 대기에 들어가고 나올 때 (그 사이는 idle 시간)
+void cputime_idle_wait(int waiting);
+
+// softirq 구간 (스레드 컨텍스트, 중첩 가능)
+void cputime_softirq_enter(void);
+void cputime_softirq_exit(void);
+
+void cputime_set_idle(struct thread* t);
+
+// 지난 보고 이후 구간 기준, CPU 사용률 순으로 정렬한 top 형식 보고 (max_threads개까지)
+void cputime_top(uint32_t max_threads);
+
+// period tick마다 system_wq에서 cputime_top 출력 (0이면 중지)
+void cputime_report_start(uint32_t period_ticks);
+
+// ---- 조회 (procfs 등) ----
+const char* cputime_category_name(int cat);
+
+// cpu의 누적 버킷(TSC cycle), 전환/IRQ 횟수
+void cputime_cpu_totals(uint32_t cpu, uint64_t t[CPUTIME_NR], uint32_t* switches, uint32_t* irqs);
+
+// 벡터별 누적 IRQ 횟수 (cycles가 있으면 누적 cycle도)
+uint32_t cputime_vector_stats(uint32_t vector, uint64_t* cycles);
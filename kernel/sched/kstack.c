@@ -0,0 +1,221 @@
+#include "kstack.h"
+#include "../memory/paging.h"
+#include "../memory/heap.h"
+#include "../panic/panic.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/cr.h"
+#include "../../arch/x86/cpu/smp.h"
+#include "../../arch/x86/cpu/irqflags.h"
+
+#define KSTACK_PAGES (THREAD_STACK_SIZE / PAGE_SIZE)
+#define KSTACK_WORDS (THREAD_STACK_SIZE / 4)
+
+static int g_ready = 0;
+
+// 아직 프레임이 없는 슬롯 번호 스택
+static uint16_t g_free_slots[KSTACK_SLOTS];
+static uint32_t g_nr_free;
+
+// CPU별 캐시: 매핑된 채로 반환된 슬롯
+typedef struct kstack_cache {
+    uint16_t slots[KSTACK_CACHE_MAX];
+    uint32_t count;
+} kstack_cache_t;
+
+static kstack_cache_t g_cache[MAX_CPUS];
+static uint32_t g_cache_limit = KSTACK_CACHE_MAX;
+
+static kstack_stats_t g_stats;
+
+static inline uint32_t slot_base(uint32_t slot) {
+    return KSTACK_VIRT_BASE + slot * KSTACK_STRIDE;
+}
+
+static inline uint8_t* slot_stack(uint32_t slot) {
+    return (uint8_t*)(slot_base(slot) + KSTACK_GUARD);
+}
+
+// 스택 바닥 주소 → 슬롯 번호 (영역 밖이면 -1)
+static int stack_slot(const uint8_t* stack) {
+    uint32_t a = (uint32_t)stack;
+    if (a < KSTACK_VIRT_BASE || a >= KSTACK_VIRT_BASE + KSTACK_SLOTS * KSTACK_STRIDE) return -1;
+    return (int)((a - KSTACK_VIRT_BASE) / KSTACK_STRIDE);
+}
+
+static void poison(uint32_t* from, uint32_t* to) {
+    while (from < to) *from++ = KSTACK_POISON;
+}
+
+// 맨 아래부터 poison이 처음 깨진 word (다 그대로면 top)
+static uint32_t* first_used(const uint8_t* stack) {
+    uint32_t* p = (uint32_t*)stack;
+    uint32_t* top = p + KSTACK_WORDS;
+    while (p < top && *p == KSTACK_POISON) p++;
+    return p;
+}
+
+void kstack_init(void) {
+    // 영역 전체를 덮는 page table을 지금 만들어 둔다: 이후 생기는 page directory는
+    // 커널 PDE를 복사하므로 같은 page table을 공유하고, 슬롯 매핑이 모든 주소 공간에 보인다
+    pde_t* kpd = paging_kernel_directory();
+    if (!paging_get_pte(kpd, KSTACK_VIRT_BASE, 1)) {
+        panic("kstack_init: out of frames");
+    }
+
+    // 낮은 슬롯부터 쓰도록 역순으로 쌓는다
+    for (uint32_t i = 0; i < KSTACK_SLOTS; i++) {
+        g_free_slots[i] = (uint16_t)(KSTACK_SLOTS - 1 - i);
+    }
+    g_nr_free = KSTACK_SLOTS;
+    g_ready = 1;
+
+    kprintf("[KSTACK] %u slots x %u KB + guard at 0x%x, cache %u/cpu\n",
+        KSTACK_SLOTS, THREAD_STACK_SIZE / 1024, KSTACK_VIRT_BASE, KSTACK_CACHE_MAX);
+}
+
+// 빈 슬롯에 프레임을 매핑하고 전체를 poison. 실패 시 0 (슬롯은 되돌림)
+static int slot_map(uint32_t slot) {
+    pde_t* kpd = paging_kernel_directory();
+    uint32_t va = (uint32_t)slot_stack(slot);
+
+    for (uint32_t i = 0; i < KSTACK_PAGES; i++) {
+        uint32_t frame = pmm_alloc_frame();
+        if (!frame || !paging_map(kpd, va + i * PAGE_SIZE, frame, PAGE_WRITE)) {
+            if (frame) pmm_free_frame(frame);
+            while (i--) {
+                pte_t* pte = paging_get_pte(kpd, va + i * PAGE_SIZE, 0);
+                pmm_free_frame(PTE_FRAME(*pte));
+                *pte = 0;
+                invlpg(va + i * PAGE_SIZE);
+            }
+            return 0;
+        }
+    }
+    poison((uint32_t*)va, (uint32_t*)(va + THREAD_STACK_SIZE));
+    return 1;
+}
+
+static void slot_unmap(uint32_t slot) {
+    pde_t* kpd = paging_kernel_directory();
+    uint32_t va = (uint32_t)slot_stack(slot);
+
+    for (uint32_t i = 0; i < KSTACK_PAGES; i++) {
+        pte_t* pte = paging_get_pte(kpd, va + i * PAGE_SIZE, 0);
+        uint32_t frame = PTE_FRAME(*pte);
+        *pte = 0;
+        // 커널 영역 page table은 공유이므로 현재 CR3와 무관하게 무효화
+        invlpg(va + i * PAGE_SIZE);
+        pmm_free_frame(frame);
+    }
+}
+
+static uint8_t* heap_stack(void) {
+    __sync_fetch_and_add(&g_stats.heap_stacks, 1);
+    return (uint8_t*)kmalloc_aligned(THREAD_STACK_SIZE, 16);
+}
+
+uint8_t* kstack_alloc(void) {
+    if (!g_ready) return heap_stack();
+
+    uint32_t f = irq_save();
+    g_stats.allocs++;
+
+    kstack_cache_t* c = &g_cache[cpu_id()];
+    if (c->count) {
+        uint32_t slot = c->slots[--c->count];
+        g_stats.cache_hits++;
+        g_stats.cached--;
+        irq_restore(f);
+        return slot_stack(slot);
+    }
+
+    if (!g_nr_free) {
+        irq_restore(f);
+        return heap_stack();
+    }
+    uint32_t slot = g_free_slots[--g_nr_free];
+    irq_restore(f);
+
+    if (!slot_map(slot)) {
+        f = irq_save();
+        g_free_slots[g_nr_free++] = (uint16_t)slot;
+        irq_restore(f);
+        return heap_stack();
+    }
+    __sync_fetch_and_add(&g_stats.slot_maps, 1);
+    return slot_stack(slot);
+}
+
+void kstack_free(uint8_t* stack) {
+    int slot = stack_slot(stack);
+    if (slot < 0) {
+        kfree(stack);
+        return;
+    }
+
+    // high-water mark 기록 후 사용된 구간만 다시 poison (아래쪽은 이미 poison)
+    uint32_t* used = first_used(stack);
+    uint32_t* top = (uint32_t*)(stack + THREAD_STACK_SIZE);
+    uint32_t hwm = (uint32_t)((uint8_t*)top - (uint8_t*)used);
+    poison(used, top);
+
+    uint32_t f = irq_save();
+    g_stats.frees++;
+    if (hwm > g_stats.max_high_water) g_stats.max_high_water = hwm;
+
+    kstack_cache_t* c = &g_cache[cpu_id()];
+    if (c->count < g_cache_limit) {
+        c->slots[c->count++] = (uint16_t)slot;
+        g_stats.cached++;
+        irq_restore(f);
+        return;
+    }
+    irq_restore(f);
+
+    slot_unmap((uint32_t)slot);
+    f = irq_save();
+    g_free_slots[g_nr_free++] = (uint16_t)slot;
+    g_stats.slot_unmaps++;
+    irq_restore(f);
+}
+
+uint32_t kstack_high_water(const uint8_t* stack) {
+    if (stack_slot(stack) < 0) return 0;
+    return (uint32_t)(stack + THREAD_STACK_SIZE - (const uint8_t*)first_used(stack));
+}
+
+uint32_t kstack_guard_hit(uint32_t addr) {
+    int slot = stack_slot((const uint8_t*)addr);
+    if (slot < 0) return 0;
+    return addr - slot_base((uint32_t)slot) < KSTACK_GUARD ? (uint32_t)slot + 1 : 0;
+}
+
+void kstack_set_cache_limit(uint32_t n) {
+    if (n > KSTACK_CACHE_MAX) n = KSTACK_CACHE_MAX;
+
+    // 줄어든 만큼 캐시에서 빼서 매핑 해제
+    for (uint32_t cpu = 0; cpu < MAX_CPUS; cpu++) {
+        kstack_cache_t* c = &g_cache[cpu];
+        for (;;) {
+            uint32_t f = irq_save();
+            if (c->count <= n) {
+                irq_restore(f);
+                break;
+            }
+            uint32_t slot = c->slots[--c->count];
+            g_stats.cached--;
+            irq_restore(f);
+
+            slot_unmap(slot);
+            f = irq_save();
+            g_free_slots[g_nr_free++] = (uint16_t)slot;
+            g_stats.slot_unmaps++;
+            irq_restore(f);
+        }
+    }
+    g_cache_limit = n;
+}
+
+void kstack_get_stats(kstack_stats_t* out) {
+    *out = g_stats;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <stdint.h>
+#include "thread.h"
+#include "../memory/pmm.h"
+
+// 커널 스레드 스택 할당기
+// - 스택은 전용 커널 가상 영역 [KSTACK_VIRT_BASE, +4MB)의 슬롯에 매핑된다.
+//   슬롯 = guard 페이지(매핑 안 함) + 스택 THREAD_STACK_SIZE. 넘치면 guard에서 #PF/#DF로 멈춘다
+// - 반환된 스택은 CPU별 캐시에 매핑된 채로 보관했다가 다음 스레드에 그대로 준다 (매핑/할당 없음)
+// - 처음 매핑할 때 스택 전체를 KSTACK_POISON으로 채우고, 반환 시 맨 아래부터 poison이 깨진 곳을
+//   찾아 high-water mark를 기록한 뒤 사용된 구간만 다시 채운다 (전체를 다시 지우지 않음)
+// - paging이 켜지기 전(kstack_init 이전)에 만든 스레드는 힙 스택을 쓴다 (guard 없음)
+
+#define KSTACK_VIRT_BASE 0xE0000000u
+#define KSTACK_VIRT_SIZE 0x00400000u    // page table 하나 (모든 page directory가 공유)
+#define KSTACK_GUARD     PAGE_SIZE
+#define KSTACK_STRIDE    (KSTACK_GUARD + THREAD_STACK_SIZE)
+#define KSTACK_SLOTS     (KSTACK_VIRT_SIZE / KSTACK_STRIDE)
+#define KSTACK_CACHE_MAX 16             // CPU별 캐시에 매핑된 채로 둘 스택 수
+#define KSTACK_POISON    0x57AC57ACu
+
+// 커널 page directory에 영역의 page table을 만든다 (paging_init 이후, 첫 주소 공간 생성 전)
+void kstack_init(void);
+
+// 스택 바닥(가장 낮은 주소) 반환. 슬롯이 모두 쓰였으면 힙 스택
+uint8_t* kstack_alloc(void);
+
+// 종료된 스레드의 스택 반환 (그 스택 위에서 실행 중이 아니어야 함)
+void kstack_free(uint8_t* stack);
+
+// 지금까지 사용된 최대 깊이 (바이트). 힙 스택이면 0
+uint32_t kstack_high_water(const uint8_t* stack);
+
+// addr가 스택 슬롯의 guard 페이지면 그 슬롯 번호 + 1, 아니면 0 (#PF/#DF 진단용)
+uint32_t kstack_guard_hit(uint32_t addr);
+
+// CPU별 캐시 깊이 변경 (0이면 캐시 없이 매번 매핑/해제, 벤치마크 비교용)
+void kstack_set_cache_limit(uint32_t n);
+
+typedef struct kstack_stats {
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t cache_hits;                // 캐시에서 바로 나간 스택
+    uint32_t slot_maps;                 // 새로 프레임을 할당해 매핑한 슬롯
+    uint32_t slot_unmaps;               // 캐시가 넘쳐 매핑을 푼 슬롯
+    uint32_t heap_stacks;               // guard 없는 힙 스택 (초기화 전 / 슬롯 소진)
+    uint32_t cached;                    // 현재 캐시에 있는 스택
+    uint32_t max_high_water;            // 반환된 스택 중 최대 사용 깊이
+} kstack_stats_t;
+
+void kstack_get_stats(kstack_stats_t* out);
+
+// 스레드 생성/종료 왕복 비용 (캐시 vs 캐시 없음)
+void kstack_bench(void);
@@ -0,0 +1,64 @@
+#include "kstack.h"
+#include "../lib/string.h"
+#include "../lib/div64.h"
+#include "../lib/cmdline.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/tsc.h"
+
+// 스레드 생성 → 실행 → 종료 → 회수 왕복 비용
+// 자식은 생성자보다 우선순위가 높아 thread_create 안에서 바로 실행되고 끝나며,
+// 회수(스택 반환)는 다음 thread_create 앞의 sched_reap에서 일어난다.
+#define KB_ROUNDS 256
+
+static volatile uint32_t g_ran;
+
+static void child(void* arg) {
+    // 스택을 조금 써서 high-water mark가 보이게
+    volatile uint8_t buf[512];
+    memset((void*)buf, (int)(uint32_t)arg, sizeof(buf));
+    if (buf[0] == (uint8_t)(uint32_t)arg) g_ran++;
+}
+
+static void run_rounds(const char* label, uint32_t cache) {
+    kstack_stats_t s0, s1;
+    kstack_set_cache_limit(cache);
+    kstack_get_stats(&s0);
+
+    int prio = thread_current()->priority + 1;
+    uint64_t total = 0, worst = 0;
+    g_ran = 0;
+    for (uint32_t i = 0; i < KB_ROUNDS; i++) {
+        uint64_t t0 = rdtsc();
+        thread_create("kstack-child", child, (void*)i, prio);
+        uint64_t dt = rdtsc() - t0;
+        total += dt;
+        if (dt > worst) worst = dt;
+    }
+    kstack_get_stats(&s1);
+
+    div_u64_u32(&total, KB_ROUNDS);
+    kprintf("[KSTACK] %-8s create+exit avg %llu cycles (%llu us), max %llu us, ran %u, maps %u, hits %u\n",
+        label, total, tsc_cycles_to_us(total), tsc_cycles_to_us(worst), g_ran,
+        s1.slot_maps - s0.slot_maps, s1.cache_hits - s0.cache_hits);
+}
+
+static void kstack_bench_thread(void* arg) {
+    (void)arg;
+    run_rounds("no-cache", 0);
+    run_rounds("cached", KSTACK_CACHE_MAX);
+
+    kstack_stats_t st;
+    kstack_get_stats(&st);
+    kprintf("[KSTACK] allocs=%u frees=%u cached=%u unmaps=%u heap=%u max_hwm=%u B (own stack %u B)\n",
+        st.allocs, st.frees, st.cached, st.slot_unmaps, st.heap_stacks, st.max_high_water,
+        kstack_high_water(thread_current()->stack));
+}
+
+void kstack_bench(void) {
+    if (!cmdline_bench("kstack")) return;
+    if (tsc_hz() == 0) {
+        kprintf("[KSTACK] TSC not calibrated\n");
+        return;
+    }
+    thread_create("kstack-bench", kstack_bench_thread, 0, PRIO_NORMAL + 2);
+}
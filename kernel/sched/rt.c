@@ -0,0 +1,252 @@
+#include "rt.h"
+#include "../memory/heap.h"
+#include "../time/time.h"
+#include "../lib/div64.h"
+#include "../panic/panic.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/tsc.h"
+#include "../../arch/x86/cpu/irqflags.h"
+
+#define PPM 1000000u
+
+// Liu & Layland RM 이용률 한계 n(2^(1/n) - 1), ppm (n > 10이면 ln2로 수렴)
+static const uint32_t g_rm_bound[] = {
+    0, 1000000, 828427, 779763, 756828, 743491, 734772, 728626, 724061, 720537, 717734,
+};
+#define RM_BOUND_LIMIT 693147
+
+static rt_policy_t g_policy = RT_POLICY_EDF;
+static rt_task_t* g_rt_all = 0;
+static uint32_t g_rt_count = 0;
+static uint32_t g_util_ppm = 0;
+static uint32_t g_rejected = 0;
+
+// RT ready 큐 (thread->next로 연결, 정책 순서)
+static thread_t* g_rt_rq = 0;
+
+void rt_init(rt_policy_t policy) {
+    g_policy = policy;
+    kprintf("[RT] policy=%s\n", policy == RT_POLICY_EDF ? "EDF" : "RM");
+}
+
+rt_policy_t rt_policy(void) {
+    return g_policy;
+}
+
+uint32_t rt_utilization_ppm(void) {
+    return g_util_ppm;
+}
+
+uint32_t rt_utilization_bound_ppm(uint32_t ntasks) {
+    if (g_policy == RT_POLICY_EDF) return PPM;
+    if (ntasks < sizeof(g_rm_bound) / sizeof(g_rm_bound[0])) return g_rm_bound[ntasks];
+    return RM_BOUND_LIMIT;
+}
+
+// 태스크 밀도 C / min(D, T) (D < T인 경우까지 보수적으로 포함)
+static uint32_t task_density_ppm(uint32_t budget, uint32_t deadline) {
+    uint64_t v = (uint64_t)budget * PPM;
+    div_u64_u32(&v, deadline);
+    return (uint32_t)v;
+}
+
+// a의 잡이 b의 잡보다 먼저 실행되어야 하는지
+static int rt_before(const rt_task_t* a, const rt_task_t* b) {
+    if (g_policy == RT_POLICY_EDF) return a->abs_deadline < b->abs_deadline;
+    if (a->period != b->period) return a->period < b->period;
+    return a->deadline < b->deadline;
+}
+
+void rt_rq_push(thread_t* t) {
+    thread_t** link = &g_rt_rq;
+    while (*link && !rt_before(t->rt, (*link)->rt)) link = &(*link)->next;
+    t->next = *link;
+    *link = t;
+}
+
+thread_t* rt_rq_pop(void) {
+    thread_t* t = g_rt_rq;
+    if (t) {
+        g_rt_rq = t->next;
+        t->next = 0;
+    }
+    return t;
+}
+
+void rt_rq_remove(thread_t* t) {
+    for (thread_t** link = &g_rt_rq; *link; link = &(*link)->next) {
+        if (*link == t) {
+            *link = t->next;
+            t->next = 0;
+            return;
+        }
+    }
+}
+
+int rt_preempts(const thread_t* a, const thread_t* b) {
+    if (a->rt && b->rt) return rt_before(a->rt, b->rt);
+    if (a->rt) return 1;
+    if (b->rt) return 0;
+    return a->priority > b->priority;
+}
+
+// 다음 잡 release (인터럽트 off)
+static void rt_release(rt_task_t* rt) {
+    if (rt->state == RT_JOB_THROTTLED) {
+        // budget을 넘긴 잡이 다음 release까지 끝나지 못함: 마감 초과 확정, 같은 잡을 이어서 실행
+        if (!rt->missed) {
+            rt->misses++;
+            rt->missed = 1;
+        }
+    } else {
+        rt->release_tsc = rdtsc();
+        rt->missed = 0;
+    }
+
+    rt->abs_deadline = rt->next_release + rt->deadline;
+    rt->next_release += rt->period;
+    rt->budget_left = rt->budget;
+    rt->state = RT_JOB_ACTIVE;
+}
+
+int rt_tick(thread_t* current, uint64_t now) {
+    if (!g_rt_all) return 0;
+
+    int resched = 0;
+
+    // 실행 중인 잡의 budget 차감: 소진되면 다음 release까지 throttle
+    rt_task_t* cur = current->rt;
+    if (cur && cur->state == RT_JOB_ACTIVE) {
+        if (cur->budget_left > 0) cur->budget_left--;
+        if (cur->budget_left == 0) {
+            cur->state = RT_JOB_THROTTLED;
+            cur->throttles++;
+            current->state = THREAD_BLOCKED;    // IRQ 종료 시 schedule()에서 내려감
+            resched = 1;
+        }
+    }
+
+    for (rt_task_t* rt = g_rt_all; rt; rt = rt->all_next) {
+        if (rt->state == RT_JOB_ACTIVE) {
+            if (!rt->missed && now > rt->abs_deadline) {
+                rt->misses++;
+                rt->missed = 1;
+            }
+        } else if (now >= rt->next_release) {
+            rt_release(rt);
+            thread_unblock(rt->thread);         // 선점 필요 여부는 thread_unblock이 판단
+        }
+    }
+
+    return resched;
+}
+
+thread_t* rt_thread_create(const char* name, void (*entry)(void*), void* arg,
+                           uint32_t period, uint32_t budget, uint32_t deadline) {
+    if (deadline == 0) deadline = period;
+    if (period == 0 || budget == 0 || budget > deadline || deadline > period) {
+        kprintf("[RT] %s: invalid params T=%u C=%u D=%u\n", name, period, budget, deadline);
+        return 0;
+    }
+
+    uint32_t u = task_density_ppm(budget, deadline);
+
+    uint32_t f = irq_save();
+    uint32_t bound = rt_utilization_bound_ppm(g_rt_count + 1);
+    if (g_util_ppm + u > bound) {
+        g_rejected++;
+        uint32_t total = g_util_ppm + u;
+        irq_restore(f);
+        kprintf("[RT] %s rejected: U=%u.%03u%% > bound %u.%03u%%\n", name,
+            total / 10000, (total / 10) % 1000, bound / 10000, (bound / 10) % 1000);
+        return 0;
+    }
+    g_util_ppm += u;
+    g_rt_count++;
+    irq_restore(f);
+
+    rt_task_t* rt = (rt_task_t*)kmalloc(sizeof(rt_task_t));
+    rt->period = period;
+    rt->budget = budget;
+    rt->deadline = deadline;
+    rt->jobs = 0;
+    rt->misses = 0;
+    rt->throttles = 0;
+    rt->last_resp_us = 0;
+    rt->wcrt_us = 0;
+
+    // 첫 잡은 지금 release
+    f = irq_save();
+    rt->state = RT_JOB_WAITING;
+    rt->next_release = timer_ticks();
+    rt_release(rt);
+    rt->all_next = g_rt_all;
+    g_rt_all = rt;
+    irq_restore(f);
+
+    return thread_create_rt(name, entry, arg, rt);
+}
+
+void rt_wait_next_period(void) {
+    thread_t* t = thread_current();
+    rt_task_t* rt = t->rt;
+    if (!rt) {
+        panic("rt_wait_next_period: not an RT thread");
+    }
+
+    uint32_t f = irq_save();
+
+    uint64_t us = tsc_cycles_to_us(rdtsc() - rt->release_tsc);
+    rt->last_resp_us = (us >> 32) ? 0xFFFFFFFFu : (uint32_t)us;
+    if (rt->last_resp_us > rt->wcrt_us) rt->wcrt_us = rt->last_resp_us;
+    rt->jobs++;
+
+    uint64_t now = timer_ticks();
+    if (!rt->missed && now > rt->abs_deadline) {
+        rt->misses++;
+        rt->missed = 1;
+    }
+
+    rt->state = RT_JOB_WAITING;
+    if (now >= rt->next_release) {
+        // 이미 다음 잡의 release 시각이 지남: 잠들지 않고 바로 다음 잡 시작
+        rt_release(rt);
+    } else {
+        thread_block();
+    }
+
+    irq_restore(f);
+}
+
+void rt_thread_exit(thread_t* t) {
+    rt_task_t* rt = t->rt;
+    if (!rt) return;
+
+    uint32_t f = irq_save();
+    for (rt_task_t** link = &g_rt_all; *link; link = &(*link)->all_next) {
+        if (*link == rt) {
+            *link = rt->all_next;
+            break;
+        }
+    }
+    g_util_ppm -= task_density_ppm(rt->budget, rt->deadline);
+    g_rt_count--;
+    t->rt = 0;
+    irq_restore(f);
+
+    kfree(rt);
+}
+
+void rt_dump(void) {
+    uint32_t bound = rt_utilization_bound_ppm(g_rt_count);
+    kprintf("[RT] policy=%s tasks=%u U=%u.%03u%% bound=%u.%03u%% rejected=%u\n",
+        g_policy == RT_POLICY_EDF ? "EDF" : "RM", g_rt_count,
+        g_util_ppm / 10000, (g_util_ppm / 10) % 1000,
+        bound / 10000, (bound / 10) % 1000, g_rejected);
+
+    for (rt_task_t* rt = g_rt_all; rt; rt = rt->all_next) {
+        kprintf("  %-10s T=%-3u C=%-3u D=%-3u jobs=%-5u miss=%-3u throttle=%-3u wcrt=%uus last=%uus\n",
+            rt->thread ? rt->thread->name : "?", rt->period, rt->budget, rt->deadline,
+            rt->jobs, rt->misses, rt->throttles, rt->wcrt_us, rt->last_resp_us);
+    }
+}
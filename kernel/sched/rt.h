@@ -0,0 +1,78 @@
+#pragma once
+#include <stdint.h>
+#include "thread.h"
+
+// 실시간 스케줄링 클래스 (주기 태스크)
+// - 각 태스크는 period(T), budget(C), deadline(D, 상대값)을 PIT tick 단위로 선언
+// - RT 태스크는 항상 일반 스레드보다 먼저 실행되고, RT끼리는 정책에 따라 선택
+//   EDF: 절대 deadline이 가장 이른 잡 / RM: period가 가장 짧은 태스크 (고정 우선순위)
+// - 잡이 budget을 다 쓰면 타이머 인터럽트에서 다음 release까지 throttle
+// - 잡 종료는 rt_wait_next_period()로 알리고, 여기서 응답 시간/마감 초과를 기록
+
+typedef enum {
+    RT_POLICY_EDF = 0,
+    RT_POLICY_RM,
+} rt_policy_t;
+
+typedef enum {
+    RT_JOB_ACTIVE = 0,      // 실행 가능 (현재 잡 진행 중)
+    RT_JOB_WAITING,         // 잡 완료, 다음 release 대기
+    RT_JOB_THROTTLED,       // budget 소진, 다음 release 대기
+} rt_job_state_t;
+
+typedef struct rt_task {
+    thread_t* thread;
+
+    uint32_t period;            // T (tick)
+    uint32_t budget;            // C (tick)
+    uint32_t deadline;          // D (tick, release 기준 상대값, D <= T)
+
+    rt_job_state_t state;
+    uint64_t next_release;      // 다음 잡 release tick
+    uint64_t abs_deadline;      // 현재 잡의 절대 deadline (tick)
+    uint32_t budget_left;
+    uint64_t release_tsc;       // 현재 잡 release 시각 (응답 시간 측정용)
+    int missed;                 // 현재 잡의 miss가 이미 집계됨
+
+    uint32_t jobs;              // 완료한 잡 수
+    uint32_t misses;            // deadline miss
+    uint32_t throttles;         // budget overrun으로 throttle 된 횟수
+    uint32_t last_resp_us;
+    uint32_t wcrt_us;           // 관측된 최악 응답 시간
+
+    struct rt_task* all_next;
+} rt_task_t;
+
+void rt_init(rt_policy_t policy);
+rt_policy_t rt_policy(void);
+
+// admission control 통과 시 스레드 생성 (첫 잡은 즉시 release)
+// 거부되면 0 (이용률 한계 초과 또는 잘못된 파라미터)
+thread_t* rt_thread_create(const char* name, void (*entry)(void*), void* arg,
+                           uint32_t period, uint32_t budget, uint32_t deadline);
+
+// 현재 잡 완료: 통계 기록 후 다음 release까지 잠듦 (RT 스레드 전용)
+void rt_wait_next_period(void);
+
+// 현재 admission 된 이용률 (ppm, 1000000 = 100%)와 정책별 한계
+uint32_t rt_utilization_ppm(void);
+uint32_t rt_utilization_bound_ppm(uint32_t ntasks);
+
+void rt_dump(void);
+
+// ---- sched.c 내부 연동 (인터럽트를 끈 상태에서 호출) ----
+
+// RT ready 큐 (정책 순서로 정렬)
+void rt_rq_push(thread_t* t);
+thread_t* rt_rq_pop(void);
+void rt_rq_remove(thread_t* t);
+
+// a가 b를 선점해야 하는지 (한쪽이라도 RT면 여기서 판단)
+int rt_preempts(const thread_t* a, const thread_t* b);
+
+// 스레드 종료 시 태스크 제거 + 이용률 반환
+void rt_thread_exit(thread_t* t);
+
+// 매 tick: release/deadline 처리. 실행 중인 RT 스레드의 budget 차감 (throttle 시 BLOCKED로 표시)
+// 재스케줄이 필요하면 1
+int rt_tick(thread_t* current, uint64_t now);
@@ -0,0 +1,502 @@
+#include "thread.h"
+#include "wait.h"
+#include "rt.h"
+#include "workqueue.h"
+#include "kstack.h"
+#include "../sync/rcu.h"
+#include "../memory/heap.h"
+#include "../lib/string.h"
+#include "../time/time.h"
+#include "../proc/process.h"
+#include "../panic/panic.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/irqflags.h"
+#include "../trace/irqsoff.h"
+#include "../../arch/x86/cpu/fpu.h"
+#include "../../arch/x86/interrupt/irq.h"
+
+extern void context_switch(uint32_t* old_esp, uint32_t new_esp);
+
+static thread_t g_boot_thread;
+static thread_t* g_current = 0;
+static thread_t* g_all = 0;
+static thread_t* g_zombies = 0;
+static uint32_t g_next_tid = 0;
+
+// 우선순위별 FIFO + 비어 있지 않은 우선순위 비트맵 (O(1) 선택)
+static thread_t* g_rq_head[NR_PRIO];
+static thread_t* g_rq_tail[NR_PRIO];
+static uint32_t g_rq_bitmap = 0;
+
+// thread_sleep 중인 스레드 (wake_tick 오름차순, next로 연결)
+static thread_t* g_sleepers = 0;
+
+static volatile int g_need_resched = 0;
+static volatile int g_preempt_count = 0;
+static volatile int g_idle_wait = 0;      // schedule()에서 runnable 스레드를 기다리며 hlt 중
+static uint32_t g_switches = 0;
+
+static void copy_name(char* dst, const char* src) {
+    uint32_t i = 0;
+    if (src) {
+        for (; src[i] && i < THREAD_NAME_LEN - 1; i++) dst[i] = src[i];
+    }
+    dst[i] = 0;
+}
+
+// t가 현재 스레드를 선점해야 하는지 (RT 클래스가 일반 클래스보다 우선)
+static int should_preempt(const thread_t* t) {
+    if (t->rt || g_current->rt) return rt_preempts(t, g_current);
+    return t->priority > g_current->priority;
+}
+
+static void rq_push(thread_t* t) {
+    cputime_enqueue(t);
+
+    if (t->rt) {
+        rt_rq_push(t);
+        return;
+    }
+
+    int p = t->priority;
+    t->next = 0;
+    if (g_rq_tail[p]) g_rq_tail[p]->next = t;
+    else g_rq_head[p] = t;
+    g_rq_tail[p] = t;
+    g_rq_bitmap |= (1u << p);
+}
+
+static void rq_remove(thread_t* t) {
+    if (t->rt) {
+        rt_rq_remove(t);
+        return;
+    }
+
+    int p = t->priority;
+    thread_t* prev = 0;
+    for (thread_t* it = g_rq_head[p]; it; prev = it, it = it->next) {
+        if (it != t) continue;
+
+        if (prev) prev->next = t->next;
+        else g_rq_head[p] = t->next;
+        if (g_rq_tail[p] == t) g_rq_tail[p] = prev;
+        if (!g_rq_head[p]) g_rq_bitmap &= ~(1u << p);
+        t->next = 0;
+        return;
+    }
+}
+
+static thread_t* rq_pop(void) {
+    thread_t* rt = rt_rq_pop();
+    if (rt) return rt;
+
+    if (g_rq_bitmap == 0) return 0;
+
+    int p = 31 - __builtin_clz(g_rq_bitmap);
+    thread_t* t = g_rq_head[p];
+    g_rq_head[p] = t->next;
+    if (!g_rq_head[p]) {
+        g_rq_tail[p] = 0;
+        g_rq_bitmap &= ~(1u << p);
+    }
+    t->next = 0;
+    return t;
+}
+
+void sched_init(void) {
+    for (int i = 0; i < NR_PRIO; i++) {
+        g_rq_head[i] = 0;
+        g_rq_tail[i] = 0;
+    }
+
+    thread_t* t = &g_boot_thread;
+    t->tid = g_next_tid++;
+    copy_name(t->name, "main");
+    t->state = THREAD_RUNNING;
+    t->priority = PRIO_NORMAL;
+    t->base_priority = PRIO_NORMAL;
+    t->esp = 0;
+    t->stack = 0;           // boot 스택 (.bss) 사용
+    t->slice = SCHED_SLICE_TICKS;
+    t->rt = 0;
+    t->proc = 0;
+    t->fpu = 0;
+    t->entry = 0;
+    t->arg = 0;
+    t->wait_on = 0;
+    t->blocked_on = 0;
+    t->held = 0;
+    t->wake_tick = 0;
+    t->worker = 0;
+    memset(&t->acct, 0, sizeof(t->acct));
+    t->next = 0;
+    t->all_next = 0;
+
+    g_all = t;
+    g_current = t;
+
+    kprintf("[SCHED] init (prio levels=%u, slice=%u ticks)\n", NR_PRIO, SCHED_SLICE_TICKS);
+}
+
+thread_t* thread_current(void) {
+    return g_current;
+}
+
+// 종료된 스레드의 스택/구조체 반환 (자기 자신의 스택은 반환할 수 없으므로 지연 처리)
+static void sched_reap(void) {
+    uint32_t f = irq_save();
+
+    while (g_zombies) {
+        thread_t* t = g_zombies;
+        g_zombies = t->next;
+
+        for (thread_t** link = &g_all; *link; link = &(*link)->all_next) {
+            if (*link == t) {
+                *link = t->all_next;
+                break;
+            }
+        }
+
+        if (t != &g_boot_thread) {
+            kstack_free(t->stack);
+            kfree(t);
+        }
+    }
+
+    irq_restore(f);
+}
+
+// 새 스레드의 첫 실행 지점 (context_switch의 ret으로 도착)
+static void thread_start(void) {
+    thread_t* t = g_current;
+
+    // schedule()은 인터럽트를 끈 채로 전환하므로 여기서 다시 켠다
+    irq_enable();
+    t->entry(t->arg);
+    thread_exit();
+}
+
+static thread_t* thread_spawn(const char* name, void (*entry)(void*), void* arg,
+                              int priority, struct rt_task* rt) {
+    sched_reap();
+
+    if (priority < PRIO_IDLE) priority = PRIO_IDLE;
+    if (priority > PRIO_MAX) priority = PRIO_MAX;
+
+    thread_t* t = (thread_t*)kmalloc(sizeof(thread_t));
+    t->stack = kstack_alloc();
+
+    copy_name(t->name, name);
+    t->state = THREAD_READY;
+    t->priority = priority;
+    t->base_priority = priority;
+    t->slice = SCHED_SLICE_TICKS;
+    t->rt = rt;
+    t->proc = 0;
+    t->fpu = 0;
+    t->entry = entry;
+    t->arg = arg;
+    t->wait_on = 0;
+    t->blocked_on = 0;
+    t->held = 0;
+    t->wake_tick = 0;
+    t->worker = 0;
+    memset(&t->acct, 0, sizeof(t->acct));
+
+    // context_switch가 pop할 초기 프레임: edi, esi, ebx, ebp, ret(thread_start)
+    uint32_t* sp = (uint32_t*)(t->stack + THREAD_STACK_SIZE);
+    *--sp = 0;                      // thread_start의 가짜 return address
+    *--sp = (uint32_t)thread_start;
+    *--sp = 0;                      // ebp
+    *--sp = 0;                      // ebx
+    *--sp = 0;                      // esi
+    *--sp = 0;                      // edi
+    t->esp = (uint32_t)sp;
+
+    uint32_t f = irq_save();
+    t->tid = g_next_tid++;
+    t->all_next = g_all;
+    g_all = t;
+    if (rt) rt->thread = t;
+    rq_push(t);
+    if (should_preempt(t)) g_need_resched = 1;
+    irq_restore(f);
+
+    sched_preempt_check();
+    return t;
+}
+
+thread_t* thread_create(const char* name, void (*entry)(void*), void* arg, int priority) {
+    return thread_spawn(name, entry, arg, priority, 0);
+}
+
+thread_t* thread_create_rt(const char* name, void (*entry)(void*), void* arg, struct rt_task* rt) {
+    // RT 스레드는 wait queue 등 우선순위 기반 구조에서도 가장 앞에 서도록 PRIO_MAX
+    return thread_spawn(name, entry, arg, PRIO_MAX, rt);
+}
+
+void schedule(void) {
+    uint32_t f = irq_save();
+
+    thread_t* prev = g_current;
+    g_need_resched = 0;
+
+    rcu_note_context_switch();
+
+    if (prev->state == THREAD_RUNNING) {
+        prev->state = THREAD_READY;
+        rq_push(prev);
+    }
+
+    thread_t* next = rq_pop();
+    if (!next) {
+        // idle 스레드까지 잠든 경우(예: boot 스레드의 sleep): IRQ가 누군가 깨울 때까지 대기
+        // 이 구간의 IRQ 종료에서 schedule()이 다시 불리지 않도록 선점을 막는다
+        g_preempt_count++;
+        g_idle_wait = 1;
+        cputime_idle_wait(1);
+        while ((next = rq_pop()) == 0) {
+            safe_halt();
+            irq_disable();
+        }
+        cputime_idle_wait(0);
+        g_idle_wait = 0;
+        g_preempt_count--;
+    }
+
+    next->state = THREAD_RUNNING;
+    next->slice = SCHED_SLICE_TICKS;
+
+    if (next != prev) {
+        cputime_switch(prev, next);
+        g_current = next;
+        g_switches++;
+
+        // 커널 스레드는 직전 주소 공간을 그대로 사용 (커널 영역은 공유)
+        if (next->proc && next->proc != process_current()) {
+            process_switch(next->proc);
+        }
+        fpu_switch_to(next);
+
+        context_switch(&prev->esp, next->esp);
+        // prev가 다시 선택되면 여기서 재개
+    }
+
+    irq_restore(f);
+}
+
+__attribute__((noreturn))
+void thread_exit(void) {
+    irq_disable();
+
+    thread_t* t = g_current;
+    fpu_thread_exit(t);
+    rt_thread_exit(t);
+    t->state = THREAD_DEAD;
+    t->next = g_zombies;
+    g_zombies = t;
+
+    schedule();
+    panic("thread_exit: dead thread rescheduled");
+}
+
+void thread_yield(void) {
+    schedule();
+}
+
+void thread_block(void) {
+    uint32_t f = irq_save();
+    g_current->state = THREAD_BLOCKED;
+    if (g_current->worker) wq_worker_sleeping(g_current);
+    schedule();
+    irq_restore(f);
+}
+
+void thread_unblock(thread_t* t) {
+    uint32_t f = irq_save();
+
+    if (t->state == THREAD_BLOCKED) {
+        t->state = THREAD_READY;
+        if (t->worker) wq_worker_waking_up(t);
+        rq_push(t);
+        if (should_preempt(t)) g_need_resched = 1;
+    }
+
+    irq_restore(f);
+    sched_preempt_check();
+}
+
+// 인터럽트를 끈 상태에서 호출
+static void sleep_locked(uint64_t wake_tick) {
+    thread_t* t = g_current;
+    t->wake_tick = wake_tick;
+
+    thread_t** link = &g_sleepers;
+    while (*link && (*link)->wake_tick <= t->wake_tick) link = &(*link)->next;
+    t->next = *link;
+    *link = t;
+
+    thread_block();
+}
+
+void thread_sleep(uint32_t ticks) {
+    if (ticks == 0) ticks = 1;
+
+    uint32_t f = irq_save();
+    sleep_locked(timer_ticks() + ticks);
+    irq_restore(f);
+}
+
+int thread_sleep_until(uint64_t tick) {
+    uint32_t f = irq_save();
+    if (timer_ticks() >= tick) {
+        irq_restore(f);
+        return 0;
+    }
+    sleep_locked(tick);
+    irq_restore(f);
+    return 1;
+}
+
+void sched_set_priority(thread_t* t, int priority) {
+    if (priority < PRIO_IDLE) priority = PRIO_IDLE;
+    if (priority > PRIO_MAX) priority = PRIO_MAX;
+
+    uint32_t f = irq_save();
+
+    if (t->priority != priority) {
+        if (t->state == THREAD_READY) {
+            rq_remove(t);
+            t->priority = priority;
+            rq_push(t);
+            if (should_preempt(t)) g_need_resched = 1;
+        } else if (t->state == THREAD_BLOCKED) {
+            t->priority = priority;
+            if (t->wait_on) wait_queue_requeue(t);
+        } else {
+            t->priority = priority;
+            // 자기 자신을 낮춘 경우: 더 높은 READY 스레드가 있으면 양보
+            if (t == g_current && priority < PRIO_MAX && (g_rq_bitmap >> (priority + 1))) {
+                g_need_resched = 1;
+            }
+        }
+    }
+
+    irq_restore(f);
+}
+
+int thread_on_cpu(const thread_t* t) {
+    // 단일 CPU: RUNNING은 항상 현재 스레드뿐
+    return t->state == THREAD_RUNNING && t != g_current;
+}
+
+void sched_tick(void) {
+    if (!g_current) return;
+
+    uint64_t now = timer_ticks();
+
+    // 만료된 sleep 스레드 깨우기 (정렬되어 있으므로 앞에서부터)
+    if (g_sleepers) {
+        while (g_sleepers && g_sleepers->wake_tick <= now) {
+            thread_t* t = g_sleepers;
+            g_sleepers = t->next;
+            t->next = 0;
+            thread_unblock(t);
+        }
+    }
+
+    // 만료된 delayed work를 worker pool로
+    wq_timer_tick(now);
+
+    // RT: release/deadline 검사 + budget 차감 (RT 스레드는 time slice 대신 budget으로 제한)
+    if (rt_tick(g_current, now)) g_need_resched = 1;
+    // 선점 가능 상태(또는 idle 대기)에서 인터럽트됐다면 RCU read-side 구간 밖
+    rcu_tick(g_preempt_count == 0 || g_idle_wait);
+
+    if (g_current->rt) return;
+
+    if (g_current->slice > 0 && --g_current->slice == 0) {
+        // 같은 우선순위에 대기 스레드가 있을 때만 전환 의미가 있음
+        if (g_rq_bitmap >> g_current->priority) g_need_resched = 1;
+        else g_current->slice = SCHED_SLICE_TICKS;
+    }
+}
+
+void sched_preempt_check(void) {
+    // 인터럽트가 꺼진 구간(스핀락 보유 등)에서는 다음 IRQ 종료 시점으로 미룸
+    if (!g_need_resched || g_preempt_count > 0 || in_irq() || irqs_disabled()) return;
+    schedule();
+}
+
+void sched_irq_exit(void) {
+    if (!g_need_resched || g_preempt_count > 0) return;
+    schedule();
+}
+
+void sched_preempt_disable(void) {
+    if (g_preempt_count++ == 0 && g_irqsoff_tracing) trace_preempt_off();
+    __asm__ __volatile__("" : : : "memory");
+}
+
+void sched_preempt_enable(void) {
+    __asm__ __volatile__("" : : : "memory");
+    if (--g_preempt_count == 0 && g_irqsoff_tracing) trace_preempt_on();
+    sched_preempt_check();
+}
+
+__attribute__((noreturn))
+void sched_idle(void) {
+    thread_t* t = g_current;
+    copy_name(t->name, "idle");
+    t->priority = PRIO_IDLE;
+    t->base_priority = PRIO_IDLE;
+    cputime_set_idle(t);
+
+    kprintf("[SCHED] boot thread is now idle\n");
+
+    for (;;) {
+        sched_reap();
+        schedule();
+        safe_halt();
+    }
+}
+
+const char* thread_state_name(thread_state_t s) {
+    switch (s) {
+        case THREAD_READY:   return "ready";
+        case THREAD_RUNNING: return "run";
+        case THREAD_BLOCKED: return "block";
+        case THREAD_DEAD:    return "dead";
+    }
+    return "?";
+}
+
+void sched_for_each_thread(void (*fn)(thread_t* t, void* arg), void* arg) {
+    uint32_t f = irq_save();
+    for (thread_t* t = g_all; t; t = t->all_next) fn(t, arg);
+    irq_restore(f);
+}
+
+void sched_get_stats(sched_stats_t* out) {
+    memset(out, 0, sizeof(*out));
+
+    uint32_t f = irq_save();
+    out->switches = g_switches;
+    for (thread_t* t = g_all; t; t = t->all_next) {
+        out->nr_threads++;
+        if (t->state == THREAD_READY) out->nr_ready++;
+        else if (t->state == THREAD_BLOCKED) out->nr_blocked++;
+    }
+    for (thread_t* t = g_sleepers; t; t = t->next) out->nr_sleepers++;
+    if (g_sleepers) out->next_wake = g_sleepers->wake_tick;
+    irq_restore(f);
+}
+
+void sched_dump(void) {
+    kprintf("[SCHED] switches=%u\n", g_switches);
+    for (thread_t* t = g_all; t; t = t->all_next) {
+        kprintf("  tid=%u %s prio=%d", t->tid, t->name, t->priority);
+        if (t->priority != t->base_priority) kprintf(" (base %d)", t->base_priority);
+        kprintf(" %s%s\n", thread_state_name(t->state), t->fpu ? " fpu" : "");
+    }
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include <stdint.h>
+#include "cputime.h"
+
+#define THREAD_NAME_LEN   16
+#define THREAD_STACK_SIZE (8u * 1024)
+
+// 우선순위: 숫자가 클수록 높음
+#define PRIO_IDLE   0
+#define PRIO_NORMAL 16
+#define PRIO_MAX    31
+#define NR_PRIO     (PRIO_MAX + 1)
+
+// 같은 우선순위 내 round-robin time slice (PIT tick 단위)
+#define SCHED_SLICE_TICKS 5
+
+typedef enum {
+    THREAD_READY = 0,
+    THREAD_RUNNING,
+    THREAD_BLOCKED,
+    THREAD_DEAD,
+} thread_state_t;
+
+struct process;
+struct fpu_state;
+struct wait_queue;
+struct mutex;
+struct rt_task;
+struct worker;
+
+typedef struct thread {
+    uint32_t tid;
+    char name[THREAD_NAME_LEN];
+    thread_state_t state;
+    int priority;               // 실효 우선순위 (priority inheritance로 base보다 높아질 수 있음)
+    int base_priority;
+
+    uint32_t esp;               // context_switch 저장 위치
+    uint8_t* stack;             // 커널 스택 (boot 스레드는 0)
+    uint32_t slice;             // 남은 time slice
+
+    struct rt_task* rt;         // 실시간 클래스 파라미터 (일반 스레드는 0)
+    struct process* proc;       // 0이면 커널 스레드 (주소 공간 전환 안 함)
+    struct fpu_state* fpu;      // FXSAVE 영역 (첫 FPU 사용 시 할당)
+
+    void (*entry)(void*);
+    void* arg;
+
+    struct wait_queue* wait_on; // 현재 대기 중인 wait queue (없으면 0)
+    struct mutex* blocked_on;   // 대기 중인 mutex (PI 전파용)
+    struct mutex* held;         // 보유 중인 mutex 리스트 (PI 복원용)
+    uint64_t wake_tick;         // thread_sleep 만료 tick
+    struct worker* worker;      // workqueue worker 스레드면 worker (concurrency management용)
+    cputime_t acct;             // CPU 시간 계정 (cputime.c)
+
+    struct thread* next;        // run queue / 대기 리스트 연결
+    struct thread* all_next;    // 전체 스레드 리스트
+} thread_t;
+
+// 부팅 컨텍스트를 "main" 스레드로 등록 (heap 초기화 이후)
+void sched_init(void);
+
+thread_t* thread_create(const char* name, void (*entry)(void*), void* arg, int priority);
+
+// 실시간 클래스 스레드 생성 (rt_thread_create에서 admission 후 호출, rt->thread 설정)
+thread_t* thread_create_rt(const char* name, void (*entry)(void*), void* arg, struct rt_task* rt);
+thread_t* thread_current(void);
+
+__attribute__((noreturn))
+void thread_exit(void);
+
+// 같은 우선순위의 다른 스레드에게 양보
+void thread_yield(void);
+
+// 현재 스레드를 BLOCKED로 전환하고 스케줄 (인터럽트를 끈 상태에서 대기 리스트 등록 후 호출)
+void thread_block(void);
+
+// BLOCKED 스레드를 run queue로 (IRQ 컨텍스트에서도 호출 가능)
+void thread_unblock(thread_t* t);
+
+// 현재 스레드를 ticks 동안 재움 (PIT tick 단위, 최소 1)
+void thread_sleep(uint32_t ticks);
+
+// 절대 tick까지 재움. 이미 지났으면 바로 0 반환 (확인과 등록 사이에 tick이 지나가도 늦게 깨지 않음)
+int thread_sleep_until(uint64_t tick);
+
+// 실효 우선순위 변경 (READY면 run queue 재배치, 대기 중이면 wait queue 재정렬)
+void sched_set_priority(thread_t* t, int priority);
+
+// 다른 CPU에서 실행 중인지 (adaptive spin 판단용, 단일 CPU에서는 항상 0)
+int thread_on_cpu(const thread_t* t);
+
+// 다음 실행할 스레드를 골라 전환
+void schedule(void);
+
+// PIT tick마다 1회 (IRQ0)
+void sched_tick(void);
+
+// 스레드 컨텍스트에서 선점 지점: 필요하면 전환
+void sched_preempt_check(void);
+
+// IRQ 처리 끝(EOI 이후)에서 호출: 필요하면 선점
+void sched_irq_exit(void);
+
+// 선점 금지 구간 (중첩 가능)
+void sched_preempt_disable(void);
+void sched_preempt_enable(void);
+
+// 부팅 스레드를 idle 스레드로 전환 (kernel_main의 마지막)
+__attribute__((noreturn))
+void sched_idle(void);
+
+// 모든 스레드에 fn 호출 (인터럽트 off 상태로 순회하므로 fn은 짧게)
+void sched_for_each_thread(void (*fn)(thread_t* t, void* arg), void* arg);
+
+// 스케줄러 전역 상태 스냅샷 (procfs 등)
+typedef struct sched_stats {
+    uint32_t switches;
+    uint32_t nr_threads;
+    uint32_t nr_ready;          // run queue에 있는 스레드
+    uint32_t nr_blocked;
+    uint32_t nr_sleepers;       // thread_sleep 대기 (nr_blocked에 포함)
+    uint64_t next_wake;         // 가장 이른 wake_tick (없으면 0)
+} sched_stats_t;
+
+void sched_get_stats(sched_stats_t* out);
+
+const char* thread_state_name(thread_state_t s);
+
+void sched_dump(void);
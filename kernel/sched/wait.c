@@ -0,0 +1,69 @@
+#include "wait.h"
+#include "../../arch/x86/cpu/irqflags.h"
+
+void wait_queue_add(wait_queue_t* wq, thread_t* t) {
+    thread_t** link = &wq->head;
+    while (*link && (*link)->priority >= t->priority) link = &(*link)->next;
+
+    t->next = *link;
+    *link = t;
+    t->wait_on = wq;
+}
+
+thread_t* wait_queue_pop(wait_queue_t* wq) {
+    thread_t* t = wq->head;
+    if (t) {
+        wq->head = t->next;
+        t->next = 0;
+        t->wait_on = 0;
+    }
+    return t;
+}
+
+int wait_queue_remove(wait_queue_t* wq, thread_t* t) {
+    for (thread_t** link = &wq->head; *link; link = &(*link)->next) {
+        if (*link == t) {
+            *link = t->next;
+            t->next = 0;
+            t->wait_on = 0;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void wait_queue_requeue(thread_t* t) {
+    wait_queue_t* wq = t->wait_on;
+    if (wq && wait_queue_remove(wq, t)) wait_queue_add(wq, t);
+}
+
+void wait_queue_sleep(wait_queue_t* wq) {
+    uint32_t f = irq_save();
+    wait_queue_add(wq, thread_current());
+    thread_block();
+    irq_restore(f);
+}
+
+int wake_up_one(wait_queue_t* wq) {
+    uint32_t f = irq_save();
+    thread_t* t = wait_queue_pop(wq);
+    if (t) thread_unblock(t);
+    irq_restore(f);
+
+    if (t) sched_preempt_check();
+    return t != 0;
+}
+
+uint32_t wake_up_all(wait_queue_t* wq) {
+    uint32_t n = 0;
+    uint32_t f = irq_save();
+    thread_t* t;
+    while ((t = wait_queue_pop(wq)) != 0) {
+        thread_unblock(t);
+        n++;
+    }
+    irq_restore(f);
+
+    if (n) sched_preempt_check();
+    return n;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <stdint.h>
+#include "thread.h"
+
+// 스레드 대기 큐: 우선순위 내림차순, 같은 우선순위는 FIFO (thread->next로 연결)
+// add/pop/remove는 인터럽트를 끈 상태에서 호출한다.
+typedef struct wait_queue {
+    thread_t* head;
+} wait_queue_t;
+
+#define WAIT_QUEUE_INIT { 0 }
+
+static inline void wait_queue_init(wait_queue_t* wq) { wq->head = 0; }
+static inline int wait_queue_empty(const wait_queue_t* wq) { return wq->head == 0; }
+static inline thread_t* wait_queue_peek(const wait_queue_t* wq) { return wq->head; }
+
+void wait_queue_add(wait_queue_t* wq, thread_t* t);
+thread_t* wait_queue_pop(wait_queue_t* wq);
+int wait_queue_remove(wait_queue_t* wq, thread_t* t);
+
+// 우선순위가 바뀐 대기 스레드를 제자리로 (sched_set_priority에서 호출)
+void wait_queue_requeue(thread_t* t);
+
+// 현재 스레드를 wq에 넣고 잠듦. 인터럽트를 끈 상태에서 조건을 확인한 직후 호출해야
+// 확인과 잠들기 사이의 wakeup을 놓치지 않는다.
+void wait_queue_sleep(wait_queue_t* wq);
+
+// 깨운 스레드 수 반환 (IRQ 컨텍스트에서도 호출 가능)
+int wake_up_one(wait_queue_t* wq);
+uint32_t wake_up_all(wait_queue_t* wq);
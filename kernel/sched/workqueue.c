@@ -0,0 +1,418 @@
+#include "workqueue.h"
+#include "wait.h"
+#include "cputime.h"
+#include "../memory/heap.h"
+#include "../time/time.h"
+#include "../panic/panic.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/irqflags.h"
+#include "../../arch/x86/cpu/cache.h"
+#include "../../arch/x86/cpu/smp.h"
+#include "../../arch/x86/interrupt/irq.h"
+
+typedef struct worker_pool worker_pool_t;
+
+typedef struct worker {
+    thread_t* thread;
+    worker_pool_t* pool;
+    uint32_t id;
+    work_t* current;            // 실행 중인 work
+    work_t* scheduled;          // 실행 중에 다시 들어온 같은 work (next로 연결)
+    int idle;                   // idle_wq에서 대기 중
+    int counted;                // pool->nr_running에 포함됨
+    struct worker* next;
+} worker_t;
+
+// CPU별 worker pool. deque와 카운터는 인터럽트를 끈 상태에서만 접근한다 (SMP에서는 pool 락)
+struct worker_pool {
+    uint32_t cpu;
+    work_t* head;               // 로컬 worker는 앞에서 꺼냄 (FIFO)
+    work_t* tail;               // 다른 CPU worker는 뒤에서 훔침
+    uint32_t nr_pending;
+
+    uint32_t nr_workers;
+    uint32_t nr_idle;
+    uint32_t nr_running;        // 작업 중이면서 블록되지 않은 worker 수
+    worker_t* workers;
+    wait_queue_t idle_wq;
+
+    uint32_t executed;
+    uint32_t stolen;
+    uint32_t wakeups;           // 블록된 worker 대신 idle worker를 깨운 횟수
+} __cacheline_aligned;
+
+static worker_pool_t g_pools[MAX_CPUS];
+static int g_wq_ready = 0;
+
+static workqueue_t g_system_wq = { "system", 0, 0, 0 };
+workqueue_t* system_wq = &g_system_wq;
+static workqueue_t* g_workqueues = 0;
+
+// delayed work 타이머 (expires 오름차순)
+static delayed_work_t* g_timers = 0;
+
+// flush_work 대기자: work가 끝날 때마다 모두 깨워 각자 자기 work를 다시 확인
+static wait_queue_t g_flush_wq = WAIT_QUEUE_INIT;
+
+static void pool_push(worker_pool_t* pool, work_t* work) {
+    work->next = 0;
+    work->prev = pool->tail;
+    if (pool->tail) pool->tail->next = work;
+    else pool->head = work;
+    pool->tail = work;
+    pool->nr_pending++;
+}
+
+static work_t* pool_pop_head(worker_pool_t* pool) {
+    work_t* w = pool->head;
+    if (!w) return 0;
+    pool->head = w->next;
+    if (pool->head) pool->head->prev = 0;
+    else pool->tail = 0;
+    w->next = w->prev = 0;
+    pool->nr_pending--;
+    return w;
+}
+
+static work_t* pool_pop_tail(worker_pool_t* pool) {
+    work_t* w = pool->tail;
+    if (!w) return 0;
+    pool->tail = w->prev;
+    if (pool->tail) pool->tail->next = 0;
+    else pool->head = 0;
+    w->next = w->prev = 0;
+    pool->nr_pending--;
+    return w;
+}
+
+// 로컬이 비었을 때: 가장 많이 밀린 다른 pool의 꼬리에서 하나 가져옴
+static work_t* pool_steal(worker_pool_t* self) {
+    worker_pool_t* victim = 0;
+    for (uint32_t c = 0; c < MAX_CPUS; c++) {
+        worker_pool_t* p = &g_pools[c];
+        if (p == self || !p->nr_pending) continue;
+        if (!victim || p->nr_pending > victim->nr_pending) victim = p;
+    }
+    if (!victim) return 0;
+
+    work_t* w = pool_pop_tail(victim);
+    if (w) self->stolen++;
+    return w;
+}
+
+// 대기 작업이 있는데 실행 중인 worker가 없으면 idle worker 하나를 깨움
+static void pool_kick(worker_pool_t* pool) {
+    if (pool->nr_pending && pool->nr_running == 0 && pool->nr_idle) {
+        wake_up_one(&pool->idle_wq);
+    }
+}
+
+void wq_worker_sleeping(thread_t* t) {
+    worker_t* w = t->worker;
+    if (!w || !w->counted) return;
+
+    w->counted = 0;
+    worker_pool_t* pool = w->pool;
+    if (--pool->nr_running == 0 && pool->nr_pending && pool->nr_idle) {
+        pool->wakeups++;
+        wake_up_one(&pool->idle_wq);
+    }
+}
+
+void wq_worker_waking_up(thread_t* t) {
+    worker_t* w = t->worker;
+    if (!w || w->idle || w->counted) return;
+
+    w->counted = 1;
+    w->pool->nr_running++;
+}
+
+// work를 실행 중인 worker 찾기 (work 구조체는 func 안에서 해제될 수 있으므로 worker 쪽에만 기록)
+static worker_t* find_worker_executing(const work_t* work) {
+    for (uint32_t c = 0; c < MAX_CPUS; c++) {
+        for (worker_t* w = g_pools[c].workers; w; w = w->next) {
+            if (w->current == work) return w;
+        }
+    }
+    return 0;
+}
+
+static void worker_main(void* arg);
+
+static worker_t* create_worker(worker_pool_t* pool) {
+    worker_t* w = (worker_t*)kmalloc(sizeof(worker_t));
+    w->pool = pool;
+    w->current = 0;
+    w->scheduled = 0;
+    w->idle = 0;
+    w->counted = 0;
+
+    uint32_t f = irq_save();
+    w->id = pool->nr_workers++;
+    w->next = pool->workers;
+    pool->workers = w;
+    irq_restore(f);
+
+    char name[THREAD_NAME_LEN];
+    ksnprintf(name, sizeof(name), "kworker/%u:%u", pool->cpu, w->id);
+
+    // worker 필드는 첫 실행 전에 채워져야 하므로 thread_create 전에 선점을 막는다
+    sched_preempt_disable();
+    w->thread = thread_create(name, worker_main, w, PRIO_NORMAL);
+    w->thread->worker = w;
+    sched_preempt_enable();
+    return w;
+}
+
+// 인터럽트 off. 이 worker가 실행할 다음 work (없으면 0)
+static work_t* worker_next_work(worker_t* w) {
+    worker_pool_t* pool = w->pool;
+
+    // 이전 work 실행 중에 같은 work가 다시 들어온 경우가 우선
+    if (w->scheduled) {
+        work_t* work = w->scheduled;
+        w->scheduled = work->next;
+        work->next = 0;
+        return work;
+    }
+
+    for (;;) {
+        // 다른 worker가 이미 달리고 있으면 (블록됐다 깨어난 경우 등) 물러난다
+        if (pool->nr_running > 1) return 0;
+
+        work_t* work = pool_pop_head(pool);
+        if (!work) work = pool_steal(pool);
+        if (!work) return 0;
+
+        // 비재진입: 다른 worker가 실행 중인 work면 그 worker 뒤에 붙인다
+        worker_t* owner = find_worker_executing(work);
+        if (owner && owner != w) {
+            work->next = owner->scheduled;
+            owner->scheduled = work;
+            continue;
+        }
+        return work;
+    }
+}
+
+static void worker_main(void* arg) {
+    worker_t* w = (worker_t*)arg;
+    worker_pool_t* pool = w->pool;
+
+    uint32_t f = irq_save();
+    w->counted = 1;
+    pool->nr_running++;
+
+    for (;;) {
+        work_t* work = worker_next_work(w);
+
+        if (!work) {
+            // idle: 실행 카운트에서 빠지고 누군가 깨울 때까지 대기
+            w->counted = 0;
+            pool->nr_running--;
+            w->idle = 1;
+            pool->nr_idle++;
+            pool_kick(pool);
+
+            wait_queue_sleep(&pool->idle_wq);
+
+            pool->nr_idle--;
+            w->idle = 0;
+            w->counted = 1;
+            pool->nr_running++;
+            continue;
+        }
+
+        work->flags &= ~WORK_PENDING;
+        w->current = work;
+        workqueue_t* wq = work->wq;
+
+        // 예비 idle worker가 없으면 하나 더 만들어 둔다 (이 work가 블록돼도 CPU를 이어받도록)
+        int need_worker = (pool->nr_idle == 0 && pool->nr_workers < WQ_MAX_WORKERS);
+        irq_restore(f);
+
+        if (need_worker) create_worker(pool);
+
+        cputime_softirq_enter();
+        work->func(work);
+        cputime_softirq_exit();
+
+        // 여기부터 work는 이미 해제됐을 수 있다
+        f = irq_save();
+        w->current = 0;
+        pool->executed++;
+        if (wq) wq->executed++;
+        if (!wait_queue_empty(&g_flush_wq)) wake_up_all(&g_flush_wq);
+    }
+}
+
+int queue_work_on(uint32_t cpu, workqueue_t* wq, work_t* work) {
+    if (!g_wq_ready || cpu >= MAX_CPUS) return 0;
+
+    uint32_t f = irq_save();
+    if (work->flags & WORK_PENDING) {
+        irq_restore(f);
+        return 0;
+    }
+
+    work->flags |= WORK_PENDING;
+    work->wq = wq;
+    wq->queued++;
+
+    worker_pool_t* pool = &g_pools[cpu];
+    pool_push(pool, work);
+    pool_kick(pool);
+    irq_restore(f);
+
+    sched_preempt_check();
+    return 1;
+}
+
+int queue_work(workqueue_t* wq, work_t* work) {
+    return queue_work_on(cpu_id(), wq, work);
+}
+
+int queue_delayed_work(workqueue_t* wq, delayed_work_t* dw, uint32_t delay) {
+    if (delay == 0) return queue_work(wq, &dw->work);
+    if (!g_wq_ready) return 0;
+
+    uint32_t f = irq_save();
+    if (dw->work.flags & WORK_PENDING) {
+        irq_restore(f);
+        return 0;
+    }
+
+    dw->work.flags |= WORK_PENDING;
+    dw->work.wq = wq;
+    dw->cpu = cpu_id();
+    dw->expires = timer_ticks() + delay;
+
+    delayed_work_t** link = &g_timers;
+    while (*link && (*link)->expires <= dw->expires) link = &(*link)->timer_next;
+    dw->timer_next = *link;
+    *link = dw;
+
+    irq_restore(f);
+    return 1;
+}
+
+// 인터럽트 off. 타이머 리스트에 있으면 빼고 1
+static int timer_remove(delayed_work_t* dw) {
+    for (delayed_work_t** link = &g_timers; *link; link = &(*link)->timer_next) {
+        if (*link == dw) {
+            *link = dw->timer_next;
+            dw->timer_next = 0;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int cancel_delayed_work(delayed_work_t* dw) {
+    uint32_t f = irq_save();
+    int removed = timer_remove(dw);
+    if (removed) dw->work.flags &= ~WORK_PENDING;
+    irq_restore(f);
+    return removed;
+}
+
+void wq_timer_tick(uint64_t now) {
+    while (g_timers && g_timers->expires <= now) {
+        delayed_work_t* dw = g_timers;
+        g_timers = dw->timer_next;
+        dw->timer_next = 0;
+
+        // PENDING은 유지한 채 deque로 옮긴다
+        dw->work.wq->queued++;
+        worker_pool_t* pool = &g_pools[dw->cpu];
+        pool_push(pool, &dw->work);
+        pool_kick(pool);
+    }
+}
+
+int flush_work(work_t* work) {
+    if (in_irq()) {
+        panic("flush_work: called from IRQ context");
+    }
+
+    thread_t* self = thread_current();
+    if (self->worker && self->worker->current == work) {
+        kprintf("[WQ] flush_work: work flushing itself (ignored)\n");
+        return 0;
+    }
+
+    int waited = 0;
+    uint32_t f = irq_save();
+    while ((work->flags & WORK_PENDING) || find_worker_executing(work)) {
+        waited = 1;
+        wait_queue_sleep(&g_flush_wq);
+    }
+    irq_restore(f);
+    return waited;
+}
+
+int flush_delayed_work(delayed_work_t* dw) {
+    // 타이머 대기 중이면 바로 큐로 보내고 기다린다
+    uint32_t f = irq_save();
+    if (timer_remove(dw)) {
+        dw->work.flags &= ~WORK_PENDING;
+        irq_restore(f);
+        queue_work_on(dw->cpu, dw->work.wq, &dw->work);
+    } else {
+        irq_restore(f);
+    }
+    return flush_work(&dw->work);
+}
+
+work_t* current_work(void) {
+    worker_t* w = thread_current()->worker;
+    return w ? w->current : 0;
+}
+
+workqueue_t* workqueue_create(const char* name) {
+    workqueue_t* wq = (workqueue_t*)kmalloc(sizeof(workqueue_t));
+    wq->name = name;
+    wq->queued = 0;
+    wq->executed = 0;
+
+    uint32_t f = irq_save();
+    wq->next = g_workqueues;
+    g_workqueues = wq;
+    irq_restore(f);
+    return wq;
+}
+
+void workqueue_init(void) {
+    g_workqueues = &g_system_wq;
+
+    for (uint32_t c = 0; c < MAX_CPUS; c++) {
+        worker_pool_t* pool = &g_pools[c];
+        pool->cpu = c;
+        pool->head = pool->tail = 0;
+        pool->nr_pending = 0;
+        pool->nr_workers = pool->nr_idle = pool->nr_running = 0;
+        pool->workers = 0;
+        wait_queue_init(&pool->idle_wq);
+        pool->executed = pool->stolen = pool->wakeups = 0;
+    }
+    g_wq_ready = 1;
+
+    for (uint32_t c = 0; c < MAX_CPUS; c++) {
+        for (uint32_t i = 0; i < WQ_MIN_WORKERS; i++) create_worker(&g_pools[c]);
+    }
+
+    kprintf("[WQ] ready (cpus=%u, workers/cpu=%u..%u)\n",
+        (uint32_t)MAX_CPUS, (uint32_t)WQ_MIN_WORKERS, (uint32_t)WQ_MAX_WORKERS);
+}
+
+void workqueue_dump(void) {
+    for (uint32_t c = 0; c < MAX_CPUS; c++) {
+        worker_pool_t* p = &g_pools[c];
+        kprintf("[WQ] pool cpu%u workers=%u idle=%u running=%u pending=%u executed=%u stolen=%u wakeups=%u\n",
+            p->cpu, p->nr_workers, p->nr_idle, p->nr_running, p->nr_pending,
+            p->executed, p->stolen, p->wakeups);
+    }
+    for (workqueue_t* wq = g_workqueues; wq; wq = wq->next) {
+        kprintf("  [WQ] %-8s queued=%u executed=%u\n", wq->name, wq->queued, wq->executed);
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <stdint.h>
+#include "thread.h"
+
+// 커널 workqueue: 지연/백그라운드 작업을 IRQ 밖(worker 스레드)에서 실행
+// - CPU별 worker pool이 로컬 deque에서 작업을 꺼내고, 비면 다른 CPU의 deque 꼬리에서 훔친다
+// - concurrency management: 작업 중인 worker가 잠들면(블록) 같은 pool의 idle worker를 깨워
+//   CPU가 놀지 않게 하고, 실행 중 worker가 둘 이상이면 남는 worker는 idle로 돌아간다
+// - 같은 work는 동시에 두 worker에서 실행되지 않는다 (실행 중 재등록 시 그 worker가 이어서 실행)
+
+#define WQ_MIN_WORKERS 2        // pool 생성 시 worker 수 (실행 1 + 예비 1)
+#define WQ_MAX_WORKERS 8        // pool당 최대 worker 수
+
+// work->flags
+#define WORK_PENDING 0x1        // 큐 또는 타이머에 올라가 있음
+
+struct work;
+struct worker;
+struct workqueue;
+
+typedef void (*work_func_t)(struct work* work);
+
+typedef struct work {
+    struct work* next;          // pool deque (양방향) / worker의 scheduled 리스트
+    struct work* prev;
+    work_func_t func;
+    volatile uint32_t flags;
+    struct workqueue* wq;
+} work_t;
+
+typedef struct delayed_work {
+    work_t work;                // 첫 멤버
+    uint64_t expires;           // 큐에 넣을 tick
+    uint32_t cpu;
+    struct delayed_work* timer_next;
+} delayed_work_t;
+
+typedef struct workqueue {
+    const char* name;
+    uint32_t queued;
+    uint32_t executed;
+    struct workqueue* next;
+} workqueue_t;
+
+// 부팅 시 만들어지는 공용 workqueue (workqueue_init 이후 유효)
+extern workqueue_t* system_wq;
+
+static inline void work_init(work_t* w, work_func_t func) {
+    w->next = 0;
+    w->prev = 0;
+    w->func = func;
+    w->flags = 0;
+    w->wq = 0;
+}
+
+static inline void delayed_work_init(delayed_work_t* dw, work_func_t func) {
+    work_init(&dw->work, func);
+    dw->expires = 0;
+    dw->cpu = 0;
+    dw->timer_next = 0;
+}
+
+// CPU별 pool과 초기 worker 생성, system_wq 등록 (sched_init 이후)
+void workqueue_init(void);
+
+workqueue_t* workqueue_create(const char* name);
+
+// 이미 대기 중이면 0, 새로 넣었으면 1 (IRQ 컨텍스트에서도 호출 가능)
+int queue_work(workqueue_t* wq, work_t* work);
+int queue_work_on(uint32_t cpu, workqueue_t* wq, work_t* work);
+
+// delay tick 뒤에 큐에 넣음 (delay 0이면 바로)
+int queue_delayed_work(workqueue_t* wq, delayed_work_t* dw, uint32_t delay);
+
+// 타이머에서 아직 큐로 가지 않은 delayed work 취소. 취소했으면 1
+int cancel_delayed_work(delayed_work_t* dw);
+
+// work가 대기/실행 중이면 끝날 때까지 대기 (스레드 컨텍스트 전용). 기다렸으면 1
+int flush_work(work_t* work);
+int flush_delayed_work(delayed_work_t* dw);
+
+// 현재 스레드가 worker면 실행 중인 work (아니면 0)
+work_t* current_work(void);
+
+// ---- sched.c 연동 (인터럽트 off) ----
+void wq_worker_sleeping(thread_t* t);
+void wq_worker_waking_up(thread_t* t);
+void wq_timer_tick(uint64_t now);
+
+void workqueue_dump(void);
@@ -0,0 +1,103 @@
+#include "futex.h"
+#include "../sched/thread.h"
+#include "../memory/vma.h"
+#include "../lib/errno.h"
+#include "../console/kprintf.h"
+#include "../panic/panic.h"
+#include "../../arch/x86/cpu/irqflags.h"
+#include "../../arch/x86/interrupt/irq.h"
+
+#define FUTEX_HASH_BITS 5
+#define FUTEX_HASH_SIZE (1u << FUTEX_HASH_BITS)
+
+// 대기자는 futex_wait의 스택에 있다 (잠든 동안만 유효)
+typedef struct futex_waiter {
+    thread_t* thread;
+    vm_space_t* space;          // 커널 주소면 0
+    uint32_t addr;
+    struct futex_waiter* next;
+} futex_waiter_t;
+
+static futex_waiter_t* g_buckets[FUTEX_HASH_SIZE];
+
+static uint32_t g_waits = 0;
+static uint32_t g_wait_eagain = 0;
+static uint32_t g_wakes = 0;
+static uint32_t g_woken = 0;
+
+static vm_space_t* key_space(uint32_t addr) {
+    if (addr >= USER_SPACE_START && addr < USER_SPACE_END) return vm_current_space();
+    return 0;
+}
+
+static uint32_t key_hash(vm_space_t* vs, uint32_t addr) {
+    uint32_t h = (addr >> 2) ^ ((uint32_t)vs >> 4);
+    h *= 0x9E3779B1u;       // golden ratio multiplicative hash
+    return h >> (32 - FUTEX_HASH_BITS);
+}
+
+int futex_wait(volatile uint32_t* addr, uint32_t expected) {
+    uint32_t a = (uint32_t)addr;
+    if (a & 3) return -EINVAL;
+    if (in_irq()) {
+        panic("futex_wait: blocking call in IRQ context");
+    }
+
+    futex_waiter_t w;
+    w.thread = thread_current();
+    w.space = key_space(a);
+    w.addr = a;
+
+    uint32_t f = irq_save();
+
+    // 값 확인과 대기 등록 사이에 futex_wake가 끼어들지 못하도록 인터럽트를 끈 채로 확인
+    if (*addr != expected) {
+        g_wait_eagain++;
+        irq_restore(f);
+        return -EAGAIN;
+    }
+
+    // 버킷 끝에 추가 (같은 키는 FIFO로 깨어남)
+    futex_waiter_t** link = &g_buckets[key_hash(w.space, a)];
+    while (*link) link = &(*link)->next;
+    w.next = 0;
+    *link = &w;
+    g_waits++;
+
+    thread_block();
+    irq_restore(f);
+    return 0;
+}
+
+int futex_wake(volatile uint32_t* addr, uint32_t n) {
+    uint32_t a = (uint32_t)addr;
+    if (a & 3) return -EINVAL;
+
+    vm_space_t* vs = key_space(a);
+    int woken = 0;
+
+    uint32_t f = irq_save();
+    g_wakes++;
+
+    futex_waiter_t** link = &g_buckets[key_hash(vs, a)];
+    while (*link && (uint32_t)woken < n) {
+        futex_waiter_t* w = *link;
+        if (w->addr == a && w->space == vs) {
+            *link = w->next;
+            thread_unblock(w->thread);
+            woken++;
+        } else {
+            link = &w->next;
+        }
+    }
+    g_woken += (uint32_t)woken;
+
+    irq_restore(f);
+    if (woken) sched_preempt_check();
+    return woken;
+}
+
+void futex_dump_stats(void) {
+    kprintf("[FUTEX] waits=%u eagain=%u wakes=%u woken=%u\n",
+        g_waits, g_wait_eagain, g_wakes, g_woken);
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <stdint.h>
+
+// futex: 주소를 키로 하는 대기/깨우기
+// 락 상태는 호출자 메모리(32비트 워드)에 있고, 경합이 있을 때만 커널에 들어온다.
+// 키 = (주소 공간, 주소). 유저 주소는 프로세스별, 커널 주소는 전역으로 구분된다.
+
+// *addr == expected면 futex_wake까지 잠듦. 값이 다르면 -EAGAIN (호출자는 다시 확인)
+int futex_wait(volatile uint32_t* addr, uint32_t expected);
+
+// addr에서 기다리는 스레드를 최대 n개 깨우고 깨운 수 반환
+int futex_wake(volatile uint32_t* addr, uint32_t n);
+
+void futex_dump_stats(void);
@@ -0,0 +1,186 @@
+#include "mutex.h"
+#include "../panic/panic.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/cache.h"
+#include "../../arch/x86/cpu/irqflags.h"
+#include "../../arch/x86/interrupt/irq.h"
+
+// PI 전파 체인 길이 상한 (A가 기다리는 mutex의 소유자 B가 또 다른 mutex를 기다리는 ...)
+#define PI_MAX_DEPTH 8
+
+static inline int owner_cas(mutex_t* m, uint32_t old, uint32_t val) {
+    return __sync_bool_compare_and_swap(&m->owner, old, val);
+}
+
+void mutex_init(mutex_t* m, const char* name) {
+    m->owner = 0;
+    wait_queue_init(&m->waiters);
+    m->held_next = 0;
+    m->name = name ? name : "mutex";
+    m->contended = 0;
+    m->spin_acquired = 0;
+    m->pi_boosts = 0;
+}
+
+// held 리스트 (인터럽트를 끈 상태에서 호출)
+static void held_add(thread_t* t, mutex_t* m) {
+    m->held_next = t->held;
+    t->held = m;
+}
+
+static void held_remove(thread_t* t, mutex_t* m) {
+    for (mutex_t** link = &t->held; *link; link = &(*link)->held_next) {
+        if (*link == m) {
+            *link = m->held_next;
+            m->held_next = 0;
+            return;
+        }
+    }
+}
+
+// 대기자가 생긴 m의 소유자 체인에 우선순위 상속
+static void pi_propagate(mutex_t* m) {
+    for (int depth = 0; m && depth < PI_MAX_DEPTH; depth++) {
+        thread_t* top = wait_queue_peek(&m->waiters);
+        thread_t* owner = mutex_owner(m);
+        if (!top || !owner || owner->priority >= top->priority) return;
+
+        sched_set_priority(owner, top->priority);
+        m->pi_boosts++;
+        m = owner->blocked_on;
+    }
+}
+
+// 보유 중인 mutex들의 최고 대기자 우선순위와 base 중 큰 값으로 복원
+static void pi_restore(thread_t* t) {
+    int prio = t->base_priority;
+    for (mutex_t* h = t->held; h; h = h->held_next) {
+        thread_t* top = wait_queue_peek(&h->waiters);
+        if (top && top->priority > prio) prio = top->priority;
+    }
+    if (prio != t->priority) sched_set_priority(t, prio);
+}
+
+int mutex_trylock(mutex_t* m) {
+    thread_t* cur = thread_current();
+    if (!owner_cas(m, 0, (uint32_t)cur)) return 0;
+
+    uint32_t f = irq_save();
+    held_add(cur, m);
+    irq_restore(f);
+    return 1;
+}
+
+static void mutex_lock_slow(mutex_t* m, thread_t* cur) {
+    // adaptive spin: 소유자가 다른 CPU에서 돌고 있는 동안만
+    for (uint32_t i = 0; i < MUTEX_SPIN_LIMIT; i++) {
+        uint32_t o = m->owner;
+        if (o == 0) {
+            if (owner_cas(m, 0, (uint32_t)cur)) {
+                uint32_t f = irq_save();
+                held_add(cur, m);
+                m->spin_acquired++;
+                irq_restore(f);
+                return;
+            }
+            continue;
+        }
+        thread_t* owner = (thread_t*)(o & ~MUTEX_HAS_WAITERS);
+        if (!thread_on_cpu(owner)) break;
+        cpu_relax();
+    }
+
+    uint32_t f = irq_save();
+    m->contended++;
+
+    for (;;) {
+        uint32_t o = m->owner;
+
+        if ((o & ~MUTEX_HAS_WAITERS) == 0) {
+            uint32_t val = (uint32_t)cur | (wait_queue_empty(&m->waiters) ? 0 : MUTEX_HAS_WAITERS);
+            if (owner_cas(m, o, val)) {
+                held_add(cur, m);
+                break;
+            }
+            continue;
+        }
+
+        if (!(o & MUTEX_HAS_WAITERS) && !owner_cas(m, o, o | MUTEX_HAS_WAITERS)) continue;
+
+        cur->blocked_on = m;
+        wait_queue_add(&m->waiters, cur);
+        pi_propagate(m);
+
+        thread_block();
+        cur->blocked_on = 0;
+
+        // unlock이 직접 넘겨준 경우 (held 리스트도 unlock 쪽에서 등록)
+        if (mutex_owner(m) == cur) break;
+    }
+
+    irq_restore(f);
+}
+
+void mutex_lock(mutex_t* m) {
+    if (in_irq()) {
+        panic("mutex_lock: called in IRQ context");
+    }
+
+    thread_t* cur = thread_current();
+    if (mutex_owner(m) == cur) {
+        kprintf("[MUTEX] %s: recursive lock by %s\n", m->name, cur->name);
+        panic("mutex_lock: deadlock");
+    }
+
+    if (owner_cas(m, 0, (uint32_t)cur)) {
+        uint32_t f = irq_save();
+        held_add(cur, m);
+        irq_restore(f);
+        return;
+    }
+
+    mutex_lock_slow(m, cur);
+}
+
+void mutex_unlock(mutex_t* m) {
+    thread_t* cur = thread_current();
+    if (mutex_owner(m) != cur) {
+        kprintf("[MUTEX] %s: unlock by non-owner %s\n", m->name, cur->name);
+        panic("mutex_unlock: not owner");
+    }
+
+    uint32_t f = irq_save();
+    held_remove(cur, m);
+
+    // 대기자가 없으면 CAS 한 번으로 끝
+    if (owner_cas(m, (uint32_t)cur, 0)) {
+        irq_restore(f);
+        return;
+    }
+
+    // 가장 높은 우선순위 대기자에게 직접 넘김 (깨어난 뒤 다시 경쟁하지 않음)
+    thread_t* next = wait_queue_pop(&m->waiters);
+    if (next) {
+        m->owner = (uint32_t)next | (wait_queue_empty(&m->waiters) ? 0 : MUTEX_HAS_WAITERS);
+        next->blocked_on = 0;
+        held_add(next, m);
+    } else {
+        m->owner = 0;
+    }
+
+    // 상속받은 우선순위 반납 (next가 남은 대기자를 대신 책임짐)
+    pi_restore(cur);
+    if (next) {
+        pi_restore(next);
+        thread_unblock(next);
+    }
+
+    irq_restore(f);
+    sched_preempt_check();
+}
+
+void mutex_dump(const mutex_t* m) {
+    thread_t* owner = mutex_owner(m);
+    kprintf("[MUTEX] %s: owner=%s contended=%u spin_acquired=%u pi_boosts=%u\n",
+        m->name, owner ? owner->name : "-", m->contended, m->spin_acquired, m->pi_boosts);
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <stdint.h>
+#include "../sched/wait.h"
+
+// 적응형 mutex + priority inheritance
+// - fast path: owner 필드 CAS 한 번 (0 -> 현재 스레드)
+// - 소유자가 다른 CPU에서 실행 중이면 잠들기 전에 잠깐 spin (곧 풀릴 가능성이 높음)
+// - 잠들 때 소유자(와 그 소유자가 기다리는 mutex의 소유자...)의 우선순위를 대기자 수준으로 올림
+// - unlock은 가장 높은 우선순위 대기자에게 직접 넘겨주고, 자신의 우선순위를 원래대로 되돌림
+// 스레드 컨텍스트 전용 (IRQ 핸들러에서는 semaphore/ring 사용)
+
+// owner 하위 비트: 대기자 있음 (unlock fast path를 막아 slow path로 유도)
+#define MUTEX_HAS_WAITERS 0x1u
+
+// 소유자가 실행 중일 때 잠들기 전 spin 횟수 상한
+#define MUTEX_SPIN_LIMIT 1000
+
+typedef struct mutex {
+    volatile uint32_t owner;    // thread_t* | MUTEX_HAS_WAITERS
+    wait_queue_t waiters;
+    struct mutex* held_next;    // 소유 스레드의 held 리스트
+
+    const char* name;
+    uint32_t contended;         // slow path 진입 횟수
+    uint32_t spin_acquired;     // spin 중 획득 (잠들지 않음)
+    uint32_t pi_boosts;         // 소유자 우선순위 상승 횟수
+} mutex_t;
+
+void mutex_init(mutex_t* m, const char* name);
+
+void mutex_lock(mutex_t* m);
+int mutex_trylock(mutex_t* m);
+void mutex_unlock(mutex_t* m);
+
+static inline thread_t* mutex_owner(const mutex_t* m) {
+    return (thread_t*)(m->owner & ~MUTEX_HAS_WAITERS);
+}
+
+static inline int mutex_has_waiters(const mutex_t* m) {
+    return (m->owner & MUTEX_HAS_WAITERS) != 0;
+}
+
+void mutex_dump(const mutex_t* m);
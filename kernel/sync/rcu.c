@@ -0,0 +1,207 @@
+#include "rcu.h"
+#include "semaphore.h"
+#include "../sched/cputime.h"
+#include "../sched/wait.h"
+#include "../panic/panic.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/irqflags.h"
+#include "../../arch/x86/cpu/smp.h"
+#include "../../arch/x86/cpu/cache.h"
+#include "../../arch/x86/interrupt/irq.h"
+
+// 콜백 리스트 (head + tail 포인터로 O(1) append / splice)
+typedef struct rcu_cblist {
+    rcu_head_t* head;
+    rcu_head_t** tail;
+    uint32_t len;
+} rcu_cblist_t;
+
+// CPU별 상태: 자기 CPU에서만 쓰므로 reader/writer 사이 공유 캐시 라인이 없다
+typedef struct rcu_cpu {
+    rcu_cblist_t next;      // 아직 grace period에 배정되지 않은 콜백
+    rcu_cblist_t wait;      // wait_gp가 끝나기를 기다리는 콜백
+    uint32_t wait_gp;
+    uint32_t qs_count;      // 보고한 quiescent state 수 (통계)
+} __cacheline_aligned rcu_cpu_t;
+
+static rcu_cpu_t g_rcu_cpu[MAX_CPUS];
+
+// grace period 번호: completed == current이면 진행 중인 GP 없음
+static volatile uint32_t g_gp_current = 0;
+static volatile uint32_t g_gp_completed = 0;
+
+// 이번 GP에서 아직 quiescent state를 지나지 않은 CPU 비트맵
+static volatile uint32_t g_qs_mask = 0;
+
+// GP가 끝나 실행만 남은 콜백 ("rcu" 스레드가 소비)
+static rcu_cblist_t g_done;
+static wait_queue_t g_rcu_wq = WAIT_QUEUE_INIT;
+static thread_t* g_rcu_thread = 0;
+
+static uint32_t g_cb_queued = 0;
+static uint32_t g_cb_invoked = 0;
+static uint32_t g_max_batch = 0;
+
+static void cblist_init(rcu_cblist_t* l) {
+    l->head = 0;
+    l->tail = &l->head;
+    l->len = 0;
+}
+
+static void cblist_append(rcu_cblist_t* l, rcu_head_t* h) {
+    if (!l->tail) cblist_init(l);   // rcu_init 이전 호출
+    h->next = 0;
+    *l->tail = h;
+    l->tail = &h->next;
+    l->len++;
+}
+
+// src 전체를 dst 끝으로 옮김
+static void cblist_splice(rcu_cblist_t* dst, rcu_cblist_t* src) {
+    if (!src->head) return;
+    *dst->tail = src->head;
+    dst->tail = src->tail;
+    dst->len += src->len;
+    cblist_init(src);
+}
+
+// 인터럽트 off. 대기 중인 콜백이 있으면 새 GP 시작 (그 시점까지 쌓인 콜백을 한 GP에 묶음)
+static void rcu_start_gp(void) {
+    if (g_gp_current != g_gp_completed) return;
+
+    int pending = 0;
+    for (uint32_t c = 0; c < MAX_CPUS; c++) {
+        if (g_rcu_cpu[c].next.head) pending = 1;
+    }
+    if (!pending) return;
+
+    g_gp_current = g_gp_completed + 1;
+    g_qs_mask = cpu_online_mask();
+
+    for (uint32_t c = 0; c < MAX_CPUS; c++) {
+        rcu_cpu_t* rc = &g_rcu_cpu[c];
+        cblist_splice(&rc->wait, &rc->next);
+        rc->wait_gp = g_gp_current;
+    }
+}
+
+// 인터럽트 off. 모든 CPU가 QS를 지났으면 GP 종료 → 콜백을 done으로
+static void rcu_end_gp(void) {
+    g_gp_completed = g_gp_current;
+
+    uint32_t batch = 0;
+    for (uint32_t c = 0; c < MAX_CPUS; c++) {
+        rcu_cpu_t* rc = &g_rcu_cpu[c];
+        if (rc->wait.head && rc->wait_gp == g_gp_completed) {
+            batch += rc->wait.len;
+            cblist_splice(&g_done, &rc->wait);
+        }
+    }
+    if (batch > g_max_batch) g_max_batch = batch;
+
+    if (g_done.head) wake_up_one(&g_rcu_wq);
+
+    // 그 사이 쌓인 콜백은 바로 다음 GP로
+    rcu_start_gp();
+}
+
+static void rcu_report_qs(uint32_t cpu) {
+    g_rcu_cpu[cpu].qs_count++;
+
+    uint32_t bit = 1u << cpu;
+    if (g_gp_current == g_gp_completed || !(g_qs_mask & bit)) return;
+
+    g_qs_mask &= ~bit;
+    if (g_qs_mask == 0) rcu_end_gp();
+}
+
+void rcu_note_context_switch(void) {
+    // schedule()은 선점 가능 지점에서만 불리므로 read-side 구간 밖
+    rcu_report_qs(cpu_id());
+}
+
+void rcu_tick(int in_qs) {
+    if (in_qs) rcu_report_qs(cpu_id());
+    rcu_start_gp();
+}
+
+void call_rcu(rcu_head_t* head, void (*func)(rcu_head_t* head)) {
+    head->func = func;
+
+    uint32_t f = irq_save();
+    cblist_append(&g_rcu_cpu[cpu_id()].next, head);
+    g_cb_queued++;
+    irq_restore(f);
+}
+
+// synchronize_rcu 대기자: rcu_head가 첫 멤버이므로 포인터 캐스트로 되돌린다
+typedef struct rcu_sync {
+    rcu_head_t head;
+    semaphore_t done;
+} rcu_sync_t;
+
+static void rcu_sync_wakeup(rcu_head_t* head) {
+    sem_up(&((rcu_sync_t*)head)->done);
+}
+
+void synchronize_rcu(void) {
+    if (in_irq()) {
+        panic("synchronize_rcu: called from IRQ context");
+    }
+    if (!g_rcu_thread) {
+        // 스케줄러/rcu 스레드 이전: 다른 스레드가 없고 IRQ reader는 이미 끝났다
+        return;
+    }
+
+    rcu_sync_t s;
+    sem_init(&s.done, 0);
+    call_rcu(&s.head, rcu_sync_wakeup);
+    sem_down(&s.done);
+}
+
+static void rcu_thread_main(void* arg) {
+    (void)arg;
+
+    for (;;) {
+        uint32_t f = irq_save();
+        while (!g_done.head) {
+            wait_queue_sleep(&g_rcu_wq);
+        }
+        rcu_head_t* list = g_done.head;
+        cblist_init(&g_done);
+        irq_restore(f);
+
+        // 콜백은 스레드 컨텍스트에서 실행 (kfree, sem_up 등)
+        cputime_softirq_enter();
+        while (list) {
+            rcu_head_t* next = list->next;
+            list->func(list);
+            g_cb_invoked++;
+            list = next;
+        }
+        cputime_softirq_exit();
+    }
+}
+
+void rcu_init(void) {
+    for (uint32_t c = 0; c < MAX_CPUS; c++) {
+        cblist_init(&g_rcu_cpu[c].next);
+        cblist_init(&g_rcu_cpu[c].wait);
+    }
+    cblist_init(&g_done);
+
+    // 콜백이 밀리면 메모리 해제가 늦어지므로 일반 스레드보다 높게
+    g_rcu_thread = thread_create("rcu", rcu_thread_main, 0, PRIO_MAX - 1);
+    if (!g_rcu_thread) {
+        panic("rcu_init: cannot create rcu thread");
+    }
+    kprintf("[RCU] ready (cpus=%u)\n", (uint32_t)MAX_CPUS);
+}
+
+void rcu_dump_stats(void) {
+    uint32_t qs = 0;
+    for (uint32_t c = 0; c < MAX_CPUS; c++) qs += g_rcu_cpu[c].qs_count;
+
+    kprintf("[RCU] gp=%u queued=%u invoked=%u max_batch=%u qs=%u\n",
+        g_gp_completed, g_cb_queued, g_cb_invoked, g_max_batch, qs);
+}
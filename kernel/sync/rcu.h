@@ -0,0 +1,49 @@
+#pragma once
+#include <stdint.h>
+#include "../sched/thread.h"
+
+// RCU (Read-Copy-Update)
+// - reader: rcu_read_lock/unlock = 선점 금지만 (락 없음, 공유 캐시 라인 쓰기 없음)
+// - writer: 새 복사본을 만들어 rcu_assign_pointer로 교체하고, 옛 것은 call_rcu로 grace period 뒤 해제
+// - grace period: 모든 CPU가 quiescent state(컨텍스트 스위치, idle, 선점 허용 상태의 tick)를 한 번씩 지난 시점
+// - 콜백은 tick에서 묶어서(batch) 하나의 grace period에 태우고, 완료되면 "rcu" 스레드가 실행
+// IRQ 핸들러(인터럽트 off 구간)는 그 자체로 read-side 구간이다.
+
+typedef struct rcu_head {
+    struct rcu_head* next;
+    void (*func)(struct rcu_head* head);
+} rcu_head_t;
+
+static inline void rcu_read_lock(void) {
+    sched_preempt_disable();
+}
+
+static inline void rcu_read_unlock(void) {
+    sched_preempt_enable();
+}
+
+// 게시: 초기화한 내용이 포인터보다 먼저 보이도록 release store
+#define rcu_assign_pointer(p, v) __atomic_store_n(&(p), (v), __ATOMIC_RELEASE)
+
+// 읽기: 포인터를 한 번만 읽음 (x86은 의존 load 순서가 보장되므로 컴파일러 배리어 수준)
+#define rcu_dereference(p) __atomic_load_n(&(p), __ATOMIC_CONSUME)
+
+// "rcu" 콜백 스레드 생성 (sched_init 이후)
+void rcu_init(void);
+
+// grace period 뒤 func(head) 호출 (IRQ 컨텍스트에서도 호출 가능)
+void call_rcu(rcu_head_t* head, void (*func)(rcu_head_t* head));
+
+// 지금 진행 중인 모든 reader가 끝날 때까지 대기 (스레드 컨텍스트 전용)
+void synchronize_rcu(void);
+
+// ---- sched.c 연동 (인터럽트 off) ----
+void rcu_note_context_switch(void);
+
+// 매 tick. in_qs = 인터럽트된 컨텍스트가 read-side 구간 밖이었는지
+void rcu_tick(int in_qs);
+
+void rcu_dump_stats(void);
+
+// RCU vs rwlock reader 비용 비교 (reader 4 + writer 1, 스레드로 실행 후 결과 출력)
+void rcu_stress(void);
@@ -0,0 +1,182 @@
+#include "rcu.h"
+#include "rwlock.h"
+#include "semaphore.h"
+#include "../memory/heap.h"
+#include "../console/kprintf.h"
+#include "../lib/cmdline.h"
+#include "../lib/div64.h"
+#include "../../arch/x86/cpu/tsc.h"
+#include "../../arch/x86/cpu/smp.h"
+
+// read-mostly 설정 테이블을 RCU / rwlock으로 보호했을 때의 reader 비용 비교
+// reader는 (a + b == sum) 불변식을 검사하므로 찢어진 읽기나 해제 후 접근(poison)이 있으면 err로 잡힌다.
+#define STRESS_READERS   4
+#define STRESS_BATCH     1024     // TSC는 배치 단위로 재서 선점 구간을 최솟값에서 제외
+#define STRESS_BATCHES   256
+#define STRESS_POISON    0xDEADBEEFu
+
+typedef struct stress_cfg {
+    rcu_head_t rcu;               // 첫 멤버 (콜백에서 캐스트)
+    uint32_t a;
+    uint32_t b;
+    uint32_t sum;
+} stress_cfg_t;
+
+typedef enum { STRESS_RWLOCK = 0, STRESS_RCU } stress_mode_t;
+
+typedef struct stress_reader {
+    uint64_t cycles;              // 전체 루프
+    uint64_t best_batch;          // 가장 빠른 배치 (선점 없는 순수 read 비용)
+    uint32_t errors;
+} stress_reader_t;
+
+static stress_mode_t g_mode;
+static stress_cfg_t* g_rcu_cfg;
+static stress_cfg_t g_rw_cfg;
+static rwlock_t g_rw_lock = RWLOCK_INIT;
+
+static stress_reader_t g_readers[STRESS_READERS];
+static semaphore_t g_readers_done;
+static volatile int g_stop_writer;
+static volatile uint32_t g_updates;
+static semaphore_t g_writer_done;
+
+static void cfg_set(stress_cfg_t* c, uint32_t seq) {
+    c->a = seq * 3;
+    c->b = seq * 5 + 1;
+    c->sum = c->a + c->b;
+}
+
+static void cfg_free(rcu_head_t* head) {
+    stress_cfg_t* c = (stress_cfg_t*)head;
+    c->sum = STRESS_POISON;
+    kfree(c);
+}
+
+static inline uint32_t read_rcu(void) {
+    rcu_read_lock();
+    const stress_cfg_t* c = rcu_dereference(g_rcu_cfg);
+    uint32_t bad = (c->a + c->b != c->sum);
+    rcu_read_unlock();
+    return bad;
+}
+
+static inline uint32_t read_rwlock(void) {
+    read_lock(&g_rw_lock);
+    uint32_t bad = (g_rw_cfg.a + g_rw_cfg.b != g_rw_cfg.sum);
+    read_unlock(&g_rw_lock);
+    return bad;
+}
+
+static void stress_reader(void* arg) {
+    stress_reader_t* st = (stress_reader_t*)arg;
+    st->cycles = 0;
+    st->best_batch = ~0ull;
+    st->errors = 0;
+
+    for (uint32_t b = 0; b < STRESS_BATCHES; b++) {
+        uint64_t t0 = rdtsc();
+        if (g_mode == STRESS_RCU) {
+            for (uint32_t i = 0; i < STRESS_BATCH; i++) st->errors += read_rcu();
+        } else {
+            for (uint32_t i = 0; i < STRESS_BATCH; i++) st->errors += read_rwlock();
+        }
+        uint64_t dt = rdtsc() - t0;
+
+        st->cycles += dt;
+        if (dt < st->best_batch) st->best_batch = dt;
+    }
+
+    sem_up(&g_readers_done);
+}
+
+static void stress_writer(void* arg) {
+    (void)arg;
+    uint32_t seq = 1;
+
+    while (!g_stop_writer) {
+        seq++;
+        if (g_mode == STRESS_RCU) {
+            // copy → update → publish → 옛 버전은 grace period 뒤 해제
+            stress_cfg_t* n = (stress_cfg_t*)kmalloc(sizeof(stress_cfg_t));
+            cfg_set(n, seq);
+            stress_cfg_t* old = g_rcu_cfg;
+            rcu_assign_pointer(g_rcu_cfg, n);
+            call_rcu(&old->rcu, cfg_free);
+        } else {
+            write_lock(&g_rw_lock);
+            cfg_set(&g_rw_cfg, seq);
+            write_unlock(&g_rw_lock);
+        }
+        g_updates++;
+        thread_sleep(1);
+    }
+
+    sem_up(&g_writer_done);
+}
+
+static void stress_run(stress_mode_t mode) {
+    g_mode = mode;
+    g_stop_writer = 0;
+    g_updates = 0;
+    sem_init(&g_readers_done, 0);
+    sem_init(&g_writer_done, 0);
+
+    thread_create("stress-w", stress_writer, 0, PRIO_NORMAL + 1);
+    for (uint32_t i = 0; i < STRESS_READERS; i++) {
+        thread_create(mode == STRESS_RCU ? "stress-rcu" : "stress-rw", stress_reader, &g_readers[i], PRIO_NORMAL);
+    }
+    for (uint32_t i = 0; i < STRESS_READERS; i++) sem_down(&g_readers_done);
+
+    g_stop_writer = 1;
+    sem_down(&g_writer_done);
+
+    uint64_t total = 0;
+    uint64_t best = ~0ull;
+    uint32_t errors = 0;
+    for (uint32_t i = 0; i < STRESS_READERS; i++) {
+        total += g_readers[i].cycles;
+        if (g_readers[i].best_batch < best) best = g_readers[i].best_batch;
+        errors += g_readers[i].errors;
+    }
+
+    uint64_t reads = (uint64_t)STRESS_READERS * STRESS_BATCHES * STRESS_BATCH;
+    // cycles/read를 소수 둘째 자리까지 (64비트 나눗셈은 div_u64_u32로)
+    uint64_t avg = total * 100;
+    div_u64_u32(&avg, (uint32_t)reads);
+    uint32_t avg_frac = div_u64_u32(&avg, 100);
+    uint64_t fast = best * 100;
+    div_u64_u32(&fast, STRESS_BATCH);
+    uint32_t fast_frac = div_u64_u32(&fast, 100);
+
+    kprintf("[RCU-STRESS] %-6s readers=%u reads=%llu updates=%u errors=%u cyc/read avg=%llu.%02u best=%llu.%02u\n",
+        mode == STRESS_RCU ? "rcu" : "rwlock", (uint32_t)STRESS_READERS, reads, g_updates, errors,
+        avg, avg_frac, fast, fast_frac);
+}
+
+static void rcu_stress_main(void* arg) {
+    (void)arg;
+
+    g_rcu_cfg = (stress_cfg_t*)kmalloc(sizeof(stress_cfg_t));
+    cfg_set(g_rcu_cfg, 1);
+    cfg_set(&g_rw_cfg, 1);
+
+    kprintf("[RCU-STRESS] %u readers + 1 writer (1 update/tick), cpus=%u\n",
+        (uint32_t)STRESS_READERS, (uint32_t)MAX_CPUS);
+
+    stress_run(STRESS_RWLOCK);
+    stress_run(STRESS_RCU);
+
+    // 마지막 버전까지 정리: 대기 중인 콜백이 모두 실행되도록 grace period 한 번 더
+    stress_cfg_t* last = g_rcu_cfg;
+    rcu_assign_pointer(g_rcu_cfg, (stress_cfg_t*)0);
+    synchronize_rcu();
+    kfree(last);
+
+    rcu_dump_stats();
+}
+
+void rcu_stress(void) {
+    if (!cmdline_bench("rcu")) return;
+    thread_create("rcu-stress", rcu_stress_main, 0, PRIO_NORMAL + 1);
+}
@@ -0,0 +1,29 @@
+#include "rwlock.h"
+#include "../sched/thread.h"
+#include "../../arch/x86/cpu/cache.h"
+
+void read_lock(rwlock_t* l) {
+    sched_preempt_disable();
+    for (;;) {
+        int32_t v = l->cnt;
+        if (v >= 0 && __sync_bool_compare_and_swap(&l->cnt, v, v + 1)) return;
+        cpu_relax();
+    }
+}
+
+void read_unlock(rwlock_t* l) {
+    __sync_fetch_and_sub(&l->cnt, 1);
+    sched_preempt_enable();
+}
+
+void write_lock(rwlock_t* l) {
+    sched_preempt_disable();
+    while (!__sync_bool_compare_and_swap(&l->cnt, 0, -1)) {
+        cpu_relax();
+    }
+}
+
+void write_unlock(rwlock_t* l) {
+    __sync_lock_release(&l->cnt);
+    sched_preempt_enable();
+}
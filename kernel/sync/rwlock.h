@@ -0,0 +1,19 @@
+#pragma once
+#include <stdint.h>
+
+// reader-writer 스핀락 (선점 금지 구간, 짧은 임계 구역 전용)
+// cnt > 0: reader 수, -1: writer 보유. reader도 공유 카운터에 atomic RMW를 하므로
+// 읽기만 하는 경로에서도 캐시 라인이 CPU 사이를 오간다 (RCU 비교 기준).
+// IRQ 핸들러에서는 쓰지 않는다 (irq_save 없음).
+typedef struct rwlock {
+    volatile int32_t cnt;
+} rwlock_t;
+
+#define RWLOCK_INIT { 0 }
+
+static inline void rwlock_init(rwlock_t* l) { l->cnt = 0; }
+
+void read_lock(rwlock_t* l);
+void read_unlock(rwlock_t* l);
+void write_lock(rwlock_t* l);
+void write_unlock(rwlock_t* l);
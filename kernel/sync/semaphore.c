@@ -0,0 +1,42 @@
+#include "semaphore.h"
+#include "../panic/panic.h"
+#include "../../arch/x86/cpu/irqflags.h"
+#include "../../arch/x86/interrupt/irq.h"
+
+void sem_init(semaphore_t* s, int32_t count) {
+    s->count = count;
+    wait_queue_init(&s->waiters);
+}
+
+void sem_down(semaphore_t* s) {
+    if (in_irq()) {
+        panic("sem_down: blocking call in IRQ context");
+    }
+
+    uint32_t f = irq_save();
+    while (s->count <= 0) {
+        wait_queue_sleep(&s->waiters);
+    }
+    s->count--;
+    irq_restore(f);
+}
+
+int sem_trydown(semaphore_t* s) {
+    int ok = 0;
+    uint32_t f = irq_save();
+    if (s->count > 0) {
+        s->count--;
+        ok = 1;
+    }
+    irq_restore(f);
+    return ok;
+}
+
+void sem_up(semaphore_t* s) {
+    uint32_t f = irq_save();
+    s->count++;
+    irq_restore(f);
+
+    // 깨어난 스레드가 count를 다시 확인하므로 그 사이 다른 스레드가 가져가도 안전
+    if (!wait_queue_empty(&s->waiters)) wake_up_one(&s->waiters);
+}
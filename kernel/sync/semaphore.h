@@ -0,0 +1,20 @@
+#pragma once
+#include <stdint.h>
+#include "../sched/wait.h"
+
+// 카운팅 세마포어
+typedef struct semaphore {
+    volatile int32_t count;
+    wait_queue_t waiters;
+} semaphore_t;
+
+void sem_init(semaphore_t* s, int32_t count);
+
+// count가 0이면 잠듦 (스레드 컨텍스트 전용)
+void sem_down(semaphore_t* s);
+
+// 잠들지 않음: 성공 1, 실패 0
+int sem_trydown(semaphore_t* s);
+
+// IRQ 컨텍스트에서도 호출 가능
+void sem_up(semaphore_t* s);
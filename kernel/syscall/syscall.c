@@ -0,0 +1,147 @@
+#include "syscall.h"
+#include "../sched/thread.h"
+#include "../sched/cputime.h"
+#include "../sync/futex.h"
+#include "../io/uring.h"
+#include "../memory/paging.h"
+#include "../memory/mmap.h"
+#include "../time/time.h"
+#include "../time/vdso.h"
+#include "../lib/errno.h"
+#include "../lib/string.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/interrupt/isr.h"
+#include "../../arch/x86/cpu/irqflags.h"
+#include "../trace/irqsoff.h"
+
+typedef int32_t (*syscall_fn_t)(regs_t* r);
+
+static uint32_t g_syscall_count[NR_SYSCALLS];
+
+// 유저 모드 호출이면 포인터가 유저 영역 안에 있어야 함
+static int user_ptr_ok(regs_t* r, uint32_t addr, uint32_t len) {
+    if ((r->cs & 3) == 0) return 1;
+    return addr >= USER_SPACE_START && addr + len > addr && addr + len <= USER_SPACE_END;
+}
+
+static int32_t sys_gettid(regs_t* r) {
+    (void)r;
+    return (int32_t)thread_current()->tid;
+}
+
+static int32_t sys_yield(regs_t* r) {
+    (void)r;
+    thread_yield();
+    return 0;
+}
+
+static int32_t sys_sleep(regs_t* r) {
+    sleep_ms(r->ebx);
+    return 0;
+}
+
+static int32_t sys_futex(regs_t* r) {
+    uint32_t addr = r->ebx;
+    if (!user_ptr_ok(r, addr, 4)) return -EFAULT;
+
+    switch (r->ecx) {
+        case FUTEX_WAIT: return futex_wait((volatile uint32_t*)addr, r->edx);
+        case FUTEX_WAKE: return futex_wake((volatile uint32_t*)addr, r->edx);
+    }
+    return -EINVAL;
+}
+
+static int32_t sys_io_uring_setup(regs_t* r) {
+    uint32_t uparams = r->edx;
+    if (!user_ptr_ok(r, uparams, sizeof(io_uring_params_t))) return -EFAULT;
+
+    // 커널 스레드면 커널 주소로 쓰는 링, 프로세스면 그 주소 공간에 공유 매핑
+    io_uring_params_t p;
+    if (!io_uring_setup(r->ebx, r->ecx, thread_current()->proc, &p)) return -ENOMEM;
+
+    memcpy((void*)uparams, &p, sizeof(p));
+    return (int32_t)p.ring_id;
+}
+
+static int32_t sys_io_uring_enter(regs_t* r) {
+    // 링 id는 전역 번호: 다른 프로세스의 링으로 그 주소 공간을 읽고 쓰지 못하게
+    io_ring_t* ring = io_uring_get_owned(r->ebx, thread_current()->proc);
+    if (!ring) return -EBADF;
+    return io_uring_enter(ring, r->ecx, r->edx, r->esi);
+}
+
+static int32_t sys_clock_gettime(regs_t* r) {
+    uint32_t uns = r->ebx;
+    if (!user_ptr_ok(r, uns, sizeof(uint64_t))) return -EFAULT;
+    *(uint64_t*)uns = clock_monotonic_ns();
+    return 0;
+}
+
+// 파일 매핑은 커널 API(vm_mmap)로만: 유저가 파일을 가리킬 fd가 아직 없다
+static int32_t sys_mmap(regs_t* r) {
+    if (!(r->esi & MAP_ANONYMOUS)) return -EBADF;
+    uint32_t addr;
+    int32_t ret = vm_mmap(vm_current_space(), r->ebx, r->ecx, r->edx, r->esi, 0, 0, &addr);
+    return ret < 0 ? ret : (int32_t)addr;
+}
+
+static int32_t sys_munmap(regs_t* r) {
+    return vm_munmap(vm_current_space(), r->ebx, r->ecx);
+}
+
+static int32_t sys_msync(regs_t* r) {
+    int32_t ret = vm_msync(vm_current_space(), r->ebx, r->ecx, r->edx);
+    return ret < 0 ? ret : 0;
+}
+
+static const syscall_fn_t g_syscalls[NR_SYSCALLS] = {
+    [SYS_GETTID] = sys_gettid,
+    [SYS_YIELD]  = sys_yield,
+    [SYS_SLEEP]  = sys_sleep,
+    [SYS_FUTEX]  = sys_futex,
+    [SYS_IO_URING_SETUP] = sys_io_uring_setup,
+    [SYS_IO_URING_ENTER] = sys_io_uring_enter,
+    [SYS_CLOCK_GETTIME]  = sys_clock_gettime,
+    [SYS_MMAP]   = sys_mmap,
+    [SYS_MUNMAP] = sys_munmap,
+    [SYS_MSYNC]  = sys_msync,
+};
+
+void syscall_init(void) {
+    for (uint32_t i = 0; i < NR_SYSCALLS; i++) g_syscall_count[i] = 0;
+    kprintf("[SYSCALL] int 0x%x, %u entries\n", SYSCALL_VECTOR, NR_SYSCALLS);
+}
+
+void syscall_dispatch(regs_t* r) {
+    // 진입부터 아래 irq_enable까지가 인터럽트 꺼짐 구간
+    irqsoff_irq_enter(0x80, r->eip, r->eflags);
+
+    // 직전 구간(유저 모드였다면 유저 시간)을 마감한 뒤 커널 시간으로
+    cputime_syscall_enter(r->cs & 3);
+
+    // ISR stub이 cli로 들어오므로 시스템 콜 본문은 인터럽트를 켠 채 실행
+    irq_enable();
+
+    uint32_t nr = r->eax;
+    if (nr >= NR_SYSCALLS || !g_syscalls[nr]) {
+        r->eax = (uint32_t)-ENOSYS;
+        cputime_syscall_exit();
+        return;
+    }
+
+    g_syscall_count[nr]++;
+    r->eax = (uint32_t)g_syscalls[nr](r);
+
+    cputime_syscall_exit();
+    sched_preempt_check();
+}
+
+void syscall_dump_stats(void) {
+    kprintf("[SYSCALL] gettid=%u yield=%u sleep=%u futex=%u uring_setup=%u uring_enter=%u clock_gettime=%u\n",
+        g_syscall_count[SYS_GETTID], g_syscall_count[SYS_YIELD],
+        g_syscall_count[SYS_SLEEP], g_syscall_count[SYS_FUTEX],
+        g_syscall_count[SYS_IO_URING_SETUP], g_syscall_count[SYS_IO_URING_ENTER],
+        g_syscall_count[SYS_CLOCK_GETTIME]);
+    kprintf("[SYSCALL] mmap=%u munmap=%u msync=%u\n",
+        g_syscall_count[SYS_MMAP], g_syscall_count[SYS_MUNMAP], g_syscall_count[SYS_MSYNC]);
+}
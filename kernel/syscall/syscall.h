@@ -0,0 +1,51 @@
+#pragma once
+#include <stdint.h>
+
+// int 0x80 시스템 콜
+// eax = 번호, ebx/ecx/edx/esi/edi = 인자, 반환값은 eax (에러는 -errno)
+#define SYSCALL_VECTOR 0x80
+
+#define SYS_GETTID 1
+#define SYS_YIELD  2
+#define SYS_SLEEP  3    // (ms)
+#define SYS_FUTEX  4    // (addr, op, val)
+#define SYS_IO_URING_SETUP 5    // (entries, flags, io_uring_params_t*) -> ring id
+#define SYS_IO_URING_ENTER 6    // (ring id, to_submit, min_complete, flags)
+#define SYS_CLOCK_GETTIME  7    // (uint64_t* ns) monotonic. 시간 페이지(vdso.h) 읽기의 비교 기준
+#define SYS_MMAP   8    // (addr, len, prot, flags) -> 주소. fd 테이블이 없어 MAP_ANONYMOUS만
+#define SYS_MUNMAP 9    // (addr, len)
+#define SYS_MSYNC  10   // (addr, len, flags)
+
+#define NR_SYSCALLS 11
+
+// 주소를 돌려주는 호출(SYS_MMAP)의 실패 판정: -4095..-1
+#define SYSCALL_IS_ERR(ret) ((uint32_t)(ret) >= (uint32_t)-4095)
+
+// SYS_FUTEX op
+#define FUTEX_WAIT 0
+#define FUTEX_WAKE 1
+
+struct regs;
+
+void syscall_init(void);
+void syscall_dispatch(struct regs* r);
+
+void syscall_dump_stats(void);
+
+static inline int32_t syscall3(uint32_t nr, uint32_t a1, uint32_t a2, uint32_t a3) {
+    int32_t ret;
+    __asm__ __volatile__("int $0x80"
+        : "=a"(ret)
+        : "a"(nr), "b"(a1), "c"(a2), "d"(a3)
+        : "memory");
+    return ret;
+}
+
+static inline int32_t syscall4(uint32_t nr, uint32_t a1, uint32_t a2, uint32_t a3, uint32_t a4) {
+    int32_t ret;
+    __asm__ __volatile__("int $0x80"
+        : "=a"(ret)
+        : "a"(nr), "b"(a1), "c"(a2), "d"(a3), "S"(a4)
+        : "memory");
+    return ret;
+}
@@ -0,0 +1,208 @@
+#include "latency.h"
+#include "time.h"
+#include "../sched/thread.h"
+#include "../memory/heap.h"
+#include "../console/kprintf.h"
+#include "../lib/cmdline.h"
+#include "../lib/div64.h"
+#include "../lib/errno.h"
+#include "../../arch/x86/cpu/tsc.h"
+#include "../../arch/x86/cpu/smp.h"
+#include "../../arch/x86/interrupt/pit.h"
+
+const uint32_t latency_hist_bounds[LATENCY_HIST_BUCKETS] = {
+    1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 5000, 0xFFFFFFFFu
+};
+
+typedef struct lat_cpu {
+    uint64_t sum;                   // us 합
+    latency_result_t r;
+} lat_cpu_t;
+
+static lat_cpu_t g_cpu[MAX_CPUS];
+static latency_config_t g_cfg;
+static volatile uint32_t g_busy = 0;
+static volatile uint32_t g_measuring = 0;   // 아직 안 끝난 측정 스레드
+static volatile uint32_t g_loaders = 0;     // 아직 안 끝난 부하 스레드
+static volatile int g_stop = 0;
+
+static void record(lat_cpu_t* c, uint64_t wake, uint64_t edge, uint64_t irq) {
+    uint32_t us = (uint32_t)tsc_cycles_to_us(wake - edge);
+    uint32_t irq_us = (uint32_t)tsc_cycles_to_us(irq - edge);
+    latency_result_t* r = &c->r;
+
+    if (r->samples == 0 || us < r->min_us) r->min_us = us;
+    if (us > r->max_us) r->max_us = us;
+    if (irq_us > r->irq_max_us) r->irq_max_us = irq_us;
+    c->sum += us;
+    r->samples++;
+
+    uint32_t b = 0;
+    while (b + 1 < LATENCY_HIST_BUCKETS && us >= latency_hist_bounds[b]) b++;
+    r->hist[b]++;
+}
+
+// 측정 스레드: 절대 tick으로 잠들어 주기가 밀리지 않게 한다
+// (CPU 고정 API가 없어 지금은 CPU 0 하나. MAX_CPUS가 늘면 스레드별로 고정)
+static void cyclic_thread(void* arg) {
+    lat_cpu_t* c = (lat_cpu_t*)arg;
+    uint32_t interval = g_cfg.interval;
+    uint64_t next = timer_ticks() + interval;
+
+    while (c->r.samples + c->r.lost < g_cfg.loops) {
+        if (!thread_sleep_until(next)) {
+            c->r.overruns++;
+            next = timer_ticks() + interval;
+            continue;
+        }
+        uint64_t wake = rdtsc();
+
+        uint64_t edge, irq;
+        if (time_tick_edge(next, &edge, &irq)) record(c, wake, edge, irq);
+        else c->r.lost++;
+        next += interval;
+    }
+    __sync_fetch_and_sub(&g_measuring, 1);
+}
+
+// 부하: 크기가 섞인 할당/해제를 쉬지 않고 반복 (힙 락 구간)
+static void load_alloc(void* arg) {
+    (void)arg;
+    void* p[16];
+    while (!g_stop) {
+        for (uint32_t i = 0; i < 16; i++) p[i] = kmalloc(32u << (i % 8));
+        for (uint32_t i = 16; i-- > 0;) kfree(p[i]);
+    }
+    __sync_fetch_and_sub(&g_loaders, 1);
+}
+
+// 부하: tick마다 로그 여러 줄 (콘솔/시리얼 출력 구간)
+static void load_log(void* arg) {
+    (void)arg;
+    uint32_t n = 0;
+    while (!g_stop) {
+        for (uint32_t i = 0; i < 4; i++) kprintf("[LAT] log load line %u\n", n++);
+        thread_sleep(1);
+    }
+    __sync_fetch_and_sub(&g_loaders, 1);
+}
+
+static void load_names(uint32_t load, char* out, uint32_t size) {
+    static const char* const names[] = { "alloc", "irq", "log" };
+    int n = 0;
+    for (uint32_t i = 0; i < 3; i++) {
+        if (!(load & (1u << i))) continue;
+        n += ksnprintf(out + n, size - (uint32_t)n, "%s%s", n ? "," : "", names[i]);
+    }
+    if (!n) ksnprintf(out, size, "none");
+}
+
+static void report(const latency_config_t* cfg, uint32_t storm_extra) {
+    char load[24];
+    load_names(cfg->load, load, sizeof(load));
+    uint32_t hz = time_get_hz();
+
+    latency_result_t all = { 0 };
+    uint64_t sum = 0;
+    for (uint32_t cpu = 0; cpu < MAX_CPUS; cpu++) {
+        lat_cpu_t* c = &g_cpu[cpu];
+        latency_result_t* r = &c->r;
+        uint64_t avg = c->sum;
+        if (r->samples) div_u64_u32(&avg, r->samples);
+        r->avg_us = (uint32_t)avg;
+
+        kprintf("[LAT] cpu%u: %u samples, min %u avg %u max %u us, irq max %u us, overruns %u, lost %u\n",
+            cpu, r->samples, r->min_us, r->avg_us, r->max_us, r->irq_max_us, r->overruns, r->lost);
+        kprintf("[LAT] cpu%u hist:", cpu);
+        for (uint32_t b = 0; b < LATENCY_HIST_BUCKETS; b++) {
+            if (b + 1 < LATENCY_HIST_BUCKETS) kprintf(" <%u:%u", latency_hist_bounds[b], r->hist[b]);
+            else kprintf(" >=%u:%u", latency_hist_bounds[b - 1], r->hist[b]);
+        }
+        kprintf("\n");
+
+        if (all.samples == 0 || (r->samples && r->min_us < all.min_us)) all.min_us = r->min_us;
+        if (r->max_us > all.max_us) all.max_us = r->max_us;
+        if (r->irq_max_us > all.irq_max_us) all.irq_max_us = r->irq_max_us;
+        all.samples += r->samples;
+        all.overruns += r->overruns;
+        all.lost += r->lost;
+        sum += c->sum;
+    }
+    if (all.samples) div_u64_u32(&sum, all.samples);
+
+    kprintf("[LATENCY] cpus=%u loops=%u interval_us=%u load=%s samples=%u min=%u avg=%u max=%u irq_max=%u overruns=%u lost=%u storm_irqs=%u\n",
+        MAX_CPUS, cfg->loops, hz ? cfg->interval * (1000000u / hz) : 0, load, all.samples,
+        all.min_us, (uint32_t)sum, all.max_us, all.irq_max_us, all.overruns, all.lost, storm_extra);
+}
+
+int latency_run(const latency_config_t* cfg, latency_result_t* out) {
+    if (tsc_hz() == 0) {
+        kprintf("[LAT] TSC not calibrated\n");
+        return -EINVAL;
+    }
+    if (__sync_lock_test_and_set(&g_busy, 1)) return -EBUSY;
+
+    g_cfg = *cfg;
+    if (!g_cfg.loops) g_cfg.loops = LATENCY_DEFAULT_LOOPS;
+    if (!g_cfg.interval) g_cfg.interval = 1;
+    for (uint32_t cpu = 0; cpu < MAX_CPUS; cpu++) g_cpu[cpu] = (lat_cpu_t){ 0 };
+
+    char load[24];
+    load_names(g_cfg.load, load, sizeof(load));
+    kprintf("[LAT] %u loops x %u tick on %u cpu(s), load=%s\n", g_cfg.loops, g_cfg.interval, MAX_CPUS, load);
+
+    // 부하를 먼저 띄우고 측정 시작
+    g_stop = 0;
+    uint32_t storm0 = pit_storm_extra();
+    if (g_cfg.load & LATENCY_LOAD_IRQ) pit_set_storm(LATENCY_STORM_MULT);
+    if (g_cfg.load & LATENCY_LOAD_ALLOC) {
+        __sync_fetch_and_add(&g_loaders, 1);
+        thread_create("lat-alloc", load_alloc, 0, PRIO_NORMAL);
+    }
+    if (g_cfg.load & LATENCY_LOAD_LOG) {
+        __sync_fetch_and_add(&g_loaders, 1);
+        thread_create("lat-log", load_log, 0, PRIO_NORMAL);
+    }
+
+    time_edge_stamping(1);
+    g_measuring = MAX_CPUS;
+    for (uint32_t cpu = 0; cpu < MAX_CPUS; cpu++) {
+        char name[THREAD_NAME_LEN];
+        ksnprintf(name, sizeof(name), "cyclic/%u", cpu);
+        thread_create(name, cyclic_thread, &g_cpu[cpu], PRIO_MAX);
+    }
+    while (g_measuring) thread_sleep(10);
+    time_edge_stamping(0);
+
+    g_stop = 1;
+    while (g_loaders) thread_sleep(1);
+    pit_set_storm(1);
+
+    report(&g_cfg, pit_storm_extra() - storm0);
+    if (out) {
+        for (uint32_t cpu = 0; cpu < MAX_CPUS; cpu++) out[cpu] = g_cpu[cpu].r;
+    }
+    __sync_lock_release(&g_busy);
+    return 0;
+}
+
+static void latency_boot_thread(void* arg) {
+    latency_config_t* cfg = (latency_config_t*)arg;
+    sleep_ms(LATENCY_BOOT_DELAY_MS);
+    latency_run(cfg, 0);
+}
+
+void latency_boot(void) {
+    static latency_config_t cfg;
+    if (!cmdline_has("latency")) return;
+
+    cfg.loops = cmdline_get_u32("latency", LATENCY_DEFAULT_LOOPS);
+    cfg.interval = cmdline_get_u32("latency.interval", 1);
+    cfg.load = 0;
+    if (cmdline_list_has("latency.load", "alloc")) cfg.load |= LATENCY_LOAD_ALLOC;
+    if (cmdline_list_has("latency.load", "irq")) cfg.load |= LATENCY_LOAD_IRQ;
+    if (cmdline_list_has("latency.load", "log")) cfg.load |= LATENCY_LOAD_LOG;
+    if (cmdline_list_has("latency.load", "all")) cfg.load = LATENCY_LOAD_ALL;
+
+    thread_create("latency", latency_boot_thread, &cfg, PRIO_NORMAL + 2);
+}
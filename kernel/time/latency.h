@@ -0,0 +1,45 @@
+#pragma once
+#include <stdint.h>
+
+// cyclictest 방식 wakeup 지연 측정
+// - CPU마다 최고 우선순위 측정 스레드가 interval tick마다 깨어나
+//   (실제 깨어난 TSC) - (타이머 edge TSC)를 기록한다. edge는 tick IRQ에서 PIT 카운터로 보정한 값
+//   (time_edge_stamping), 그중 edge → IRQ 진입 구간을 irq 지연으로 따로 본다
+// - 선택적 배경 부하: kmalloc/kfree churn, PIT를 LATENCY_STORM_MULT배로 돌린 IRQ storm, kprintf 폭주
+// - 결과는 min/avg/max + 히스토그램, 마지막에 빌드 간 비교용 한 줄 "[LATENCY] key=value ..."
+// - 부팅 옵션: latency[=loops] latency.interval=<tick> latency.load=alloc,irq,log
+
+#define LATENCY_LOAD_ALLOC 0x1
+#define LATENCY_LOAD_IRQ   0x2
+#define LATENCY_LOAD_LOG   0x4
+#define LATENCY_LOAD_ALL   (LATENCY_LOAD_ALLOC | LATENCY_LOAD_IRQ | LATENCY_LOAD_LOG)
+
+#define LATENCY_DEFAULT_LOOPS 1000
+#define LATENCY_STORM_MULT    20          // 100Hz tick → 2kHz 인터럽트
+#define LATENCY_BOOT_DELAY_MS 3000        // 부팅 벤치 스레드들이 먼저 끝나도록
+#define LATENCY_HIST_BUCKETS  12
+
+typedef struct latency_config {
+    uint32_t loops;                 // CPU별 측정 횟수
+    uint32_t interval;              // 주기 (PIT tick, 최소 1)
+    uint32_t load;                  // LATENCY_LOAD_*
+} latency_config_t;
+
+typedef struct latency_result {
+    uint32_t samples;
+    uint32_t overruns;              // 다음 주기 전에 잠들지 못함 (처리가 주기보다 길었음)
+    uint32_t lost;                  // edge 기록이 ring에서 밀려나 측정 못함
+    uint32_t min_us, avg_us, max_us;
+    uint32_t irq_max_us;            // edge → tick IRQ 진입 최대
+    uint32_t hist[LATENCY_HIST_BUCKETS];
+} latency_result_t;
+
+// 히스토그램 구간 상한 (us, 마지막은 그 이상 전부)
+extern const uint32_t latency_hist_bounds[LATENCY_HIST_BUCKETS];
+
+// 측정 + 보고. 끝날 때까지 블록 (스레드 컨텍스트, TSC 보정 이후)
+// out이 있으면 CPU별 결과 (MAX_CPUS개). 이미 실행 중이면 -EBUSY
+int latency_run(const latency_config_t* cfg, latency_result_t* out);
+
+// 부팅 옵션에 latency가 있으면 LATENCY_BOOT_DELAY_MS 뒤 측정하는 스레드를 띄움
+void latency_boot(void);
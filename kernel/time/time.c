@@ -1,49 +1,115 @@
-#include "time.h"
-#include "../console/kprintf.h"  
-#include "../panic/panic.h"
-
-static volatile uint64_t g_ticks = 0;
-static uint32_t g_hz = 0;
-
-void time_on_tick(void) {
-    g_ticks++;
-}
-
-uint64_t timer_ticks(void) {
-    // 32-bit 환경에서 64-bit 읽기 경쟁을 피하려면 원칙적으로 IRQ disable이 필요하지만,
-    // Phase1 busy-wait 용도로는 대부분 충분합니다.
-    // 더 안전하게 하려면 arch 레벨에서 IRQ off/on을 제공한 뒤 보호하면 됩니다.
-    return g_ticks;
-}
-
-void time_set_hz(uint32_t hz) {
-    if (hz == 0) {
-        panic("time_set_hz: hz=0");
-    }
-    g_hz = hz;
-}
-
-
-// Busy-wait sleep (Phase1)
-void sleep_ms(uint32_t ms) {
-    if (g_hz == 0) {
-        panic("sleep_ms: time hz not set (call time_set_hz after pit_init)");
-    }
-
-    if (ms == 0) return;
-
-    // 32비트 범위 내에서 계산
-    // delta = ceil(ms * hz / 1000)
-    uint32_t product = ms * g_hz;
-    uint32_t delta = (product + 999) / 1000;  // 32비트 나눗셈 (컴파일러 최적화)
-
-    if (delta == 0) delta = 1;
-
-    uint64_t start = timer_ticks();
-    uint64_t target = start + (uint64_t)delta;
-
-    while (timer_ticks() < target) {
-        // CPU 점유 줄이기: 인터럽트는 켜져 있어야 tick이 올라갑니다.
-        __asm__ __volatile__("sti; hlt; cli");  // sti 추가
-    }
+#include "time.h"
+#include "vdso.h"
+#include "../console/kprintf.h"  
+#include "../panic/panic.h"
+#include "../sched/thread.h"
+#include "../../arch/x86/cpu/irqflags.h"
+#include "../../arch/x86/interrupt/irq.h"
+#include "../../arch/x86/interrupt/pit.h"
+#include "../../arch/x86/cpu/tsc.h"
+#include "../lib/div64.h"
+
+static volatile uint64_t g_ticks = 0;
+static uint32_t g_hz = 0;
+
+typedef struct tick_edge {
+    uint64_t tick;
+    uint64_t edge_tsc;
+    uint64_t irq_tsc;
+} tick_edge_t;
+
+static tick_edge_t g_edges[TIME_EDGE_RING];
+static volatile int g_edge_on = 0;
+
+// IRQ 진입 시점에서 PIT 카운터를 읽어, 카운터가 reload된 순간(= tick 경계)의 TSC를 거꾸로 계산
+static void record_edge(uint64_t tick) {
+    uint64_t now = rdtsc();
+    uint32_t div = pit_divisor();
+    uint32_t count = pit_read_count();
+    uint64_t elapsed = 0;
+    if (count && count <= div) {
+        elapsed = (uint64_t)(div - count) * tsc_hz();
+        div_u64_u32(&elapsed, PIT_BASE_HZ);
+    }
+
+    tick_edge_t* e = &g_edges[tick % TIME_EDGE_RING];
+    e->tick = tick;
+    e->edge_tsc = now - elapsed;
+    e->irq_tsc = now;
+}
+
+void time_on_tick(void) {
+    g_ticks++;
+    if (g_edge_on) record_edge(g_ticks);
+    vdso_update(g_ticks);
+}
+
+void time_edge_stamping(int on) {
+    uint32_t f = irq_save();
+    if (on && !g_edge_on) {
+        for (uint32_t i = 0; i < TIME_EDGE_RING; i++) g_edges[i].tick = 0;
+    }
+    g_edge_on = on && tsc_hz();
+    irq_restore(f);
+}
+
+int time_tick_edge(uint64_t tick, uint64_t* edge_tsc, uint64_t* irq_tsc) {
+    uint32_t f = irq_save();
+    const tick_edge_t* e = &g_edges[tick % TIME_EDGE_RING];
+    int ok = e->tick == tick && tick != 0;
+    if (ok) {
+        *edge_tsc = e->edge_tsc;
+        *irq_tsc = e->irq_tsc;
+    }
+    irq_restore(f);
+    return ok;
+}
+
+uint64_t timer_ticks(void) {
+    // 32-bit 환경에서 64-bit 읽기 경쟁을 피하려면 원칙적으로 IRQ disable이 필요하지만,
+    // Phase1 busy-wait 용도로는 대부분 충분합니다.
+    // 더 안전하게 하려면 arch 레벨에서 IRQ off/on을 제공한 뒤 보호하면 됩니다.
+    return g_ticks;
+}
+
+void time_set_hz(uint32_t hz) {
+    if (hz == 0) {
+        panic("time_set_hz: hz=0");
+    }
+    g_hz = hz;
+}
+
+uint32_t time_get_hz(void) {
+    return g_hz;
+}
+
+
+// 스레드 컨텍스트면 잠들고(다른 스레드 실행), 부팅 초기/IRQ/인터럽트 off 구간이면 hlt 대기
+void sleep_ms(uint32_t ms) {
+    if (g_hz == 0) {
+        panic("sleep_ms: time hz not set (call time_set_hz after pit_init)");
+    }
+
+    if (ms == 0) return;
+
+    // 32비트 범위 내에서 계산
+    // delta = ceil(ms * hz / 1000)
+    uint32_t product = ms * g_hz;
+    uint32_t delta = (product + 999) / 1000;  // 32비트 나눗셈 (컴파일러 최적화)
+
+    if (delta == 0) delta = 1;
+
+    if (thread_current() && !in_irq() && !irqs_disabled()) {
+        thread_sleep(delta);
+        return;
+    }
+
+    uint64_t start = timer_ticks();
+    uint64_t target = start + (uint64_t)delta;
+
+    while (timer_ticks() < target) {
+        // CPU 점유 줄이기: 인터럽트는 켜져 있어야 tick이 올라갑니다.
+        safe_halt();
+        irq_disable();
+    }
 }
\ No newline at end of file
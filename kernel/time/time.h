@@ -1,14 +1,23 @@
-#pragma once
-#include <stdint.h>
-
-// PIT tick마다 1회 호출 (IRQ0에서 호출)
-void time_on_tick(void);
-
-// 현재 tick 값 반환 (monotonic)
-uint64_t timer_ticks(void);
-
-// PIT 주파수 설정값(Hz)을 time 모듈에 알려줌 (pit_init 이후 1회 호출)
-void time_set_hz(uint32_t hz);
-
-// ms 단위 sleep (Phase1: busy-wait)
+#pragma once
+#include <stdint.h>
+
+// PIT tick마다 1회 호출 (IRQ0에서 호출)
+void time_on_tick(void);
+
+// tick 경계 기록 (지연 측정용). 켜 두면 매 tick IRQ에서 PIT 카운터를 읽어
+// 실제 타이머 edge의 TSC와 핸들러 진입 TSC를 최근 TIME_EDGE_RING개 tick만큼 보관한다
+#define TIME_EDGE_RING 64
+void time_edge_stamping(int on);
+
+// tick의 기록이 남아 있으면 1 (edge_tsc <= irq_tsc)
+int time_tick_edge(uint64_t tick, uint64_t* edge_tsc, uint64_t* irq_tsc);
+
+// 현재 tick 값 반환 (monotonic)
+uint64_t timer_ticks(void);
+
+// PIT 주파수 설정값(Hz)을 time 모듈에 알려줌 (pit_init 이후 1회 호출)
+void time_set_hz(uint32_t hz);
+uint32_t time_get_hz(void);
+
+// ms 단위 sleep (스레드 컨텍스트면 thread_sleep, 그 외에는 hlt busy-wait)
 void sleep_ms(uint32_t ms);
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "vdso.h"
+#include "time.h"
+#include "../memory/pmm.h"
+#include "../memory/vma.h"
+#include "../syscall/syscall.h"
+#include "../sched/thread.h"
+#include "../lib/cmdline.h"
+#include "../lib/div64.h"
+#include "../lib/string.h"
+#include "../panic/panic.h"
+#include "../console/kprintf.h"
+
+#define VDSO_SHIFT 24
+#define NSEC_PER_SEC 1000000000u
+
+static vdso_time_t* g_vdso = 0;
+static uint32_t g_vdso_frame = 0;
+
+void vdso_init(void) {
+    g_vdso_frame = pmm_alloc_frame();
+    if (!g_vdso_frame) {
+        panic("vdso_init: out of frames");
+    }
+    memset((void*)g_vdso_frame, 0, PAGE_SIZE);
+    vdso_time_t* vd = (vdso_time_t*)g_vdso_frame;
+
+    vd->hz = time_get_hz();
+    vd->tsc_hz = tsc_hz();
+    vd->shift = VDSO_SHIFT;
+    if (vd->tsc_hz) {
+        // mult = 1e9 * 2^shift / tsc_hz
+        uint64_t m = (uint64_t)NSEC_PER_SEC << VDSO_SHIFT;
+        div_u64_u32(&m, vd->tsc_hz);
+        vd->mult = (uint32_t)m;
+    }
+
+    // 부팅 후 지난 tick을 시작값으로
+    uint64_t ticks = timer_ticks();
+    uint64_t ns = ticks * (NSEC_PER_SEC / vd->hz);
+    vd->ticks = ticks;
+    vd->ns_base = ns;
+    vd->tsc_base = rdtsc();
+
+    __atomic_store_n(&g_vdso, vd, __ATOMIC_RELEASE);
+    kprintf("[VDSO] time page phys=0x%x user=0x%x mult=%u shift=%u tsc=%u Hz\n",
+        g_vdso_frame, VDSO_USER_ADDR, vd->mult, vd->shift, vd->tsc_hz);
+}
+
+void vdso_update(uint64_t ticks) {
+    vdso_time_t* vd = g_vdso;
+    if (!vd) return;
+
+    uint64_t now = rdtsc();
+
+    // seqlock writer: 홀수 = 갱신 중 (IRQ 컨텍스트라 writer는 항상 하나)
+    __atomic_store_n(&vd->seq, vd->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    if (vd->mult) {
+        uint64_t total = (now - vd->tsc_base) * vd->mult + vd->ns_frac;
+        vd->ns_base += total >> vd->shift;
+        vd->ns_frac = total & ((1ull << vd->shift) - 1);
+    } else {
+        vd->ns_base += NSEC_PER_SEC / vd->hz;
+    }
+    vd->tsc_base = now;
+    vd->ticks = ticks;
+
+    __atomic_store_n(&vd->seq, vd->seq + 1, __ATOMIC_RELEASE);
+}
+
+const vdso_time_t* vdso_data(void) {
+    return g_vdso;
+}
+
+int vdso_map(struct vm_space* vs) {
+    if (!g_vdso_frame) return 1;    // 아직 없음: 매핑 없이 진행 (시스템 콜 경로는 동작)
+    return vm_map_shared(vs, VDSO_USER_ADDR, &g_vdso_frame, 1, VMA_READ);
+}
+
+uint64_t clock_monotonic_ns(void) {
+    const vdso_time_t* vd = g_vdso;
+    if (vd) return vdso_clock_ns(vd);
+
+    uint32_t hz = time_get_hz();
+    return hz ? timer_ticks() * (NSEC_PER_SEC / hz) : 0;
+}
+
+#define VDSO_BENCH_ITERS 20000
+
+static void vdso_bench_main(void* arg) {
+    (void)arg;
+    const vdso_time_t* vd = g_vdso;
+    if (!vd || !vd->tsc_hz) {
+        kprintf("[VDSO] bench skipped (no TSC clocksource)\n");
+        return;
+    }
+
+    // 1) 시간 페이지 직접 읽기 + 단조 증가 확인
+    uint32_t backwards = 0;
+    uint64_t prev = 0;
+    uint64_t t0 = rdtsc();
+    for (uint32_t i = 0; i < VDSO_BENCH_ITERS; i++) {
+        uint64_t ns = vdso_clock_ns(vd);
+        if (ns < prev) backwards++;
+        prev = ns;
+    }
+    uint64_t vdso_cycles = rdtsc() - t0;
+
+    // 2) 같은 값을 시스템 콜로 (int 0x80 진입/복귀 + 디스패치)
+    uint64_t out = 0;
+    t0 = rdtsc();
+    for (uint32_t i = 0; i < VDSO_BENCH_ITERS; i++) {
+        syscall3(SYS_CLOCK_GETTIME, (uint32_t)&out, 0, 0);
+        if (out < prev) backwards++;
+        prev = out;
+    }
+    uint64_t sys_cycles = rdtsc() - t0;
+
+    div_u64_u32(&vdso_cycles, VDSO_BENCH_ITERS);
+    div_u64_u32(&sys_cycles, VDSO_BENCH_ITERS);
+    kprintf("[VDSO] clock read: vdso=%llu cyc, syscall=%llu cyc (%u iters), backwards=%u, now=%llu ns\n",
+        vdso_cycles, sys_cycles, (uint32_t)VDSO_BENCH_ITERS, backwards, prev);
+}
+
+void vdso_bench(void) {
+    if (!cmdline_bench("vdso")) return;
+    thread_create("vdso-bench", vdso_bench_main, 0, PRIO_NORMAL + 1);
+}
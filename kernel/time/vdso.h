@@ -0,0 +1,66 @@
+#pragma once
+#include <stdint.h>
+#include "../../arch/x86/cpu/tsc.h"
+
+// 커널 시간 페이지 (vDSO 방식)
+// 모든 프로세스에 VDSO_USER_ADDR로 읽기 전용 매핑되는 한 페이지. 커널은 매 tick마다
+// seqlock으로 clocksource 파라미터를 갱신하고, 유저 코드는 rdtsc + 곱셈/시프트만으로
+// 시스템 콜 없이 monotonic 시간을 계산한다.
+#define VDSO_USER_ADDR 0xAFFFF000u
+
+typedef struct vdso_time {
+    volatile uint32_t seq;      // 홀수면 갱신 중
+    uint32_t mult;              // ns = (cycles * mult + frac) >> shift
+    uint32_t shift;
+    uint32_t tsc_hz;            // 0이면 TSC 미측정: tick 해상도로만 진행
+
+    uint64_t tsc_base;          // 마지막 갱신 시점 TSC
+    uint64_t ns_base;           // tsc_base 시점의 monotonic ns
+    uint64_t ns_frac;           // ns_base의 소수부 (<< shift 단위, 누적 오차 없이 단조 증가)
+    uint64_t ticks;             // PIT tick
+    uint32_t hz;                // PIT 주파수
+} vdso_time_t;
+
+// 시스템 콜 없이 monotonic ns 읽기 (커널/유저 공용)
+static inline uint64_t vdso_clock_ns(const vdso_time_t* vd) {
+    uint32_t seq;
+    uint64_t base, ns, frac;
+    uint32_t mult, shift;
+
+    for (;;) {
+        seq = __atomic_load_n(&vd->seq, __ATOMIC_ACQUIRE);
+        if (seq & 1) {
+            __asm__ __volatile__("pause" ::: "memory");
+            continue;
+        }
+        base = vd->tsc_base;
+        ns = vd->ns_base;
+        frac = vd->ns_frac;
+        mult = vd->mult;
+        shift = vd->shift;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&vd->seq, __ATOMIC_RELAXED) == seq) break;
+    }
+
+    if (!mult) return ns;
+    return ns + (((rdtsc() - base) * mult + frac) >> shift);
+}
+
+// 커널 쪽 시간 페이지 할당 + clocksource 파라미터 계산 (tsc_calibrate 이후)
+void vdso_init(void);
+
+// 매 tick (IRQ0, time_on_tick에서 호출)
+void vdso_update(uint64_t ticks);
+
+// 커널 주소의 시간 페이지 (vdso_init 이전이면 0)
+const vdso_time_t* vdso_data(void);
+
+// 프로세스 주소 공간에 시간 페이지 매핑. 성공 1
+struct vm_space;
+int vdso_map(struct vm_space* vs);
+
+// 커널용 monotonic ns (vdso_init 이전이면 tick 기반)
+uint64_t clock_monotonic_ns(void);
+
+// 시간 페이지 읽기 vs SYS_CLOCK_GETTIME 비용 비교 (TSC cycle/호출, 별도 스레드에서 실행)
+void vdso_bench(void);
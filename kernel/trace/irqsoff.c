@@ -0,0 +1,192 @@
+#include "irqsoff.h"
+#include "../sched/thread.h"
+#include "../fs/procfs.h"
+#include "../loader/ksym.h"
+#include "../lib/cmdline.h"
+#include "../lib/div64.h"
+#include "../time/time.h"
+#include "../console/kprintf.h"
+#include "../../arch/x86/cpu/tsc.h"
+#include "../../arch/x86/cpu/smp.h"
+
+volatile uint32_t g_irqsoff_tracing = 0;
+
+enum { TRACE_IRQ = 0, TRACE_PREEMPT = 1 };
+
+// CPU별 열린 창
+typedef struct trace_cpu {
+    uint32_t open;
+    uint32_t start_ip;
+    uint32_t vector;
+    uint64_t start_tsc;
+    const thread_t* start_thread;
+} trace_cpu_t;
+
+static trace_cpu_t g_cpu[2][MAX_CPUS];
+static irqsoff_stats_t g_stats[2];
+
+// 추적기 자신은 irq_save를 쓰지 않는다 (훅이 다시 불리므로)
+static inline uint32_t raw_save(void) {
+    uint32_t flags;
+    __asm__ __volatile__("pushf; pop %0; cli" : "=r"(flags) : : "memory");
+    return flags;
+}
+
+static inline void raw_restore(uint32_t flags) {
+    if (flags & EFLAGS_IF) __asm__ __volatile__("sti" : : : "memory");
+}
+
+static void open_window(int kind, uint32_t ip, uint32_t vector) {
+    trace_cpu_t* c = &g_cpu[kind][cpu_id()];
+    if (c->open) return;
+    c->open = 1;
+    c->start_ip = ip;
+    c->vector = vector;
+    c->start_thread = thread_current();
+    c->start_tsc = rdtsc();
+}
+
+static void close_window(int kind, uint32_t ip) {
+    uint64_t now = rdtsc();
+    trace_cpu_t* c = &g_cpu[kind][cpu_id()];
+    if (!c->open) return;
+    c->open = 0;
+
+    uint64_t cycles = now - c->start_tsc;
+    irqsoff_stats_t* st = &g_stats[kind];
+    st->windows++;
+    st->total_cycles += cycles;
+
+    // 상위 IRQSOFF_TOP개만 (대부분은 마지막 항목과 비교 한 번으로 끝)
+    if (st->ntop == IRQSOFF_TOP && cycles <= st->top[IRQSOFF_TOP - 1].cycles) return;
+    uint32_t i = st->ntop < IRQSOFF_TOP ? st->ntop++ : IRQSOFF_TOP - 1;
+    while (i > 0 && st->top[i - 1].cycles < cycles) {
+        st->top[i] = st->top[i - 1];
+        i--;
+    }
+
+    irqsoff_window_t* w = &st->top[i];
+    const thread_t* t = thread_current();
+    w->cycles = cycles;
+    w->start_ip = c->start_ip;
+    w->end_ip = ip;
+    w->vector = c->vector;
+    w->switched = t != c->start_thread;
+    uint32_t n = 0;
+    if (t) {
+        for (; t->name[n] && n < sizeof(w->thread) - 1; n++) w->thread[n] = t->name[n];
+    }
+    w->thread[n] = 0;
+}
+
+#define CALLER() ((uint32_t)__builtin_return_address(0))
+
+void trace_irqs_off(void) {
+    open_window(TRACE_IRQ, CALLER(), 0);
+}
+
+void trace_irqs_on(void) {
+    close_window(TRACE_IRQ, CALLER());
+}
+
+void trace_irq_enter(uint32_t vector, uint32_t eip) {
+    open_window(TRACE_IRQ, eip, vector + 1);
+}
+
+void trace_irq_exit(void) {
+    close_window(TRACE_IRQ, CALLER());
+}
+
+// 선점 금지는 인터럽트가 켜진 채로 바뀌므로 기록 중에만 잠깐 끈다
+void trace_preempt_off(void) {
+    uint32_t f = raw_save();
+    open_window(TRACE_PREEMPT, CALLER(), 0);
+    raw_restore(f);
+}
+
+void trace_preempt_on(void) {
+    uint32_t f = raw_save();
+    close_window(TRACE_PREEMPT, CALLER());
+    raw_restore(f);
+}
+
+void irqsoff_reset(void) {
+    uint32_t f = raw_save();
+    for (int k = 0; k < 2; k++) {
+        g_stats[k] = (irqsoff_stats_t){ 0 };
+        for (uint32_t cpu = 0; cpu < MAX_CPUS; cpu++) g_cpu[k][cpu].open = 0;
+    }
+    raw_restore(f);
+}
+
+void irqsoff_start(void) {
+    irqsoff_reset();
+    g_irqsoff_tracing = 1;
+}
+
+void irqsoff_stop(void) {
+    g_irqsoff_tracing = 0;
+}
+
+void irqsoff_get_stats(int preempt, irqsoff_stats_t* out) {
+    uint32_t f = raw_save();
+    *out = g_stats[preempt ? TRACE_PREEMPT : TRACE_IRQ];
+    raw_restore(f);
+}
+
+static void print_ip(proc_seq_t* s, uint32_t ip) {
+    uint32_t off;
+    const char* name = ksym_lookup(ip, &off);
+    if (name) proc_printf(s, "%s+0x%x", name, off);
+    else proc_printf(s, "0x%x", ip);
+}
+
+static void show_table(proc_seq_t* s, const char* label, const irqsoff_stats_t* st) {
+    uint64_t avg = st->total_cycles;
+    if (st->windows) div_u64_u32(&avg, st->windows);
+    proc_printf(s, "%s: %u windows, avg %llu us, max %llu us\n", label, st->windows,
+        tsc_cycles_to_us(avg), st->ntop ? tsc_cycles_to_us(st->top[0].cycles) : 0ull);
+
+    for (uint32_t i = 0; i < st->ntop; i++) {
+        const irqsoff_window_t* w = &st->top[i];
+        proc_printf(s, " %u) %6llu us  ", i + 1, tsc_cycles_to_us(w->cycles));
+        if (w->vector) proc_printf(s, "int %u @ ", w->vector - 1);
+        print_ip(s, w->start_ip);
+        proc_printf(s, " -> ");
+        print_ip(s, w->end_ip);
+        proc_printf(s, "  [%s%s]\n", w->thread[0] ? w->thread : "-", w->switched ? ", switched" : "");
+    }
+}
+
+static void show_irqsoff(proc_seq_t* s) {
+    irqsoff_stats_t st;
+    proc_printf(s, "tracing: %s\n", g_irqsoff_tracing ? "on" : "off");
+    irqsoff_get_stats(0, &st);
+    show_table(s, "irqs-off", &st);
+    irqsoff_get_stats(1, &st);
+    show_table(s, "preempt-off", &st);
+}
+
+void irqsoff_init(void) {
+    procfs_register("irqsoff", show_irqsoff);
+}
+
+void irqsoff_report(void) {
+    procfs_cat("irqsoff");
+}
+
+static void irqsoff_boot_thread(void* arg) {
+    sleep_ms((uint32_t)arg * 1000);
+    irqsoff_stop();
+    kprintf("[IRQSOFF] longest windows over %u s:\n", (uint32_t)arg);
+    irqsoff_report();
+}
+
+void irqsoff_boot(void) {
+    if (!cmdline_has("irqsoff")) return;
+    uint32_t secs = cmdline_get_u32("irqsoff", IRQSOFF_BOOT_SECS);
+    if (!secs) secs = IRQSOFF_BOOT_SECS;
+
+    irqsoff_start();
+    thread_create("irqsoff", irqsoff_boot_thread, (void*)secs, PRIO_NORMAL + 2);
+}
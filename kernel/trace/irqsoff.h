@@ -0,0 +1,65 @@
+#pragma once
+#include <stdint.h>
+#include "../../arch/x86/cpu/irqflags.h"
+
+// irqsoff / preemptoff tracer
+// - irq_disable/irq_enable/irq_save/irq_restore/safe_halt와 인터럽트 진입·종료(IRQ, 예외, 시스템 콜)에서
+//   CPU의 "인터럽트 꺼짐" 상태가 바뀔 때마다 TSC를 찍는다. 이미 꺼진 상태의 cli나 켜진 상태의 sti는 무시
+// - 창(꺼짐 → 켜짐) 하나가 끝날 때 길이를 재서 가장 긴 IRQSOFF_TOP개를 시작/끝 위치와 함께 보관
+//   (위치는 헬퍼를 부른 함수, 인터럽트 진입으로 시작했으면 끊긴 지점의 eip)
+// - 같은 방식으로 sched_preempt_disable/enable 구간(선점 금지)도 따로 기록
+// - 꺼 두면 헬퍼마다 전역 변수 하나만 확인한다
+// - 결과: /proc/irqsoff, 콘솔 명령 irqsoff [on|off|reset], 부팅 옵션 irqsoff[=초] (그 시간 뒤 보고)
+
+#define IRQSOFF_TOP       8
+#define IRQSOFF_BOOT_SECS 10
+
+typedef struct irqsoff_window {
+    uint64_t cycles;
+    uint32_t start_ip;
+    uint32_t end_ip;
+    uint32_t vector;                // 인터럽트 진입으로 시작했으면 벡터 + 1, 아니면 0
+    uint32_t switched;              // 창 안에서 스레드가 바뀜 (시작과 끝이 다른 스레드)
+    char thread[16];                // 끝난 시점의 스레드
+} irqsoff_window_t;
+
+typedef struct irqsoff_stats {
+    uint32_t windows;
+    uint64_t total_cycles;
+    irqsoff_window_t top[IRQSOFF_TOP];  // 긴 순서
+    uint32_t ntop;
+} irqsoff_stats_t;
+
+// /proc/irqsoff 등록 (procfs_init 이후)
+void irqsoff_init(void);
+
+// 기록을 비우고 추적 시작 / 중지 (중지해도 기록은 남음)
+void irqsoff_start(void);
+void irqsoff_stop(void);
+void irqsoff_reset(void);
+
+// preempt == 0: irqs-off, 1: preempt-off
+void irqsoff_get_stats(int preempt, irqsoff_stats_t* out);
+
+// /proc/irqsoff 내용을 콘솔로
+void irqsoff_report(void);
+
+// 부팅 옵션 irqsoff[=초]: 지금부터 추적하고 그 시간 뒤 보고
+void irqsoff_boot(void);
+
+// 인터럽트/예외/시스템 콜 진입·종료 (stub이 interrupt gate로 IF를 끈 구간).
+// 끊긴 문맥이 인터럽트를 켜 둔 상태(eflags.IF)였을 때만 창이 열리고 닫힌다
+void trace_irq_enter(uint32_t vector, uint32_t eip);
+void trace_irq_exit(void);
+
+static inline void irqsoff_irq_enter(uint32_t vector, uint32_t eip, uint32_t eflags) {
+    if (g_irqsoff_tracing && (eflags & EFLAGS_IF)) trace_irq_enter(vector, eip);
+}
+
+static inline void irqsoff_irq_exit(uint32_t eflags) {
+    if (g_irqsoff_tracing && (eflags & EFLAGS_IF)) trace_irq_exit();
+}
+
+// sched_preempt_disable/enable에서 0 ↔ 1 전환 시
+void trace_preempt_off(void);
+void trace_preempt_on(void);
@@ -0,0 +1,141 @@
+#include "tty.h"
+#include "../sched/wait.h"
+#include "../console/kprintf.h"
+#include "../panic/panic.h"
+#include "../../arch/x86/cpu/irqflags.h"
+#include "../../arch/x86/interrupt/irq.h"
+
+#define TTY_BUF_MASK (TTY_BUF_SIZE - 1)
+
+#define CTRL_C 0x03
+#define CTRL_D 0x04
+#define CTRL_U 0x15
+#define DEL    0x7F
+
+static uint32_t g_mode = TTY_ICANON | TTY_ECHO;
+
+// 편집 중인 줄 (입력 스레드만 접근)
+static char g_line[TTY_LINE_MAX];
+static uint32_t g_line_len = 0;
+
+// 읽기 대기 버퍼: tty_input(쓰기) / tty_read(읽기) 사이는 인터럽트 off로 보호
+static char g_buf[TTY_BUF_SIZE];
+static uint32_t g_head = 0;
+static uint32_t g_tail = 0;
+static uint32_t g_lines = 0;    // 버퍼 안의 완성된 줄 (줄 끝 = '\n' 또는 ^D)
+static wait_queue_t g_readers = WAIT_QUEUE_INIT;
+
+// ^D는 버퍼에 0으로 기록해 두고 읽을 때 줄 끝으로 취급
+#define TTY_EOF_MARK 0
+
+static void tty_echo(const char* s) {
+    if (g_mode & TTY_ECHO) kprintf("%s", s);
+}
+
+static void tty_commit(const char* s, uint32_t n, int line_end) {
+    uint32_t f = irq_save();
+    // 줄이 잘리면 줄 경계가 어긋나므로 자리가 없으면 통째로 버린다
+    if (TTY_BUF_SIZE - (g_head - g_tail) < n) {
+        irq_restore(f);
+        return;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        g_buf[g_head & TTY_BUF_MASK] = s[i];
+        g_head++;
+    }
+    if (line_end) g_lines++;
+    irq_restore(f);
+
+    if (!wait_queue_empty(&g_readers)) wake_up_all(&g_readers);
+}
+
+void tty_input(char c) {
+    if (!(g_mode & TTY_ICANON)) {
+        if (g_mode & TTY_ECHO) kprintf("%c", c);
+        tty_commit(&c, 1, 0);
+        return;
+    }
+
+    switch (c) {
+        case '\b':
+        case DEL:
+            if (g_line_len) {
+                g_line_len--;
+                tty_echo("\b \b");
+            }
+            return;
+        case CTRL_U:
+            while (g_line_len) {
+                g_line_len--;
+                tty_echo("\b \b");
+            }
+            return;
+        case CTRL_C:
+            g_line_len = 0;
+            tty_echo("^C\n");
+            return;
+        case CTRL_D: {
+            // 빈 줄에서 ^D면 읽는 쪽에 EOF(0바이트)
+            char mark = TTY_EOF_MARK;
+            g_line[g_line_len] = mark;
+            tty_commit(g_line, g_line_len + 1, 1);
+            g_line_len = 0;
+            return;
+        }
+        case '\n':
+            g_line[g_line_len++] = '\n';
+            tty_echo("\n");
+            tty_commit(g_line, g_line_len, 1);
+            g_line_len = 0;
+            return;
+    }
+
+    // 마지막 칸은 '\n'/^D 자리로 남긴다
+    if ((uint8_t)c < 0x20 && c != '\t') return;
+    if (g_line_len >= TTY_LINE_MAX - 1) return;
+
+    g_line[g_line_len++] = c;
+    if (g_mode & TTY_ECHO) kprintf("%c", c);
+}
+
+int32_t tty_read(char* buf, uint32_t n) {
+    if (in_irq()) {
+        panic("tty_read: blocking call in IRQ context");
+    }
+    if (n == 0) return 0;
+
+    uint32_t f = irq_save();
+    if (g_mode & TTY_ICANON) {
+        while (g_lines == 0) wait_queue_sleep(&g_readers);
+    } else {
+        while (g_head == g_tail) wait_queue_sleep(&g_readers);
+    }
+
+    uint32_t got = 0;
+    while (got < n && g_tail != g_head) {
+        char c = g_buf[g_tail & TTY_BUF_MASK];
+        g_tail++;
+
+        if ((g_mode & TTY_ICANON) && c == TTY_EOF_MARK) {
+            g_lines--;
+            break;
+        }
+        buf[got++] = c;
+        if ((g_mode & TTY_ICANON) && c == '\n') {
+            g_lines--;
+            break;
+        }
+    }
+    irq_restore(f);
+    return (int32_t)got;
+}
+
+void tty_set_mode(uint32_t flags) {
+    uint32_t f = irq_save();
+    g_mode = flags;
+    irq_restore(f);
+}
+
+uint32_t tty_get_mode(void) {
+    return g_mode;
+}
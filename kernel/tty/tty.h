@@ -0,0 +1,22 @@
+#pragma once
+#include <stdint.h>
+
+// 콘솔 TTY line discipline
+// 키보드 디코더가 문자를 tty_input()으로 넘기면, canonical 모드에서는 줄 단위로 편집
+// (Backspace, ^U 줄 지우기, ^C 취소, ^D EOF)하고 Enter가 들어와야 tty_read()에 공개한다.
+
+// tty_set_mode flags
+#define TTY_ICANON 0x1          // 줄 단위 편집 (끄면 문자 단위 raw)
+#define TTY_ECHO   0x2
+
+#define TTY_LINE_MAX 256        // 편집 중인 한 줄
+#define TTY_BUF_SIZE 1024       // 읽기 대기 버퍼 (2의 거듭제곱)
+
+// 입력 문자 하나 (키보드 디코더 스레드에서 호출)
+void tty_input(char c);
+
+// 한 줄(canonical) 또는 가용 바이트(raw)를 읽을 때까지 대기. 읽은 바이트 수, EOF면 0
+int32_t tty_read(char* buf, uint32_t n);
+
+void tty_set_mode(uint32_t flags);
+uint32_t tty_get_mode(void);
@@ -0,0 +1,19 @@
+#include <stdint.h>
+#include "../kernel/syscall/syscall.h"
+
+// 예제 유저 프로그램: 부팅 시 Multiboot 모듈로 적재된다 (make의 기본 MODULES)
+// user/user.ld로 0x40000000에 링크. 코드/읽기 전용(.text/.rodata), .data, .bss 세그먼트를
+// 하나씩 가져 demand paging(모듈 이미지 직접 매핑, 복사, 0 채움)과 fork COW 경로를 모두 거친다
+
+static const char g_msg[] = "hello from user space";
+static volatile uint32_t g_ticks = 1;
+static volatile uint32_t g_scratch[1024];
+
+void _start(void) {
+    uint32_t tid = (uint32_t)syscall3(SYS_GETTID, 0, 0, 0);
+    for (uint32_t i = 0; ; i++) {
+        g_scratch[i & 1023] = tid + g_msg[i % (sizeof(g_msg) - 1)];
+        g_ticks++;
+        syscall3(SYS_SLEEP, 100, 0, 0);
+    }
+}